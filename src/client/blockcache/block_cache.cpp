@@ -28,6 +28,7 @@
 #include <memory>
 
 #include "absl/cleanup/cleanup.h"
+#include "client/blockcache/block_cache_filler.h"
 #include "client/blockcache/block_cache_metric.h"
 #include "client/blockcache/block_cache_throttle.h"
 #include "client/blockcache/cache_store.h"
@@ -37,6 +38,7 @@
 #include "client/blockcache/log.h"
 #include "client/blockcache/mem_cache.h"
 #include "client/blockcache/phase_timer.h"
+#include "client/blockcache/tier_cache.h"
 
 namespace dingofs {
 namespace client {
@@ -48,12 +50,22 @@ BlockCacheImpl::BlockCacheImpl(BlockCacheOption option)
       s3_(S3ClientImpl::GetInstance()),
       stage_count_(std::make_shared<Countdown>()),
       throttle_(std::make_unique<BlockCacheThrottle>()) {
+  auto mem_cache = std::make_shared<MemCache>(option.mem_cache_option);
   if (option.cache_store == "none") {
-    store_ = std::make_shared<MemCache>();
-  } else {
+    store_ = mem_cache;
+  } else if (option.mem_cache_option.cache_size == 0) {
     store_ = std::make_shared<DiskCacheGroup>(option.disk_cache_options);
+  } else {  // memory cache as L1 in front of disk cache
+    store_ = std::make_shared<TierCache>(
+        mem_cache,
+        std::make_shared<DiskCacheGroup>(option.disk_cache_options));
   }
   uploader_ = std::make_shared<BlockCacheUploader>(s3_, store_, stage_count_);
+  filler_ = std::make_shared<BlockCacheFiller>(store_);
+  if (option.cache_group_option.enable) {
+    group_ =
+        std::make_unique<CacheGroup>(option.cache_group_option, store_, s3_);
+  }
   metric_ = std::make_unique<BlockCacheMetric>(
       option, BlockCacheMetric::AuxMember(uploader_, throttle_));
 }
@@ -63,19 +75,28 @@ BCACHE_ERROR BlockCacheImpl::Init() {
     throttle_->Start();
     uploader_->Init(option_.upload_stage_workers,
                     option_.upload_stage_queue_size);
-    return store_->Init([this](const BlockKey& key,
-                               const std::string& stage_path,
-                               BlockContext ctx) {
+    filler_->Init(option_.cache_fill_workers, option_.cache_fill_queue_size);
+    auto rc = store_->Init([this](const BlockKey& key,
+                                  const std::string& stage_path,
+                                  BlockContext ctx) {
       uploader_->AddStageBlock(key, stage_path, ctx);
     });
+    if (rc == BCACHE_ERROR::OK && group_ != nullptr) {
+      rc = group_->Start();
+    }
+    return rc;
   }
   return BCACHE_ERROR::OK;
 }
 
 BCACHE_ERROR BlockCacheImpl::Shutdown() {
   if (running_.exchange(false)) {
+    if (group_ != nullptr) {
+      group_->Stop();
+    }
     uploader_->WaitAllUploaded();  // wait all stage blocks uploaded
     uploader_->Shutdown();
+    filler_->Shutdown();
     store_->Shutdown();
     throttle_->Stop();
   }
@@ -106,9 +127,11 @@ BCACHE_ERROR BlockCacheImpl::Put(const BlockKey& key, const Block& block,
     }
   }
 
-  // TODO(@Wine93): Cache the block which put to storage directly
   timer.NextPhase(Phase::S3_PUT);
   rc = s3_->Put(key.StoreKey(), block.data, block.size);
+  if (rc == BCACHE_ERROR::OK && GetStoreType() != StoreType::NONE) {
+    filler_->Fill(key, block);  // write-through, it's best effort
+  }
   return rc;
 }
 
@@ -133,13 +156,30 @@ BCACHE_ERROR BlockCacheImpl::Range(const BlockKey& key, off_t offset,
     }
   }
 
-  timer.NextPhase(Phase::S3_RANGE);
   if (retrive) {
+    timer.NextPhase(Phase::PEER_RANGE);
+    rc = RangePeer(key, offset, length, buffer);
+    if (rc == BCACHE_ERROR::OK) {
+      return rc;
+    }
+
+    timer.NextPhase(Phase::S3_RANGE);
     rc = s3_->Range(key.StoreKey(), offset, length, buffer);
   }
   return rc;
 }
 
+BCACHE_ERROR BlockCacheImpl::Load(const BlockKey& key,
+                                  std::shared_ptr<BlockReader>& reader) {
+  BCACHE_ERROR rc;
+  LogGuard log([&]() {
+    return StrFormat("load(%s): %s", key.Filename(), StrErr(rc));
+  });
+
+  rc = store_->Load(key, reader);
+  return rc;
+}
+
 BCACHE_ERROR BlockCacheImpl::Cache(const BlockKey& key, const Block& block) {
   BCACHE_ERROR rc;
   LogGuard log([&]() {
@@ -151,6 +191,14 @@ BCACHE_ERROR BlockCacheImpl::Cache(const BlockKey& key, const Block& block) {
   return rc;
 }
 
+BCACHE_ERROR BlockCacheImpl::RangePeer(const BlockKey& key, off_t offset,
+                                       size_t length, char* buffer) {
+  if (group_ == nullptr) {
+    return BCACHE_ERROR::NOT_FOUND;
+  }
+  return group_->Range(key, offset, length, buffer);
+}
+
 BCACHE_ERROR BlockCacheImpl::Flush(uint64_t ino) {
   BCACHE_ERROR rc;
   LogGuard log([&]() { return StrFormat("flush(%d): %s", ino, StrErr(rc)); });
@@ -164,10 +212,12 @@ bool BlockCacheImpl::IsCached(const BlockKey& key) {
 }
 
 StoreType BlockCacheImpl::GetStoreType() {
-  if (option_.cache_store == "none") {
-    return StoreType::NONE;
+  if (option_.cache_store != "none") {
+    return StoreType::DISK;
+  } else if (option_.mem_cache_option.cache_size > 0) {
+    return StoreType::MEMORY;
   }
-  return StoreType::DISK;
+  return StoreType::NONE;
 }
 
 }  // namespace blockcache
@@ -26,9 +26,11 @@
 #include <atomic>
 #include <memory>
 
+#include "client/blockcache/block_cache_filler.h"
 #include "client/blockcache/block_cache_metric.h"
 #include "client/blockcache/block_cache_throttle.h"
 #include "client/blockcache/block_cache_uploader.h"
+#include "client/blockcache/cache_group.h"
 #include "client/blockcache/cache_store.h"
 #include "client/blockcache/countdown.h"
 #include "client/blockcache/error.h"
@@ -45,6 +47,7 @@ using ::dingofs::client::common::BlockCacheOption;
 
 enum class StoreType {
   NONE,
+  MEMORY,
   DISK,
 };
 
@@ -62,8 +65,18 @@ class BlockCache {
   virtual BCACHE_ERROR Range(const BlockKey& key, off_t offset, size_t length,
                              char* buffer, bool retrive = true) = 0;
 
+  // Open the block cached in local store without retrieving from s3,
+  // the |reader| must be closed by caller.
+  virtual BCACHE_ERROR Load(const BlockKey& key,
+                            std::shared_ptr<BlockReader>& reader) = 0;
+
   virtual BCACHE_ERROR Cache(const BlockKey& key, const Block& block) = 0;
 
+  // Read the range from the owner of block in cache group, return NOT_FOUND
+  // if the group is disabled or the block is owned by ourselves.
+  virtual BCACHE_ERROR RangePeer(const BlockKey& key, off_t offset,
+                                 size_t length, char* buffer) = 0;
+
   virtual BCACHE_ERROR Flush(uint64_t ino) = 0;
 
   virtual bool IsCached(const BlockKey& key) = 0;
@@ -87,8 +100,14 @@ class BlockCacheImpl : public BlockCache {
   BCACHE_ERROR Range(const BlockKey& key, off_t offset, size_t length,
                      char* buffer, bool retrive = true) override;
 
+  BCACHE_ERROR Load(const BlockKey& key,
+                    std::shared_ptr<BlockReader>& reader) override;
+
   BCACHE_ERROR Cache(const BlockKey& key, const Block& block) override;
 
+  BCACHE_ERROR RangePeer(const BlockKey& key, off_t offset, size_t length,
+                         char* buffer) override;
+
   BCACHE_ERROR Flush(uint64_t ino) override;
 
   bool IsCached(const BlockKey& key) override;
@@ -106,6 +125,8 @@ class BlockCacheImpl : public BlockCache {
   std::shared_ptr<Countdown> stage_count_;
   std::shared_ptr<BlockCacheThrottle> throttle_;
   std::shared_ptr<BlockCacheUploader> uploader_;
+  std::shared_ptr<BlockCacheFiller> filler_;
+  std::unique_ptr<CacheGroup> group_;  // nullptr if disabled
   std::unique_ptr<BlockCacheMetric> metric_;
 };
 
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/blockcache/block_cache_filler.h"
+
+#include <butil/time.h>
+#include <glog/logging.h>
+
+#include <cstring>
+#include <memory>
+
+#include "base/math/math.h"
+#include "client/blockcache/error.h"
+#include "client/common/dynamic_config.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+USING_FLAG(block_cache_fill_bandwidth_mb);
+
+using ::dingofs::base::math::kMiB;
+
+BlockCacheFiller::BlockCacheFiller(std::shared_ptr<CacheStore> store)
+    : running_(false),
+      queue_size_(0),
+      inflight_(0),
+      window_second_(0),
+      window_bytes_(0),
+      store_(store),
+      thread_pool_(std::make_unique<TaskThreadPool<>>("cache_fill_worker")),
+      num_filled_("dingofs_block_cache", "cache_fill_blocks"),
+      num_dropped_("dingofs_block_cache", "cache_fill_dropped") {}
+
+void BlockCacheFiller::Init(uint32_t fill_workers, uint32_t fill_queue_size) {
+  if (fill_workers == 0 || fill_queue_size == 0) {
+    LOG(INFO) << "Cache fill for blocks which put to storage is disabled.";
+    return;
+  }
+
+  if (!running_.exchange(true)) {
+    queue_size_ = fill_queue_size;
+    CHECK(thread_pool_->Start(fill_workers) == 0);
+  }
+}
+
+// The blocks which still in queue will be dropped.
+void BlockCacheFiller::Shutdown() {
+  if (running_.exchange(false)) {
+    thread_pool_->Stop();
+    uint32_t dropped = thread_pool_->QueueSize();
+    num_dropped_ << dropped;
+    // New pool for restart, the dropped tasks are discarded with the old one
+    thread_pool_ = std::make_unique<TaskThreadPool<>>("cache_fill_worker");
+    TaskDone(dropped);
+  }
+}
+
+bool BlockCacheFiller::Fill(const BlockKey& key, const Block& block) {
+  if (!running_.load(std::memory_order_relaxed)) {
+    return false;
+  } else if (inflight_.load(std::memory_order_relaxed) >= queue_size_ ||
+             !Acquire(block.size)) {
+    num_dropped_ << 1;
+    return false;
+  }
+
+  // The caller will reuse its buffer once put returned, so we copy it here
+  // instead of reading it back from storage.
+  std::shared_ptr<char> buffer(new char[block.size],
+                               std::default_delete<char[]>());
+  std::memcpy(buffer.get(), block.data, block.size);
+
+  inflight_.fetch_add(1, std::memory_order_relaxed);
+  thread_pool_->Enqueue(&BlockCacheFiller::FillBlock, this, key, buffer,
+                        block.size);
+  return true;
+}
+
+void BlockCacheFiller::WaitAllFilled() {
+  std::unique_lock<std::mutex> lk(idle_mutex_);
+  idle_cond_.wait(lk, [this]() {
+    return inflight_.load(std::memory_order_acquire) == 0;
+  });
+}
+
+// Simple fixed window limiter, the budget is reset every second.
+bool BlockCacheFiller::Acquire(size_t bytes) {
+  uint64_t limit = FLAGS_block_cache_fill_bandwidth_mb * kMiB;
+  if (limit == 0) {
+    return false;
+  }
+
+  int64_t now = butil::monotonic_time_s();
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (now != window_second_) {
+    window_second_ = now;
+    window_bytes_ = 0;
+  }
+
+  if (window_bytes_ + bytes > limit) {
+    return false;
+  }
+  window_bytes_ += bytes;
+  return true;
+}
+
+void BlockCacheFiller::FillBlock(const BlockKey& key,
+                                 std::shared_ptr<char> buffer, size_t length) {
+  auto rc = store_->Cache(key, Block(buffer.get(), length));
+  if (rc == BCACHE_ERROR::OK) {
+    num_filled_ << 1;
+  } else {
+    LOG_EVERY_SECOND(WARNING) << "Fill block (key=" << key.Filename()
+                              << ") into cache failed: " << StrErr(rc);
+  }
+  TaskDone(1);
+}
+
+void BlockCacheFiller::TaskDone(uint32_t n) {
+  if (n == 0) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(idle_mutex_);
+    inflight_.fetch_sub(n, std::memory_order_acq_rel);
+  }
+  idle_cond_.notify_all();
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CACHE_FILLER_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CACHE_FILLER_H_
+
+#include <bvar/bvar.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "client/blockcache/cache_store.h"
+#include "utils/concurrent/task_thread_pool.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::utils::TaskThreadPool;
+
+// Fill the block which put to storage directly (e.g. stage throttled or
+// cache full) into cache store in background, so the next read of data
+// we just wrote won't go to storage.
+//
+// It never blocks the caller: the block is dropped if the fill bandwidth
+// budget in current second is used up or the fill queue is full.
+class BlockCacheFiller {
+ public:
+  explicit BlockCacheFiller(std::shared_ptr<CacheStore> store);
+
+  virtual ~BlockCacheFiller() = default;
+
+  void Init(uint32_t fill_workers, uint32_t fill_queue_size);
+
+  void Shutdown();
+
+  // Return false if the block is dropped
+  bool Fill(const BlockKey& key, const Block& block);
+
+  // Wait until all accepted blocks are filled or dropped
+  void WaitAllFilled();
+
+ private:
+  bool Acquire(size_t bytes);
+
+  void FillBlock(const BlockKey& key, std::shared_ptr<char> buffer,
+                 size_t length);
+
+  void TaskDone(uint32_t n);
+
+ private:
+  std::mutex mutex_;  // protect window_*
+  std::atomic<bool> running_;
+  uint32_t queue_size_;
+  std::atomic<uint32_t> inflight_;
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cond_;
+  int64_t window_second_;
+  uint64_t window_bytes_;
+  std::shared_ptr<CacheStore> store_;
+  std::unique_ptr<TaskThreadPool<>> thread_pool_;
+  bvar::Adder<uint64_t> num_filled_;
+  bvar::Adder<uint64_t> num_dropped_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CACHE_FILLER_H_
@@ -66,6 +66,22 @@ class BlockCacheMetricHelper {
        << stat.num_from_nocto << "," << stat.num_from_reload;
   }
 
+  static uint32_t GetUploadInflight(void* arg) {
+    auto* uploader = reinterpret_cast<BlockCacheUploader*>(arg);
+    return uploader->limiter_ == nullptr ? 0 : uploader->limiter_->Inflight();
+  }
+
+  static uint32_t GetUploadInflightLimit(void* arg) {
+    auto* uploader = reinterpret_cast<BlockCacheUploader*>(arg);
+    return uploader->limiter_ == nullptr ? 0 : uploader->limiter_->Limit();
+  }
+
+  static void ExposeUploadLatency(const std::string& prefix,
+                                  BlockCacheUploader* uploader) {
+    uploader->read_block_latency_.expose(prefix, "upload_read_block");
+    uploader->put_block_latency_.expose(prefix, "upload_put_block");
+  }
+
   static bool IsThrottleEnable(void*) {
     return FLAGS_block_cache_stage_bandwidth_throttle_enable;
   }
@@ -114,6 +130,13 @@ class BlockCacheMetric {
           stage_blocks_on_uploading(prefix, "stage_blocks_on_uploading",
                                     &BlockCacheMetricHelper::PrintOnUploading,
                                     aux_members.uploader.get()),
+          upload_inflight(prefix, "upload_inflight",
+                          &BlockCacheMetricHelper::GetUploadInflight,
+                          aux_members.uploader.get()),
+          upload_inflight_limit(
+              prefix, "upload_inflight_limit",
+              &BlockCacheMetricHelper::GetUploadInflightLimit,
+              aux_members.uploader.get()),
           // stage bandwidth throttle
           stage_bandwidth_throttle_enable(
               prefix, "stage_bandwidth_throttle_enable",
@@ -125,12 +148,18 @@ class BlockCacheMetric {
           stage_bandwidth_throttle_overflow(
               prefix, "stage_bandwidth_throttle_overflow",
               &BlockCacheMetricHelper::IsThrottleOverflow,
-              aux_members.throttle.get()) {}
+              aux_members.throttle.get()) {
+      // latency of each upload phase: read block from disk and put to s3
+      BlockCacheMetricHelper::ExposeUploadLatency(prefix,
+                                                  aux_members.uploader.get());
+    }
 
     bvar::Status<uint32_t> upload_stage_workers;
     bvar::Status<uint32_t> upload_stage_queue_capacity;
     bvar::PassiveStatus<std::string> stage_blocks_on_pending;
     bvar::PassiveStatus<std::string> stage_blocks_on_uploading;
+    bvar::PassiveStatus<uint32_t> upload_inflight;
+    bvar::PassiveStatus<uint32_t> upload_inflight_limit;
     bvar::PassiveStatus<bool> stage_bandwidth_throttle_enable;
     bvar::PassiveStatus<uint64_t> stage_bandwidth_throttle_mb;
     bvar::PassiveStatus<bool> stage_bandwidth_throttle_overflow;
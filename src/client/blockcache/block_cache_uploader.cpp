@@ -22,6 +22,9 @@
 
 #include "client/blockcache/block_cache_uploader.h"
 
+#include <butil/time.h>
+
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <mutex>
@@ -29,6 +32,7 @@
 #include <utility>
 
 #include "absl/cleanup/cleanup.h"
+#include "base/math/math.h"
 #include "client/blockcache/block_cache_uploader_cmmon.h"
 #include "client/blockcache/cache_store.h"
 #include "client/blockcache/error.h"
@@ -44,6 +48,16 @@ namespace blockcache {
 
 USING_FLAG(drop_page_cache);
 
+using ::dingofs::base::math::kMiB;
+
+namespace {
+
+constexpr size_t kUploadBufferSize = 4 * kMiB;  // max block size
+constexpr size_t kMaxPooledBuffers = 16;        // 64 MiB at most
+constexpr uint32_t kMaxInflightPerWorker = 8;
+
+};  // namespace
+
 BlockCacheUploader::BlockCacheUploader(std::shared_ptr<S3Client> s3,
                                        std::shared_ptr<CacheStore> store,
                                        std::shared_ptr<Countdown> stage_count)
@@ -61,6 +75,14 @@ void BlockCacheUploader::Init(uint64_t upload_workers,
     pending_queue_ = std::make_shared<PendingQueue>();
     uploading_queue_ = std::make_shared<UploadingQueue>(upload_queue_size);
 
+    // inflight puts limiter and buffers for them
+    uint32_t max_inflight = upload_workers * kMaxInflightPerWorker;
+    limiter_ = std::make_unique<UploadLimiter>(upload_workers, max_inflight);
+    buffer_pool_ = std::make_shared<UploadBufferPool>(
+        kUploadBufferSize,
+        std::min<size_t>(max_inflight + upload_workers, kMaxPooledBuffers),
+        upload_workers);
+
     // scan stage block worker
     CHECK(scan_stage_thread_pool_->Start(1) == 0);
     scan_stage_thread_pool_->Enqueue(&BlockCacheUploader::ScaningWorker, this);
@@ -76,6 +98,7 @@ void BlockCacheUploader::Init(uint64_t upload_workers,
 
 void BlockCacheUploader::Shutdown() {
   if (running_.exchange(false)) {
+    limiter_->Stop();  // wake up the workers waiting for inflight slot
     scan_stage_thread_pool_->Stop();
     upload_stage_thread_pool_->Stop();
   }
@@ -119,6 +142,9 @@ void BlockCacheUploader::ScaningWorker() {
 void BlockCacheUploader::UploadingWorker() {
   while (running_.load(std::memory_order_relaxed)) {
     auto stage_block = uploading_queue_->Pop();
+    if (!limiter_->Acquire()) {  // stopped, it will be reloaded at next start
+      break;
+    }
     UploadStageBlock(stage_block);
   }
 }
@@ -147,14 +173,16 @@ void BlockCacheUploader::UploadStageBlock(const StageBlock& stage_block) {
   });
 
   timer.NextPhase(Phase::READ_BLOCK);
+  auto start_us = butil::monotonic_time_us();
   rc = ReadBlock(stage_block, buffer, &length);
+  read_block_latency_ << butil::monotonic_time_us() - start_us;
   if (rc == BCACHE_ERROR::OK) {  // OK
     timer.NextPhase(Phase::S3_PUT);
     UploadBlock(stage_block, buffer, length, timer);
   } else if (rc == BCACHE_ERROR::NOT_FOUND) {  // already deleted
-    Uploaded(stage_block, false);
+    UploadDone(stage_block, false);
   } else {  // throw error
-    Uploaded(stage_block, false);
+    UploadDone(stage_block, false);
   }
 }
 
@@ -163,7 +191,9 @@ BCACHE_ERROR BlockCacheUploader::ReadBlock(const StageBlock& stage_block,
                                            size_t* length) {
   auto stage_path = stage_block.stage_path;
   auto fs = NewTempLocalFileSystem();
-  auto rc = fs->ReadFile(stage_path, buffer, length, FLAGS_drop_page_cache);
+  auto rc = fs->ReadFile(
+      stage_path, buffer, length, FLAGS_drop_page_cache,
+      [this](size_t size) { return buffer_pool_->Allocate(size); });
   if (rc == BCACHE_ERROR::NOT_FOUND) {
     LOG(ERROR) << "Stage block (path=" << stage_path
                << ") already deleted, abort upload!";
@@ -177,16 +207,24 @@ BCACHE_ERROR BlockCacheUploader::ReadBlock(const StageBlock& stage_block,
 void BlockCacheUploader::UploadBlock(const StageBlock& stage_block,
                                      std::shared_ptr<char> buffer,
                                      size_t length, PhaseTimer timer) {
-  auto retry_cb = [stage_block, buffer, length, timer, this](int code) {
+  // start time of current attempt, it's updated for every retry
+  auto start_us = std::make_shared<int64_t>(butil::monotonic_time_us());
+  auto retry_cb = [stage_block, buffer, length, timer, start_us,
+                   this](int code) {
     auto key = stage_block.key;
+    auto now_us = butil::monotonic_time_us();
+    auto latency_us = now_us - *start_us;
+    *start_us = now_us;
+    limiter_->OnSample(latency_us, length, code == 0);
     if (code != 0) {
       LOG(ERROR) << "Upload object " << key.Filename()
                  << " failed, code=" << code;
       return true;  // retry
     }
 
+    put_block_latency_ << latency_us;
     RemoveBlock(stage_block);
-    Uploaded(stage_block, true);
+    UploadDone(stage_block, true);
     Log(stage_block, length, BCACHE_ERROR::OK, timer);
     return false;
   };
@@ -201,6 +239,12 @@ void BlockCacheUploader::RemoveBlock(const StageBlock& stage_block) {
   }
 }
 
+void BlockCacheUploader::UploadDone(const StageBlock& stage_block,
+                                    bool success) {
+  limiter_->Release();
+  Uploaded(stage_block, success);
+}
+
 void BlockCacheUploader::Staging(const StageBlock& stage_block) {
   if (NeedCount(stage_block)) {
     stage_count_->Add(stage_block.key.ino, 1, false);
@@ -23,6 +23,8 @@
 #ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CACHE_UPLOADER_H_
 #define DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CACHE_UPLOADER_H_
 
+#include <bvar/bvar.h>
+
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -44,6 +46,10 @@ using ::dingofs::utils::TaskThreadPool;
 // How it works:
 //               add                   scan                     put
 // [stage block]----> [pending queue] -----> [uploading queue] ----> [s3]
+//
+// The uploading workers read stage block into pooled buffer and put it
+// asynchronously, so disk reads are overlapped with inflight puts, and
+// the number of inflight puts is limited by UploadLimiter.
 class BlockCacheUploader {
  public:
   BlockCacheUploader(std::shared_ptr<S3Client> s3,
@@ -79,6 +85,8 @@ class BlockCacheUploader {
   void UploadBlock(const StageBlock& stage_block, std::shared_ptr<char> buffer,
                    size_t length, PhaseTimer timer);
 
+  void UploadDone(const StageBlock& stage_block, bool success);
+
   void RemoveBlock(const StageBlock& stage_block);
 
   void Staging(const StageBlock& stage_block);
@@ -97,6 +105,10 @@ class BlockCacheUploader {
   std::shared_ptr<UploadingQueue> uploading_queue_;
   std::unique_ptr<TaskThreadPool<>> scan_stage_thread_pool_;
   std::unique_ptr<TaskThreadPool<>> upload_stage_thread_pool_;
+  std::shared_ptr<UploadBufferPool> buffer_pool_;
+  std::unique_ptr<UploadLimiter> limiter_;
+  bvar::LatencyRecorder read_block_latency_;
+  bvar::LatencyRecorder put_block_latency_;
 };
 
 }  // namespace blockcache
@@ -27,6 +27,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "client/blockcache/cache_store.h"
 #include "client/blockcache/countdown.h"
@@ -118,6 +119,70 @@ class UploadingQueue {
   std::unordered_map<BlockFrom, uint64_t> count_;
 };
 
+// Reuse aligned buffers for reading stage blocks, the buffer will be given
+// back to pool when the last reference released (e.g. after put to s3).
+// Buffers are allocated on demand up to capacity, and at most max_idle of
+// them are kept once released, the others are freed.
+// It falls back to allocate from heap if the block is larger than buffer
+// size or all pooled buffers are in use, so it never blocks the caller.
+class UploadBufferPool : public std::enable_shared_from_this<UploadBufferPool> {
+ public:
+  UploadBufferPool(size_t buffer_size, size_t capacity, size_t max_idle);
+
+  ~UploadBufferPool();
+
+  std::shared_ptr<char> Allocate(size_t size);
+
+  size_t NumFree();
+
+ private:
+  void Release(char* buffer);
+
+ private:
+  std::mutex mutex_;
+  size_t buffer_size_;
+  size_t capacity_;
+  size_t max_idle_;
+  size_t num_allocated_;
+  std::vector<char*> free_buffers_;
+};
+
+// Limit the number of inflight puts adaptively (AIMD) by observed latency:
+//   1. increase the limit by 1 every round trip if latency is close to the
+//      lowest one we have seen.
+//   2. decrease it multiplicatively once the latency goes up (s3 is busy)
+//      or put failed.
+// The latency is normalized by block size, so blocks with different size
+// can be compared.
+class UploadLimiter {
+ public:
+  UploadLimiter(uint32_t min_limit, uint32_t max_limit);
+
+  // Return false if the limiter stopped
+  bool Acquire();
+
+  void Release();
+
+  void OnSample(int64_t latency_us, size_t length, bool success);
+
+  void Stop();
+
+  uint32_t Inflight();
+
+  uint32_t Limit();
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool running_;
+  uint32_t min_limit_;
+  uint32_t max_limit_;
+  uint32_t inflight_;
+  double limit_;
+  double min_latency_;  // us per MiB
+  uint64_t num_samples_;
+};
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
@@ -22,6 +22,11 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+#include "base/math/math.h"
 #include "client/blockcache/block_cache_uploader_cmmon.h"
 #include "client/common/dynamic_config.h"
 
@@ -31,6 +36,9 @@ namespace blockcache {
 
 USING_FLAG(drop_page_cache);
 
+using ::dingofs::base::math::kKiB;
+using ::dingofs::base::math::kMiB;
+
 void PendingQueue::Push(const StageBlock& stage_block) {
   std::unique_lock<std::mutex> lk(mutex_);
   auto from = stage_block.ctx.from;
@@ -127,6 +135,147 @@ void UploadingQueue::Stat(struct StatBlocks* stat) {
 
 size_t UploadingQueue::Capacity() const { return capacity_; }
 
+namespace {
+
+constexpr size_t kBufferAlignment = 4096;
+
+};  // namespace
+
+UploadBufferPool::UploadBufferPool(size_t buffer_size, size_t capacity,
+                                   size_t max_idle)
+    : buffer_size_(buffer_size),
+      capacity_(capacity),
+      max_idle_(std::min(max_idle, capacity)),
+      num_allocated_(0) {}
+
+UploadBufferPool::~UploadBufferPool() {
+  for (auto* buffer : free_buffers_) {
+    ::free(buffer);
+  }
+}
+
+std::shared_ptr<char> UploadBufferPool::Allocate(size_t size) {
+  if (size <= buffer_size_) {
+    char* buffer = nullptr;
+    {
+      std::unique_lock<std::mutex> lk(mutex_);
+      if (!free_buffers_.empty()) {
+        buffer = free_buffers_.back();
+        free_buffers_.pop_back();
+      } else if (num_allocated_ < capacity_) {
+        void* data;
+        if (::posix_memalign(&data, kBufferAlignment, buffer_size_) == 0) {
+          buffer = static_cast<char*>(data);
+          num_allocated_++;
+        }
+      }
+    }
+
+    if (buffer != nullptr) {
+      auto self = shared_from_this();
+      return std::shared_ptr<char>(
+          buffer, [self](char* buffer) { self->Release(buffer); });
+    }
+  }
+  return std::shared_ptr<char>(new char[size], std::default_delete<char[]>());
+}
+
+size_t UploadBufferPool::NumFree() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  return free_buffers_.size() + (capacity_ - num_allocated_);
+}
+
+void UploadBufferPool::Release(char* buffer) {
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    if (free_buffers_.size() < max_idle_) {
+      free_buffers_.push_back(buffer);
+      return;
+    }
+    num_allocated_--;
+  }
+  ::free(buffer);
+}
+
+namespace {
+
+constexpr double kLatencyTolerance = 2.0;  // sample vs min latency
+constexpr double kBackoffRatio = 0.9;
+constexpr uint64_t kResetMinLatencyInterval = 1000;  // samples
+constexpr size_t kMinSampleLength = 64 * kKiB;
+
+};  // namespace
+
+UploadLimiter::UploadLimiter(uint32_t min_limit, uint32_t max_limit)
+    : running_(true),
+      min_limit_(std::max(min_limit, 1U)),
+      max_limit_(std::max(max_limit, min_limit_)),
+      inflight_(0),
+      limit_(max_limit_),
+      min_latency_(0),
+      num_samples_(0) {}
+
+bool UploadLimiter::Acquire() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  while (running_ && inflight_ >= static_cast<uint32_t>(limit_)) {
+    cond_.wait_for(lk, std::chrono::milliseconds(100));
+  }
+
+  if (!running_) {
+    return false;
+  }
+  inflight_++;
+  return true;
+}
+
+void UploadLimiter::Release() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  CHECK(inflight_ > 0);
+  inflight_--;
+  cond_.notify_one();
+}
+
+void UploadLimiter::OnSample(int64_t latency_us, size_t length,
+                             bool success) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (!success) {
+    limit_ = std::max<double>(min_limit_, limit_ * kBackoffRatio);
+    return;
+  }
+
+  double sample = static_cast<double>(latency_us) * kMiB /
+                  std::max(length, kMinSampleLength);
+  // Forget the lowest latency periodically, the network may changed
+  if (++num_samples_ % kResetMinLatencyInterval == 0) {
+    min_latency_ = sample;
+  } else if (min_latency_ == 0 || sample < min_latency_) {
+    min_latency_ = sample;
+  }
+
+  if (sample > min_latency_ * kLatencyTolerance) {
+    limit_ = std::max<double>(min_limit_, limit_ * kBackoffRatio);
+  } else if (inflight_ + 1 >= static_cast<uint32_t>(limit_)) {
+    limit_ = std::min<double>(max_limit_, limit_ + 1.0 / limit_);
+  }
+  cond_.notify_all();
+}
+
+void UploadLimiter::Stop() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  running_ = false;
+  cond_.notify_all();
+}
+
+uint32_t UploadLimiter::Inflight() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  return inflight_;
+}
+
+uint32_t UploadLimiter::Limit() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  return static_cast<uint32_t>(limit_);
+}
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
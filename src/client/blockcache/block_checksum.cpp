@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/blockcache/block_checksum.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "utils/crc32.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::utils::CRC32;
+
+BlockChecksum::BlockChecksum() : sub_block_size_(kSubBlockSize), length_(0) {}
+
+BlockChecksum BlockChecksum::Compute(const char* data, size_t length) {
+  BlockChecksum checksum;
+  checksum.length_ = length;
+  for (size_t offset = 0; offset < length; offset += kSubBlockSize) {
+    size_t n = std::min(kSubBlockSize, length - offset);
+    checksum.crcs_.push_back(CRC32(data + offset, n));
+  }
+  return checksum;
+}
+
+std::string BlockChecksum::Encode() const {
+  std::string value(kHeaderSize + crcs_.size() * sizeof(uint32_t), '\0');
+  char* p = value.data();
+  uint32_t version = kVersion;
+  std::memcpy(p, &version, sizeof(version));
+  std::memcpy(p + 4, &sub_block_size_, sizeof(sub_block_size_));
+  std::memcpy(p + 8, &length_, sizeof(length_));
+  if (!crcs_.empty()) {
+    std::memcpy(p + kHeaderSize, crcs_.data(),
+                crcs_.size() * sizeof(uint32_t));
+  }
+  return value;
+}
+
+bool BlockChecksum::Decode(const std::string& value) {
+  if (value.size() < kHeaderSize) {
+    return false;
+  }
+
+  uint32_t version, sub_block_size;
+  uint64_t length;
+  const char* p = value.data();
+  std::memcpy(&version, p, sizeof(version));
+  std::memcpy(&sub_block_size, p + 4, sizeof(sub_block_size));
+  std::memcpy(&length, p + 8, sizeof(length));
+  if (version != kVersion || sub_block_size == 0) {
+    return false;
+  }
+
+  size_t count = (length + sub_block_size - 1) / sub_block_size;
+  if (value.size() != kHeaderSize + count * sizeof(uint32_t)) {
+    return false;
+  }
+
+  sub_block_size_ = sub_block_size;
+  length_ = length;
+  crcs_.resize(count);
+  if (count > 0) {
+    std::memcpy(crcs_.data(), p + kHeaderSize, count * sizeof(uint32_t));
+  }
+  return true;
+}
+
+bool BlockChecksum::Empty() const { return crcs_.empty(); }
+
+size_t BlockChecksum::Length() const { return length_; }
+
+void BlockChecksum::AlignRange(off_t offset, size_t length,
+                               off_t* aligned_offset,
+                               size_t* aligned_length) const {
+  uint64_t begin = offset / sub_block_size_ * sub_block_size_;
+  uint64_t end = (offset + length + sub_block_size_ - 1) / sub_block_size_ *
+                 sub_block_size_;
+  end = std::max(begin, std::min(end, length_));
+  *aligned_offset = begin;
+  *aligned_length = end - begin;
+}
+
+bool BlockChecksum::Verify(off_t offset, const char* data,
+                           size_t length) const {
+  if (offset % sub_block_size_ != 0 || offset + length > length_) {
+    return false;
+  }
+
+  size_t index = offset / sub_block_size_;
+  for (size_t pos = 0; pos < length; pos += sub_block_size_, index++) {
+    size_t n = std::min<size_t>(sub_block_size_, length - pos);
+    if (CRC32(data + pos, n) != crcs_[index]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// NOTE: the sub-block may span several backing blocks of IOBuf,
+// so we extend the crc block by block to avoid copying.
+bool BlockChecksum::Verify(off_t offset, const butil::IOBuf& data) const {
+  if (offset % sub_block_size_ != 0 || offset + data.size() > length_) {
+    return false;
+  }
+
+  size_t index = offset / sub_block_size_;
+  size_t remain = std::min<size_t>(sub_block_size_, data.size());
+  uint32_t crc = 0;
+  for (size_t i = 0; i < data.backing_block_num(); i++) {
+    auto piece = data.backing_block(i);
+    const char* p = piece.data();
+    size_t left = piece.size();
+    while (left > 0) {
+      size_t n = std::min(left, remain);
+      crc = CRC32(crc, p, n);
+      p += n;
+      left -= n;
+      remain -= n;
+      if (remain == 0) {  // one sub-block is done
+        if (crc != crcs_[index]) {
+          return false;
+        }
+        offset += sub_block_size_;
+        index++;
+        crc = 0;
+        remain = std::min<size_t>(sub_block_size_, length_ - offset);
+      }
+    }
+  }
+  return true;
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CHECKSUM_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CHECKSUM_H_
+
+#include <butil/iobuf.h>
+#include <sys/types.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+// The CRC32C of every 64 KiB sub-block, it's stored in the extended
+// attribute of block file, so range reads only verify what they touch.
+//
+// Layout (little endian):
+//   | version (4B) | sub_block_size (4B) | length (8B) | crc32c (4B) * N |
+class BlockChecksum {
+ public:
+  static constexpr const char* kXattrName = "user.dingofs.crc32c";
+  static constexpr size_t kSubBlockSize = 64 * 1024;
+
+ public:
+  BlockChecksum();
+
+  static BlockChecksum Compute(const char* data, size_t length);
+
+  std::string Encode() const;
+
+  bool Decode(const std::string& value);
+
+  bool Empty() const;
+
+  size_t Length() const;
+
+  // Expand [offset, offset + length) to the sub-block boundaries,
+  // the range must be verified as a whole.
+  void AlignRange(off_t offset, size_t length, off_t* aligned_offset,
+                  size_t* aligned_length) const;
+
+  // The offset and length must be aligned by AlignRange().
+  bool Verify(off_t offset, const char* data, size_t length) const;
+
+  bool Verify(off_t offset, const butil::IOBuf& data) const;
+
+ private:
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kHeaderSize = 16;
+
+  uint32_t sub_block_size_;
+  uint64_t length_;
+  std::vector<uint32_t> crcs_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_BLOCK_CHECKSUM_H_
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/blockcache/cache_group.h"
+
+#include <brpc/closure_guard.h>
+#include <brpc/controller.h>
+#include <bthread/countdown_event.h>
+#include <glog/logging.h>
+
+#include <memory>
+#include <utility>
+
+#include "absl/cleanup/cleanup.h"
+#include "client/blockcache/log.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::aws::GetObjectAsyncContext;
+using ::dingofs::base::hash::ConNode;
+using ::dingofs::base::hash::KetamaConHash;
+using ::dingofs::pb::client::blockcache::CacheGroupService_Stub;
+using ::dingofs::pb::client::blockcache::RangeRequest;
+using ::dingofs::pb::client::blockcache::RangeResponse;
+
+CacheGroupServiceImpl::CacheGroupServiceImpl(std::shared_ptr<CacheStore> store,
+                                             std::shared_ptr<S3Client> s3)
+    : store_(store), s3_(s3) {}
+
+void CacheGroupServiceImpl::Range(google::protobuf::RpcController* controller,
+                                  const RangeRequest* request,
+                                  RangeResponse* response,
+                                  google::protobuf::Closure* done) {
+  brpc::ClosureGuard done_guard(done);
+  auto* cntl = static_cast<brpc::Controller*>(controller);
+  const auto& pb_key = request->key();
+  BlockKey key(pb_key.fs_id(), pb_key.ino(), pb_key.id(), pb_key.index(),
+               pb_key.version());
+  off_t offset = request->offset();
+  size_t length = request->length();
+
+  BCACHE_ERROR rc;
+  LogGuard log([&]() {
+    return StrFormat("serve_range(%s,%d,%d): %s", key.Filename(), offset,
+                     length, StrErr(rc));
+  });
+
+  auto* data = &cntl->response_attachment();
+  rc = RangeFromStore(key, offset, length, data);
+  if (rc != BCACHE_ERROR::OK) {
+    data->clear();
+    rc = RangeFromS3(key, offset, length, request->block_size(), data);
+  }
+  response->set_status(static_cast<int32_t>(rc));
+}
+
+BCACHE_ERROR CacheGroupServiceImpl::RangeFromStore(const BlockKey& key,
+                                                   off_t offset, size_t length,
+                                                   butil::IOBuf* data) {
+  std::shared_ptr<BlockReader> reader;
+  auto rc = store_->Load(key, reader);
+  if (rc == BCACHE_ERROR::OK) {
+    auto defer = ::absl::MakeCleanup([reader]() { reader->Close(); });
+    std::unique_ptr<char[]> buffer(new char[length]);
+    rc = reader->ReadAt(offset, length, buffer.get());
+    if (rc == BCACHE_ERROR::OK) {
+      data->append_user_data(buffer.release(), length, [](void* data) {
+        delete[] static_cast<char*>(data);
+      });
+    }
+  }
+  return rc;
+}
+
+BCACHE_ERROR CacheGroupServiceImpl::RangeFromS3(const BlockKey& key,
+                                                off_t offset, size_t length,
+                                                size_t block_size,
+                                                butil::IOBuf* data) {
+  if (offset + length > block_size) {
+    return BCACHE_ERROR::INVALID_ARGUMENT;
+  }
+
+  // the members missed the same block wait for the one fetch
+  bool leader;
+  std::string store_key = key.StoreKey();
+  auto call =
+      flight_.JoinOrBegin(store_key, offset, length, 0, block_size, &leader);
+  if (!leader) {
+    std::unique_ptr<char[]> buffer(new char[length]);
+    auto rc = flight_.Wait(call, offset, length, buffer.get());
+    if (rc == BCACHE_ERROR::OK) {
+      data->append_user_data(buffer.release(), length, [](void* data) {
+        delete[] static_cast<char*>(data);
+      });
+    }
+    return rc;
+  }
+
+  size_t nread = 0;
+  auto rc = FetchBlock(store_key, block_size, call->Buffer(), &nread);
+  flight_.End(store_key, call, rc, nread);
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  } else if (offset + length > nread) {
+    return BCACHE_ERROR::END_OF_FILE;
+  }
+
+  // it's best effort, the range is served anyway
+  auto cache_rc = store_->Cache(key, Block(call->Buffer(), nread));
+  if (cache_rc != BCACHE_ERROR::OK) {
+    LOG_EVERY_SECOND(INFO) << "Cache block(" << key.Filename()
+                           << ") failed: " << StrErr(cache_rc);
+  }
+  data->append(call->Buffer() + offset, length);
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR CacheGroupServiceImpl::FetchBlock(const std::string& store_key,
+                                               size_t block_size, char* buffer,
+                                               size_t* nread) {
+  // the last block of file may be shorter than block size, the actual
+  // length is only known by the get
+  bthread::CountdownEvent event(1);
+  auto context = std::make_shared<GetObjectAsyncContext>();
+  context->key = store_key;
+  context->buf = buffer;
+  context->offset = 0;
+  context->len = block_size;
+  context->retCode = 0;
+  context->retry = 0;
+  context->actualLen = 0;
+  context->cb = [&event](const aws::S3Adapter*,
+                         const std::shared_ptr<GetObjectAsyncContext>&) {
+    event.signal();
+  };
+  s3_->AsyncGet(context);
+  event.wait();
+
+  if (context->retCode != 0) {
+    LOG(ERROR) << "Get object(" << store_key
+               << ") failed, retCode=" << context->retCode;
+    return BCACHE_ERROR::IO_ERROR;
+  }
+  *nread = context->actualLen;
+  return BCACHE_ERROR::OK;
+}
+
+CacheGroup::CacheGroup(CacheGroupOption option,
+                       std::shared_ptr<CacheStore> store,
+                       std::shared_ptr<S3Client> s3)
+    : option_(std::move(option)),
+      running_(false),
+      chash_(std::make_unique<KetamaConHash>()),
+      service_(store, s3),
+      num_peer_hits_("dingofs_block_cache", "cache_group_hits"),
+      num_peer_errors_("dingofs_block_cache", "cache_group_errors") {}
+
+BCACHE_ERROR CacheGroup::Start() {
+  if (running_) {
+    return BCACHE_ERROR::OK;
+  }
+
+  brpc::ChannelOptions options;
+  options.timeout_ms = option_.rpc_timeout_ms;
+  options.max_retry = 0;  // fallback to s3 instead
+  for (const auto& peer : option_.peers) {
+    chash_->AddNode(peer, 10);  // the same weight for all members
+    if (peer == option_.listen_address) {
+      continue;
+    }
+
+    auto channel = std::make_unique<brpc::Channel>();
+    if (channel->Init(peer.c_str(), &options) != 0) {
+      LOG(ERROR) << "Init channel to cache group member(" << peer
+                 << ") failed.";
+      return BCACHE_ERROR::INVALID_ARGUMENT;
+    }
+    channels_[peer] = std::move(channel);
+  }
+  chash_->Final();
+
+  if (server_.AddService(&service_, brpc::SERVER_DOESNT_OWN_SERVICE) != 0) {
+    LOG(ERROR) << "Add cache group service failed.";
+    return BCACHE_ERROR::IO_ERROR;
+  }
+
+  brpc::ServerOptions server_options;
+  if (server_.Start(option_.listen_address.c_str(), &server_options) != 0) {
+    LOG(ERROR) << "Start cache group server on " << option_.listen_address
+               << " failed.";
+    return BCACHE_ERROR::IO_ERROR;
+  }
+
+  running_ = true;
+  LOG(INFO) << "Cache group started, listen on " << option_.listen_address
+            << ", " << option_.peers.size() << " members.";
+  return BCACHE_ERROR::OK;
+}
+
+void CacheGroup::Stop() {
+  if (running_) {
+    server_.Stop(0);
+    server_.Join();
+    running_ = false;
+  }
+}
+
+brpc::Channel* CacheGroup::GetOwner(const BlockKey& key) {
+  ConNode node;
+  if (!chash_->Lookup(key.Filename(), node)) {
+    return nullptr;
+  }
+
+  auto iter = channels_.find(node.key);
+  if (iter == channels_.end()) {  // ourselves
+    return nullptr;
+  }
+  return iter->second.get();
+}
+
+BCACHE_ERROR CacheGroup::Range(const BlockKey& key, off_t offset,
+                               size_t length, char* buffer) {
+  if (!running_) {
+    return BCACHE_ERROR::NOT_FOUND;
+  }
+
+  auto* channel = GetOwner(key);
+  if (channel == nullptr) {
+    return BCACHE_ERROR::NOT_FOUND;
+  }
+
+  RangeRequest request;
+  RangeResponse response;
+  brpc::Controller cntl;
+  auto* pb_key = request.mutable_key();
+  pb_key->set_fs_id(key.fs_id);
+  pb_key->set_ino(key.ino);
+  pb_key->set_id(key.id);
+  pb_key->set_index(key.index);
+  pb_key->set_version(key.version);
+  request.set_offset(offset);
+  request.set_length(length);
+  request.set_block_size(option_.block_size);
+
+  CacheGroupService_Stub stub(channel);
+  stub.Range(&cntl, &request, &response, nullptr);
+  if (cntl.Failed()) {
+    num_peer_errors_ << 1;
+    LOG_EVERY_SECOND(WARNING)
+        << "Range block(" << key.Filename() << ") from cache group member("
+        << butil::endpoint2str(cntl.remote_side()).c_str()
+        << ") failed: " << cntl.ErrorText();
+    return BCACHE_ERROR::IO_ERROR;
+  }
+
+  auto rc = static_cast<BCACHE_ERROR>(response.status());
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  } else if (cntl.response_attachment().size() != length) {
+    num_peer_errors_ << 1;
+    return BCACHE_ERROR::IO_ERROR;
+  }
+
+  cntl.response_attachment().copy_to(buffer, length);
+  num_peer_hits_ << 1;
+  return BCACHE_ERROR::OK;
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
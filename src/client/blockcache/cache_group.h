@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_CACHE_GROUP_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_CACHE_GROUP_H_
+
+#include <brpc/channel.h>
+#include <brpc/server.h>
+#include <butil/iobuf.h>
+#include <bvar/bvar.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "base/hash/ketama_con_hash.h"
+#include "client/blockcache/cache_store.h"
+#include "client/blockcache/error.h"
+#include "client/blockcache/s3_client.h"
+#include "client/blockcache/single_flight.h"
+#include "client/common/config.h"
+#include "dingofs/cache_group.pb.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::base::hash::ConHash;
+using ::dingofs::client::common::CacheGroupOption;
+
+// Serve the block ranges for the other members: the block is read from
+// local store, or fetched from s3 as a whole and cached if it's missed,
+// so the next request from any member is served without touching s3.
+class CacheGroupServiceImpl : public pb::client::blockcache::CacheGroupService {
+ public:
+  CacheGroupServiceImpl(std::shared_ptr<CacheStore> store,
+                        std::shared_ptr<S3Client> s3);
+
+  void Range(google::protobuf::RpcController* controller,
+             const pb::client::blockcache::RangeRequest* request,
+             pb::client::blockcache::RangeResponse* response,
+             google::protobuf::Closure* done) override;
+
+ private:
+  BCACHE_ERROR RangeFromStore(const BlockKey& key, off_t offset, size_t length,
+                              butil::IOBuf* data);
+
+  BCACHE_ERROR RangeFromS3(const BlockKey& key, off_t offset, size_t length,
+                           size_t block_size, butil::IOBuf* data);
+
+  BCACHE_ERROR FetchBlock(const std::string& store_key, size_t block_size,
+                          char* buffer, size_t* nread);
+
+ private:
+  std::shared_ptr<CacheStore> store_;
+  std::shared_ptr<S3Client> s3_;
+  SingleFlight flight_;  // coalesce the fetches from all members
+};
+
+// The clients which share their block caches with each other, every block
+// is owned by one member chosen by consistent hash of its key, the block
+// missed in local cache is read from its owner instead of s3, which turns
+// the repeated s3 reads of the same block from many clients into one.
+//
+// The members are static (listed in config) and all of them should use
+// the same list, so every member agrees on the owner of each block.
+class CacheGroup {
+ public:
+  CacheGroup(CacheGroupOption option, std::shared_ptr<CacheStore> store,
+             std::shared_ptr<S3Client> s3);
+
+  virtual ~CacheGroup() = default;
+
+  BCACHE_ERROR Start();
+
+  void Stop();
+
+  // Read the range from owner of block, return NOT_FOUND if the block is
+  // owned by ourselves (it's missed in local cache already).
+  BCACHE_ERROR Range(const BlockKey& key, off_t offset, size_t length,
+                     char* buffer);
+
+ private:
+  // Return the channel to owner of block, nullptr for ourselves
+  brpc::Channel* GetOwner(const BlockKey& key);
+
+ private:
+  CacheGroupOption option_;
+  std::atomic<bool> running_;  // published after members are set up
+  std::unique_ptr<ConHash> chash_;
+  std::unordered_map<std::string, std::unique_ptr<brpc::Channel>> channels_;
+  CacheGroupServiceImpl service_;
+  brpc::Server server_;
+  bvar::Adder<uint64_t> num_peer_hits_;
+  bvar::Adder<uint64_t> num_peer_errors_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_CACHE_GROUP_H_
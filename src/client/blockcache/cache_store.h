@@ -96,8 +96,25 @@ struct BlockContext {
 
 class BlockReader {
  public:
+  virtual ~BlockReader() = default;
+
   virtual BCACHE_ERROR ReadAt(off_t offset, size_t length, char* buffer) = 0;
 
+  // Total bytes of the block
+  virtual size_t Size() const = 0;
+
+  // Resolve the range into the file on local disk which holds it, so it
+  // can be spliced without copying through user space. It returns false
+  // if the range can't be read from the file directly (e.g. it's in memory
+  // or must be verified), the fd is valid until the reader closed.
+  virtual bool Fd(off_t offset, size_t length, int* fd, off_t* fd_offset) {
+    (void)offset;
+    (void)length;
+    (void)fd;
+    (void)fd_offset;
+    return false;
+  }
+
   virtual void Close() = 0;
 };
 
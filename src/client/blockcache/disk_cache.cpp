@@ -24,7 +24,9 @@
 
 #include <glog/logging.h>
 
+#include <cstring>
 #include <memory>
+#include <utility>
 
 #include "absl/cleanup/cleanup.h"
 #include "base/string/string.h"
@@ -36,12 +38,15 @@
 #include "client/blockcache/error.h"
 #include "client/blockcache/log.h"
 #include "client/blockcache/phase_timer.h"
+#include "client/common/dynamic_config.h"
 #include "stub/metric/metric.h"
 
 namespace dingofs {
 namespace client {
 namespace blockcache {
 
+USING_FLAG(disk_cache_persist_index);
+
 using ::dingofs::base::string::GenUuid;
 using ::dingofs::base::string::TrimSpace;
 using ::dingofs::base::time::TimeNow;
@@ -50,23 +55,119 @@ using DiskCacheTotalMetric = ::dingofs::stub::metric::DiskCacheMetric;
 using DiskCacheMetricGuard =
     ::dingofs::client::blockcache::DiskCacheMetricGuard;
 
-BlockReaderImpl::BlockReaderImpl(int fd, std::shared_ptr<LocalFileSystem> fs)
-    : fd_(fd), fs_(fs) {}
+namespace {
+
+// Registered buffers for unaligned O_DIRECT reads, 32 MiB per disk,
+// each one can hold a whole block (4 MiB).
+constexpr uint32_t kIoUringFixedBuffers = 8;
+constexpr size_t kIoUringFixedBufferSize = 4 * 1024 * 1024;
+
+};  // namespace
+
+BlockReaderImpl::BlockReaderImpl(int fd, size_t size,
+                                 std::shared_ptr<LocalFileSystem> fs,
+                                 bool use_direct, BlockChecksum checksum,
+                                 CorruptFunc on_corrupt)
+    : fd_(fd),
+      size_(size),
+      fs_(fs),
+      use_direct_(use_direct),
+      checksum_(std::move(checksum)),
+      on_corrupt_(on_corrupt) {}
 
 BCACHE_ERROR BlockReaderImpl::ReadAt(off_t offset, size_t length,
                                      char* buffer) {
+  if (checksum_.Empty()) {
+    return DoRead(offset, length, buffer);
+  }
+  return ReadVerified(offset, length, buffer);
+}
+
+BCACHE_ERROR BlockReaderImpl::DoRead(off_t offset, size_t length,
+                                     char* buffer) {
   return fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
     BCACHE_ERROR rc;
     DiskCacheMetricGuard guard(
         &rc, &DiskCacheTotalMetric::GetInstance().read_disk, length);
-    rc = posix->LSeek(fd_, offset, SEEK_SET);
-    if (rc == BCACHE_ERROR::OK) {
-      rc = posix->Read(fd_, buffer, length);
+    if (use_direct_) {
+      rc = posix->PReadDirect(fd_, buffer, length, offset);
+    } else {
+      rc = posix->PRead(fd_, buffer, length, offset);
     }
     return rc;
   });
 }
 
+// The range is expanded to the sub-block boundaries for verifying,
+// so the extra bytes are read into a temporary buffer if it's unaligned.
+BCACHE_ERROR BlockReaderImpl::ReadVerified(off_t offset, size_t length,
+                                           char* buffer) {
+  if (offset + length > checksum_.Length()) {
+    return DoRead(offset, length, buffer);  // let filesystem report EOF
+  }
+
+  off_t aligned_offset;
+  size_t aligned_length;
+  checksum_.AlignRange(offset, length, &aligned_offset, &aligned_length);
+
+  char* data = buffer;
+  std::unique_ptr<char[]> temp;
+  if (aligned_offset != offset || aligned_length != length) {
+    temp = std::make_unique<char[]>(aligned_length);
+    data = temp.get();
+  }
+
+  auto rc = DoRead(aligned_offset, aligned_length, data);
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  } else if (!checksum_.Verify(aligned_offset, data, aligned_length)) {
+    return Corrupted();
+  }
+
+  if (data != buffer) {
+    std::memcpy(buffer, data + (offset - aligned_offset), length);
+  }
+  return BCACHE_ERROR::OK;
+}
+
+// NOTE: the block opened with O_DIRECT (which bypasses page cache) is never
+// read by splice, and the sub-blocks touched by the range are verified
+// before handing out the fd if the checksum is present.
+bool BlockReaderImpl::Fd(off_t offset, size_t length, int* fd,
+                         off_t* fd_offset) {
+  if (use_direct_ || offset < 0 || offset + length > size_) {
+    return false;
+  } else if (!checksum_.Empty()) {
+    if (offset + length > checksum_.Length()) {
+      return false;
+    }
+
+    off_t aligned_offset;
+    size_t aligned_length;
+    checksum_.AlignRange(offset, length, &aligned_offset, &aligned_length);
+    auto data = std::make_unique<char[]>(aligned_length);
+    auto rc = DoRead(aligned_offset, aligned_length, data.get());
+    if (rc != BCACHE_ERROR::OK) {
+      return false;
+    } else if (!checksum_.Verify(aligned_offset, data.get(),
+                                 aligned_length)) {
+      Corrupted();
+      return false;
+    }
+  }
+
+  *fd = fd_;
+  *fd_offset = offset;
+  return true;
+}
+
+BCACHE_ERROR BlockReaderImpl::Corrupted() {
+  if (on_corrupt_ != nullptr) {
+    on_corrupt_();
+  }
+  return BCACHE_ERROR::CHECKSUM_MISMATCH;
+}
+
 void BlockReaderImpl::Close() {
   fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
     posix->Close(fd_);
@@ -75,16 +176,27 @@ void BlockReaderImpl::Close() {
 }
 
 DiskCache::DiskCache(DiskCacheOption option)
-    : option_(option), running_(false), use_direct_write_(false) {
+    : option_(option),
+      running_(false),
+      use_direct_write_(false),
+      use_checksum_(true) {
   metric_ = std::make_shared<DiskCacheMetric>(option);
   layout_ = std::make_shared<DiskCacheLayout>(option.cache_dir);
   disk_state_machine_ = std::make_shared<DiskStateMachineImpl>(metric_);
   disk_state_health_checker_ =
       std::make_unique<DiskStateHealthChecker>(layout_, disk_state_machine_);
-  fs_ = std::make_shared<LocalFileSystem>(disk_state_machine_);
-  manager_ = std::make_shared<DiskCacheManager>(option.cache_size, layout_, fs_,
-                                                metric_);
+  if (option.io_uring_depth > 0) {
+    io_uring_ = std::make_shared<IoUring>(
+        option.io_uring_depth, kIoUringFixedBuffers, kIoUringFixedBufferSize);
+  }
+  fs_ = std::make_shared<LocalFileSystem>(disk_state_machine_, io_uring_);
+  manager_ = std::make_shared<DiskCacheManager>(
+      option.cache_size, layout_, fs_, metric_, option.cache_policy);
   loader_ = std::make_unique<DiskCacheLoader>(layout_, fs_, manager_, metric_);
+  if (option.segment_size > 0) {
+    segments_ = std::make_unique<SegmentCache>(
+        option.cache_size, option.segment_size, layout_, fs_, metric_);
+  }
 }
 
 BCACHE_ERROR DiskCache::Init(UploadFunc uploader) {
@@ -92,6 +204,10 @@ BCACHE_ERROR DiskCache::Init(UploadFunc uploader) {
     return BCACHE_ERROR::OK;  // already running
   }
 
+  if (io_uring_ != nullptr && !io_uring_->Start()) {
+    return BCACHE_ERROR::IO_ERROR;
+  }
+
   auto rc = CreateDirs();
   if (rc == BCACHE_ERROR::OK) {
     rc = LoadLockFile();
@@ -107,7 +223,14 @@ BCACHE_ERROR DiskCache::Init(UploadFunc uploader) {
   disk_state_machine_->Start();         // monitor disk state
   disk_state_health_checker_->Start();  // probe disk health
   manager_->Start();                    // manage disk capacity, cache expire
-  loader_->Start(uuid_, uploader);      // load stage and cache block
+  if (UseSegment()) {
+    rc = segments_->Start();  // rebuild index from segment footers
+    if (rc != BCACHE_ERROR::OK) {
+      LOG(ERROR) << "Start segment cache failed: " << StrErr(rc);
+      return rc;
+    }
+  }
+  loader_->Start(uuid_, uploader);  // load stage and cache block
   metric_->SetUuid(uuid_);
   metric_->SetRunningStatus(kCacheUp);
 
@@ -122,10 +245,22 @@ BCACHE_ERROR DiskCache::Shutdown() {
 
   LOG(INFO) << "Disk cache (dir=" << GetRootDir() << ") is shutting down...";
 
+  // The index is complete only if all blocks have been loaded
+  bool save_index = FLAGS_disk_cache_persist_index && !loader_->IsLoading() &&
+                    !UseSegment();
   loader_->Stop();
+  if (save_index) {
+    manager_->SaveIndex(uuid_);
+  }
+  if (UseSegment()) {
+    segments_->Stop();
+  }
   manager_->Stop();
   disk_state_health_checker_->Stop();
   disk_state_machine_->Stop();
+  if (io_uring_ != nullptr) {
+    io_uring_->Stop();
+  }
   metric_->SetRunningStatus(kCacheDown);
 
   LOG(INFO) << "Disk cache (dir=" << GetRootDir() << ") is down.";
@@ -156,20 +291,32 @@ BCACHE_ERROR DiskCache::Stage(const BlockKey& key, const Block& block,
   timer.NextPhase(Phase::WRITE_FILE);
   std::string stage_path(GetStagePath(key));
   std::string cache_path(GetCachePath(key));
-  rc = fs_->WriteFile(stage_path, block.data, block.size, use_direct_write_);
+  // The checksum is shared by the hard link of cache block
+  rc = fs_->WriteFile(
+      stage_path, block.data, block.size, use_direct_write_,
+      [&](const std::string& tmp_path) { SetChecksum(tmp_path, block); });
   if (rc != BCACHE_ERROR::OK) {
     return rc;
   }
 
-  timer.NextPhase(Phase::LINK);
-  rc = fs_->HardLink(stage_path, cache_path);
-  if (rc == BCACHE_ERROR::OK) {
+  if (UseSegment()) {
     timer.NextPhase(Phase::CACHE_ADD);
-    manager_->Add(key, CacheValue(block.size, TimeNow()));
-  } else {
-    LOG(WARNING) << "Link " << stage_path << " to " << cache_path
-                 << " failed: " << StrErr(rc);
-    rc = BCACHE_ERROR::OK;  // ignore link error
+    auto status = segments_->Put(key, block);
+    if (status != BCACHE_ERROR::OK) {
+      LOG(WARNING) << "Append block " << key.Filename()
+                   << " to segment failed: " << StrErr(status);
+    }
+  } else if (manager_->Admit(key, block.size)) {
+    timer.NextPhase(Phase::LINK);
+    rc = fs_->HardLink(stage_path, cache_path);
+    if (rc == BCACHE_ERROR::OK) {
+      timer.NextPhase(Phase::CACHE_ADD);
+      manager_->Add(key, CacheValue(block.size, TimeNow()));
+    } else {
+      LOG(WARNING) << "Link " << stage_path << " to " << cache_path
+                   << " failed: " << StrErr(rc);
+      rc = BCACHE_ERROR::OK;  // ignore link error
+    }
   }
 
   timer.NextPhase(Phase::ENQUEUE_UPLOAD);
@@ -207,8 +354,19 @@ BCACHE_ERROR DiskCache::Cache(const BlockKey& key, const Block& block) {
     return rc;
   }
 
+  if (UseSegment()) {
+    timer.NextPhase(Phase::CACHE_ADD);
+    rc = segments_->Put(key, block);
+    return rc;
+  } else if (!manager_->Admit(key, block.size)) {
+    return rc;  // rejected by cache policy, it's not an error
+  }
+
   timer.NextPhase(Phase::WRITE_FILE);
-  rc = fs_->WriteFile(GetCachePath(key), block.data, block.size);
+  std::string cache_path(GetCachePath(key));
+  rc = fs_->WriteFile(
+      cache_path, block.data, block.size, false,
+      [&](const std::string& tmp_path) { SetChecksum(tmp_path, block); });
   if (rc != BCACHE_ERROR::OK) {
     return rc;
   }
@@ -237,6 +395,9 @@ BCACHE_ERROR DiskCache::Load(const BlockKey& key,
   rc = Check(WANT_EXEC);
   if (rc != BCACHE_ERROR::OK) {
     return rc;
+  } else if (UseSegment()) {
+    rc = segments_->Get(key, reader);
+    return rc;
   } else if (!IsCached(key)) {
     return BCACHE_ERROR::NOT_FOUND;
   }
@@ -244,10 +405,22 @@ BCACHE_ERROR DiskCache::Load(const BlockKey& key,
   timer.NextPhase(Phase::OPEN_FILE);
   rc = fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
     int fd;
-    auto rc = posix->Open(GetCachePath(key), O_RDONLY, &fd);
-    if (rc == BCACHE_ERROR::OK) {
-      reader = std::make_shared<BlockReaderImpl>(fd, fs_);
+    struct stat stat;
+    int flags = UseDirectRead() ? O_RDONLY | O_DIRECT : O_RDONLY;
+    auto rc = posix->Open(GetCachePath(key), flags, &fd);
+    if (rc != BCACHE_ERROR::OK) {
+      return rc;
     }
+
+    rc = posix->FStat(fd, &stat);
+    if (rc != BCACHE_ERROR::OK) {
+      posix->Close(fd);
+      return rc;
+    }
+
+    reader = std::make_shared<BlockReaderImpl>(
+        fd, stat.st_size, fs_, UseDirectRead(), GetChecksum(fd),
+        [this, key]() { RemoveCorrupted(key); });
     return rc;
   });
 
@@ -259,6 +432,10 @@ BCACHE_ERROR DiskCache::Load(const BlockKey& key,
 }
 
 bool DiskCache::IsCached(const BlockKey& key) {
+  if (UseSegment()) {
+    return segments_->Exists(key);
+  }
+
   CacheValue value;
   std::string cache_path = GetCachePath(key);
   auto rc = manager_->Get(key, &value);
@@ -325,6 +502,61 @@ void DiskCache::DetectDirectIO() {
   metric_->SetUseDirectWrite(use_direct_write_);
 }
 
+void DiskCache::SetChecksum(const std::string& path, const Block& block) {
+  if (!use_checksum_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  auto checksum = BlockChecksum::Compute(block.data, block.size);
+  auto rc = fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    return posix->SetXattr(path, BlockChecksum::kXattrName, checksum.Encode());
+  });
+  if (rc == BCACHE_ERROR::NOT_SUPPORTED) {
+    use_checksum_.store(false, std::memory_order_relaxed);
+    LOG(WARNING) << "The filesystem of disk cache (dir="
+                 << layout_->GetRootDir()
+                 << ") not support xattr, blocks will not be verified.";
+  } else if (rc != BCACHE_ERROR::OK) {
+    LOG(WARNING) << "Set checksum for block (path=" << path
+                 << ") failed: " << StrErr(rc);
+  }
+}
+
+// NOTE: the block which has no checksum (e.g. cached by old version)
+// will be read without verifying.
+BlockChecksum DiskCache::GetChecksum(int fd) {
+  BlockChecksum checksum;
+  if (!use_checksum_.load(std::memory_order_relaxed)) {
+    return checksum;
+  }
+
+  std::string value;
+  auto rc = fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    return posix->GetXattr(fd, BlockChecksum::kXattrName, &value);
+  });
+  if (rc == BCACHE_ERROR::OK && !checksum.Decode(value)) {
+    LOG(WARNING) << "Decode checksum of block (fd=" << fd
+                 << ") failed, skip verifying.";
+    return BlockChecksum();
+  }
+  return checksum;
+}
+
+// The corrupted block is removed from cache, and the caller will
+// fallback to read from storage.
+void DiskCache::RemoveCorrupted(const BlockKey& key) {
+  std::string cache_path = GetCachePath(key);
+  LOG(ERROR) << "Checksum mismatch for cache block (path=" << cache_path
+             << "), remove it.";
+  metric_->AddChecksumMismatch();
+  manager_->Delete(key);
+  auto rc = fs_->RemoveFile(cache_path);
+  if (rc != BCACHE_ERROR::OK && rc != BCACHE_ERROR::NOT_FOUND) {
+    LOG(ERROR) << "Remove corrupted block (path=" << cache_path
+               << ") failed: " << StrErr(rc);
+  }
+}
+
 // Check cache status:
 //   1. check running status (UP/DOWN)
 //   2. check disk healthy (HEALTHY/UNHEALTHY)
@@ -346,6 +578,14 @@ BCACHE_ERROR DiskCache::Check(uint8_t want) {
 
 bool DiskCache::IsLoading() const { return loader_->IsLoading(); }
 
+bool DiskCache::UseSegment() const { return segments_ != nullptr; }
+
+// Bypass the page cache only if reads are served by io_uring,
+// otherwise the extra copy of the aligned buffer is not worth.
+bool DiskCache::UseDirectRead() const {
+  return io_uring_ != nullptr && use_direct_write_;
+}
+
 bool DiskCache::IsHealthy() const {
   return disk_state_machine_->GetDiskState() == DiskState::kDiskStateNormal;
 }
@@ -24,9 +24,11 @@
 #define DINGOFS_SRC_CLIENT_BLOCKCACHE_DISK_CACHE_H_
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
 
+#include "client/blockcache/block_checksum.h"
 #include "client/blockcache/cache_store.h"
 #include "client/blockcache/disk_cache_layout.h"
 #include "client/blockcache/disk_cache_loader.h"
@@ -36,6 +38,7 @@
 #include "client/blockcache/disk_state_machine.h"
 #include "client/blockcache/error.h"
 #include "client/blockcache/local_filesystem.h"
+#include "client/blockcache/segment_cache.h"
 #include "client/common/config.h"
 
 namespace dingofs {
@@ -44,19 +47,41 @@ namespace blockcache {
 
 using ::dingofs::client::common::DiskCacheOption;
 
+// The reader verifies the sub-blocks it touches if the checksum is present,
+// and invokes the CorruptFunc once a mismatch is found.
 class BlockReaderImpl : public BlockReader {
  public:
-  BlockReaderImpl(int fd, std::shared_ptr<LocalFileSystem> fs);
+  using CorruptFunc = std::function<void()>;
+
+  BlockReaderImpl(int fd, size_t size, std::shared_ptr<LocalFileSystem> fs,
+                  bool use_direct = false,
+                  BlockChecksum checksum = BlockChecksum(),
+                  CorruptFunc on_corrupt = nullptr);
 
   virtual ~BlockReaderImpl() = default;
 
   BCACHE_ERROR ReadAt(off_t offset, size_t length, char* buffer) override;
 
+  size_t Size() const override { return size_; }
+
+  bool Fd(off_t offset, size_t length, int* fd, off_t* fd_offset) override;
+
   void Close() override;
 
+ private:
+  BCACHE_ERROR DoRead(off_t offset, size_t length, char* buffer);
+
+  BCACHE_ERROR ReadVerified(off_t offset, size_t length, char* buffer);
+
+  BCACHE_ERROR Corrupted();
+
  private:
   int fd_;
+  size_t size_;
   std::shared_ptr<LocalFileSystem> fs_;
+  bool use_direct_;  // fd is opened with O_DIRECT
+  BlockChecksum checksum_;
+  CorruptFunc on_corrupt_;
 };
 
 class DiskCache : public CacheStore {
@@ -96,11 +121,22 @@ class DiskCache : public CacheStore {
 
   void DetectDirectIO();
 
+  // Store the checksum of block in its extended attribute
+  void SetChecksum(const std::string& path, const Block& block);
+
+  BlockChecksum GetChecksum(int fd);
+
+  void RemoveCorrupted(const BlockKey& key);
+
   // check running status, disk healthy and disk free space
   BCACHE_ERROR Check(uint8_t want);
 
   bool IsLoading() const;
 
+  bool UseSegment() const;
+
+  bool UseDirectRead() const;
+
   bool IsHealthy() const;
 
   bool StageFull() const;
@@ -122,10 +158,13 @@ class DiskCache : public CacheStore {
   std::shared_ptr<DiskCacheLayout> layout_;
   std::shared_ptr<DiskStateMachine> disk_state_machine_;
   std::unique_ptr<DiskStateHealthChecker> disk_state_health_checker_;
+  std::shared_ptr<IoUring> io_uring_;
   std::shared_ptr<LocalFileSystem> fs_;
   std::shared_ptr<DiskCacheManager> manager_;
   std::unique_ptr<DiskCacheLoader> loader_;
+  std::unique_ptr<SegmentCache> segments_;
   bool use_direct_write_;
+  std::atomic<bool> use_checksum_;  // false if xattr is not supported
 };
 
 }  // namespace blockcache
@@ -58,8 +58,12 @@ using ::dingofs::base::filepath::PathJoin;
  *   |           └── 4
  *   |               ├── 2_21626898_4096_0_0
  *   |               └── 2_21626898_4097_0_0
+ *   ├── segments (only if segment_size > 0)
+ *   │   ├── 0
+ *   │   └── 1
  *   ├── probe
  *   ├── .detect
+ *   ├── .index (cache index dumped at shutdown)
  *   └── .lock
  */
 class DiskCacheLayout {
@@ -72,12 +76,18 @@ class DiskCacheLayout {
 
   std::string GetCacheDir() const { return PathJoin({root_dir_, "cache"}); }
 
+  std::string GetSegmentDir() const {
+    return PathJoin({root_dir_, "segments"});
+  }
+
   std::string GetProbeDir() const { return PathJoin({root_dir_, "probe"}); }
 
   std::string GetDetectPath() const { return PathJoin({root_dir_, ".detect"}); }
 
   std::string GetLockPath() const { return PathJoin({root_dir_, ".lock"}); }
 
+  std::string GetIndexPath() const { return PathJoin({root_dir_, ".index"}); }
+
   std::string GetStagePath(const BlockKey& key) const {
     return PathJoin({GetStageDir(), key.StoreKey()});
   }
@@ -24,18 +24,26 @@
 
 #include <butil/time.h>
 
+#include <algorithm>
 #include <atomic>
+#include <vector>
 
+#include "absl/cleanup/cleanup.h"
+#include "base/file/file.h"
 #include "base/filepath/filepath.h"
 #include "client/blockcache/cache_store.h"
 #include "client/blockcache/disk_cache_metric.h"
 #include "client/blockcache/error.h"
+#include "client/common/dynamic_config.h"
 
 namespace dingofs {
 namespace client {
 namespace blockcache {
 
-using ::butil::Timer;
+USING_FLAG(disk_cache_load_threads);
+USING_FLAG(disk_cache_persist_index);
+
+using ::dingofs::base::file::IsDir;
 using ::dingofs::base::filepath::HasSuffix;
 using ::dingofs::base::filepath::PathJoin;
 
@@ -47,8 +55,7 @@ DiskCacheLoader::DiskCacheLoader(std::shared_ptr<DiskCacheLayout> layout,
       layout_(layout),
       fs_(fs),
       manager_(manager),
-      metric_(metric),
-      task_pool_(absl::make_unique<TaskThreadPool<>>("disk_cache_loader")) {}
+      metric_(metric) {}
 
 void DiskCacheLoader::Start(const std::string& disk_id,
                             CacheStore::UploadFunc uploader) {
@@ -58,13 +65,17 @@ void DiskCacheLoader::Start(const std::string& disk_id,
 
   disk_id_ = disk_id;
   uploader_ = uploader;
-  task_pool_->Start(2);
+  // Must be set before any task runs, the loading may finish immediately
+  // (e.g. load from index) and set it to finished.
+  metric_->SetLoadStatus(kOnLoading);
+
+  // New pool for restart, the tasks left by last round will be discarded
+  task_pool_ = std::make_unique<TaskThreadPool<>>("disk_cache_loader");
+  task_pool_->Start(std::max(FLAGS_disk_cache_load_threads, 2U));
   task_pool_->Enqueue(&DiskCacheLoader::LoadAllBlocks, this,
                       layout_->GetStageDir(), BlockType::STAGE_BLOCK);
   task_pool_->Enqueue(&DiskCacheLoader::LoadAllBlocks, this,
                       layout_->GetCacheDir(), BlockType::CACHE_BLOCK);
-
-  metric_->SetLoadStatus(kOnLoading);
   LOG(INFO) << "Disk cache loading thread start success.";
 }
 
@@ -85,38 +96,141 @@ bool DiskCacheLoader::IsLoading() {
 
 // If load failed, it only takes up some spaces.
 void DiskCacheLoader::LoadAllBlocks(const std::string& root, BlockType type) {
+  if (type == BlockType::CACHE_BLOCK && FLAGS_disk_cache_persist_index &&
+      LoadIndex()) {
+    metric_->SetLoadStatus(kLoadFinised);
+    return;
+  }
+
+  auto ctx = std::make_shared<LoadContext>(root, type);
+  FanOut(root, 0, ctx);
+  TaskDone(ctx);  // for fan out itself
+}
+
+bool DiskCacheLoader::LoadIndex() {
   Timer timer;
-  BCACHE_ERROR rc;
-  uint64_t num_blocks = 0, num_invalids = 0, size = 0;
+  uint64_t num_blocks = 0;
 
   timer.start();
-  rc = fs_->Walk(root, [&](const std::string& prefix, const FileInfo& file) {
-    if (!running_.load(std::memory_order_relaxed)) {
-      return BCACHE_ERROR::ABORT;
+  auto rc = manager_->LoadIndex(disk_id_, &num_blocks);
+  timer.stop();
+
+  if (rc == BCACHE_ERROR::OK) {
+    LOG(INFO) << StrFormat(
+        "Load cache index (dir=%s) success: %d blocks loaded, costs %.6f "
+        "seconds.",
+        layout_->GetRootDir(), num_blocks, timer.u_elapsed() / 1e6);
+  } else if (rc != BCACHE_ERROR::NOT_FOUND) {
+    LOG(WARNING) << "Load cache index (dir=" << layout_->GetRootDir()
+                 << ") failed: " << StrErr(rc)
+                 << ", fallback to walk cache directory.";
+  }
+  return rc == BCACHE_ERROR::OK;
+}
+
+// Blocks are stored in hashed subdirectories (e.g. blocks/0/1), we walk the
+// top levels here and load each subdirectory in parallel by thread pool.
+void DiskCacheLoader::FanOut(const std::string& dir, int depth,
+                             std::shared_ptr<LoadContext> ctx) {
+  static constexpr int kFanOutDepth = 3;  // root/blocks/{id/1e6}/{id/1e3}
+  if (depth == kFanOutDepth) {
+    ctx->pending.fetch_add(1);
+    task_pool_->Enqueue(&DiskCacheLoader::LoadBlocks, this, dir, ctx);
+    return;
+  }
+
+  std::vector<std::string> subdirs;
+  auto rc = fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    ::DIR* dirp;
+    auto rc = posix->OpenDir(dir, &dirp);
+    if (rc != BCACHE_ERROR::OK) {
+      return rc;
     }
 
-    if (LoadOneBlock(prefix, file, type)) {
-      num_blocks++;
-      size += file.size;
-    } else {
-      num_invalids++;
+    struct dirent* dirent;
+    struct stat stat;
+    auto defer = ::absl::MakeCleanup([&]() { posix->CloseDir(dirp); });
+    while ((rc = posix->ReadDir(dirp, &dirent)) == BCACHE_ERROR::OK) {
+      std::string name(dirent->d_name);
+      if (name == "." || name == "..") {
+        continue;
+      }
+
+      std::string path = PathJoin({dir, name});
+      rc = posix->Stat(path, &stat);
+      if (rc != BCACHE_ERROR::OK) {
+        return rc;
+      } else if (IsDir(&stat)) {
+        subdirs.emplace_back(path);
+      } else {  // file in top levels, load it directly
+        LoadBlock(dir, FileInfo(name, stat.st_size, TimeSpec(stat.st_atime)),
+                  ctx.get());
+      }
     }
-    return BCACHE_ERROR::OK;
+    return rc == BCACHE_ERROR::END_OF_FILE ? BCACHE_ERROR::OK : rc;
   });
-  timer.stop();
 
+  if (rc != BCACHE_ERROR::OK) {
+    ctx->rc.store(rc);
+    return;
+  }
+
+  for (const auto& subdir : subdirs) {
+    if (!running_.load(std::memory_order_relaxed)) {
+      ctx->rc.store(BCACHE_ERROR::ABORT);
+      break;
+    }
+    FanOut(subdir, depth + 1, ctx);
+  }
+}
+
+void DiskCacheLoader::LoadBlocks(const std::string& dir,
+                                 std::shared_ptr<LoadContext> ctx) {
+  auto rc =
+      fs_->Walk(dir, [&](const std::string& prefix, const FileInfo& file) {
+        if (!running_.load(std::memory_order_relaxed)) {
+          return BCACHE_ERROR::ABORT;
+        }
+        LoadBlock(prefix, file, ctx.get());
+        return BCACHE_ERROR::OK;
+      });
+
+  if (rc != BCACHE_ERROR::OK) {
+    ctx->rc.store(rc);
+  }
+  TaskDone(ctx);
+}
+
+void DiskCacheLoader::LoadBlock(const std::string& prefix, const FileInfo& file,
+                                LoadContext* ctx) {
+  if (LoadOneBlock(prefix, file, ctx->type)) {
+    ctx->num_blocks.fetch_add(1, std::memory_order_relaxed);
+    ctx->size.fetch_add(file.size, std::memory_order_relaxed);
+  } else {
+    ctx->num_invalids.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+// The last finished sub-task reports the result.
+void DiskCacheLoader::TaskDone(std::shared_ptr<LoadContext> ctx) {
+  if (ctx->pending.fetch_sub(1) != 1) {
+    return;
+  }
+
+  ctx->timer.stop();
+  auto rc = ctx->rc.load();
   std::string message = StrFormat(
       "Load %s (dir=%s) %s: %d blocks loaded, %d invalid blocks found, costs "
       "%.6f seconds.",
-      ToString(type), root, StrErr(rc), num_blocks, num_invalids,
-      timer.u_elapsed() / 1e6);
+      ToString(ctx->type), ctx->root, StrErr(rc), ctx->num_blocks.load(),
+      ctx->num_invalids.load(), ctx->timer.u_elapsed() / 1e6);
   if (rc == BCACHE_ERROR::OK) {
     LOG(INFO) << message;
   } else {
     LOG(ERROR) << message;
   }
 
-  if (type == BlockType::CACHE_BLOCK) {
+  if (ctx->type == BlockType::CACHE_BLOCK) {
     metric_->SetLoadStatus(kLoadFinised);
   }
 }
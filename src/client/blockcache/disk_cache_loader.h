@@ -23,6 +23,8 @@
 #ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_DISK_CACHE_LOADER_H_
 #define DINGOFS_SRC_CLIENT_BLOCKCACHE_DISK_CACHE_LOADER_H_
 
+#include <butil/time.h>
+
 #include <atomic>
 #include <memory>
 #include <string>
@@ -37,6 +39,7 @@ namespace dingofs {
 namespace client {
 namespace blockcache {
 
+using ::butil::Timer;
 using ::dingofs::utils::TaskThreadPool;
 using FileInfo = LocalFileSystem::FileInfo;
 using UploadFunc = CacheStore::UploadFunc;
@@ -47,6 +50,29 @@ class DiskCacheLoader {
     CACHE_BLOCK,
   };
 
+  // Shared by all sub-tasks which load the same type of blocks
+  struct LoadContext {
+    LoadContext(const std::string& root, BlockType type)
+        : root(root),
+          type(type),
+          rc(BCACHE_ERROR::OK),
+          pending(1),
+          num_blocks(0),
+          num_invalids(0),
+          size(0) {
+      timer.start();
+    }
+
+    std::string root;
+    BlockType type;
+    Timer timer;
+    std::atomic<BCACHE_ERROR> rc;
+    std::atomic<uint64_t> pending;  // number of unfinished sub-tasks
+    std::atomic<uint64_t> num_blocks;
+    std::atomic<uint64_t> num_invalids;
+    std::atomic<uint64_t> size;
+  };
+
  public:
   DiskCacheLoader(std::shared_ptr<DiskCacheLayout> layout,
                   std::shared_ptr<LocalFileSystem> fs,
@@ -64,6 +90,18 @@ class DiskCacheLoader {
  private:
   void LoadAllBlocks(const std::string& root, BlockType type);
 
+  bool LoadIndex();
+
+  void FanOut(const std::string& dir, int depth,
+              std::shared_ptr<LoadContext> ctx);
+
+  void LoadBlocks(const std::string& dir, std::shared_ptr<LoadContext> ctx);
+
+  void LoadBlock(const std::string& prefix, const FileInfo& file,
+                 LoadContext* ctx);
+
+  void TaskDone(std::shared_ptr<LoadContext> ctx);
+
   bool LoadOneBlock(const std::string& prefix, const FileInfo& file,
                     BlockType type);
 
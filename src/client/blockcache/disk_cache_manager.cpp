@@ -25,6 +25,7 @@
 #include <butil/time.h>
 
 #include <chrono>
+#include <cstring>
 #include <memory>
 
 #include "base/math/math.h"
@@ -32,8 +33,10 @@
 #include "client/blockcache/disk_cache_metric.h"
 #include "client/blockcache/lru_cache.h"
 #include "client/blockcache/lru_common.h"
+#include "client/blockcache/tinylfu_cache.h"
 #include "client/common/config.h"
 #include "client/common/dynamic_config.h"
+#include "utils/crc32.h"
 
 namespace dingofs {
 namespace client {
@@ -47,12 +50,51 @@ using ::butil::Timer;
 using ::dingofs::base::math::kMiB;
 using ::dingofs::base::string::StrFormat;
 using ::dingofs::base::time::TimeNow;
+using ::dingofs::utils::CRC32;
 using ::dingofs::utils::LockGuard;
 
+namespace {
+
+// Index file format:
+//
+//   +-------+-------+-----------+------+---------+-----+---------+-------+
+//   | magic | count | uuid_size | uuid | item 0  | ... | item n  | crc32 |
+//   +-------+-------+-----------+------+---------+-----+---------+-------+
+//
+//   item: 7 uint64, fs_id, ino, id, index, version, size, atime
+constexpr uint64_t kIndexMagic = 0x5844494f474e4944;  // "DINGOIDX"
+constexpr size_t kItemFields = 7;
+
+void PutUint64(std::string* buffer, uint64_t value) {
+  buffer->append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+bool GetUint64(const char** pos, const char* end, uint64_t* value) {
+  if (end - *pos < static_cast<ssize_t>(sizeof(uint64_t))) {
+    return false;
+  }
+  std::memcpy(value, *pos, sizeof(uint64_t));
+  *pos += sizeof(uint64_t);
+  return true;
+}
+
+std::unique_ptr<CachePolicy> NewCachePolicy(const std::string& name,
+                                           uint64_t capacity) {
+  if (name == "tinylfu") {
+    return std::make_unique<TinyLFUCache>(capacity / kMiB);
+  } else if (name != "lru") {
+    LOG(WARNING) << "Unknown cache policy (" << name << "), using lru.";
+  }
+  return std::make_unique<LRUCache>();
+}
+
+};  // namespace
+
 DiskCacheManager::DiskCacheManager(uint64_t capacity,
                                    std::shared_ptr<DiskCacheLayout> layout,
                                    std::shared_ptr<LocalFileSystem> fs,
-                                   std::shared_ptr<DiskCacheMetric> metric)
+                                   std::shared_ptr<DiskCacheMetric> metric,
+                                   const std::string& policy)
     : used_bytes_(0),
       capacity_(capacity),
       stage_full_(false),
@@ -60,7 +102,7 @@ DiskCacheManager::DiskCacheManager(uint64_t capacity,
       running_(false),
       layout_(layout),
       fs_(fs),
-      lru_(std::make_unique<LRUCache>()),
+      policy_(NewCachePolicy(policy, capacity)),
       metric_(metric),
       task_pool_(std::make_unique<TaskThreadPool<>>("disk_cache_manager")) {
   mq_ = std::make_unique<MessageQueueType>("delete_block_queue", 10);
@@ -81,7 +123,9 @@ void DiskCacheManager::Start() {
   task_pool_->Enqueue(&DiskCacheManager::CleanupExpire, this);
   LOG(INFO) << "Disk cache manager start, capacity=" << capacity_
             << ", free_space_ratio=" << FLAGS_disk_cache_free_space_ratio
-            << ", cache_expire_second=" << FLAGS_disk_cache_expire_second;
+            << ", cache_expire_second=" << FLAGS_disk_cache_expire_second
+            << ", cache_policy=" << policy_->Name();
+  metric_->SetCachePolicy(policy_->Name());
 }
 
 void DiskCacheManager::Stop() {
@@ -92,24 +136,32 @@ void DiskCacheManager::Stop() {
   LOG(INFO) << "Stop disk cache manager thread...";
   task_pool_->Stop();
   mq_->Stop();
-  lru_->Clear();
+  policy_->Clear();
   LOG(INFO) << "Disk cache manager thread stopped.";
 }
 
+bool DiskCacheManager::Admit(const CacheKey& key, size_t size) {
+  LockGuard lk(mutex_);
+  bool evict_needed = used_bytes_ + size >= capacity_;
+  bool admitted = policy_->Admit(key, evict_needed);
+  metric_->AddCacheAdmit(admitted);
+  return admitted;
+}
+
 void DiskCacheManager::Add(const CacheKey& key, const CacheValue& value) {
   LockGuard lk(mutex_);
-  lru_->Add(key, value);
+  policy_->Add(key, value);
   UpdateUsage(1, value.size);
   if (used_bytes_ >= capacity_) {
     uint64_t goal_bytes = capacity_ * 0.95;
-    uint64_t goal_files = lru_->Size() * 0.95;
+    uint64_t goal_files = policy_->Size() * 0.95;
     CleanupFull(goal_bytes, goal_files);
   }
 }
 
 BCACHE_ERROR DiskCacheManager::Get(const CacheKey& key, CacheValue* value) {
   LockGuard lk(mutex_);
-  if (lru_->Get(key, value)) {
+  if (policy_->Get(key, value)) {
     return BCACHE_ERROR::OK;
   }
   return BCACHE_ERROR::NOT_FOUND;
@@ -118,7 +170,7 @@ BCACHE_ERROR DiskCacheManager::Get(const CacheKey& key, CacheValue* value) {
 void DiskCacheManager::Delete(const CacheKey& key) {
   LockGuard lk(mutex_);
   CacheValue value;
-  if (lru_->Delete(key, &value)) {  // exist
+  if (policy_->Delete(key, &value)) {  // exist
     UpdateUsage(-1, -value.size);
   }
 }
@@ -175,8 +227,8 @@ void DiskCacheManager::CheckFreeSpace() {
 
 // protect by mutex
 void DiskCacheManager::CleanupFull(uint64_t goal_bytes, uint64_t goal_files) {
-  auto to_del = lru_->Evict([&](const CacheValue& value) {
-    if (used_bytes_ <= goal_bytes && lru_->Size() <= goal_files) {
+  auto to_del = policy_->Evict([&](const CacheValue& value) {
+    if (used_bytes_ <= goal_bytes && policy_->Size() <= goal_files) {
       return FilterStatus::FINISH;
     }
     UpdateUsage(-1, -value.size);
@@ -200,7 +252,7 @@ void DiskCacheManager::CleanupExpire() {
 
     {
       LockGuard lk(mutex_);
-      to_del = lru_->Evict([&](const CacheValue& value) {
+      to_del = policy_->Evict([&](const CacheValue& value) {
         if (++num_checks > 1e3) {
           return FilterStatus::FINISH;
         } else if (value.atime + FLAGS_disk_cache_expire_second > now) {
@@ -253,6 +305,104 @@ void DiskCacheManager::DeleteBlocks(const CacheItems& to_del, DeleteFrom from) {
       timer.u_elapsed() / 1e6);
 }
 
+BCACHE_ERROR DiskCacheManager::SaveIndex(const std::string& disk_id) {
+  CacheItems items;
+  {
+    LockGuard lk(mutex_);
+    items = policy_->Snapshot();
+  }
+
+  std::string buffer;
+  buffer.reserve(items.size() * kItemFields * sizeof(uint64_t) + 64);
+  PutUint64(&buffer, kIndexMagic);
+  PutUint64(&buffer, items.size());
+  PutUint64(&buffer, disk_id.size());
+  buffer.append(disk_id);
+  for (const auto& item : items) {
+    const auto& key = item.key;
+    for (uint64_t field : {key.fs_id, key.ino, key.id, key.index,
+                           key.version, static_cast<uint64_t>(item.value.size),
+                           item.value.atime.seconds}) {
+      PutUint64(&buffer, field);
+    }
+  }
+  uint32_t crc = CRC32(buffer.data(), buffer.size());
+  buffer.append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+
+  auto rc = fs_->WriteFile(layout_->GetIndexPath(), buffer.data(),
+                           buffer.size());
+  if (rc == BCACHE_ERROR::OK) {
+    LOG(INFO) << "Save cache index (path=" << layout_->GetIndexPath()
+              << ") success: " << items.size() << " blocks saved.";
+  } else {
+    LOG(ERROR) << "Save cache index (path=" << layout_->GetIndexPath()
+               << ") failed: " << StrErr(rc);
+  }
+  return rc;
+}
+
+BCACHE_ERROR DiskCacheManager::LoadIndex(const std::string& disk_id,
+                                         uint64_t* num_blocks) {
+  std::string path = layout_->GetIndexPath();
+  std::string buffer;
+  auto rc = fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    struct stat stat;
+    auto rc = posix->Stat(path, &stat);
+    if (rc != BCACHE_ERROR::OK) {
+      return rc;
+    }
+
+    int fd;
+    rc = posix->Open(path, O_RDONLY, &fd);
+    if (rc == BCACHE_ERROR::OK) {
+      buffer.resize(stat.st_size);
+      rc = posix->PRead(fd, buffer.data(), buffer.size(), 0);
+      posix->Close(fd);
+    }
+    return rc;
+  });
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  }
+  fs_->RemoveFile(path);  // never reuse it
+
+  uint32_t crc;
+  if (buffer.size() < sizeof(crc)) {
+    return BCACHE_ERROR::INVALID_ARGUMENT;
+  }
+  size_t length = buffer.size() - sizeof(crc);
+  std::memcpy(&crc, buffer.data() + length, sizeof(crc));
+  if (crc != CRC32(buffer.data(), length)) {
+    return BCACHE_ERROR::INVALID_ARGUMENT;
+  }
+
+  uint64_t magic, count, uuid_size;
+  const char* pos = buffer.data();
+  const char* end = buffer.data() + length;
+  if (!GetUint64(&pos, end, &magic) || magic != kIndexMagic ||
+      !GetUint64(&pos, end, &count) || !GetUint64(&pos, end, &uuid_size) ||
+      static_cast<uint64_t>(end - pos) < uuid_size ||
+      std::string(pos, uuid_size) != disk_id) {
+    return BCACHE_ERROR::INVALID_ARGUMENT;
+  }
+  pos += uuid_size;
+  uint64_t item_size = kItemFields * sizeof(uint64_t);
+  if (static_cast<uint64_t>(end - pos) != count * item_size) {
+    return BCACHE_ERROR::INVALID_ARGUMENT;
+  }
+
+  uint64_t fields[kItemFields];
+  for (uint64_t i = 0; i < count; i++) {
+    for (size_t j = 0; j < kItemFields; j++) {
+      GetUint64(&pos, end, &fields[j]);
+    }
+    CacheKey key(fields[0], fields[1], fields[2], fields[3], fields[4]);
+    Add(key, CacheValue(fields[5], TimeSpec(fields[6])));
+  }
+  *num_blocks = count;
+  return BCACHE_ERROR::OK;
+}
+
 void DiskCacheManager::UpdateUsage(int64_t n, int64_t bytes) {
   used_bytes_ += bytes;
   metric_->AddCacheBlock(n, bytes);
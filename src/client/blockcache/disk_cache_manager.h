@@ -47,7 +47,7 @@ using ::dingofs::utils::TaskThreadPool;
 using ::dingofs::base::cache::Cache;
 using ::dingofs::base::queue::MessageQueue;
 using ::dingofs::base::time::TimeSpec;
-using ::dingofs::client::blockcache::LRUCache;
+using ::dingofs::client::blockcache::CachePolicy;
 
 // Manage cache items and its capacity
 class DiskCacheManager {
@@ -62,7 +62,8 @@ class DiskCacheManager {
  public:
   DiskCacheManager(uint64_t capacity, std::shared_ptr<DiskCacheLayout> layout,
                    std::shared_ptr<LocalFileSystem> fs,
-                   std::shared_ptr<DiskCacheMetric> metric);
+                   std::shared_ptr<DiskCacheMetric> metric,
+                   const std::string& policy = "lru");
 
   virtual ~DiskCacheManager() = default;
 
@@ -70,6 +71,9 @@ class DiskCacheManager {
 
   virtual void Stop();
 
+  // Ask cache policy whether the block should be cached
+  virtual bool Admit(const BlockKey& key, size_t size);
+
   virtual void Add(const BlockKey& key, const CacheValue& value);
 
   virtual BCACHE_ERROR Get(const BlockKey& key, CacheValue* value);
@@ -80,6 +84,15 @@ class DiskCacheManager {
 
   virtual bool CacheFull() const;
 
+  // Dump all cache items into index file, which will be loaded at next
+  // startup instead of walking the whole cache directory.
+  virtual BCACHE_ERROR SaveIndex(const std::string& disk_id);
+
+  // The index file will be removed once it loaded, so a crashed client
+  // never trusts the stale index.
+  virtual BCACHE_ERROR LoadIndex(const std::string& disk_id,
+                                 uint64_t* num_blocks);
+
  private:
   void CheckFreeSpace();
 
@@ -104,7 +117,7 @@ class DiskCacheManager {
   std::atomic<bool> running_;
   std::shared_ptr<DiskCacheLayout> layout_;
   std::shared_ptr<LocalFileSystem> fs_;
-  std::unique_ptr<LRUCache> lru_;
+  std::unique_ptr<CachePolicy> policy_;
   std::unique_ptr<MessageQueueType> mq_;
   std::shared_ptr<DiskCacheMetric> metric_;
   std::unique_ptr<TaskThreadPool<>> task_pool_;
@@ -76,6 +76,9 @@ class DiskCacheMetric {
     metric_.cache_blocks.reset();
     metric_.cache_bytes.reset();
     metric_.cache_full.set_value(false);
+    metric_.cache_admits.reset();
+    metric_.cache_rejects.reset();
+    metric_.checksum_mismatches.reset();
     metric_.use_direct_write.set_value(false);
   }
 
@@ -122,13 +125,29 @@ class DiskCacheMetric {
 
   void SetCacheFull(bool is_full) { metric_.cache_full.set_value(is_full); }
 
+  void SetCachePolicy(const std::string& value) {
+    metric_.cache_policy.set_value(value);
+  }
+
+  void AddCacheAdmit(bool admitted) {
+    if (admitted) {
+      metric_.cache_admits << 1;
+    } else {
+      metric_.cache_rejects << 1;
+    }
+  }
+
+  // every mismatch will fallback to read from storage
+  void AddChecksumMismatch() { metric_.checksum_mismatches << 1; }
+
   void SetUseDirectWrite(bool use_direct_write) {
     metric_.use_direct_write.set_value(use_direct_write);
   }
 
  private:
   struct Metric {
-    Metric(const std::string& prefix) {
+    Metric(const std::string& prefix)
+        : cache_hit_ratio(&Metric::GetCacheHitRatio, this) {
       uuid.expose_as(prefix, "uuid");
       dir.expose_as(prefix, "dir");
       used_bytes.expose_as(prefix, "used_bytes");
@@ -145,9 +164,21 @@ class DiskCacheMetric {
       cache_blocks.expose_as(prefix, "cache_blocks");
       cache_bytes.expose_as(prefix, "cache_bytes");
       cache_full.expose_as(prefix, "cache_full");
+      cache_policy.expose_as(prefix, "cache_policy");
+      cache_admits.expose_as(prefix, "cache_admits");
+      cache_rejects.expose_as(prefix, "cache_rejects");
+      cache_hit_ratio.expose_as(prefix, "cache_hit_ratio");
+      checksum_mismatches.expose_as(prefix, "checksum_mismatches");
       use_direct_write.expose_as(prefix, "use_direct_write");
     }
 
+    static double GetCacheHitRatio(void* arg) {
+      auto* metric = static_cast<Metric*>(arg);
+      double hits = metric->cache_hits.get_value();
+      double total = hits + metric->cache_misses.get_value();
+      return total == 0 ? 0 : hits / total;
+    }
+
     bvar::Status<std::string> uuid;
     bvar::Status<std::string> dir;
     bvar::Status<int64_t> used_bytes;
@@ -164,6 +195,11 @@ class DiskCacheMetric {
     bvar::Adder<int64_t> cache_blocks;
     bvar::Adder<int64_t> cache_bytes;
     bvar::Status<bool> cache_full;
+    bvar::Status<std::string> cache_policy;  // policy
+    bvar::Adder<int64_t> cache_admits;
+    bvar::Adder<int64_t> cache_rejects;
+    bvar::PassiveStatus<double> cache_hit_ratio;
+    bvar::Adder<int64_t> checksum_mismatches;
     bvar::Status<bool> use_direct_write;
   };
 
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/blockcache/io_uring.h"
+
+#include <errno.h>
+#include <glog/logging.h>
+#include <sys/uio.h>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+namespace {
+
+constexpr size_t kBufferAlignment = 4096;
+
+// Wait time for completions when the ring is full
+constexpr long kWaitCompletionUs = 1000;
+
+};  // namespace
+
+IoUring::IoUring(uint32_t iodepth, uint32_t fixed_buffers,
+                 size_t fixed_buffer_size)
+    : iodepth_(iodepth),
+      num_fixed_buffers_(fixed_buffers),
+      fixed_buffer_size_(fixed_buffer_size),
+      running_(false),
+      cq_depth_(0),
+      inflight_(0) {}
+
+IoUring::~IoUring() { Stop(); }
+
+bool IoUring::Start() {
+  if (running_) {
+    return true;
+  }
+
+  int rc = io_uring_queue_init(iodepth_, &ring_, 0);
+  if (rc < 0) {
+    LOG(ERROR) << "Init io_uring failed: " << ::strerror(-rc);
+    return false;
+  }
+
+  // The CQ is twice the size of SQ by default, bound inflight requests
+  // to it so that completions never overflow.
+  cq_depth_ = ring_.cq.ring_entries;
+
+  if (!RegisterBuffers()) {  // not fatal, fallback to unregistered buffer
+    LOG(WARNING) << "Register buffers to io_uring failed, "
+                 << "all I/O will use unregistered buffer.";
+  }
+
+  bthread::ExecutionQueueOptions options;
+  options.bthread_attr = BTHREAD_ATTR_NORMAL;
+  if (bthread::execution_queue_start(&submit_queue_id_, &options, BatchSubmit,
+                                     this) != 0) {
+    LOG(ERROR) << "Start io_uring submit queue failed.";
+    UnregisterBuffers();
+    io_uring_queue_exit(&ring_);
+    return false;
+  }
+
+  running_ = true;
+  reap_thread_ = std::thread(&IoUring::ReapCompletion, this);
+  LOG(INFO) << "io_uring is up: iodepth=" << iodepth_
+            << ", fixed_buffers=" << fixed_buffers_.size()
+            << ", fixed_buffer_size=" << fixed_buffer_size_;
+  return true;
+}
+
+void IoUring::Stop() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+
+  // All pending requests will be submitted before queue stopped
+  bthread::execution_queue_stop(submit_queue_id_);
+  bthread::execution_queue_join(submit_queue_id_);
+
+  // Wake up the reap thread, it will exit after all inflight I/O completed
+  Aio nop(AioType::kNop, -1, nullptr, 0, 0, -1, nullptr);
+  SubmitNop(&nop);
+  reap_thread_.join();
+
+  UnregisterBuffers();
+  io_uring_queue_exit(&ring_);
+  LOG(INFO) << "io_uring is down.";
+}
+
+int IoUring::PRead(int fd, char* buffer, size_t length, off_t offset,
+                   int buf_index) {
+  return SyncSubmit(AioType::kRead, fd, buffer, length, offset, buf_index);
+}
+
+int IoUring::PWrite(int fd, const char* buffer, size_t length, off_t offset,
+                    int buf_index) {
+  return SyncSubmit(AioType::kWrite, fd, const_cast<char*>(buffer), length,
+                    offset, buf_index);
+}
+
+void IoUring::AsyncPRead(int fd, char* buffer, size_t length, off_t offset,
+                         int buf_index, AioClosure done) {
+  Submit(new Aio(AioType::kRead, fd, buffer, length, offset, buf_index,
+                 std::move(done)));
+}
+
+void IoUring::AsyncPWrite(int fd, const char* buffer, size_t length,
+                          off_t offset, int buf_index, AioClosure done) {
+  Submit(new Aio(AioType::kWrite, fd, const_cast<char*>(buffer), length,
+                 offset, buf_index, std::move(done)));
+}
+
+bool IoUring::AcquireBuffer(size_t length, FixedBuffer* buffer) {
+  if (length > fixed_buffer_size_) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (free_buffers_.empty()) {
+    return false;
+  }
+  *buffer = fixed_buffers_[free_buffers_.back()];
+  free_buffers_.pop_back();
+  return true;
+}
+
+void IoUring::ReleaseBuffer(const FixedBuffer& buffer) {
+  if (buffer.index < 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  free_buffers_.push_back(buffer.index);
+}
+
+// The aio is owned by the submit queue once enqueued, and will be deleted
+// after its callback invoked.
+void IoUring::Submit(Aio* aio) {
+  if (!running_.load(std::memory_order_relaxed) ||
+      bthread::execution_queue_execute(submit_queue_id_, aio) != 0) {
+    aio->done(-ECANCELED);
+    delete aio;
+  }
+}
+
+int IoUring::SyncSubmit(AioType type, int fd, char* buffer, size_t length,
+                        off_t offset, int buf_index) {
+  int retcode = 0;
+  bthread::CountdownEvent done(1);
+  Submit(new Aio(type, fd, buffer, length, offset, buf_index,
+                 [&](int rc) {
+                   retcode = rc;
+                   done.signal();
+                 }));
+  done.wait();
+  return retcode;
+}
+
+int IoUring::BatchSubmit(void* meta, bthread::TaskIterator<Aio*>& iter) {
+  if (iter.is_queue_stopped()) {
+    return 0;
+  }
+
+  auto* uring = static_cast<IoUring*>(meta);
+  for (; iter; ++iter) {
+    Aio* aio = *iter;
+    uring->WaitInflight();
+
+    // The submission queue is full, submit prepared sqes to make room
+    while (!uring->PrepareSqe(aio)) {
+      int rc = io_uring_submit(&uring->ring_);
+      if (rc == -EAGAIN || rc == -EBUSY) {
+        uring->WaitInflight();
+      } else if (rc < 0) {
+        LOG(ERROR) << "io_uring_submit() failed: " << ::strerror(-rc);
+        aio->done(rc);
+        delete aio;
+        break;
+      }
+    }
+  }
+
+  int rc = io_uring_submit(&uring->ring_);
+  if (rc < 0) {  // the sqes will be submitted in next round
+    LOG(ERROR) << "io_uring_submit() failed: " << ::strerror(-rc);
+  }
+  return 0;
+}
+
+// Block the submit queue until the inflight requests drop below the CQ
+// depth, the prepared sqes are submitted first so that they can complete.
+void IoUring::WaitInflight() {
+  if (inflight_.load(std::memory_order_acquire) < cq_depth_) {
+    return;
+  }
+
+  std::unique_lock<bthread::Mutex> lk(inflight_mutex_);
+  while (inflight_.load(std::memory_order_acquire) >= cq_depth_) {
+    lk.unlock();
+    io_uring_submit(&ring_);
+    lk.lock();
+    if (inflight_.load(std::memory_order_acquire) >= cq_depth_) {
+      inflight_cond_.wait_for(lk, kWaitCompletionUs);
+    }
+  }
+}
+
+bool IoUring::PrepareSqe(Aio* aio) {
+  struct io_uring_sqe* sqe = io_uring_get_sqe(&ring_);
+  if (nullptr == sqe) {
+    return false;
+  }
+
+  switch (aio->type) {
+    case AioType::kRead:
+      if (aio->buf_index >= 0) {
+        io_uring_prep_read_fixed(sqe, aio->fd, aio->buffer, aio->length,
+                                 aio->offset, aio->buf_index);
+      } else {
+        io_uring_prep_read(sqe, aio->fd, aio->buffer, aio->length,
+                           aio->offset);
+      }
+      break;
+
+    case AioType::kWrite:
+      if (aio->buf_index >= 0) {
+        io_uring_prep_write_fixed(sqe, aio->fd, aio->buffer, aio->length,
+                                  aio->offset, aio->buf_index);
+      } else {
+        io_uring_prep_write(sqe, aio->fd, aio->buffer, aio->length,
+                            aio->offset);
+      }
+      break;
+
+    case AioType::kNop:
+      io_uring_prep_nop(sqe);
+      io_uring_sqe_set_data(sqe, nullptr);
+      return true;
+
+    default:
+      CHECK(false) << "Unknown aio type: " << static_cast<int>(aio->type);
+  }
+
+  io_uring_sqe_set_data(sqe, aio);
+  inflight_.fetch_add(1, std::memory_order_acq_rel);
+  return true;
+}
+
+// The submit queue is stopped, so the ring is only touched by us here.
+void IoUring::SubmitNop(Aio* nop) {
+  for (;;) {
+    if (PrepareSqe(nop)) {
+      break;
+    }
+    io_uring_submit(&ring_);
+    WaitInflight();
+  }
+
+  for (;;) {
+    int rc = io_uring_submit(&ring_);
+    if (rc >= 0) {
+      break;
+    } else if (rc != -EAGAIN && rc != -EBUSY && rc != -EINTR) {
+      LOG(ERROR) << "io_uring_submit() failed: " << ::strerror(-rc);
+      break;
+    }
+    std::unique_lock<bthread::Mutex> lk(inflight_mutex_);
+    inflight_cond_.wait_for(lk, kWaitCompletionUs);
+  }
+}
+
+void IoUring::ReapCompletion() {
+  bool stopping = false;
+  while (!stopping || inflight_.load(std::memory_order_acquire) > 0) {
+    struct io_uring_cqe* cqe;
+    int rc = io_uring_wait_cqe(&ring_, &cqe);
+    if (rc < 0) {
+      if (rc != -EINTR) {
+        LOG(ERROR) << "io_uring_wait_cqe() failed: " << ::strerror(-rc);
+      }
+      continue;
+    }
+
+    auto* aio = static_cast<Aio*>(io_uring_cqe_get_data(cqe));
+    int res = cqe->res;
+    io_uring_cqe_seen(&ring_, cqe);
+    if (nullptr == aio) {  // nop for stopping
+      stopping = true;
+      continue;
+    }
+
+    {
+      std::lock_guard<bthread::Mutex> lk(inflight_mutex_);
+      inflight_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    inflight_cond_.notify_one();
+
+    aio->done(res);
+    delete aio;
+  }
+}
+
+bool IoUring::RegisterBuffers() {
+  std::vector<struct iovec> iovecs;
+  for (uint32_t i = 0; i < num_fixed_buffers_; i++) {
+    void* data;
+    if (::posix_memalign(&data, kBufferAlignment, fixed_buffer_size_) != 0) {
+      break;
+    }
+    fixed_buffers_.emplace_back(static_cast<char*>(data), fixed_buffer_size_,
+                                i);
+    iovecs.push_back({data, fixed_buffer_size_});
+  }
+
+  int rc = -ENOMEM;
+  if (iovecs.size() == num_fixed_buffers_ && !iovecs.empty()) {
+    rc = io_uring_register_buffers(&ring_, iovecs.data(), iovecs.size());
+  }
+
+  if (rc < 0) {  // e.g. exceed RLIMIT_MEMLOCK
+    for (auto& buffer : fixed_buffers_) {
+      ::free(buffer.data);
+    }
+    fixed_buffers_.clear();
+    return num_fixed_buffers_ == 0;
+  }
+
+  for (const auto& buffer : fixed_buffers_) {
+    free_buffers_.push_back(buffer.index);
+  }
+  return true;
+}
+
+void IoUring::UnregisterBuffers() {
+  if (fixed_buffers_.empty()) {
+    return;
+  }
+
+  io_uring_unregister_buffers(&ring_);
+  for (auto& buffer : fixed_buffers_) {
+    ::free(buffer.data);
+  }
+  fixed_buffers_.clear();
+  free_buffers_.clear();
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_IO_URING_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_IO_URING_H_
+
+#include <bthread/condition_variable.h>
+#include <bthread/countdown_event.h>
+#include <bthread/execution_queue.h>
+#include <bthread/mutex.h>
+#include <liburing.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+// The aligned buffer which registered to io_uring, it can be used for
+// O_DIRECT read/write without extra page pinning in kernel.
+struct FixedBuffer {
+  FixedBuffer() : data(nullptr), size(0), index(-1) {}
+
+  FixedBuffer(char* data, size_t size, int index)
+      : data(data), size(size), index(index) {}
+
+  char* data;
+  size_t size;
+  int index;  // index in registered buffers, -1 means not registered
+};
+
+// How it works:
+//   1. callers put the I/O request into the submit queue (bthread execution
+//      queue) and return immediately, the result is delivered by callback.
+//   2. the submit queue consumes all pending requests in one batch, prepares
+//      one sqe for each and submits them by a single io_uring_submit().
+//      inflight requests are bounded by the CQ depth, the queue waits for
+//      completions instead of spinning when the ring is full.
+//   3. a dedicated reap thread waits the cqe and runs the callback.
+//
+// So a few threads can keep a deep queue on the disk, instead of tying up
+// one thread for each blocking syscall.
+class IoUring {
+ public:
+  // Run in the reap thread with bytes transferred or -errno, so it should
+  // be short and never block.
+  using AioClosure = std::function<void(int retcode)>;
+
+ private:
+  enum class AioType : uint8_t {
+    kRead = 0,
+    kWrite = 1,
+    kNop = 2,  // wake up reap thread when stopping
+  };
+
+  struct Aio {
+    Aio(AioType type, int fd, char* buffer, size_t length, off_t offset,
+        int buf_index, AioClosure done)
+        : type(type),
+          fd(fd),
+          buffer(buffer),
+          length(length),
+          offset(offset),
+          buf_index(buf_index),
+          done(std::move(done)) {}
+
+    AioType type;
+    int fd;
+    char* buffer;
+    size_t length;
+    off_t offset;
+    int buf_index;
+    AioClosure done;
+  };
+
+ public:
+  IoUring(uint32_t iodepth, uint32_t fixed_buffers, size_t fixed_buffer_size);
+
+  virtual ~IoUring();
+
+  virtual bool Start();
+
+  virtual void Stop();
+
+  // Return the bytes read/written or -errno like pread(2)/pwrite(2),
+  // and the buf_index must be specified if the buffer is a fixed buffer.
+  virtual int PRead(int fd, char* buffer, size_t length, off_t offset,
+                    int buf_index = -1);
+
+  virtual int PWrite(int fd, const char* buffer, size_t length, off_t offset,
+                     int buf_index = -1);
+
+  // Same as above but return immediately, the buffer must be kept valid
+  // until the done is invoked.
+  virtual void AsyncPRead(int fd, char* buffer, size_t length, off_t offset,
+                          int buf_index, AioClosure done);
+
+  virtual void AsyncPWrite(int fd, const char* buffer, size_t length,
+                           off_t offset, int buf_index, AioClosure done);
+
+  // Borrow a registered buffer which is enough to hold length bytes,
+  // return false if all buffers are in use or length exceeds buffer size.
+  virtual bool AcquireBuffer(size_t length, FixedBuffer* buffer);
+
+  virtual void ReleaseBuffer(const FixedBuffer& buffer);
+
+ private:
+  void Submit(Aio* aio);
+
+  int SyncSubmit(AioType type, int fd, char* buffer, size_t length,
+                 off_t offset, int buf_index);
+
+  static int BatchSubmit(void* meta, bthread::TaskIterator<Aio*>& iter);
+
+  void WaitInflight();
+
+  bool PrepareSqe(Aio* aio);
+
+  void SubmitNop(Aio* nop);
+
+  void ReapCompletion();
+
+  bool RegisterBuffers();
+
+  void UnregisterBuffers();
+
+ private:
+  uint32_t iodepth_;
+  uint32_t num_fixed_buffers_;
+  size_t fixed_buffer_size_;
+  std::atomic<bool> running_;
+  uint32_t cq_depth_;
+  std::atomic<uint64_t> inflight_;
+  bthread::Mutex inflight_mutex_;
+  bthread::ConditionVariable inflight_cond_;
+  struct io_uring ring_;
+  bthread::ExecutionQueueId<Aio*> submit_queue_id_;
+  std::thread reap_thread_;
+  std::mutex mutex_;  // protect free_buffers_
+  std::vector<FixedBuffer> fixed_buffers_;
+  std::vector<int> free_buffers_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_IO_URING_H_
@@ -26,7 +26,10 @@
 #include <fcntl.h>
 #include <glog/logging.h>
 #include <sys/vfs.h>
+#include <sys/xattr.h>
 
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <sstream>
 
@@ -54,8 +57,9 @@ using ::dingofs::base::string::StrFormat;
 
 // posix filesystem
 PosixFileSystem::PosixFileSystem(
-    std::shared_ptr<DiskStateMachine> disk_state_machine)
-    : disk_state_machine_(disk_state_machine) {}
+    std::shared_ptr<DiskStateMachine> disk_state_machine,
+    std::shared_ptr<IoUring> io_uring)
+    : disk_state_machine_(disk_state_machine), io_uring_(io_uring) {}
 
 template <typename... Args>
 BCACHE_ERROR PosixFileSystem::PosixError(int code, const char* format,
@@ -110,6 +114,13 @@ BCACHE_ERROR PosixFileSystem::Stat(const std::string& path, struct stat* stat) {
   return BCACHE_ERROR::OK;
 }
 
+BCACHE_ERROR PosixFileSystem::FStat(int fd, struct stat* stat) {
+  if (::fstat(fd, stat) < 0) {
+    return PosixError(errno, "fstat(%d)", fd);
+  }
+  return BCACHE_ERROR::OK;
+}
+
 BCACHE_ERROR PosixFileSystem::MkDir(const std::string& path, uint16_t mode) {
   if (::mkdir(path.c_str(), mode) != 0) {
     return PosixError(errno, "mkdir(%s,%s)", path, StrMode(mode));
@@ -204,6 +215,101 @@ BCACHE_ERROR PosixFileSystem::Read(int fd, char* buffer, size_t length) {
   return BCACHE_ERROR::OK;
 }
 
+BCACHE_ERROR PosixFileSystem::PRead(int fd, char* buffer, size_t length,
+                                    off_t offset) {
+  while (length > 0) {
+    ssize_t n = DoPRead(fd, buffer, length, offset);
+    if (n < 0) {
+      if (n == -EINTR) {
+        continue;  // retry
+      }
+      // error
+      return PosixError(-n, "pread(%d,%d,%d)", fd, length, offset);
+    } else if (n == 0) {
+      return BCACHE_ERROR::END_OF_FILE;
+    }
+    // success
+    buffer += n;
+    length -= n;
+    offset += n;
+  }
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR PosixFileSystem::PReadDirect(int fd, char* buffer, size_t length,
+                                          off_t offset) {
+  off_t aligned_offset = offset - offset % IO_ALIGNED_BLOCK_SIZE;
+  off_t end = offset + length;
+  size_t aligned_length =
+      (end - aligned_offset + IO_ALIGNED_BLOCK_SIZE - 1) /
+      IO_ALIGNED_BLOCK_SIZE * IO_ALIGNED_BLOCK_SIZE;
+
+  // Prefer the registered buffer, fallback to allocate aligned buffer
+  FixedBuffer aligned;
+  if (nullptr == io_uring_ ||
+      !io_uring_->AcquireBuffer(aligned_length, &aligned)) {
+    void* data;
+    if (::posix_memalign(&data, IO_ALIGNED_BLOCK_SIZE, aligned_length) != 0) {
+      return BCACHE_ERROR::IO_ERROR;
+    }
+    aligned = FixedBuffer(static_cast<char*>(data), aligned_length, -1);
+  }
+  auto defer = ::absl::MakeCleanup([&]() {
+    if (aligned.index >= 0) {
+      io_uring_->ReleaseBuffer(aligned);
+    } else {
+      ::free(aligned.data);
+    }
+  });
+
+  // The last block of file maybe not aligned, so the read will stop
+  // at the end of file which is fine if it covers the range we want.
+  size_t nread = 0;
+  while (aligned_offset + static_cast<off_t>(nread) < end) {
+    ssize_t n = DoPRead(fd, aligned.data + nread, aligned_length - nread,
+                        aligned_offset + nread, aligned.index);
+    if (n < 0) {
+      if (n == -EINTR) {
+        continue;  // retry
+      }
+      return PosixError(-n, "pread(%d,%d,%d)", fd, aligned_length - nread,
+                        aligned_offset + nread);
+    } else if (n == 0) {
+      return BCACHE_ERROR::END_OF_FILE;
+    }
+    nread += n;
+  }
+
+  std::memcpy(buffer, aligned.data + (offset - aligned_offset), length);
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR PosixFileSystem::PWrite(int fd, const char* buffer, size_t length,
+                                     off_t offset) {
+  while (length > 0) {
+    ssize_t n = DoPWrite(fd, buffer, length, offset);
+    if (n < 0) {
+      if (n == -EINTR) {
+        continue;  // retry
+      }
+      // error
+      return PosixError(-n, "pwrite(%d,%d,%d)", fd, length, offset);
+    }
+    // success
+    buffer += n;
+    length -= n;
+    offset += n;
+  }
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR PosixFileSystem::FTruncate(int fd, off_t length) {
+  if (::ftruncate(fd, length) < 0) {
+    return PosixError(errno, "ftruncate(%d,%d)", fd, length);
+  }
+  return BCACHE_ERROR::OK;
+}
+
 BCACHE_ERROR PosixFileSystem::Close(int fd) {
   ::close(fd);
   return BCACHE_ERROR::OK;
@@ -247,9 +353,62 @@ BCACHE_ERROR PosixFileSystem::FAdvise(int fd, int advise) {
   return BCACHE_ERROR::OK;
 }
 
+// NOTE: the filesystem which not support extended attribute is not an
+// IO error, so we return NOT_SUPPORTED without updating disk state.
+BCACHE_ERROR PosixFileSystem::SetXattr(const std::string& path,
+                                       const std::string& name,
+                                       const std::string& value) {
+  if (::setxattr(path.c_str(), name.c_str(), value.data(), value.size(), 0) <
+      0) {
+    if (errno == ENOTSUP) {
+      return BCACHE_ERROR::NOT_SUPPORTED;
+    }
+    return PosixError(errno, "setxattr(%s,%s)", path, name);
+  }
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR PosixFileSystem::GetXattr(int fd, const std::string& name,
+                                       std::string* value) {
+  ssize_t n = ::fgetxattr(fd, name.c_str(), nullptr, 0);
+  if (n >= 0) {
+    value->resize(n);
+    n = ::fgetxattr(fd, name.c_str(), value->data(), n);
+  }
+
+  if (n < 0) {
+    if (errno == ENODATA || errno == ENOTSUP) {
+      return BCACHE_ERROR::NOT_FOUND;
+    }
+    return PosixError(errno, "fgetxattr(%d,%s)", fd, name);
+  }
+  value->resize(n);
+  return BCACHE_ERROR::OK;
+}
+
+ssize_t PosixFileSystem::DoPRead(int fd, char* buffer, size_t length,
+                                 off_t offset, int buf_index) {
+  if (io_uring_ != nullptr) {
+    return io_uring_->PRead(fd, buffer, length, offset, buf_index);
+  }
+  ssize_t n = ::pread(fd, buffer, length, offset);
+  return n < 0 ? -errno : n;
+}
+
+ssize_t PosixFileSystem::DoPWrite(int fd, const char* buffer, size_t length,
+                                  off_t offset) {
+  if (io_uring_ != nullptr) {
+    return io_uring_->PWrite(fd, buffer, length, offset);
+  }
+  ssize_t n = ::pwrite(fd, buffer, length, offset);
+  return n < 0 ? -errno : n;
+}
+
 LocalFileSystem::LocalFileSystem(
-    std::shared_ptr<DiskStateMachine> disk_state_machine)
-    : posix_(std::make_shared<PosixFileSystem>(disk_state_machine)) {}
+    std::shared_ptr<DiskStateMachine> disk_state_machine,
+    std::shared_ptr<IoUring> io_uring)
+    : posix_(
+          std::make_shared<PosixFileSystem>(disk_state_machine, io_uring)) {}
 
 BCACHE_ERROR LocalFileSystem::MkDirs(const std::string& path) {
   // The parent diectory already exists in most time
@@ -318,7 +477,8 @@ BCACHE_ERROR LocalFileSystem::Walk(const std::string& prefix, WalkFunc func) {
 
 BCACHE_ERROR LocalFileSystem::WriteFile(const std::string& path,
                                         const char* buffer, size_t length,
-                                        bool use_direct) {
+                                        bool use_direct,
+                                        PublishFunc before_publish) {
   auto rc = MkDirs(ParentDir(path));
   if (rc != BCACHE_ERROR::OK) {
     return rc;
@@ -332,9 +492,12 @@ BCACHE_ERROR LocalFileSystem::WriteFile(const std::string& path,
   }
   rc = posix_->Create(tmp, &fd, use_direct);
   if (rc == BCACHE_ERROR::OK) {
-    rc = posix_->Write(fd, buffer, length);
+    rc = posix_->PWrite(fd, buffer, length, 0);
     posix_->Close(fd);
     if (rc == BCACHE_ERROR::OK) {
+      if (before_publish != nullptr) {
+        before_publish(tmp);
+      }
       rc = posix_->Rename(tmp, path);
     }
   }
@@ -343,7 +506,8 @@ BCACHE_ERROR LocalFileSystem::WriteFile(const std::string& path,
 
 BCACHE_ERROR LocalFileSystem::ReadFile(const std::string& path,
                                        std::shared_ptr<char>& buffer,
-                                       size_t* length, bool drop_page_cache) {
+                                       size_t* length, bool drop_page_cache,
+                                       AllocFunc alloc) {
   struct stat stat;
   auto rc = posix_->Stat(path, &stat);
   if (rc != BCACHE_ERROR::OK) {
@@ -365,7 +529,12 @@ BCACHE_ERROR LocalFileSystem::ReadFile(const std::string& path,
   }
 
   *length = size;
-  buffer = std::shared_ptr<char>(new char[size], std::default_delete<char[]>());
+  if (alloc != nullptr) {
+    buffer = alloc(size);
+  } else {
+    buffer =
+        std::shared_ptr<char>(new char[size], std::default_delete<char[]>());
+  }
   rc = posix_->Read(fd, buffer.get(), size);
 
   if (rc == BCACHE_ERROR::OK && drop_page_cache) {
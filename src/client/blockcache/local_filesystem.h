@@ -34,6 +34,7 @@
 #include "base/time/time.h"
 #include "client/blockcache/disk_state_machine_impl.h"
 #include "client/blockcache/error.h"
+#include "client/blockcache/io_uring.h"
 
 #define IO_ALIGNED_BLOCK_SIZE 4096
 
@@ -45,12 +46,15 @@ using ::dingofs::base::time::TimeSpec;
 
 class PosixFileSystem {
  public:
-  PosixFileSystem(std::shared_ptr<DiskStateMachine> disk_state_machine);
+  PosixFileSystem(std::shared_ptr<DiskStateMachine> disk_state_machine,
+                  std::shared_ptr<IoUring> io_uring = nullptr);
 
   ~PosixFileSystem() = default;
 
   BCACHE_ERROR Stat(const std::string& path, struct stat* stat);
 
+  BCACHE_ERROR FStat(int fd, struct stat* stat);
+
   BCACHE_ERROR MkDir(const std::string& path, uint16_t mode);
 
   BCACHE_ERROR OpenDir(const std::string& path, ::DIR** dir);
@@ -69,6 +73,16 @@ class PosixFileSystem {
 
   BCACHE_ERROR Read(int fd, char* buffer, size_t length);
 
+  BCACHE_ERROR PRead(int fd, char* buffer, size_t length, off_t offset);
+
+  // Read from file which opened with O_DIRECT, the offset and length
+  // are not required to be aligned.
+  BCACHE_ERROR PReadDirect(int fd, char* buffer, size_t length, off_t offset);
+
+  BCACHE_ERROR PWrite(int fd, const char* buffer, size_t length, off_t offset);
+
+  BCACHE_ERROR FTruncate(int fd, off_t length);
+
   BCACHE_ERROR Close(int fd);
 
   BCACHE_ERROR Unlink(const std::string& path);
@@ -81,14 +95,27 @@ class PosixFileSystem {
 
   BCACHE_ERROR FAdvise(int fd, int advise);
 
+  BCACHE_ERROR SetXattr(const std::string& path, const std::string& name,
+                        const std::string& value);
+
+  // Return NOT_FOUND if the attribute is absent or xattr is not supported
+  BCACHE_ERROR GetXattr(int fd, const std::string& name, std::string* value);
+
  private:
   template <typename... Args>
   BCACHE_ERROR PosixError(int code, const char* format, const Args&... args);
 
   void CheckError(BCACHE_ERROR rc);
 
+  // Return bytes or -errno, dispatch to io_uring if enabled
+  ssize_t DoPRead(int fd, char* buffer, size_t length, off_t offset,
+                  int buf_index = -1);
+
+  ssize_t DoPWrite(int fd, const char* buffer, size_t length, off_t offset);
+
  private:
   std::shared_ptr<DiskStateMachine> disk_state_machine_;
+  std::shared_ptr<IoUring> io_uring_;
 };
 
 // The local filesystem with high-level utilities for block cache
@@ -120,9 +147,14 @@ class LocalFileSystem {
   using DoFunc = std::function<BCACHE_ERROR(
       const std::shared_ptr<PosixFileSystem>& posix)>;
 
+  using AllocFunc = std::function<std::shared_ptr<char>(size_t size)>;
+
+  using PublishFunc = std::function<void(const std::string& tmp_path)>;
+
  public:
   explicit LocalFileSystem(
-      std::shared_ptr<DiskStateMachine> disk_state_machine = nullptr);
+      std::shared_ptr<DiskStateMachine> disk_state_machine = nullptr,
+      std::shared_ptr<IoUring> io_uring = nullptr);
 
   ~LocalFileSystem() = default;
 
@@ -131,11 +163,17 @@ class LocalFileSystem {
   // NOTE: only invoke WalkFunc for file
   BCACHE_ERROR Walk(const std::string& prefix, WalkFunc func);
 
+  // The file is written to a temporary path and renamed to |path|, the
+  // |before_publish| is invoked with the temporary path before renaming,
+  // e.g. set attributes which must be visible once the file appears.
   BCACHE_ERROR WriteFile(const std::string& path, const char* buffer,
-                         size_t length, bool use_direct = false);
+                         size_t length, bool use_direct = false,
+                         PublishFunc before_publish = nullptr);
 
+  // The buffer is allocated by |alloc| if specified, otherwise from heap.
   BCACHE_ERROR ReadFile(const std::string& path, std::shared_ptr<char>& buffer,
-                        size_t* length, bool drop_page_cache = false);
+                        size_t* length, bool drop_page_cache = false,
+                        AllocFunc alloc = nullptr);
 
   BCACHE_ERROR RemoveFile(const std::string& path);
 
@@ -55,6 +55,10 @@ LRUCache::~LRUCache() {
   delete hash_;
 }
 
+std::string LRUCache::Name() const { return "lru"; }
+
+bool LRUCache::Admit(const CacheKey&, bool) { return true; }
+
 void LRUCache::Add(const CacheKey& key, const CacheValue& value) {
   ListNode* node = new ListNode(value);
   HashInsert(key.Filename(), node);
@@ -96,6 +100,13 @@ CacheItems LRUCache::Evict(FilterFunc filter) {
   return evicted;
 }
 
+CacheItems LRUCache::Snapshot() {
+  CacheItems items;
+  SnapshotNodes(&inactive_, &items);
+  SnapshotNodes(&active_, &items);
+  return items;
+}
+
 size_t LRUCache::Size() { return hash_->TotalCharge(); }
 
 void LRUCache::Clear() {
@@ -164,6 +175,12 @@ void LRUCache::EvictAllNodes(ListNode* list) {
   }
 }
 
+void LRUCache::SnapshotNodes(ListNode* list, CacheItems* items) {
+  for (ListNode* curr = list->next; curr != list; curr = curr->next) {
+    items->emplace_back(KV(curr));
+  }
+}
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
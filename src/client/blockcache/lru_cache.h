@@ -25,6 +25,7 @@
 
 #include <functional>
 #include <memory>
+#include <string>
 #include <string_view>
 
 #include "client/blockcache/lru_common.h"
@@ -39,30 +40,64 @@ enum class FilterStatus {
   FINISH,
 };
 
+// Cache policy decides which block should be admitted into cache
+// and which blocks should be evicted when cache is full.
+class CachePolicy {
+ public:
+  using FilterFunc = std::function<FilterStatus(const CacheValue& value)>;
+
+  virtual ~CachePolicy() = default;
+
+  virtual std::string Name() const = 0;
+
+  // Return false if the block should not be cached, the evict_needed
+  // indicates that admitting it will evict other blocks.
+  virtual bool Admit(const CacheKey& key, bool evict_needed) = 0;
+
+  virtual void Add(const CacheKey& key, const CacheValue& value) = 0;
+
+  virtual bool Get(const CacheKey& key, CacheValue* value) = 0;
+
+  virtual bool Delete(const CacheKey& key, CacheValue* deleted) = 0;
+
+  virtual CacheItems Evict(FilterFunc filter) = 0;
+
+  // Return all items, from the least recently used to the most
+  virtual CacheItems Snapshot() = 0;
+
+  virtual size_t Size() = 0;
+
+  virtual void Clear() = 0;
+};
+
 // How it implements:
 //  hash table: using base::Cache
 //  lru policy: manage inactive and active list
-class LRUCache {
-  using FilterFunc = std::function<FilterStatus(const CacheValue& value)>;
-
+class LRUCache : public CachePolicy {
  public:
   LRUCache();
 
   virtual ~LRUCache();
 
-  virtual void Add(const CacheKey& key, const CacheValue& value);
+  std::string Name() const override;
+
+  bool Admit(const CacheKey& key, bool evict_needed) override;
+
+  void Add(const CacheKey& key, const CacheValue& value) override;
 
-  virtual bool Get(const CacheKey& key, CacheValue* value);
+  bool Get(const CacheKey& key, CacheValue* value) override;
 
-  virtual bool Delete(const CacheKey& key, CacheValue* deleted);
+  bool Delete(const CacheKey& key, CacheValue* deleted) override;
 
-  virtual CacheItems Evict(FilterFunc filter);
+  CacheItems Evict(FilterFunc filter) override;
 
-  virtual size_t Size();
+  CacheItems Snapshot() override;
 
-  virtual void Clear();
+  size_t Size() override;
 
- private:
+  void Clear() override;
+
+ protected:
   void HashInsert(const std::string& key, ListNode* node);
 
   bool HashLookup(const std::string& key, ListNode** node);
@@ -76,7 +111,9 @@ class LRUCache {
 
   void EvictAllNodes(ListNode* list);
 
- private:
+  void SnapshotNodes(ListNode* list, CacheItems* items);
+
+ protected:
   Cache* hash_;  // mapping: CacheKey -> ListNode*
   ListNode active_;
   ListNode inactive_;
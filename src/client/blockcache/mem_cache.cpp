@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/blockcache/mem_cache.h"
+
+#include <glog/logging.h>
+
+#include <cstring>
+#include <memory>
+
+#include "client/blockcache/cache_store.h"
+#include "client/blockcache/error.h"
+#include "client/blockcache/log.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::base::cache::NewLRUCache;
+
+namespace {
+
+struct MemBlock {
+  MemBlock(const char* data, size_t size)
+      : data(new char[size]), size(size) {
+    std::memcpy(this->data.get(), data, size);
+  }
+
+  std::unique_ptr<char[]> data;
+  size_t size;
+};
+
+void FreeBlock(const std::string_view&, void* value) {
+  MemBlock* block = reinterpret_cast<MemBlock*>(value);
+  delete block;
+}
+
+};  // namespace
+
+MemBlockReader::MemBlockReader(Cache* cache, Cache::Handle* handle)
+    : cache_(cache), handle_(handle) {}
+
+MemBlockReader::~MemBlockReader() { Close(); }
+
+BCACHE_ERROR MemBlockReader::ReadAt(off_t offset, size_t length,
+                                    char* buffer) {
+  if (nullptr == handle_) {
+    return BCACHE_ERROR::NOT_FOUND;
+  }
+
+  auto* block = reinterpret_cast<MemBlock*>(cache_->Value(handle_));
+  if (offset < 0 || offset + length > block->size) {
+    return BCACHE_ERROR::INVALID_ARGUMENT;
+  }
+  std::memcpy(buffer, block->data.get() + offset, length);
+  return BCACHE_ERROR::OK;
+}
+
+size_t MemBlockReader::Size() const {
+  if (nullptr == handle_) {
+    return 0;
+  }
+  return reinterpret_cast<MemBlock*>(cache_->Value(handle_))->size;
+}
+
+void MemBlockReader::Close() {
+  if (handle_ != nullptr) {
+    cache_->Release(handle_);
+    handle_ = nullptr;
+  }
+}
+
+MemCache::MemCache(MemCacheOption option)
+    : option_(option),
+      running_(false),
+      cache_(NewLRUCache(option.cache_size)) {}
+
+MemCache::~MemCache() { delete cache_; }
+
+BCACHE_ERROR MemCache::Init(UploadFunc) {
+  if (!running_.exchange(true)) {
+    LOG(INFO) << "Memory cache is up, capacity=" << option_.cache_size;
+  }
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR MemCache::Shutdown() {
+  if (running_.exchange(false)) {
+    cache_->Prune();  // free all blocks which not in use
+    LOG(INFO) << "Memory cache is down.";
+  }
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR MemCache::Stage(const BlockKey&, const Block&, BlockContext) {
+  return BCACHE_ERROR::NOT_SUPPORTED;
+}
+
+BCACHE_ERROR MemCache::RemoveStage(const BlockKey&, BlockContext) {
+  return BCACHE_ERROR::NOT_SUPPORTED;
+}
+
+BCACHE_ERROR MemCache::Cache(const BlockKey& key, const Block& block) {
+  if (!IsEnabled()) {
+    return BCACHE_ERROR::NOT_SUPPORTED;
+  } else if (!running_.load(std::memory_order_relaxed)) {
+    return BCACHE_ERROR::CACHE_DOWN;
+  } else if (block.size > option_.cache_size) {
+    return BCACHE_ERROR::CACHE_FULL;
+  }
+
+  auto* value = new MemBlock(block.data, block.size);
+  auto* handle = cache_->Insert(key.Filename(), value, block.size, &FreeBlock);
+  cache_->Release(handle);
+  return BCACHE_ERROR::OK;
+}
+
+BCACHE_ERROR MemCache::Load(const BlockKey& key,
+                            std::shared_ptr<BlockReader>& reader) {
+  if (!IsEnabled()) {
+    return BCACHE_ERROR::NOT_SUPPORTED;
+  } else if (!running_.load(std::memory_order_relaxed)) {
+    return BCACHE_ERROR::CACHE_DOWN;
+  }
+
+  auto* handle = cache_->Lookup(key.Filename());
+  if (nullptr == handle) {
+    return BCACHE_ERROR::NOT_FOUND;
+  }
+  reader = std::make_shared<MemBlockReader>(cache_, handle);
+  return BCACHE_ERROR::OK;
+}
+
+bool MemCache::IsCached(const BlockKey& key) {
+  if (!IsEnabled() || !running_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+
+  auto* handle = cache_->Lookup(key.Filename());
+  if (nullptr == handle) {
+    return false;
+  }
+  cache_->Release(handle);
+  return true;
+}
+
+std::string MemCache::Id() { return "memory_cache"; }
+
+size_t MemCache::UsedBytes() { return cache_->TotalCharge(); }
+
+bool MemCache::IsEnabled() const { return option_.cache_size > 0; }
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
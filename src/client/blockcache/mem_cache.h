@@ -20,51 +20,89 @@
  * Author: Jingli Chen (Wine93)
  */
 
-#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_NONE_CACHE_H_
-#define DINGOFS_SRC_CLIENT_BLOCKCACHE_NONE_CACHE_H_
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_MEM_CACHE_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_MEM_CACHE_H_
 
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "base/cache/cache.h"
 #include "client/blockcache/cache_store.h"
 #include "client/blockcache/error.h"
+#include "client/common/config.h"
 
 namespace dingofs {
 namespace client {
 namespace blockcache {
 
+using ::dingofs::base::cache::Cache;
+using ::dingofs::client::common::MemCacheOption;
 using UploadFunc = CacheStore::UploadFunc;
 
+// The block reader holds a reference of cache entry, so the block
+// will not be freed until the reader closed even if it has been evicted.
+class MemBlockReader : public BlockReader {
+ public:
+  MemBlockReader(Cache* cache, Cache::Handle* handle);
+
+  virtual ~MemBlockReader();
+
+  BCACHE_ERROR ReadAt(off_t offset, size_t length, char* buffer) override;
+
+  size_t Size() const override;
+
+  void Close() override;
+
+ private:
+  Cache* cache_;
+  Cache::Handle* handle_;
+};
+
+// How it implements:
+//   hash table + lru policy: using base::Cache (16 shards, each shard has
+//   its own mutex), every block is charged by its size, so the capacity of
+//   memory cache is bounded by bytes.
+//
+// NOTE: the memory is not durable, so we don't support stage block which
+//       must be uploaded to storage after client crashed.
 class MemCache : public CacheStore {
  public:
-  MemCache() = default;
+  explicit MemCache(MemCacheOption option);
+
+  virtual ~MemCache();
+
+  BCACHE_ERROR Init(UploadFunc uploader) override;
+
+  BCACHE_ERROR Shutdown() override;
 
-  virtual ~MemCache() = default;
+  BCACHE_ERROR Stage(const BlockKey& key, const Block& block,
+                     BlockContext ctx) override;
 
-  BCACHE_ERROR Init(UploadFunc) override { return BCACHE_ERROR::OK; }
+  BCACHE_ERROR RemoveStage(const BlockKey& key, BlockContext ctx) override;
 
-  BCACHE_ERROR Shutdown() override { return BCACHE_ERROR::OK; }
+  BCACHE_ERROR Cache(const BlockKey& key, const Block& block) override;
 
-  BCACHE_ERROR Stage(const BlockKey&, const Block&, BlockContext) override {
-    return BCACHE_ERROR::NOT_SUPPORTED;
-  }
+  BCACHE_ERROR Load(const BlockKey& key,
+                    std::shared_ptr<BlockReader>& reader) override;
 
-  BCACHE_ERROR RemoveStage(const BlockKey&, BlockContext) override {
-    return BCACHE_ERROR::NOT_SUPPORTED;
-  }
+  bool IsCached(const BlockKey& key) override;
 
-  BCACHE_ERROR Cache(const BlockKey&, const Block&) override {
-    return BCACHE_ERROR::NOT_SUPPORTED;
-  }
+  std::string Id() override;
 
-  BCACHE_ERROR Load(const BlockKey&, std::shared_ptr<BlockReader>&) override {
-    return BCACHE_ERROR::NOT_SUPPORTED;
-  }
+  size_t UsedBytes();
 
-  bool IsCached(const BlockKey&) override { return false; }
+ private:
+  bool IsEnabled() const;
 
-  std::string Id() override { return "memory_cache"; }
+ private:
+  MemCacheOption option_;
+  std::atomic<bool> running_;
+  ::dingofs::base::cache::Cache* cache_;
 };
 
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
 
-#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_NONE_CACHE_H_
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_MEM_CACHE_H_
@@ -59,6 +59,7 @@ std::string PhaseTimer::StrPhase(Phase phase) {
       {Phase::CACHE_BLOCK, "cache_block"},
       {Phase::LOAD_BLOCK, "load_block"},
       {Phase::READ_BLOCK, "read_block"},
+      {Phase::PEER_RANGE, "peer_range"},
       // s3
       {Phase::S3_PUT, "s3_put"},
       {Phase::S3_RANGE, "s3_range"},
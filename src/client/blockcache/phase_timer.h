@@ -38,6 +38,7 @@ enum class Phase {
   CACHE_BLOCK,
   LOAD_BLOCK,
   READ_BLOCK,
+  PEER_RANGE,
 
   // s3
   S3_PUT,
@@ -36,12 +36,31 @@ using aws::S3AdapterOption;
 using stub::metric::MetricGuard;
 using stub::metric::S3Metric;
 
+static constexpr int kCheckWorkers = 2;
+
 void S3ClientImpl::Init(const S3AdapterOption& option) {
   client_ = std::make_unique<aws::S3Adapter>();
   client_->Init(option);
+
+  check_thread_pool_ =
+      std::make_unique<utils::TaskThreadPool<>>("s3_check_worker");
+  CHECK(check_thread_pool_->Start(kCheckWorkers) == 0);
+  std::lock_guard<std::mutex> lk(check_mutex_);
+  check_running_ = true;
 }
 
-void S3ClientImpl::Destroy() { client_->Deinit(); }
+void S3ClientImpl::Destroy() {
+  // the queued checks are not run by Stop(), wait them done
+  {
+    std::unique_lock<std::mutex> lk(check_mutex_);
+    check_running_ = false;
+    check_cond_.wait(lk, [this]() { return check_inflight_ == 0; });
+  }
+  if (check_thread_pool_ != nullptr) {
+    check_thread_pool_->Stop();
+  }
+  client_->Deinit();
+}
 
 BCACHE_ERROR S3ClientImpl::Put(const std::string& key, const char* buffer,
                                size_t length) {
@@ -103,6 +122,62 @@ void S3ClientImpl::AsyncGet(std::shared_ptr<GetObjectAsyncContext> context) {
   client_->GetObjectAsync(context);
 }
 
+void S3ClientImpl::AsyncRange(const std::string& key, off_t offset,
+                              size_t length, char* buffer,
+                              RangeCallback callback) {
+  auto context = std::make_shared<GetObjectAsyncContext>();
+  context->key = key;
+  context->buf = buffer;
+  context->offset = offset;
+  context->len = length;
+  auto start = butil::cpuwide_time_us();
+  context->cb = [this, start, callback](
+                    const aws::S3Adapter*,
+                    const std::shared_ptr<GetObjectAsyncContext>& context) {
+    // read s3 metrics
+    MetricGuard guard(&context->retCode, &S3Metric::GetInstance().read_s3,
+                      context->len, start);
+
+    if (context->retCode == 0) {
+      callback(BCACHE_ERROR::OK);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lk(check_mutex_);
+      if (check_running_) {
+        check_inflight_++;
+        check_thread_pool_->Enqueue(&S3ClientImpl::CheckRangeFailed, this,
+                                    context->key, context->retCode,
+                                    callback);
+        return;
+      }
+    }
+
+    // it's destroying, no more HEAD requests
+    LOG(ERROR) << "Get object(" << context->key
+               << ") failed, retCode=" << context->retCode;
+    callback(BCACHE_ERROR::IO_ERROR);
+  };
+  client_->GetObjectAsync(context);
+}
+
+void S3ClientImpl::CheckRangeFailed(const std::string& key, int ret_code,
+                                    RangeCallback callback) {
+  // it's rare, so the object is checked the same way as Range()
+  if (!client_->ObjectExist(S3Key(key))) {
+    LOG(WARNING) << "Object(" << key << ") not found.";
+    callback(BCACHE_ERROR::NOT_FOUND);
+  } else {
+    LOG(ERROR) << "Get object(" << key << ") failed, retCode=" << ret_code;
+    callback(BCACHE_ERROR::IO_ERROR);
+  }
+
+  std::lock_guard<std::mutex> lk(check_mutex_);
+  check_inflight_--;
+  check_cond_.notify_all();
+}
+
 Aws::String S3ClientImpl::S3Key(const std::string& key) {
   return Aws::String(key.c_str(), key.size());
 }
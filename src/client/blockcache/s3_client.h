@@ -23,11 +23,15 @@
 #ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_S3_CLIENT_H_
 #define DINGOFS_SRC_CLIENT_BLOCKCACHE_S3_CLIENT_H_
 
+#include <condition_variable>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 
 #include "aws/s3_adapter.h"
 #include "client/blockcache/error.h"
+#include "utils/concurrent/task_thread_pool.h"
 
 namespace dingofs {
 namespace client {
@@ -38,6 +42,8 @@ class S3Client {
   // retry if callback return true
   using RetryCallback = std::function<bool(int code)>;
 
+  using RangeCallback = std::function<void(BCACHE_ERROR rc)>;
+
   virtual ~S3Client() = default;
 
   virtual void Init(const aws::S3AdapterOption& option) = 0;
@@ -58,6 +64,13 @@ class S3Client {
 
   virtual void AsyncGet(
       std::shared_ptr<aws::GetObjectAsyncContext> context) = 0;
+
+  // Read the range without blocking, |callback| is invoked once it's done.
+  // By default it's served by Range() synchronously.
+  virtual void AsyncRange(const std::string& key, off_t offset, size_t length,
+                          char* buffer, RangeCallback callback) {
+    callback(Range(key, offset, length, buffer));
+  }
 };
 
 class S3ClientImpl : public S3Client {
@@ -87,10 +100,24 @@ class S3ClientImpl : public S3Client {
 
   void AsyncGet(std::shared_ptr<aws::GetObjectAsyncContext> context) override;
 
+  void AsyncRange(const std::string& key, off_t offset, size_t length,
+                  char* buffer, RangeCallback callback) override;
+
  private:
   static Aws::String S3Key(const std::string& key);
 
+  // Whether the failed range is not found or an io error, it sends a HEAD
+  // request, so it's done in |check_thread_pool_| rather than the async
+  // callback thread of aws sdk.
+  void CheckRangeFailed(const std::string& key, int ret_code,
+                        RangeCallback callback);
+
   std::unique_ptr<::dingofs::aws::S3Adapter> client_;
+  std::unique_ptr<utils::TaskThreadPool<>> check_thread_pool_;
+  std::mutex check_mutex_;
+  std::condition_variable check_cond_;
+  bool check_running_{false};
+  uint32_t check_inflight_{0};
 };
 
 }  // namespace blockcache
@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/blockcache/segment_cache.h"
+
+#include <butil/time.h>
+#include <glog/logging.h>
+
+#include <cstring>
+#include <memory>
+
+#include "absl/cleanup/cleanup.h"
+#include "base/filepath/filepath.h"
+#include "base/string/string.h"
+#include "client/blockcache/error.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::butil::Timer;
+using ::dingofs::base::filepath::PathJoin;
+using ::dingofs::base::string::Str2Int;
+using ::dingofs::base::string::StrFormat;
+using ::dingofs::utils::LockGuard;
+using ::dingofs::utils::UniqueLock;
+using DiskCacheTotalMetric = ::dingofs::stub::metric::DiskCacheMetric;
+
+namespace {
+
+constexpr uint64_t kSegmentMagic = 0x4745534f474e4944;  // "DINGOSEG"
+constexpr size_t kEntryFields = 7;
+constexpr size_t kEntrySize = kEntryFields * sizeof(uint64_t);
+constexpr size_t kTrailerSize = 2 * sizeof(uint64_t);  // count + magic
+
+std::string EncodeFooter(const std::vector<SegmentEntry>& entries) {
+  std::vector<uint64_t> fields;
+  fields.reserve(entries.size() * kEntryFields + 2);
+  for (const auto& entry : entries) {
+    const auto& key = entry.key;
+    fields.insert(fields.end(), {key.fs_id, key.ino, key.id, key.index,
+                                 key.version, entry.offset, entry.length});
+  }
+  fields.push_back(entries.size());
+  fields.push_back(kSegmentMagic);
+  return std::string(reinterpret_cast<const char*>(fields.data()),
+                     fields.size() * sizeof(uint64_t));
+}
+
+void DecodeEntries(const char* buffer, uint64_t count,
+                   std::vector<SegmentEntry>* entries) {
+  const auto* fields = reinterpret_cast<const uint64_t*>(buffer);
+  for (uint64_t i = 0; i < count; i++, fields += kEntryFields) {
+    BlockKey key(fields[0], fields[1], fields[2], fields[3], fields[4]);
+    entries->emplace_back(key, fields[5], fields[6]);
+  }
+}
+
+};  // namespace
+
+Segment::~Segment() {
+  if (rfd >= 0) {
+    ::close(rfd);
+  }
+  if (wfd >= 0) {
+    ::close(wfd);
+  }
+}
+
+SegmentBlockReader::SegmentBlockReader(std::shared_ptr<Segment> segment,
+                                       uint64_t offset, uint64_t length,
+                                       std::shared_ptr<LocalFileSystem> fs)
+    : segment_(segment), offset_(offset), length_(length), fs_(fs) {}
+
+BCACHE_ERROR SegmentBlockReader::ReadAt(off_t offset, size_t length,
+                                        char* buffer) {
+  if (nullptr == segment_) {
+    return BCACHE_ERROR::NOT_FOUND;
+  } else if (offset < 0 || offset + length > length_) {
+    return BCACHE_ERROR::INVALID_ARGUMENT;
+  }
+
+  return fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    BCACHE_ERROR rc;
+    DiskCacheMetricGuard guard(
+        &rc, &DiskCacheTotalMetric::GetInstance().read_disk, length);
+    rc = posix->PRead(segment_->rfd, buffer, length, offset_ + offset);
+    return rc;
+  });
+}
+
+bool SegmentBlockReader::Fd(off_t offset, size_t length, int* fd,
+                            off_t* fd_offset) {
+  if (nullptr == segment_ || offset < 0 || offset + length > length_) {
+    return false;
+  }
+
+  *fd = segment_->rfd;
+  *fd_offset = offset_ + offset;
+  return true;
+}
+
+void SegmentBlockReader::Close() { segment_ = nullptr; }
+
+SegmentCache::SegmentCache(uint64_t capacity, uint64_t segment_size,
+                           std::shared_ptr<DiskCacheLayout> layout,
+                           std::shared_ptr<LocalFileSystem> fs,
+                           std::shared_ptr<DiskCacheMetric> metric)
+    : capacity_(capacity),
+      segment_size_(segment_size),
+      used_bytes_(0),
+      next_id_(0),
+      running_(false),
+      writing_(0),
+      layout_(layout),
+      fs_(fs),
+      metric_(metric) {}
+
+BCACHE_ERROR SegmentCache::Start() {
+  LockGuard lk(mutex_);
+  if (running_.load(std::memory_order_relaxed)) {
+    return BCACHE_ERROR::OK;  // already running
+  }
+
+  used_bytes_ = 0;  // For restart
+  auto rc = fs_->MkDirs(layout_->GetSegmentDir());
+  if (rc == BCACHE_ERROR::OK) {
+    rc = LoadSegments();
+  }
+  if (rc == BCACHE_ERROR::OK) {
+    rc = OpenSegment();
+  }
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  }
+
+  running_.store(true, std::memory_order_relaxed);
+  LOG(INFO) << "Segment cache start, capacity=" << capacity_
+            << ", segment_size=" << segment_size_
+            << ", segments=" << sealed_.size()
+            << ", blocks=" << index_.size();
+  return BCACHE_ERROR::OK;
+}
+
+// The blocks being written are waited, then the active segment is sealed.
+void SegmentCache::Stop() {
+  if (!running_.exchange(false)) {
+    return;  // already stopped
+  }
+
+  std::string footer;
+  std::shared_ptr<Segment> segment;
+  {
+    UniqueLock lk(mutex_);
+    cond_.wait(lk, [&]() { return writing_ == 0; });
+    segment = active_;
+    RetireActive();
+    if (segment != nullptr && !SealLocked(segment, &footer)) {
+      segment = nullptr;
+    }
+  }
+
+  if (segment != nullptr) {
+    auto rc = WriteFooter(segment, footer);
+    if (rc != BCACHE_ERROR::OK) {
+      LOG(ERROR) << "Seal active segment failed: " << StrErr(rc);
+    }
+  }
+
+  LockGuard lk(mutex_);
+  sealed_.clear();
+  index_.clear();
+  LOG(INFO) << "Segment cache stopped.";
+}
+
+// The space is reserved under lock, then the block is written without it.
+// The hole left by a failed write is never indexed, it's reclaimed with
+// its segment.
+BCACHE_ERROR SegmentCache::Put(const BlockKey& key, const Block& block) {
+  if (!running_.load(std::memory_order_relaxed)) {
+    return BCACHE_ERROR::CACHE_DOWN;
+  }
+
+  uint64_t offset;
+  std::string filename = key.Filename();
+  std::shared_ptr<Segment> segment;
+  {
+    LockGuard lk(mutex_);
+    if (!running_.load(std::memory_order_relaxed)) {  // stopped concurrently
+      return BCACHE_ERROR::CACHE_DOWN;
+    } else if (index_.count(filename) != 0 ||
+               !pending_.emplace(filename).second) {
+      return BCACHE_ERROR::OK;  // already cached or being cached
+    } else if (nullptr == active_) {  // retired or last open failed
+      auto rc = OpenSegment();
+      if (rc != BCACHE_ERROR::OK) {
+        pending_.erase(filename);
+        return rc;
+      }
+    }
+
+    segment = active_;
+    offset = segment->size;
+    segment->size += block.size;
+    segment->writers++;
+    writing_++;
+    if (segment->size >= segment_size_) {
+      RetireActive();
+    }
+  }
+
+  auto rc = fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    return posix->PWrite(segment->wfd, block.data, block.size, offset);
+  });
+
+  bool seal;
+  std::string footer;
+  std::vector<std::shared_ptr<Segment>> removed;
+  {
+    LockGuard lk(mutex_);
+    pending_.erase(filename);
+    segment->writers--;
+    if (rc == BCACHE_ERROR::OK && !segment->removed) {
+      segment->entries.emplace_back(key, offset, block.size);
+      index_[filename] = Location(segment->id, offset, block.size);
+      UpdateUsage(1, block.size);
+    }
+    seal = segment != active_ && SealLocked(segment, &footer);
+    if (used_bytes_ >= capacity_) {
+      removed = CleanupFull();
+    }
+  }
+
+  if (seal) {
+    auto status = WriteFooter(segment, footer);
+    if (status != BCACHE_ERROR::OK) {
+      LOG(ERROR) << "Seal segment (path=" << segment->path
+                 << ") failed: " << StrErr(status);
+    }
+  }
+  RemoveFiles(removed);
+
+  LockGuard lk(mutex_);
+  if (--writing_ == 0) {
+    cond_.notify_all();
+  }
+  return rc;
+}
+
+BCACHE_ERROR SegmentCache::Get(const BlockKey& key,
+                               std::shared_ptr<BlockReader>& reader) {
+  if (!running_.load(std::memory_order_relaxed)) {
+    return BCACHE_ERROR::CACHE_DOWN;
+  }
+
+  LockGuard lk(mutex_);
+  auto iter = index_.find(key.Filename());
+  if (iter == index_.end()) {
+    return BCACHE_ERROR::NOT_FOUND;
+  }
+
+  const auto& loc = iter->second;
+  auto segment = FindSegment(loc.segment_id);
+  CHECK(segment != nullptr);
+  reader = std::make_shared<SegmentBlockReader>(segment, loc.offset,
+                                                loc.length, fs_);
+  return BCACHE_ERROR::OK;
+}
+
+bool SegmentCache::Exists(const BlockKey& key) {
+  LockGuard lk(mutex_);
+  return index_.count(key.Filename()) != 0;
+}
+
+// The space of deleted block will be reclaimed when its segment evicted,
+// and a tombstone is appended to the active segment, so the block won't
+// come back after restart.
+void SegmentCache::Delete(const BlockKey& key) {
+  LockGuard lk(mutex_);
+  auto iter = index_.find(key.Filename());
+  if (iter == index_.end()) {
+    return;
+  }
+
+  uint64_t segment_id = iter->second.segment_id;
+  UpdateUsage(-1, 0);
+  index_.erase(iter);
+  if (!running_.load(std::memory_order_relaxed)) {
+    return;
+  } else if (nullptr == active_ && OpenSegment() != BCACHE_ERROR::OK) {
+    LOG(WARNING) << "Open segment for tombstone of block "
+                 << key.Filename() << " failed, it may be reloaded.";
+    return;
+  }
+  active_->entries.emplace_back(key, segment_id, SegmentEntry::kTombstone);
+}
+
+// protect by mutex
+BCACHE_ERROR SegmentCache::LoadSegments() {
+  Timer timer;
+  std::vector<std::pair<uint64_t, std::string>> files;
+
+  timer.start();
+  auto rc = fs_->Walk(layout_->GetSegmentDir(),
+                      [&](const std::string& prefix,
+                          const LocalFileSystem::FileInfo& info) {
+                        uint64_t id;
+                        std::string path = PathJoin({prefix, info.name});
+                        if (Str2Int(info.name, &id)) {
+                          files.emplace_back(id, path);
+                        } else {
+                          fs_->RemoveFile(path);
+                        }
+                        return BCACHE_ERROR::OK;
+                      });
+  if (rc != BCACHE_ERROR::OK) {
+    return rc;
+  }
+
+  for (const auto& file : files) {
+    next_id_ = std::max(next_id_, file.first + 1);
+    rc = LoadSegment(file.first, file.second);
+    if (rc != BCACHE_ERROR::OK) {  // invalid segment, maybe crashed
+      LOG(WARNING) << "Remove invalid segment (path=" << file.second
+                   << "): " << StrErr(rc);
+      fs_->RemoveFile(file.second);
+    }
+  }
+  timer.stop();
+
+  LOG(INFO) << StrFormat(
+      "Load %d segments (dir=%s): %d blocks loaded, costs %.6f seconds.",
+      sealed_.size(), layout_->GetSegmentDir(), index_.size(),
+      timer.u_elapsed() / 1e6);
+  return BCACHE_ERROR::OK;
+}
+
+// protect by mutex
+BCACHE_ERROR SegmentCache::LoadSegment(uint64_t id, const std::string& path) {
+  auto segment = std::make_shared<Segment>(id, path);
+  return fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    struct stat stat;
+    auto rc = posix->Stat(path, &stat);
+    if (rc != BCACHE_ERROR::OK) {
+      return rc;
+    } else if (static_cast<size_t>(stat.st_size) < kTrailerSize) {
+      return BCACHE_ERROR::END_OF_FILE;
+    }
+
+    rc = posix->Open(path, O_RDONLY, &segment->rfd);
+    if (rc != BCACHE_ERROR::OK) {
+      return rc;
+    }
+
+    uint64_t trailer[2];  // count + magic
+    uint64_t file_size = stat.st_size;
+    rc = posix->PRead(segment->rfd, reinterpret_cast<char*>(trailer),
+                      kTrailerSize, file_size - kTrailerSize);
+    if (rc != BCACHE_ERROR::OK) {
+      return rc;
+    } else if (trailer[1] != kSegmentMagic ||
+               trailer[0] * kEntrySize + kTrailerSize > file_size) {
+      return BCACHE_ERROR::INVALID_ARGUMENT;
+    }
+
+    uint64_t count = trailer[0];
+    uint64_t footer_size = count * kEntrySize;
+    std::unique_ptr<char[]> footer(new char[footer_size]);
+    rc = posix->PRead(segment->rfd, footer.get(), footer_size,
+                      file_size - kTrailerSize - footer_size);
+    if (rc != BCACHE_ERROR::OK) {
+      return rc;
+    }
+
+    DecodeEntries(footer.get(), count, &segment->entries);
+    for (const auto& entry : segment->entries) {
+      auto filename = entry.key.Filename();
+      if (!entry.IsTombstone()) {
+        index_[filename] = Location(id, entry.offset, entry.length);
+        UpdateUsage(1, entry.length);
+        continue;
+      }
+
+      auto iter = index_.find(filename);
+      if (iter != index_.end() && iter->second.segment_id == entry.offset) {
+        index_.erase(iter);
+        UpdateUsage(-1, 0);
+      }
+    }
+    segment->size = file_size;
+    segment->sealed = true;
+    sealed_[id] = segment;
+    return BCACHE_ERROR::OK;
+  });
+}
+
+// protect by mutex
+BCACHE_ERROR SegmentCache::OpenSegment() {
+  uint64_t id = next_id_++;
+  auto segment = std::make_shared<Segment>(id, GetSegmentPath(id));
+  auto rc = fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    auto rc = posix->Create(segment->path, &segment->wfd, false);
+    if (rc == BCACHE_ERROR::OK) {
+      rc = posix->Open(segment->path, O_RDONLY, &segment->rfd);
+    }
+    return rc;
+  });
+
+  if (rc == BCACHE_ERROR::OK) {
+    active_ = segment;
+  }
+  return rc;
+}
+
+// protect by mutex
+void SegmentCache::RetireActive() {
+  if (active_ != nullptr) {
+    sealed_[active_->id] = active_;
+    active_ = nullptr;
+  }
+}
+
+// protect by mutex
+bool SegmentCache::SealLocked(const std::shared_ptr<Segment>& segment,
+                              std::string* footer) {
+  if (segment->sealed || segment->writers > 0) {
+    return false;
+  }
+
+  segment->sealed = true;
+  if (segment->removed) {
+    return true;
+  } else if (segment->entries.empty()) {  // nothing appended
+    sealed_.erase(segment->id);
+    return true;
+  }
+  *footer = EncodeFooter(segment->entries);
+  return true;
+}
+
+// The segment which not sealed can't be reloaded after restart,
+// but its blocks still can be read in this round.
+BCACHE_ERROR SegmentCache::WriteFooter(const std::shared_ptr<Segment>& segment,
+                                       const std::string& footer) {
+  if (footer.empty()) {  // nothing appended or evicted
+    fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+      posix->Close(segment->wfd);
+      segment->wfd = -1;
+      return BCACHE_ERROR::OK;
+    });
+    if (!segment->removed) {
+      fs_->RemoveFile(segment->path);
+    }
+    return BCACHE_ERROR::OK;
+  }
+
+  return fs_->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    auto rc = posix->PWrite(segment->wfd, footer.data(), footer.size(),
+                            segment->size);
+    posix->Close(segment->wfd);
+    segment->wfd = -1;
+    return rc;
+  });
+}
+
+// protect by mutex
+std::vector<std::shared_ptr<Segment>> SegmentCache::CleanupFull() {
+  std::vector<std::shared_ptr<Segment>> removed;
+  uint64_t goal_bytes = capacity_ * 0.95;
+  while (used_bytes_ > goal_bytes && !sealed_.empty()) {
+    auto iter = sealed_.begin();
+    auto segment = iter->second;
+    sealed_.erase(iter);
+    RemoveSegment(segment);
+    removed.emplace_back(segment);
+  }
+  return removed;
+}
+
+// protect by mutex
+void SegmentCache::RemoveSegment(std::shared_ptr<Segment> segment) {
+  uint64_t num_blocks = 0, bytes_freed = 0;
+  segment->removed = true;
+  for (const auto& entry : segment->entries) {
+    if (entry.IsTombstone()) {
+      continue;
+    }
+
+    auto iter = index_.find(entry.key.Filename());
+    if (iter != index_.end() && iter->second.segment_id == segment->id) {
+      index_.erase(iter);
+      num_blocks++;
+    }
+    bytes_freed += entry.length;
+  }
+
+  used_bytes_ -= bytes_freed;
+  metric_->AddCacheBlock(-num_blocks, -bytes_freed);
+  metric_->SetUsedBytes(used_bytes_);
+  VLOG(3) << "Segment (path=" << segment->path << ") evicted, free "
+          << bytes_freed << " bytes.";
+}
+
+// The file descriptor will be closed after all readers closed.
+void SegmentCache::RemoveFiles(
+    const std::vector<std::shared_ptr<Segment>>& segments) {
+  for (const auto& segment : segments) {
+    auto rc = fs_->RemoveFile(segment->path);
+    if (rc != BCACHE_ERROR::OK) {
+      LOG(ERROR) << "Remove segment (path=" << segment->path
+                 << ") failed: " << StrErr(rc);
+    }
+  }
+}
+
+void SegmentCache::UpdateUsage(int64_t n, int64_t bytes) {
+  used_bytes_ += bytes;
+  metric_->AddCacheBlock(n, bytes);
+  metric_->SetUsedBytes(used_bytes_);
+}
+
+std::string SegmentCache::GetSegmentPath(uint64_t id) const {
+  return PathJoin({layout_->GetSegmentDir(), std::to_string(id)});
+}
+
+// protect by mutex
+std::shared_ptr<Segment> SegmentCache::FindSegment(uint64_t id) {
+  if (active_ != nullptr && active_->id == id) {
+    return active_;
+  }
+  auto iter = sealed_.find(id);
+  return iter == sealed_.end() ? nullptr : iter->second;
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_SEGMENT_CACHE_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_SEGMENT_CACHE_H_
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "client/blockcache/cache_store.h"
+#include "client/blockcache/disk_cache_layout.h"
+#include "client/blockcache/disk_cache_metric.h"
+#include "client/blockcache/error.h"
+#include "client/blockcache/local_filesystem.h"
+#include "utils/concurrent/concurrent.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::utils::ConditionVariable;
+using ::dingofs::utils::Mutex;
+
+// Segment file format:
+//
+//   +---------+---------+-----+---------+--------+-------+-------+
+//   | block 0 | block 1 | ... | block n | footer | count | magic |
+//   +---------+---------+-----+---------+--------+-------+-------+
+//
+//   footer: |count| entries, each entry is 7 uint64:
+//     fs_id, ino, id, index, version, offset, length
+//
+// The footer is written when segment sealed, so the segment which has
+// no footer (e.g. client crashed) will be removed at next startup.
+//
+// A deleted block is recorded as a tombstone entry in the footer of the
+// segment which is active at that time, whose offset is the id of segment
+// holding the block, and length is kTombstone. Entries are replayed in
+// order at startup, so the tombstone only removes the block put before it.
+struct SegmentEntry {
+  static constexpr uint64_t kTombstone = UINT64_MAX;
+
+  SegmentEntry() = default;
+
+  SegmentEntry(const BlockKey& key, uint64_t offset, uint64_t length)
+      : key(key), offset(offset), length(length) {}
+
+  bool IsTombstone() const { return length == kTombstone; }
+
+  BlockKey key;
+  uint64_t offset;
+  uint64_t length;
+};
+
+// The space of segment is reserved under lock and written without it,
+// so the segment is sealed by the last writer once it's full.
+struct Segment {
+  Segment(uint64_t id, const std::string& path)
+      : id(id),
+        path(path),
+        rfd(-1),
+        wfd(-1),
+        size(0),
+        writers(0),
+        sealed(false),
+        removed(false) {}
+
+  ~Segment();
+
+  uint64_t id;
+  std::string path;
+  int rfd;  // for read
+  int wfd;  // for append, only valid before sealed
+  uint64_t size;
+  uint32_t writers;  // blocks being written
+  bool sealed;       // footer is (being) written
+  bool removed;      // evicted
+  std::vector<SegmentEntry> entries;
+};
+
+// The block reader holds a reference of segment, so the file descriptor
+// will not be closed even if the segment has been evicted.
+class SegmentBlockReader : public BlockReader {
+ public:
+  SegmentBlockReader(std::shared_ptr<Segment> segment, uint64_t offset,
+                     uint64_t length, std::shared_ptr<LocalFileSystem> fs);
+
+  virtual ~SegmentBlockReader() = default;
+
+  BCACHE_ERROR ReadAt(off_t offset, size_t length, char* buffer) override;
+
+  size_t Size() const override { return length_; }
+
+  bool Fd(off_t offset, size_t length, int* fd, off_t* fd_offset) override;
+
+  void Close() override;
+
+ private:
+  std::shared_ptr<Segment> segment_;
+  uint64_t offset_;
+  uint64_t length_;
+  std::shared_ptr<LocalFileSystem> fs_;
+};
+
+// Log-structured cache blocks: append blocks into large segment files
+// instead of creating one file per block, and reclaim the whole segment
+// (oldest first) when the capacity is exceeded.
+//
+// NOTE: blocks in segment carry no checksum (it's kept in the xattr of
+//       per-block file), so they are not verified on read.
+class SegmentCache {
+  struct Location {
+    Location() = default;
+
+    Location(uint64_t segment_id, uint64_t offset, uint64_t length)
+        : segment_id(segment_id), offset(offset), length(length) {}
+
+    uint64_t segment_id;
+    uint64_t offset;
+    uint64_t length;
+  };
+
+ public:
+  SegmentCache(uint64_t capacity, uint64_t segment_size,
+               std::shared_ptr<DiskCacheLayout> layout,
+               std::shared_ptr<LocalFileSystem> fs,
+               std::shared_ptr<DiskCacheMetric> metric);
+
+  virtual ~SegmentCache() = default;
+
+  virtual BCACHE_ERROR Start();
+
+  virtual void Stop();
+
+  virtual BCACHE_ERROR Put(const BlockKey& key, const Block& block);
+
+  virtual BCACHE_ERROR Get(const BlockKey& key,
+                           std::shared_ptr<BlockReader>& reader);
+
+  virtual bool Exists(const BlockKey& key);
+
+  virtual void Delete(const BlockKey& key);
+
+ private:
+  BCACHE_ERROR LoadSegments();
+
+  BCACHE_ERROR LoadSegment(uint64_t id, const std::string& path);
+
+  BCACHE_ERROR OpenSegment();
+
+  // Retire the active segment, it's sealed once no one writes it
+  void RetireActive();
+
+  // Return true if the segment should be sealed by caller,
+  // and the |footer| is encoded for it
+  bool SealLocked(const std::shared_ptr<Segment>& segment,
+                  std::string* footer);
+
+  BCACHE_ERROR WriteFooter(const std::shared_ptr<Segment>& segment,
+                           const std::string& footer);
+
+  std::vector<std::shared_ptr<Segment>> CleanupFull();
+
+  void RemoveSegment(std::shared_ptr<Segment> segment);
+
+  void RemoveFiles(const std::vector<std::shared_ptr<Segment>>& segments);
+
+  void UpdateUsage(int64_t n, int64_t bytes);
+
+  std::string GetSegmentPath(uint64_t id) const;
+
+  std::shared_ptr<Segment> FindSegment(uint64_t id);
+
+ private:
+  Mutex mutex_;
+  uint64_t capacity_;
+  uint64_t segment_size_;
+  uint64_t used_bytes_;
+  uint64_t next_id_;
+  std::atomic<bool> running_;
+  uint64_t writing_;                                // blocks being written
+  ConditionVariable cond_;                          // writing_ drops to 0
+  std::unordered_set<std::string> pending_;         // blocks being written
+  std::shared_ptr<Segment> active_;
+  std::map<uint64_t, std::shared_ptr<Segment>> sealed_;  // oldest first
+  std::unordered_map<std::string, Location> index_;      // filename -> loc
+  std::shared_ptr<DiskCacheLayout> layout_;
+  std::shared_ptr<LocalFileSystem> fs_;
+  std::shared_ptr<DiskCacheMetric> metric_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_SEGMENT_CACHE_H_
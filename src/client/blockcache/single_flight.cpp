@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/blockcache/single_flight.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+FlightCall::FlightCall(off_t offset, size_t length, char* buffer)
+    : offset_(offset),
+      length_(length),
+      data_(buffer == nullptr ? new char[length] : nullptr),
+      buffer_(buffer == nullptr ? data_.get() : buffer),
+      nread_(0),
+      rc_(BCACHE_ERROR::OK),
+      done_(1),
+      copied_(0) {}
+
+bool FlightCall::Covers(off_t offset, size_t length) const {
+  return offset >= offset_ && offset + length <= offset_ + length_;
+}
+
+SingleFlight::SingleFlight()
+    : num_fetched_("dingofs_block_cache", "single_flight_fetched"),
+      num_coalesced_("dingofs_block_cache", "single_flight_coalesced") {}
+
+BCACHE_ERROR SingleFlight::Do(const std::string& key, off_t offset,
+                              size_t length, char* buffer, FetchFunc fetch) {
+  std::shared_ptr<FlightCall> call;
+  bool leader = false;
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    call = FindLocked(key, offset, length);
+    if (call == nullptr) {  // fetch into the caller's buffer, no extra copy
+      call = std::make_shared<FlightCall>(offset, length, buffer);
+      calls_[key].emplace_back(call);
+      leader = true;
+    }
+  }
+
+  if (!leader) {
+    auto rc = Wait(call, offset, length, buffer);
+    if (rc == BCACHE_ERROR::OK) {
+      return rc;
+    }
+    // the shared fetch failed or is short, try it by ourselves
+    return fetch(offset, length, buffer);
+  }
+
+  auto rc = fetch(offset, length, buffer);
+  End(key, call, rc, length);
+  return rc;
+}
+
+bool SingleFlight::Join(const std::string& key, off_t offset, size_t length,
+                        char* buffer) {
+  std::shared_ptr<FlightCall> call;
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    call = FindLocked(key, offset, length);
+  }
+  if (call == nullptr) {
+    return false;
+  }
+  return Wait(call, offset, length, buffer) == BCACHE_ERROR::OK;
+}
+
+std::shared_ptr<FlightCall> SingleFlight::Begin(const std::string& key,
+                                                off_t offset, size_t length,
+                                                char* buffer) {
+  auto call = std::make_shared<FlightCall>(offset, length, buffer);
+  std::lock_guard<std::mutex> lk(mutex_);
+  calls_[key].emplace_back(call);
+  return call;
+}
+
+std::shared_ptr<FlightCall> SingleFlight::JoinOrBegin(
+    const std::string& key, off_t offset, size_t length, off_t fetch_offset,
+    size_t fetch_length, bool* leader) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto call = FindLocked(key, offset, length);
+  *leader = (call == nullptr);
+  if (*leader) {
+    call = std::make_shared<FlightCall>(fetch_offset, fetch_length);
+    calls_[key].emplace_back(call);
+  }
+  return call;
+}
+
+BCACHE_ERROR SingleFlight::Wait(const std::shared_ptr<FlightCall>& call,
+                                off_t offset, size_t length, char* buffer) {
+  call->done_.wait();
+  auto rc = CopyFrom(call, offset, length, buffer);
+  call->copied_.signal();
+  if (rc == BCACHE_ERROR::OK) {
+    num_coalesced_ << 1;
+  }
+  return rc;
+}
+
+// No more waiter can join once the call is removed, so the copied_ count
+// is stable when we wait for it.
+void SingleFlight::End(const std::string& key,
+                       const std::shared_ptr<FlightCall>& call,
+                       BCACHE_ERROR rc, size_t nread) {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto iter = calls_.find(key);
+    if (iter != calls_.end()) {
+      auto& calls = iter->second;
+      calls.erase(std::remove(calls.begin(), calls.end(), call), calls.end());
+      if (calls.empty()) {
+        calls_.erase(iter);
+      }
+    }
+  }
+
+  call->rc_ = rc;
+  call->nread_ = std::min(nread, call->length_);
+  num_fetched_ << 1;
+  call->done_.signal();
+  if (call->data_ == nullptr) {  // borrowed buffer
+    call->copied_.wait();
+  }
+}
+
+// The waiter is counted under the lock, so that the leader which borrowed
+// the buffer can wait for it.
+std::shared_ptr<FlightCall> SingleFlight::FindLocked(const std::string& key,
+                                                     off_t offset,
+                                                     size_t length) {
+  auto iter = calls_.find(key);
+  if (iter == calls_.end()) {
+    return nullptr;
+  }
+
+  for (const auto& call : iter->second) {
+    if (call->Covers(offset, length)) {
+      call->copied_.add_count(1);
+      return call;
+    }
+  }
+  return nullptr;
+}
+
+BCACHE_ERROR SingleFlight::CopyFrom(const std::shared_ptr<FlightCall>& call,
+                                    off_t offset, size_t length,
+                                    char* buffer) {
+  if (call->rc_ != BCACHE_ERROR::OK) {
+    return call->rc_;
+  } else if (offset + length > call->offset_ + call->nread_) {
+    return BCACHE_ERROR::END_OF_FILE;
+  }
+
+  std::memcpy(buffer, call->Buffer() + (offset - call->offset_), length);
+  return BCACHE_ERROR::OK;
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_SINGLE_FLIGHT_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_SINGLE_FLIGHT_H_
+
+#include <bthread/countdown_event.h>
+#include <bvar/bvar.h>
+#include <sys/types.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "client/blockcache/error.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+// One inflight fetch of block range, the fetched data is shared by
+// the leader and all waiters.
+//
+// The buffer is either owned by the call, or borrowed from the leader
+// (e.g. the caller's buffer) which is only valid until End() returns,
+// so End() waits for all waiters have copied from it.
+class FlightCall {
+ public:
+  FlightCall(off_t offset, size_t length, char* buffer = nullptr);
+
+  char* Buffer() { return buffer_; }
+
+  bool Covers(off_t offset, size_t length) const;
+
+ private:
+  friend class SingleFlight;
+
+  off_t offset_;
+  size_t length_;
+  std::unique_ptr<char[]> data_;  // nullptr if the buffer is borrowed
+  char* buffer_;
+  size_t nread_;  // actual bytes fetched, maybe less than length
+  BCACHE_ERROR rc_;
+  bthread::CountdownEvent done_;
+  bthread::CountdownEvent copied_;  // one count for each waiter
+};
+
+// Coalesce the concurrent fetches for the same block from storage:
+// the caller whose range is covered by an inflight fetch waits for it and
+// copies from its result, instead of issuing another request to storage.
+class SingleFlight {
+ public:
+  using FetchFunc =
+      std::function<BCACHE_ERROR(off_t offset, size_t length, char* buffer)>;
+
+ public:
+  SingleFlight();
+
+  virtual ~SingleFlight() = default;
+
+  // Read [offset, offset + length) of block |key| into |buffer|, the caller
+  // fetches the range by |fetch| straight into |buffer| if no inflight
+  // fetch covers it.
+  BCACHE_ERROR Do(const std::string& key, off_t offset, size_t length,
+                  char* buffer, FetchFunc fetch);
+
+  // Wait for the inflight fetch which covers the range and copy from it,
+  // return false if there is none or it failed.
+  bool Join(const std::string& key, off_t offset, size_t length,
+            char* buffer);
+
+  // For the fetch which completes asynchronously (e.g. prefetch whole block):
+  // Begin() registers the call, and End() must be invoked once the data
+  // is filled into call->Buffer(). The call reads into |buffer| if it's
+  // specified, otherwise it allocates one.
+  std::shared_ptr<FlightCall> Begin(const std::string& key, off_t offset,
+                                    size_t length, char* buffer = nullptr);
+
+  // Find the inflight fetch which covers [offset, offset + length) or
+  // register a new fetch of [fetch_offset, fetch_offset + fetch_length)
+  // if there is none, in one step. The caller is the leader of the new
+  // fetch if |*leader| is true, and it must End() it; otherwise it must
+  // Wait() for the returned one.
+  std::shared_ptr<FlightCall> JoinOrBegin(const std::string& key,
+                                          off_t offset, size_t length,
+                                          off_t fetch_offset,
+                                          size_t fetch_length, bool* leader);
+
+  // Wait for the call which returned by JoinOrBegin() and copy from it
+  BCACHE_ERROR Wait(const std::shared_ptr<FlightCall>& call, off_t offset,
+                    size_t length, char* buffer);
+
+  void End(const std::string& key, const std::shared_ptr<FlightCall>& call,
+           BCACHE_ERROR rc, size_t nread);
+
+ private:
+  std::shared_ptr<FlightCall> FindLocked(const std::string& key,
+                                         off_t offset, size_t length);
+
+  static BCACHE_ERROR CopyFrom(const std::shared_ptr<FlightCall>& call,
+                               off_t offset, size_t length, char* buffer);
+
+ private:
+  std::mutex mutex_;  // protect calls_
+  std::unordered_map<std::string, std::vector<std::shared_ptr<FlightCall>>>
+      calls_;
+  bvar::Adder<uint64_t> num_fetched_;
+  bvar::Adder<uint64_t> num_coalesced_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_SINGLE_FLIGHT_H_
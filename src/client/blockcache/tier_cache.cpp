@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/blockcache/tier_cache.h"
+
+#include <glog/logging.h>
+
+#include <functional>
+#include <memory>
+
+#include "client/blockcache/cache_store.h"
+#include "client/blockcache/error.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+TierCache::TierCache(std::shared_ptr<CacheStore> l1,
+                     std::shared_ptr<CacheStore> l2)
+    : l1_(l1),
+      l2_(l2),
+      sketch_(65536),
+      thread_pool_(std::make_unique<TaskThreadPool<>>("cache_promote")) {}
+
+BCACHE_ERROR TierCache::Init(UploadFunc uploader) {
+  auto rc = l1_->Init(uploader);
+  if (rc == BCACHE_ERROR::OK) {
+    rc = l2_->Init(uploader);
+  }
+  if (rc == BCACHE_ERROR::OK) {
+    CHECK(thread_pool_->Start(1) == 0);
+  }
+  return rc;
+}
+
+// The blocks which still wait for promoting will be dropped.
+BCACHE_ERROR TierCache::Shutdown() {
+  thread_pool_->Stop();
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    promoting_.clear();
+  }
+
+  auto rc = l2_->Shutdown();
+  if (rc == BCACHE_ERROR::OK) {
+    rc = l1_->Shutdown();
+  }
+  return rc;
+}
+
+BCACHE_ERROR TierCache::Stage(const BlockKey& key, const Block& block,
+                              BlockContext ctx) {
+  auto rc = l2_->Stage(key, block, ctx);
+  if (rc == BCACHE_ERROR::OK) {
+    l1_->Cache(key, block);  // ignore error, it's only a cache
+  }
+  return rc;
+}
+
+BCACHE_ERROR TierCache::RemoveStage(const BlockKey& key, BlockContext ctx) {
+  return l2_->RemoveStage(key, ctx);
+}
+
+BCACHE_ERROR TierCache::Cache(const BlockKey& key, const Block& block) {
+  l1_->Cache(key, block);
+  return l2_->Cache(key, block);
+}
+
+BCACHE_ERROR TierCache::Load(const BlockKey& key,
+                             std::shared_ptr<BlockReader>& reader) {
+  auto rc = l1_->Load(key, reader);
+  if (rc == BCACHE_ERROR::OK) {
+    return rc;
+  }
+
+  rc = l2_->Load(key, reader);
+  if (rc == BCACHE_ERROR::OK) {
+    MaybePromote(key);
+  }
+  return rc;
+}
+
+void TierCache::MaybePromote(const BlockKey& key) {
+  std::string filename = key.Filename();
+  uint64_t hash = std::hash<std::string>{}(filename);
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    sketch_.Increment(hash);
+    if (sketch_.Frequency(hash) < kPromoteFrequency ||
+        promoting_.size() >= kMaxPromoting ||
+        !promoting_.emplace(filename).second) {
+      return;
+    }
+  }
+  thread_pool_->Enqueue(&TierCache::Promote, this, key);
+}
+
+// The block is read through its own L2 reader, which verifies the checksum
+// and removes the corrupted block, so nothing is handled here on failure.
+void TierCache::Promote(const BlockKey& key) {
+  std::shared_ptr<BlockReader> reader;
+  auto rc = l2_->Load(key, reader);
+  if (rc == BCACHE_ERROR::OK) {
+    size_t size = reader->Size();
+    auto buffer = std::make_unique<char[]>(size);
+    rc = reader->ReadAt(0, size, buffer.get());
+    reader->Close();
+    if (rc == BCACHE_ERROR::OK) {
+      l1_->Cache(key, Block(buffer.get(), size));  // ignore error
+    }
+  }
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  promoting_.erase(key.Filename());
+}
+
+bool TierCache::IsCached(const BlockKey& key) {
+  return l1_->IsCached(key) || l2_->IsCached(key);
+}
+
+std::string TierCache::Id() { return "tier_cache"; }
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
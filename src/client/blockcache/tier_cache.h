@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_TIER_CACHE_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_TIER_CACHE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+#include "client/blockcache/cache_store.h"
+#include "client/blockcache/error.h"
+#include "client/blockcache/tinylfu_cache.h"
+#include "utils/concurrent/task_thread_pool.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using UploadFunc = CacheStore::UploadFunc;
+using ::dingofs::utils::TaskThreadPool;
+
+// How it works:
+//
+//   load: [L1 (memory)] --miss--> [L2 (disk)] --hit again--> promote into [L1]
+//   stage: [L2] --success--> [L1]
+//   cache: [L1] + [L2]
+//
+// The L1 cache store is used to absorb the hot blocks, and the L2 cache
+// store is responsible for stage block, which is durable.
+//
+// The block hit in L2 is promoted only if it's accessed at least twice
+// (estimated by frequency sketch), and in background, so the one-time read
+// never pays for copying the whole block.
+class TierCache : public CacheStore {
+ public:
+  TierCache(std::shared_ptr<CacheStore> l1, std::shared_ptr<CacheStore> l2);
+
+  virtual ~TierCache() = default;
+
+  static constexpr uint8_t kPromoteFrequency = 2;
+  static constexpr size_t kMaxPromoting = 64;
+
+  BCACHE_ERROR Init(UploadFunc uploader) override;
+
+  BCACHE_ERROR Shutdown() override;
+
+  BCACHE_ERROR Stage(const BlockKey& key, const Block& block,
+                     BlockContext ctx) override;
+
+  BCACHE_ERROR RemoveStage(const BlockKey& key, BlockContext ctx) override;
+
+  BCACHE_ERROR Cache(const BlockKey& key, const Block& block) override;
+
+  BCACHE_ERROR Load(const BlockKey& key,
+                    std::shared_ptr<BlockReader>& reader) override;
+
+  bool IsCached(const BlockKey& key) override;
+
+  std::string Id() override;
+
+ private:
+  void MaybePromote(const BlockKey& key);
+
+  void Promote(const BlockKey& key);
+
+  std::shared_ptr<CacheStore> l1_;
+  std::shared_ptr<CacheStore> l2_;
+  std::mutex mutex_;  // protect sketch_ and promoting_
+  FrequencySketch sketch_;
+  std::unordered_set<std::string> promoting_;
+  std::unique_ptr<TaskThreadPool<>> thread_pool_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_TIER_CACHE_H_
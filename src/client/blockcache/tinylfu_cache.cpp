@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/blockcache/tinylfu_cache.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+namespace {
+
+constexpr uint64_t kSeeds[] = {
+    0xc3a5c85c97cb3127ULL,
+    0xb492b66fbe98f273ULL,
+    0x9ae16a3b2f90404fULL,
+    0xcbf29ce484222325ULL,
+};
+
+};  // namespace
+
+FrequencySketch::FrequencySketch(size_t capacity)
+    : width_(64), additions_(0) {
+  while (width_ < capacity) {
+    width_ <<= 1;
+  }
+  sample_size_ = width_ * 10;
+  table_.resize(width_ * kDepth, 0);
+}
+
+void FrequencySketch::Increment(uint64_t hash) {
+  bool added = false;
+  for (int row = 0; row < kDepth; row++) {
+    auto& counter = table_[Index(hash, row)];
+    if (counter < kMaxCount) {
+      counter++;
+      added = true;
+    }
+  }
+
+  if (added && ++additions_ >= sample_size_) {
+    Reset();
+  }
+}
+
+uint8_t FrequencySketch::Frequency(uint64_t hash) const {
+  uint8_t freq = kMaxCount;
+  for (int row = 0; row < kDepth; row++) {
+    freq = std::min(freq, table_[Index(hash, row)]);
+  }
+  return freq;
+}
+
+// Mix the hash with row seed (splitmix64 finalizer), so the rows are
+// independent of each other.
+size_t FrequencySketch::Index(uint64_t hash, int row) const {
+  uint64_t h = hash + kSeeds[row];
+  h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  h = h ^ (h >> 31);
+  return row * width_ + (h & (width_ - 1));
+}
+
+// Aging: halve all counters to keep the sketch fresh
+void FrequencySketch::Reset() {
+  for (auto& counter : table_) {
+    counter >>= 1;
+  }
+  additions_ /= 2;
+}
+
+TinyLFUCache::TinyLFUCache(size_t capacity)
+    : ghost_capacity_(std::max<size_t>(capacity, 1024)), sketch_(capacity) {}
+
+std::string TinyLFUCache::Name() const { return "tinylfu"; }
+
+bool TinyLFUCache::Admit(const CacheKey& key, bool evict_needed) {
+  uint64_t hash = Hash(key.Filename());
+  sketch_.Increment(hash);
+  if (!evict_needed || ghost_set_.count(hash) != 0) {
+    return true;
+  }
+
+  ListNode* victim = Victim();
+  if (nullptr == victim) {
+    return true;
+  }
+  uint64_t victim_hash = Hash(hash_->Key(victim->handle));
+  return sketch_.Frequency(hash) > sketch_.Frequency(victim_hash);
+}
+
+void TinyLFUCache::Add(const CacheKey& key, const CacheValue& value) {
+  std::string filename = key.Filename();
+  ListNode* node = new ListNode(value);
+  HashInsert(filename, node);
+  if (RemoveGhost(Hash(filename))) {  // accessed again after evicted
+    ListAddFront(&active_, node);
+  } else {
+    ListAddFront(&inactive_, node);
+  }
+}
+
+bool TinyLFUCache::Get(const CacheKey& key, CacheValue* value) {
+  if (!LRUCache::Get(key, value)) {
+    return false;
+  }
+  sketch_.Increment(Hash(key.Filename()));
+  return true;
+}
+
+CacheItems TinyLFUCache::Evict(FilterFunc filter) {
+  auto evicted = LRUCache::Evict(filter);
+  for (const auto& item : evicted) {
+    AddGhost(Hash(item.key.Filename()));
+  }
+  return evicted;
+}
+
+void TinyLFUCache::Clear() {
+  LRUCache::Clear();
+  ghost_list_.clear();
+  ghost_set_.clear();
+}
+
+uint64_t TinyLFUCache::Hash(std::string_view filename) {
+  return std::hash<std::string_view>()(filename);
+}
+
+ListNode* TinyLFUCache::Victim() {
+  if (inactive_.next != &inactive_) {
+    return inactive_.next;
+  } else if (active_.next != &active_) {
+    return active_.next;
+  }
+  return nullptr;
+}
+
+void TinyLFUCache::AddGhost(uint64_t hash) {
+  if (!ghost_set_.insert(hash).second) {
+    return;
+  }
+
+  ghost_list_.push_back(hash);
+  while (ghost_list_.size() > ghost_capacity_) {
+    ghost_set_.erase(ghost_list_.front());
+    ghost_list_.pop_front();
+  }
+}
+
+// NOTE: the hash is removed from set only, and the stale one in list will
+// be dropped when it becomes the oldest.
+bool TinyLFUCache::RemoveGhost(uint64_t hash) {
+  return ghost_set_.erase(hash) != 0;
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
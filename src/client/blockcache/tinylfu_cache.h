@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_BLOCKCACHE_TINYLFU_CACHE_H_
+#define DINGOFS_SRC_CLIENT_BLOCKCACHE_TINYLFU_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "client/blockcache/lru_cache.h"
+#include "client/blockcache/lru_common.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+// Count-min sketch which estimates the access frequency of blocks,
+// all counters are halved after every sample_size increments, so the
+// frequency of old blocks will decay.
+class FrequencySketch {
+ public:
+  explicit FrequencySketch(size_t capacity);
+
+  void Increment(uint64_t hash);
+
+  uint8_t Frequency(uint64_t hash) const;
+
+ private:
+  size_t Index(uint64_t hash, int row) const;
+
+  void Reset();
+
+ private:
+  static constexpr int kDepth = 4;
+  static constexpr uint8_t kMaxCount = 15;
+
+  size_t width_;  // power of 2
+  size_t additions_;
+  size_t sample_size_;
+  std::vector<uint8_t> table_;  // kDepth * width_ counters
+};
+
+// How it implements:
+//   1. lru policy: reuse inactive and active list of LRUCache.
+//   2. admission: when cache is full, the new block is admitted only if its
+//      estimated frequency is higher than the victim (head of inactive list),
+//      so one-time accessed blocks (e.g. sequential scan) can't flush out the
+//      hot blocks.
+//   3. ghost entries: remember the recently evicted blocks, once they are
+//      accessed again they will be admitted into active list directly.
+class TinyLFUCache : public LRUCache {
+ public:
+  explicit TinyLFUCache(size_t capacity);
+
+  ~TinyLFUCache() override = default;
+
+  std::string Name() const override;
+
+  bool Admit(const CacheKey& key, bool evict_needed) override;
+
+  void Add(const CacheKey& key, const CacheValue& value) override;
+
+  bool Get(const CacheKey& key, CacheValue* value) override;
+
+  CacheItems Evict(FilterFunc filter) override;
+
+  void Clear() override;
+
+ private:
+  static uint64_t Hash(std::string_view filename);
+
+  ListNode* Victim();
+
+  void AddGhost(uint64_t hash);
+
+  bool RemoveGhost(uint64_t hash);
+
+ private:
+  size_t ghost_capacity_;
+  FrequencySketch sketch_;
+  std::list<uint64_t> ghost_list_;  // FIFO, oldest first
+  std::unordered_set<uint64_t> ghost_set_;
+};
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_BLOCKCACHE_TINYLFU_CACHE_H_
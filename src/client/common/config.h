@@ -56,6 +56,20 @@ struct PageOption {
   uint64_t page_size;
   uint64_t total_size;
   bool use_pool;
+  uint32_t num_shards;
+  bool use_hugepage;
+  bool numa_aware;
+};
+
+struct WritebackOption {
+  uint64_t max_inflight_bytes = 0;        // 0 means unlimited
+  uint64_t max_inode_inflight_bytes = 0;  // per inode, 0 means unlimited
+};
+
+struct ReadCacheOption {
+  uint64_t capacity = 0;  // 0 means disabled
+  uint64_t page_size = 65536;
+  uint32_t num_shards = 16;
 };
 
 struct DataStreamOption {
@@ -64,6 +78,8 @@ struct DataStreamOption {
   ChunkOption chunk_option;
   SliceOption slice_option;
   PageOption page_option;
+  WritebackOption writeback_option;
+  ReadCacheOption read_cache_option;
 };
 // }
 
@@ -71,9 +87,24 @@ struct DataStreamOption {
 struct DiskCacheOption {
   uint32_t index;
   std::string cache_dir;
+  uint64_t cache_size;    // bytes
+  uint64_t segment_size;    // bytes, 0 means store one file per block
+  uint32_t io_uring_depth;  // 0 means using blocking psync I/O
+  std::string cache_policy;  // lru or tinylfu
+};
+
+struct MemCacheOption {
   uint64_t cache_size;  // bytes
 };
 
+struct CacheGroupOption {
+  bool enable = false;
+  std::string listen_address;      // ip:port served for the peers
+  std::vector<std::string> peers;  // ip:port of all members, itself included
+  uint32_t rpc_timeout_ms = 3000;
+  uint64_t block_size = 0;  // of filesystem, set at mount
+};
+
 struct BlockCacheOption {
   std::string cache_store;
   bool stage;
@@ -85,7 +116,11 @@ struct BlockCacheOption {
   uint32_t flush_slice_queue_size;
   uint64_t upload_stage_workers;
   uint64_t upload_stage_queue_size;
+  uint32_t cache_fill_workers;  // 0 means disable cache fill
+  uint32_t cache_fill_queue_size;
   std::vector<DiskCacheOption> disk_cache_options;
+  MemCacheOption mem_cache_option;
+  CacheGroupOption cache_group_option;
 };
 // }
 
@@ -41,16 +41,26 @@ bool PassBool(const char*, bool) { return true; }
 DEFINE_bool(access_logging, true, "enable access log");
 DEFINE_validator(access_logging, &PassBool);
 
+// fuse
+DEFINE_uint64(fuse_read_buffer_pool_max_mb, 256,
+              "max memory cached by the shared free lists of fuse read "
+              "buffer pool");
+DEFINE_validator(fuse_read_buffer_pool_max_mb, &PassUint64);
+
 // block cache
 DEFINE_bool(block_cache_logging, true, "enable block cache logging");
 DEFINE_bool(block_cache_stage_bandwidth_throttle_enable, false,
             "enable block cache stage bandwidth throttle");
 DEFINE_uint64(block_cache_stage_bandwidth_throttle_mb, 102400,
               "block cache stage bandwidth throttle");
+DEFINE_uint64(block_cache_fill_bandwidth_mb, 100,
+              "bandwidth budget for filling blocks which put to storage "
+              "directly into cache, 0 means disable it");
 
 DEFINE_validator(block_cache_logging, &PassBool);
 DEFINE_validator(block_cache_stage_bandwidth_throttle_enable, &PassBool);
 DEFINE_validator(block_cache_stage_bandwidth_throttle_mb, &PassUint64);
+DEFINE_validator(block_cache_fill_bandwidth_mb, &PassUint64);
 
 // disk cache
 DEFINE_bool(drop_page_cache, true, "drop page cache for disk cache");
@@ -70,6 +80,15 @@ DEFINE_validator(disk_cache_expire_second, &PassUint64);
 DEFINE_validator(disk_cache_cleanup_expire_interval_millsecond, &PassUint64);
 DEFINE_validator(disk_cache_free_space_ratio, &PassDouble);
 
+// disk cache loader
+DEFINE_uint32(disk_cache_load_threads, 8,
+              "number of threads for loading blocks at startup");
+DEFINE_bool(disk_cache_persist_index, true,
+            "dump cache index at shutdown and load it at next startup");
+
+DEFINE_validator(disk_cache_load_threads, &PassUint32);
+DEFINE_validator(disk_cache_persist_index, &PassBool);
+
 // disk state machine
 DEFINE_int32(disk_state_tick_duration_second, 60,
              "tick duration in seconds for disk state machine");
@@ -40,10 +40,14 @@ namespace common {
 // access log
 DECLARE_bool(access_logging);
 
+// fuse
+DECLARE_uint64(fuse_read_buffer_pool_max_mb);
+
 // block cache logging
 DECLARE_bool(block_cache_logging);
 DECLARE_bool(block_cache_stage_bandwidth_throttle_enable);
 DECLARE_uint64(block_cache_stage_bandwidth_throttle_mb);
+DECLARE_uint64(block_cache_fill_bandwidth_mb);
 
 // disk cache
 DECLARE_bool(drop_page_cache);
@@ -53,6 +57,10 @@ DECLARE_uint64(disk_cache_expire_second);
 DECLARE_uint64(disk_cache_cleanup_expire_interval_millsecond);
 DECLARE_double(disk_cache_free_space_ratio);
 
+// disk cache loader
+DECLARE_uint32(disk_cache_load_threads);
+DECLARE_bool(disk_cache_persist_index);
+
 // disk state machine
 DECLARE_int32(disk_state_tick_duration_second);
 DECLARE_int32(disk_state_normal2unstable_io_error_num);
@@ -22,14 +22,19 @@
 
 #include "client/datastream/data_stream.h"
 
+#include <butil/time.h>
 #include <glog/logging.h>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <thread>
 
 #include "client/common/config.h"
 #include "client/datastream/metric.h"
 #include "client/datastream/page_allocator.h"
+#include "client/datastream/page_cache.h"
 
 namespace dingofs {
 namespace client {
@@ -54,12 +59,15 @@ bool DataStream::Init(DataStreamOption option) {
   // chunk
   {
     auto o = option.chunk_option;
-    flush_chunk_thread_pool_ =
-        std::make_shared<TaskThreadPool<>>("flush_chunk_worker");
-    auto rc =
-        flush_chunk_thread_pool_->Start(o.flush_workers, o.flush_queue_size);
-    if (rc != 0) {
-      LOG(ERROR) << "Start flush chunk thread pool failed, rc = " << rc;
+    flush_chunk_scheduler_ =
+        std::make_shared<FlushScheduler>(FlushSchedulerOption{
+            .name = "flush_chunk_worker",
+            .workers = static_cast<uint32_t>(o.flush_workers),
+            .queue_size = o.flush_queue_size,
+            .max_inode_inflight = 0,
+        });
+    if (!flush_chunk_scheduler_->Start()) {
+      LOG(ERROR) << "Start flush chunk scheduler failed.";
       return false;
     }
   }
@@ -67,12 +75,16 @@ bool DataStream::Init(DataStreamOption option) {
   // slice
   {
     auto o = option.slice_option;
-    flush_slice_thread_pool_ =
-        std::make_shared<TaskThreadPool<>>("flush_slice_worker");
-    auto rc =
-        flush_slice_thread_pool_->Start(o.flush_workers, o.flush_queue_size);
-    if (rc != 0) {
-      LOG(ERROR) << "Start flush slice thread pool failed, rc = " << rc;
+    flush_slice_scheduler_ =
+        std::make_shared<FlushScheduler>(FlushSchedulerOption{
+            .name = "flush_slice_worker",
+            .workers = static_cast<uint32_t>(o.flush_workers),
+            .queue_size = o.flush_queue_size,
+            .max_inode_inflight =
+                option.writeback_option.max_inode_inflight_bytes,
+        });
+    if (!flush_slice_scheduler_->Start()) {
+      LOG(ERROR) << "Start flush slice scheduler failed.";
       return false;
     }
   }
@@ -81,7 +93,11 @@ bool DataStream::Init(DataStreamOption option) {
   {
     auto o = option.page_option;
     if (o.use_pool) {
-      page_allocator_ = std::make_shared<PagePool>();
+      page_allocator_ = std::make_shared<PagePool>(PagePoolOption{
+          .num_shards = o.num_shards,
+          .use_hugepage = o.use_hugepage,
+          .numa_aware = o.numa_aware,
+      });
     } else {
       page_allocator_ = std::make_shared<DefaultPageAllocator>();
     }
@@ -93,11 +109,23 @@ bool DataStream::Init(DataStreamOption option) {
     }
   }
 
+  // read cache
+  {
+    auto o = option.read_cache_option;
+    if (o.capacity > 0) {
+      page_cache_ = std::make_unique<PageCache>(PageCacheOption{
+          .capacity = o.capacity,
+          .page_size = o.page_size,
+          .num_shards = o.num_shards,
+      });
+    }
+  }
+
   // metric
   auto aux_members = DataStreamMetric::AuxMembers{
       .flush_file_thread_pool = flush_file_thread_pool_,
-      .flush_chunk_thread_pool = flush_chunk_thread_pool_,
-      .flush_slice_thread_pool = flush_slice_thread_pool_,
+      .flush_chunk_scheduler = flush_chunk_scheduler_,
+      .flush_slice_scheduler = flush_slice_scheduler_,
       .page_allocator = page_allocator_,
   };
   metric_ = std::make_unique<DataStreamMetric>(option, aux_members);
@@ -106,26 +134,106 @@ bool DataStream::Init(DataStreamOption option) {
 
 void DataStream::Shutdown() {
   flush_file_thread_pool_->Stop();
-  flush_chunk_thread_pool_->Stop();
-  flush_slice_thread_pool_->Stop();
+  flush_chunk_scheduler_->Stop();
+  flush_slice_scheduler_->Stop();
 }
 
 void DataStream::EnterFlushFileQueue(TaskFunc task) {
   flush_file_thread_pool_->Enqueue(task);
 }
 
-void DataStream::EnterFlushChunkQueue(TaskFunc task) {
-  flush_chunk_thread_pool_->Enqueue(task);
+void DataStream::EnterFlushChunkQueue(uint64_t ino, TaskFunc task) {
+  flush_chunk_scheduler_->Enqueue(ino, 0, task);
 }
 
-void DataStream::EnterFlushSliceQueue(TaskFunc task) {
-  flush_slice_thread_pool_->Enqueue(task);
+void DataStream::EnterFlushSliceQueue(uint64_t ino, uint64_t bytes,
+                                      TaskFunc task) {
+  flush_slice_scheduler_->Enqueue(ino, bytes, task);
+}
+
+void DataStream::BeginUrgentFlush(uint64_t ino) {
+  flush_chunk_scheduler_->BeginUrgent(ino);
+  flush_slice_scheduler_->BeginUrgent(ino);
+}
+
+void DataStream::EndUrgentFlush(uint64_t ino) {
+  flush_chunk_scheduler_->EndUrgent(ino);
+  flush_slice_scheduler_->EndUrgent(ino);
 }
 
 char* DataStream::NewPage() { return page_allocator_->Allocate(); }
 
+char* DataStream::TryNewPage() { return page_allocator_->TryAllocate(); }
+
 void DataStream::FreePage(char* page) { page_allocator_->DeAllocate(page); }
 
+void DataStream::WaitMemoryNotFull() {
+  if (!MemoryNearFull()) {
+    return;
+  }
+
+  butil::Timer timer;
+  timer.start();
+  while (MemoryNearFull()) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  timer.stop();
+  metric_->AddWriteStall(timer.u_elapsed());
+}
+
+void DataStream::AcquireWriteback(uint64_t ino, uint64_t bytes) {
+  uint64_t max_bytes = option_.writeback_option.max_inflight_bytes;
+  uint64_t max_inode_bytes = option_.writeback_option.max_inode_inflight_bytes;
+  std::unique_lock<std::mutex> lk(writeback_mutex_);
+  auto has_room = [&]() {
+    auto iter = inode_writeback_bytes_.find(ino);
+    uint64_t inode_bytes =
+        (iter == inode_writeback_bytes_.end()) ? 0 : iter->second;
+    if (writeback_bytes_ == 0) {  // always make progress
+      return true;
+    } else if (max_bytes != 0 && writeback_bytes_ + bytes > max_bytes) {
+      return false;
+    }
+    // one huge file can't hold up the others
+    return inode_bytes == 0 || max_inode_bytes == 0 ||
+           inode_bytes + bytes <= max_inode_bytes;
+  };
+
+  if (!has_room()) {
+    butil::Timer timer;
+    timer.start();
+    writeback_cond_.wait(lk, has_room);
+    timer.stop();
+    if (metric_ != nullptr) {
+      metric_->AddWritebackThrottle(timer.u_elapsed());
+    }
+  }
+
+  writeback_bytes_ += bytes;
+  inode_writeback_bytes_[ino] += bytes;
+  if (metric_ != nullptr) {
+    metric_->AddWritebackBytes(bytes);
+  }
+}
+
+void DataStream::ReleaseWriteback(uint64_t ino, uint64_t bytes) {
+  {
+    std::lock_guard<std::mutex> lk(writeback_mutex_);
+    writeback_bytes_ -= std::min(bytes, writeback_bytes_);
+    auto iter = inode_writeback_bytes_.find(ino);
+    if (iter != inode_writeback_bytes_.end()) {
+      iter->second -= std::min(bytes, iter->second);
+      if (iter->second == 0) {
+        inode_writeback_bytes_.erase(iter);
+      }
+    }
+    if (metric_ != nullptr) {
+      metric_->AddWritebackBytes(-static_cast<int64_t>(bytes));
+    }
+  }
+  writeback_cond_.notify_all();
+}
+
 bool DataStream::MemoryNearFull() {
   double trigger_force_memory_ratio =
       option_.background_flush_option.trigger_force_memory_ratio;
@@ -24,12 +24,17 @@
 #define DINGOFS_SRC_CLIENT_DATASTREAM_DATA_STREAM_H_
 
 #include <cassert>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 
 #include "client/common/config.h"
+#include "client/datastream/flush_scheduler.h"
 #include "client/datastream/metric.h"
 #include "client/datastream/page_allocator.h"
+#include "client/datastream/page_cache.h"
 #include "utils/concurrent/task_thread_pool.h"
 
 namespace dingofs {
@@ -55,23 +60,51 @@ class DataStream {
 
   void EnterFlushFileQueue(TaskFunc task);
 
-  void EnterFlushChunkQueue(TaskFunc task);
+  // The chunk and slice queues are fair across inodes, see FlushScheduler,
+  // and the running bytes of each inode are capped in slice queue
+  void EnterFlushChunkQueue(uint64_t ino, TaskFunc task);
 
-  void EnterFlushSliceQueue(TaskFunc task);
+  void EnterFlushSliceQueue(uint64_t ino, uint64_t bytes, TaskFunc task);
+
+  // The flush of inode is waited by fsync or close, it runs before others
+  void BeginUrgentFlush(uint64_t ino);
+
+  void EndUrgentFlush(uint64_t ino);
 
   char* NewPage();
 
+  // Return nullptr rather than waiting if all pages are in use
+  char* TryNewPage();
+
   void FreePage(char* p);
 
   bool MemoryNearFull();
 
+  // Block the writer until the memory is not near full
+  void WaitMemoryNotFull();
+
+  // Bound the bytes being written back, it blocks until there is room,
+  // but an inode holding nothing is always admitted
+  void AcquireWriteback(uint64_t ino, uint64_t bytes);
+
+  void ReleaseWriteback(uint64_t ino, uint64_t bytes);
+
+  // The cache of clean pages, return nullptr if it's disabled
+  PageCache* GetPageCache() { return page_cache_.get(); }
+
  private:
   std::shared_ptr<TaskThreadPool<>> flush_file_thread_pool_;
-  std::shared_ptr<TaskThreadPool<>> flush_chunk_thread_pool_;
-  std::shared_ptr<TaskThreadPool<>> flush_slice_thread_pool_;
+  std::shared_ptr<FlushScheduler> flush_chunk_scheduler_;
+  std::shared_ptr<FlushScheduler> flush_slice_scheduler_;
   std::shared_ptr<PageAllocator> page_allocator_;
+  std::unique_ptr<PageCache> page_cache_;
   std::unique_ptr<DataStreamMetric> metric_;
   DataStreamOption option_;
+
+  std::mutex writeback_mutex_;
+  std::condition_variable writeback_cond_;
+  uint64_t writeback_bytes_{0};
+  std::unordered_map<uint64_t, uint64_t> inode_writeback_bytes_;
 };
 
 }  // namespace datastream
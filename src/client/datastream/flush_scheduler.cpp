@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/datastream/flush_scheduler.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace dingofs {
+namespace client {
+namespace datastream {
+
+FlushScheduler::FlushScheduler(FlushSchedulerOption option)
+    : option_(std::move(option)) {
+  option_.queue_size = std::max<uint64_t>(option_.queue_size, 1);
+}
+
+FlushScheduler::~FlushScheduler() { Stop(); }
+
+bool FlushScheduler::Start() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (option_.workers == 0) {
+    return false;
+  } else if (running_) {
+    return true;
+  }
+
+  running_ = true;
+  for (uint32_t i = 0; i < option_.workers; i++) {
+    workers_.emplace_back([this]() {
+      pthread_setname_np(pthread_self(), option_.name.substr(0, 15).c_str());
+      WorkerLoop();
+    });
+  }
+  return true;
+}
+
+void FlushScheduler::Stop() {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+
+  // the workers exit after all pending tasks are done
+  not_empty_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void FlushScheduler::Enqueue(uint64_t ino, uint64_t bytes, TaskFunc task) {
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    not_full_.wait(lk, [&]() { return num_pending_ < option_.queue_size; });
+
+    auto& inode = inodes_[ino];
+    inode.pending.emplace_back(Task{bytes, std::move(task)});
+    if (!inode.active) {
+      inode.active = true;
+      active_.push_back(ino);
+    }
+    num_pending_++;
+  }
+  not_empty_.notify_one();
+}
+
+void FlushScheduler::BeginUrgent(uint64_t ino) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  inodes_[ino].urgent++;
+}
+
+void FlushScheduler::EndUrgent(uint64_t ino) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto iter = inodes_.find(ino);
+  if (iter != inodes_.end() && iter->second.urgent > 0) {
+    iter->second.urgent--;
+    TryErase(ino);
+  }
+}
+
+uint32_t FlushScheduler::QueueSize() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return num_pending_;
+}
+
+void FlushScheduler::WorkerLoop() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  while (true) {
+    uint64_t ino;
+    Task task;
+    if (!PickTask(&ino, &task)) {
+      if (!running_ && num_pending_ == 0) {
+        break;
+      }
+      not_empty_.wait(lk);
+      continue;
+    }
+
+    not_full_.notify_one();
+    lk.unlock();
+    task.func();
+    lk.lock();
+
+    auto& inode = inodes_[ino];
+    inode.inflight -= task.bytes;
+    TryErase(ino);
+
+    // the inode may be runnable again, and the stopping workers may exit
+    not_empty_.notify_all();
+  }
+}
+
+bool FlushScheduler::Runnable(const Inode& inode) const {
+  return option_.max_inode_inflight == 0 ||
+         inode.inflight < option_.max_inode_inflight;
+}
+
+bool FlushScheduler::PickTask(uint64_t* ino, Task* task) {
+  auto picked = active_.end();
+  for (auto iter = active_.begin(); iter != active_.end(); iter++) {
+    const auto& inode = inodes_[*iter];
+    if (!Runnable(inode)) {
+      continue;
+    } else if (inode.urgent > 0) {
+      picked = iter;
+      break;
+    } else if (picked == active_.end()) {
+      picked = iter;  // the first runnable one, unless someone is urgent
+    }
+  }
+
+  if (picked == active_.end()) {
+    return false;
+  }
+
+  *ino = *picked;
+  auto& inode = inodes_[*ino];
+  *task = std::move(inode.pending.front());
+  inode.pending.pop_front();
+  inode.inflight += task->bytes;
+  num_pending_--;
+
+  // round-robin: the inode goes to the back of list
+  active_.erase(picked);
+  if (inode.pending.empty()) {
+    inode.active = false;
+  } else {
+    active_.push_back(*ino);
+  }
+  return true;
+}
+
+void FlushScheduler::TryErase(uint64_t ino) {
+  auto iter = inodes_.find(ino);
+  if (iter != inodes_.end()) {
+    const auto& inode = iter->second;
+    if (inode.pending.empty() && inode.inflight == 0 && inode.urgent == 0) {
+      inodes_.erase(iter);
+    }
+  }
+}
+
+}  // namespace datastream
+}  // namespace client
+}  // namespace dingofs
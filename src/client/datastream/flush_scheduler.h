@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_DATASTREAM_FLUSH_SCHEDULER_H_
+#define DINGOFS_SRC_CLIENT_DATASTREAM_FLUSH_SCHEDULER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace dingofs {
+namespace client {
+namespace datastream {
+
+struct FlushSchedulerOption {
+  std::string name;
+  uint32_t workers = 1;
+  uint64_t queue_size = 1;          // max pending tasks, enqueue blocks
+  uint64_t max_inode_inflight = 0;  // bytes, 0 means unlimited
+};
+
+// The flush queue shared by all files, which keeps one file from stalling
+// the others:
+//   1) the pending tasks are queued by inode, and the inodes are served
+//      round-robin, so a small file never waits behind a huge one.
+//   2) the inode under explicit fsync or close is urgent, its tasks
+//      (including those queued by background flush) run before others.
+//   3) the running bytes of each inode are capped, an inode beyond the
+//      cap is skipped until its tasks finish, unless nothing of it runs.
+class FlushScheduler {
+ public:
+  using TaskFunc = std::function<void()>;
+
+  explicit FlushScheduler(FlushSchedulerOption option);
+
+  virtual ~FlushScheduler();
+
+  // Return false if there is no worker
+  bool Start();
+
+  void Stop();
+
+  void Enqueue(uint64_t ino, uint64_t bytes, TaskFunc task);
+
+  // Mark the inode as urgent until the same times of EndUrgent()
+  void BeginUrgent(uint64_t ino);
+
+  void EndUrgent(uint64_t ino);
+
+  uint32_t QueueSize();
+
+ private:
+  struct Task {
+    uint64_t bytes;
+    TaskFunc func;
+  };
+
+  struct Inode {
+    std::deque<Task> pending;
+    uint64_t inflight{0};  // bytes of running tasks
+    uint32_t urgent{0};
+    bool active{false};  // in the round-robin list
+  };
+
+  void WorkerLoop();
+
+  // Pick the next task, return false if no inode is runnable
+  bool PickTask(uint64_t* ino, Task* task);
+
+  bool Runnable(const Inode& inode) const;
+
+  // Drop the inode if it's idle
+  void TryErase(uint64_t ino);
+
+ private:
+  FlushSchedulerOption option_;
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  bool running_{false};
+  uint64_t num_pending_{0};
+  std::unordered_map<uint64_t, Inode> inodes_;
+  std::list<uint64_t> active_;  // the inodes with pending tasks
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace datastream
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_DATASTREAM_FLUSH_SCHEDULER_H_
@@ -25,14 +25,19 @@
 #include <butil/logging.h>
 #include <butil/time.h>
 #include <glog/logging.h>
+#include <linux/mempolicy.h>
 #include <stdlib.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #include <cassert>
+#include <cerrno>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <mutex>
+#include <vector>
 
 namespace dingofs {
 namespace client {
@@ -40,6 +45,14 @@ namespace datastream {
 
 using Timer = ::butil::Timer;
 
+// Prefer the pages of [addr, addr + length) to be allocated on |numa_node|,
+// it must be called before the memory is touched.
+static int BindNumaNode(void* addr, uint64_t length, int numa_node) {
+  unsigned long nodemask = 1UL << numa_node;
+  return syscall(SYS_mbind, addr, length, MPOL_PREFERRED, &nodemask,
+                 sizeof(nodemask) * 8, 0);
+}
+
 MemoryPool::MemoryPool()
     : size_each_block_(0),
       num_total_blocks_(0),
@@ -48,21 +61,29 @@ MemoryPool::MemoryPool()
       mem_start_(nullptr),
       next_free_index_(nullptr) {}
 
-bool MemoryPool::CreatePool(size_t size_each_block, uint64_t num_total_blocks) {
+bool MemoryPool::CreatePool(size_t size_each_block, uint64_t num_total_blocks,
+                            bool use_hugepage, int numa_node) {
   Timer timer;
   uint64_t total_size = size_each_block * num_total_blocks;
   void** memptr = reinterpret_cast<void**>(&mem_start_);
 
   timer.start();
   int rc = posix_memalign(memptr, 1 << 21, total_size);
-  if (rc == 0) {
+  if (rc == 0 && use_hugepage) {
     void* addr = reinterpret_cast<void*>(mem_start_);
     rc = madvise(addr, total_size, MADV_HUGEPAGE);
   }
+  if (rc == 0 && numa_node >= 0 && numa_node < 64) {
+    void* addr = reinterpret_cast<void*>(mem_start_);
+    LOG_IF(WARNING, BindNumaNode(addr, total_size, numa_node) != 0)
+        << "Bind memory pool to numa node " << numa_node
+        << " failed: " << strerror(errno);
+  }
   timer.stop();
 
   if (rc != 0) {
-    LOG(ERROR) << "Alloc huge page memory failed: rc = " << rc;
+    LOG(ERROR) << "Alloc " << (use_hugepage ? "huge page " : "")
+               << "memory failed: rc = " << rc;
     return false;
   }
 
@@ -80,7 +101,7 @@ bool MemoryPool::CreatePool(size_t size_each_block, uint64_t num_total_blocks) {
 }
 
 void MemoryPool::DestroyPool() {
-  delete[] mem_start_;
+  free(mem_start_);  // allocated by posix_memalign()
   mem_start_ = nullptr;
 }
 
@@ -103,6 +124,12 @@ void MemoryPool::DeAllocate(void* block) {
 
 uint64_t MemoryPool::GetFreeBlocks() const { return num_free_blocks_; }
 
+bool MemoryPool::Contains(const void* block) const {
+  const char* addr = reinterpret_cast<const char*>(block);
+  return addr >= mem_start_ &&
+         addr < mem_start_ + num_total_blocks_ * size_each_block_;
+}
+
 void MemoryPool::AllocateAllBlocksOnce() {
   std::vector<void*> blocks;
   size_t num_total_blocks = num_total_blocks_;
@@ -39,7 +39,10 @@ class MemoryPool {
  public:
   MemoryPool();
 
-  bool CreatePool(size_t size_each_block, uint64_t num_total_blocks);
+  // The memory is backed by transparent huge pages if |use_hugepage|,
+  // and preferred to be placed on |numa_node| if it's not -1.
+  bool CreatePool(size_t size_each_block, uint64_t num_total_blocks,
+                  bool use_hugepage = true, int numa_node = -1);
 
   void DestroyPool();
 
@@ -49,6 +52,8 @@ class MemoryPool {
 
   uint64_t GetFreeBlocks() const;
 
+  bool Contains(const void* block) const;
+
  private:
   void AllocateAllBlocksOnce();
 
@@ -29,6 +29,7 @@
 #include <memory>
 
 #include "client/common/config.h"
+#include "client/datastream/flush_scheduler.h"
 #include "client/datastream/page_allocator.h"
 #include "utils/concurrent/task_thread_pool.h"
 
@@ -44,6 +45,11 @@ static uint32_t GetQueueSize(void* arg) {
   return thread_pool->QueueSize();
 }
 
+static uint32_t GetSchedulerQueueSize(void* arg) {
+  auto* scheduler = reinterpret_cast<FlushScheduler*>(arg);
+  return scheduler->QueueSize();
+}
+
 static uint64_t GetFreePages(void* arg) {
   auto* page_allocator = reinterpret_cast<PageAllocator*>(arg);
   return page_allocator->GetFreePages();
@@ -53,8 +59,8 @@ class DataStreamMetric {
  public:
   struct AuxMembers {
     std::shared_ptr<TaskThreadPool<>> flush_file_thread_pool;
-    std::shared_ptr<TaskThreadPool<>> flush_chunk_thread_pool;
-    std::shared_ptr<TaskThreadPool<>> flush_slice_thread_pool;
+    std::shared_ptr<FlushScheduler> flush_chunk_scheduler;
+    std::shared_ptr<FlushScheduler> flush_slice_scheduler;
     std::shared_ptr<PageAllocator> page_allocator;
   };
 
@@ -91,6 +97,12 @@ class DataStreamMetric {
 
   virtual ~DataStreamMetric() = default;
 
+  void AddWriteStall(int64_t us) { metric_.write_stall << us; }
+
+  void AddWritebackThrottle(int64_t us) { metric_.writeback_throttle << us; }
+
+  void AddWritebackBytes(int64_t bytes) { metric_.writeback_bytes << bytes; }
+
  private:
   struct Metric {
     Metric(const std::string& prefix, AuxMembers aux_members)
@@ -104,18 +116,22 @@ class DataStreamMetric {
           flush_chunk_workers(prefix, "flush_chunk_workers", 0),
           flush_chunk_queue_capacity(prefix, "flush_chunk_queue_capacity", 0),
           flush_chunk_pending_tasks(prefix, "flush_chunk_pending_tasks",
-                                    &GetQueueSize,
-                                    aux_members.flush_chunk_thread_pool.get()),
+                                    &GetSchedulerQueueSize,
+                                    aux_members.flush_chunk_scheduler.get()),
           // slice
           flush_slice_workers(prefix, "flush_slice_workers", 0),
           flush_slice_queue_capacity(prefix, "flush_slice_queue_capacity", 0),
           flush_slice_pending_tasks(prefix, "flush_slice_pending_tasks",
-                                    &GetQueueSize,
-                                    aux_members.flush_slice_thread_pool.get()),
+                                    &GetSchedulerQueueSize,
+                                    aux_members.flush_slice_scheduler.get()),
           // page
           use_page_pool(prefix, "use_page_pool", false),
           free_pages(prefix, "free_pages", &GetFreePages,
-                     aux_members.page_allocator.get()) {}
+                     aux_members.page_allocator.get()),
+          write_stall(prefix, "write_stall"),
+          // writeback
+          writeback_throttle(prefix, "writeback_throttle"),
+          writeback_bytes(prefix, "writeback_bytes") {}
 
     // file
     bvar::Status<uint32_t> flush_file_workers;
@@ -132,6 +148,10 @@ class DataStreamMetric {
     // page
     bvar::Status<bool> use_page_pool;
     bvar::PassiveStatus<uint64_t> free_pages;
+    bvar::LatencyRecorder write_stall;  // wait for memory near full
+    // writeback
+    bvar::LatencyRecorder writeback_throttle;  // wait for inflight bytes
+    bvar::Adder<int64_t> writeback_bytes;
     bvar::Status<uint32_t> s3_async_upload_workers;
   };
 
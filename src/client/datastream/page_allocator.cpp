@@ -22,13 +22,27 @@
 
 #include "client/datastream/page_allocator.h"
 
+#include <butil/time.h>
+#include <glog/logging.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
 
 namespace dingofs {
 namespace client {
 namespace datastream {
 
+static constexpr uint32_t kMaxShards = 64;
+static constexpr uint64_t kMaxShardPages = 64;
+
 DefaultPageAllocator::DefaultPageAllocator()
     : page_size_(0), num_free_pages_(0) {}
 
@@ -50,6 +64,18 @@ char* DefaultPageAllocator::Allocate() {
   return page;
 }
 
+char* DefaultPageAllocator::TryAllocate() {
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (num_free_pages_ == 0) {
+    return nullptr;
+  }
+
+  char* page = new (std::nothrow) char[page_size_];
+  std::memset(page, 0, page_size_);
+  num_free_pages_--;
+  return page;
+}
+
 void DefaultPageAllocator::DeAllocate(char* page) {
   std::unique_lock<std::mutex> lk(mutex_);
   delete[] page;
@@ -62,41 +88,258 @@ uint64_t DefaultPageAllocator::GetFreePages() {
   return num_free_pages_;
 }
 
-PagePool::PagePool()
-    : page_size_(0),
+PagePool::PagePool() : PagePool(PagePoolOption()) {}
+
+PagePool::PagePool(PagePoolOption option)
+    : option_(option),
+      page_size_(0),
+      shard_capacity_(0),
+      batch_size_(1),
       num_free_pages_(0),
-      mem_pool_(std::make_unique<MemoryPool>()) {}
+      num_waiters_(0),
+      num_shard_contentions_("dingofs_data_stream",
+                             "page_pool_shard_contentions"),
+      num_refills_("dingofs_data_stream", "page_pool_refills"),
+      num_steals_("dingofs_data_stream", "page_pool_steals"),
+      wait_latency_("dingofs_data_stream", "page_pool_wait") {}
 
-PagePool::~PagePool() { mem_pool_->DestroyPool(); }
+PagePool::~PagePool() {
+  for (auto& node : nodes_) {
+    node->mem_pool->DestroyPool();
+  }
+}
 
 bool PagePool::Init(uint64_t page_size, uint64_t num_pages) {
   page_size_ = page_size;
-  num_free_pages_ = num_pages;
-  return mem_pool_->CreatePool(page_size, num_pages);
+  num_free_pages_.store(num_pages);
+
+  // global memory pools
+  std::vector<int> node_ids{-1};
+  if (option_.numa_aware) {
+    node_ids = OnlineNumaNodes();
+  }
+  uint64_t num_nodes = std::min<uint64_t>(node_ids.size(), num_pages);
+  for (uint64_t i = 0; i < num_nodes; i++) {
+    uint64_t num_node_pages =
+        num_pages / num_nodes + (i < num_pages % num_nodes ? 1 : 0);
+    auto node = std::make_unique<Node>();
+    node->id = node_ids[i];
+    node->mem_pool = std::make_unique<MemoryPool>();
+    if (!node->mem_pool->CreatePool(page_size, num_node_pages,
+                                    option_.use_hugepage, node->id)) {
+      return false;
+    }
+    nodes_.emplace_back(std::move(node));
+  }
+
+  // shards, which cache at most 1/4 of the pages in total
+  uint32_t num_shards = option_.num_shards;
+  if (num_shards == 0) {
+    num_shards = std::thread::hardware_concurrency();
+  }
+  num_shards = std::min(std::max(num_shards, 1U), kMaxShards);
+  for (uint32_t i = 0; i < num_shards; i++) {
+    shards_.emplace_back(std::make_unique<Shard>());
+  }
+  shard_capacity_ =
+      std::min<uint64_t>(kMaxShardPages, num_pages / (num_shards * 4));
+  batch_size_ = std::max<uint64_t>(1, shard_capacity_ / 2);
+
+  LOG(INFO) << "Page pool init success: pages = " << num_pages
+            << ", numa nodes = " << nodes_.size()
+            << ", shards = " << shards_.size()
+            << ", shard capacity = " << shard_capacity_;
+  return true;
 }
 
 char* PagePool::Allocate() {
-  std::unique_lock<std::mutex> lk(mutex_);
-  while (num_free_pages_ == 0) {
-    can_allocate_.wait(lk);
+  char* page = TryAllocate();
+  if (page == nullptr) {
+    page = WaitPage();
+    num_free_pages_.fetch_sub(1);
   }
+  return page;
+}
 
-  void* page = mem_pool_->Allocate();
-  assert(page != nullptr);
-  num_free_pages_--;
-  return reinterpret_cast<char*>(page);
+char* PagePool::TryAllocate() {
+  Shard* shard = CurrentShard();
+  char* page = PopShard(shard);
+  if (page == nullptr) {
+    page = Refill(shard);
+  }
+  if (page == nullptr) {
+    page = Steal();
+  }
+
+  if (page != nullptr) {
+    num_free_pages_.fetch_sub(1);
+  }
+  return page;
 }
 
 void PagePool::DeAllocate(char* page) {
-  std::unique_lock<std::mutex> lk(mutex_);
-  mem_pool_->DeAllocate(reinterpret_cast<void*>(page));
-  num_free_pages_++;
-  can_allocate_.notify_one();
+  PushShard(CurrentShard(), page);
+  num_free_pages_.fetch_add(1);
+
+  // NOTE: the page is pushed before checking the waiters, and the waiter
+  // scans the shards after it's counted, so the page is never missed.
+  if (num_waiters_.load() > 0) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    can_allocate_.notify_one();
+  }
 }
 
-uint64_t PagePool::GetFreePages() {
-  std::unique_lock<std::mutex> lk(mutex_);
-  return num_free_pages_;
+uint64_t PagePool::GetFreePages() { return num_free_pages_.load(); }
+
+std::vector<int> PagePool::OnlineNumaNodes() {
+  // e.g. "0-1" or "0,2-3"
+  std::vector<int> node_ids;
+  std::ifstream file("/sys/devices/system/node/online");
+  std::string range;
+  while (std::getline(file, range, ',')) {
+    int first = 0, last = 0;
+    int n = std::sscanf(range.c_str(), "%d-%d", &first, &last);
+    if (n == 1) {
+      last = first;
+    } else if (n != 2) {
+      continue;
+    }
+    for (int id = first; id <= last; id++) {
+      node_ids.push_back(id);
+    }
+  }
+
+  if (node_ids.empty()) {
+    node_ids.push_back(-1);
+  }
+  return node_ids;
+}
+
+PagePool::Shard* PagePool::CurrentShard() {
+  int cpu = sched_getcpu();
+  if (cpu < 0) {
+    cpu = 0;
+  }
+  return shards_[cpu % shards_.size()].get();
+}
+
+char* PagePool::PopShard(Shard* shard) {
+  std::unique_lock<std::mutex> lk(shard->mutex, std::try_to_lock);
+  if (!lk.owns_lock()) {
+    num_shard_contentions_ << 1;
+    lk.lock();
+  }
+
+  if (shard->pages.empty()) {
+    return nullptr;
+  }
+  char* page = shard->pages.back();
+  shard->pages.pop_back();
+  return page;
+}
+
+void PagePool::PushShard(Shard* shard, char* page) {
+  std::vector<char*> overflow;
+  {
+    std::unique_lock<std::mutex> lk(shard->mutex, std::try_to_lock);
+    if (!lk.owns_lock()) {
+      num_shard_contentions_ << 1;
+      lk.lock();
+    }
+
+    shard->pages.push_back(page);
+    if (shard->pages.size() > shard_capacity_) {
+      uint64_t n = std::min<uint64_t>(batch_size_, shard->pages.size());
+      overflow.assign(shard->pages.end() - n, shard->pages.end());
+      shard->pages.resize(shard->pages.size() - n);
+    }
+  }
+
+  for (char* p : overflow) {
+    PushNode(p);
+  }
+}
+
+char* PagePool::Steal() {
+  for (auto& shard : shards_) {
+    char* page = PopShard(shard.get());
+    if (page != nullptr) {
+      num_steals_ << 1;
+      return page;
+    }
+  }
+  return nullptr;
+}
+
+char* PagePool::Refill(Shard* shard) {
+  // prefer the pages of current numa node
+  size_t start = 0;
+  unsigned int cpu = 0, node_id = 0;
+  if (nodes_.size() > 1 && syscall(SYS_getcpu, &cpu, &node_id, nullptr) == 0) {
+    for (size_t i = 0; i < nodes_.size(); i++) {
+      if (nodes_[i]->id == static_cast<int>(node_id)) {
+        start = i;
+        break;
+      }
+    }
+  }
+
+  std::vector<char*> pages;
+  for (size_t i = 0; i < nodes_.size() && pages.empty(); i++) {
+    Node* node = nodes_[(start + i) % nodes_.size()].get();
+    std::lock_guard<std::mutex> lk(node->mutex);
+    while (pages.size() < batch_size_) {
+      void* page = node->mem_pool->Allocate();
+      if (page == nullptr) {
+        break;
+      }
+      pages.push_back(reinterpret_cast<char*>(page));
+    }
+  }
+
+  if (pages.empty()) {
+    return nullptr;
+  }
+
+  num_refills_ << 1;
+  char* page = pages.back();
+  pages.pop_back();
+  if (!pages.empty()) {
+    std::lock_guard<std::mutex> lk(shard->mutex);
+    shard->pages.insert(shard->pages.end(), pages.begin(), pages.end());
+  }
+  return page;
+}
+
+void PagePool::PushNode(char* page) {
+  for (auto& node : nodes_) {
+    if (node->mem_pool->Contains(page)) {
+      std::lock_guard<std::mutex> lk(node->mutex);
+      node->mem_pool->DeAllocate(reinterpret_cast<void*>(page));
+      return;
+    }
+  }
+  CHECK(false) << "The page is not allocated by page pool.";
+}
+
+char* PagePool::WaitPage() {
+  butil::Timer timer;
+  timer.start();
+
+  char* page = nullptr;
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    num_waiters_.fetch_add(1);
+    while ((page = Refill(CurrentShard())) == nullptr &&
+           (page = Steal()) == nullptr) {
+      can_allocate_.wait(lk);
+    }
+    num_waiters_.fetch_sub(1);
+  }
+
+  timer.stop();
+  wait_latency_ << timer.u_elapsed();
+  return page;
 }
 
 }  // namespace datastream
@@ -23,10 +23,15 @@
 #ifndef DINGOFS_SRC_CLIENT_DATASTREAM_PAGE_ALLOCATOR_H_
 #define DINGOFS_SRC_CLIENT_DATASTREAM_PAGE_ALLOCATOR_H_
 
+#include <bvar/bvar.h>
 #include <sys/types.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "client/datastream/memory_pool.h"
 
@@ -40,6 +45,9 @@ class PageAllocator {
 
   virtual char* Allocate() = 0;
 
+  // Return nullptr rather than waiting if all pages are in use
+  virtual char* TryAllocate() = 0;
+
   virtual void DeAllocate(char* page) = 0;
 
   virtual uint64_t GetFreePages() = 0;
@@ -55,6 +63,8 @@ class DefaultPageAllocator : public PageAllocator {
 
   char* Allocate() override;
 
+  char* TryAllocate() override;
+
   void DeAllocate(char* page) override;
 
   uint64_t GetFreePages() override;
@@ -66,27 +76,87 @@ class DefaultPageAllocator : public PageAllocator {
   std::condition_variable can_allocate_;
 };
 
+struct PagePoolOption {
+  uint32_t num_shards = 0;  // 0 means the number of cpus
+  bool use_hugepage = true;
+  bool numa_aware = false;
+};
+
+// The page pool which is sharded by cpu to reduce lock contention:
+//
+//   * every shard caches a few free pages, the allocation and deallocation
+//     on the same cpu only touch the shard's lock;
+//   * the shard refills (or flushes) a batch of pages from (or to) the
+//     global memory pools, which are one per numa node if |numa_aware|,
+//     and the pages of the caller's node are preferred;
+//   * the caller waits only if all of the pages are in use, and it's
+//     woken up by the next deallocation.
 class PagePool : public PageAllocator {
  public:
   PagePool();
 
+  explicit PagePool(PagePoolOption option);
+
   virtual ~PagePool();
 
   bool Init(uint64_t page_size, uint64_t num_pages) override;
 
   char* Allocate() override;
 
+  char* TryAllocate() override;
+
   void DeAllocate(char* p) override;
 
   uint64_t GetFreePages() override;
 
  private:
+  struct Node {
+    int id;  // numa node id, -1 if it's not numa aware
+    std::mutex mutex;
+    std::unique_ptr<MemoryPool> mem_pool;
+  };
+
+  struct alignas(64) Shard {
+    std::mutex mutex;
+    std::vector<char*> pages;
+  };
+
+  static std::vector<int> OnlineNumaNodes();
+
+  Shard* CurrentShard();
+
+  // shard
+  char* PopShard(Shard* shard);
+
+  void PushShard(Shard* shard, char* page);
+
+  char* Steal();
+
+  // global memory pools
+  char* Refill(Shard* shard);
+
+  void PushNode(char* page);
+
+  char* WaitPage();
+
+ private:
+  PagePoolOption option_;
   uint64_t page_size_;
-  uint64_t num_free_pages_;
-  // TODO: use multi-slots or thread local to reduce mutex overhead
+  uint64_t shard_capacity_;  // max cached pages of each shard
+  uint64_t batch_size_;      // pages for each refill and flush
+  std::atomic<uint64_t> num_free_pages_;
+  std::vector<std::unique_ptr<Node>> nodes_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  // for waiting when all pages are in use
   std::mutex mutex_;
   std::condition_variable can_allocate_;
-  std::unique_ptr<MemoryPool> mem_pool_;
+  std::atomic<uint32_t> num_waiters_;
+
+  bvar::Adder<uint64_t> num_shard_contentions_;
+  bvar::Adder<uint64_t> num_refills_;
+  bvar::Adder<uint64_t> num_steals_;
+  bvar::LatencyRecorder wait_latency_;
 };
 
 }  // namespace datastream
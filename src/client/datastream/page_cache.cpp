@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/datastream/page_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dingofs {
+namespace client {
+namespace datastream {
+
+static uint64_t Mix(uint64_t x) {
+  x = (x ^ (x >> 33)) * 0xff51afd7ed558ccdULL;
+  x = (x ^ (x >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+  return x ^ (x >> 33);
+}
+
+size_t PageKeyHash::operator()(const PageKey& key) const {
+  uint64_t h = Mix(key.ino);
+  h = Mix(h ^ key.chunk_index);
+  h = Mix(h ^ key.page_index);
+  return h;
+}
+
+PageCache::PageCache(PageCacheOption option)
+    : option_(option),
+      num_hits_("dingofs_page_cache", "hits"),
+      num_misses_("dingofs_page_cache", "misses"),
+      num_evicts_("dingofs_page_cache", "evicts"),
+      num_pages_("dingofs_page_cache", "pages") {
+  option_.num_shards = std::max(option_.num_shards, 1U);
+  shard_capacity_ = std::max<uint64_t>(
+      1, option_.capacity / option_.page_size / option_.num_shards);
+  for (uint32_t i = 0; i < option_.num_shards; i++) {
+    shards_.emplace_back(std::make_unique<Shard>());
+  }
+}
+
+PageCache::Shard* PageCache::GetShard(const PageKey& key) {
+  // the low bits of hash are taken by the hash table of shard
+  uint64_t h = PageKeyHash()(key);
+  return shards_[(h >> 32) % shards_.size()].get();
+}
+
+bool PageCache::Get(const PageKey& key, uint64_t version, uint64_t offset,
+                    uint64_t length, char* buffer) {
+  auto* shard = GetShard(key);
+  std::lock_guard<std::mutex> lk(shard->mutex);
+  auto iter = shard->index.find(key);
+  if (iter == shard->index.end()) {
+    num_misses_ << 1;
+    return false;
+  }
+
+  size_t slot = iter->second;
+  auto& page = shard->slots[slot];
+  if (page.version != version) {  // the chunk has changed
+    shard->index.erase(iter);
+    shard->free_slots.push_back(slot);
+    num_pages_ << -1;
+    num_misses_ << 1;
+    return false;
+  } else if (offset + length > page.length) {
+    num_misses_ << 1;
+    return false;
+  }
+
+  std::memcpy(buffer, page.data.get() + offset, length);
+  page.referenced = true;
+  num_hits_ << 1;
+  return true;
+}
+
+void PageCache::Put(const PageKey& key, uint64_t version, const char* data,
+                    uint64_t length) {
+  length = std::min(length, option_.page_size);
+  auto* shard = GetShard(key);
+  std::lock_guard<std::mutex> lk(shard->mutex);
+  size_t slot;
+  auto iter = shard->index.find(key);
+  if (iter != shard->index.end()) {
+    slot = iter->second;
+  } else {
+    slot = Evict(shard);
+    shard->index.emplace(key, slot);
+    num_pages_ << 1;
+  }
+
+  auto& page = shard->slots[slot];
+  if (page.data == nullptr) {
+    page.data.reset(new char[option_.page_size]);
+  }
+  page.key = key;
+  page.version = version;
+  page.length = length;
+  page.referenced = false;
+  std::memcpy(page.data.get(), data, length);
+}
+
+size_t PageCache::Evict(Shard* shard) {
+  if (!shard->free_slots.empty()) {
+    size_t slot = shard->free_slots.back();
+    shard->free_slots.pop_back();
+    return slot;
+  } else if (shard->slots.size() < shard_capacity_) {
+    shard->slots.emplace_back(Page{PageKey{}, 0, 0, nullptr, false});
+    return shard->slots.size() - 1;
+  }
+
+  // give the referenced pages a second chance, it ends within 2 rounds
+  while (true) {
+    size_t slot = shard->hand;
+    shard->hand = (shard->hand + 1) % shard->slots.size();
+    auto& page = shard->slots[slot];
+    if (page.referenced) {
+      page.referenced = false;
+      continue;
+    }
+
+    shard->index.erase(page.key);
+    num_pages_ << -1;
+    num_evicts_ << 1;
+    return slot;
+  }
+}
+
+uint64_t PageCache::Size() {
+  uint64_t size = 0;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lk(shard->mutex);
+    size += shard->index.size();
+  }
+  return size * option_.page_size;
+}
+
+}  // namespace datastream
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_DATASTREAM_PAGE_CACHE_H_
+#define DINGOFS_SRC_CLIENT_DATASTREAM_PAGE_CACHE_H_
+
+#include <bvar/bvar.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace dingofs {
+namespace client {
+namespace datastream {
+
+struct PageCacheOption {
+  uint64_t capacity = 0;  // bytes, 0 means disabled
+  uint64_t page_size = 64 * 1024;
+  uint32_t num_shards = 16;
+};
+
+struct PageKey {
+  uint64_t ino;
+  uint64_t chunk_index;
+  uint64_t page_index;  // page in chunk
+
+  bool operator==(const PageKey& other) const {
+    return ino == other.ino && chunk_index == other.chunk_index &&
+           page_index == other.page_index;
+  }
+};
+
+struct PageKeyHash {
+  size_t operator()(const PageKey& key) const;
+};
+
+// The memory cache of clean file pages shared by all files, which serves
+// the hot reads without touching block cache or disk.
+//
+// Every page is tagged by the |version| of its chunk data when it's read,
+// the lookup with another version misses, so a page is never stale once
+// the chunk changes. The cache is sharded by key, and the pages of each
+// shard are evicted by CLOCK: the hand clears the referenced bit of
+// recently used pages and evicts the first page which isn't referenced.
+class PageCache {
+ public:
+  explicit PageCache(PageCacheOption option);
+
+  uint64_t PageSize() const { return option_.page_size; }
+
+  // Copy [offset, offset + length) of page into |buffer|
+  bool Get(const PageKey& key, uint64_t version, uint64_t offset,
+           uint64_t length, char* buffer);
+
+  // The |length| is less than page size only for the last page of file
+  void Put(const PageKey& key, uint64_t version, const char* data,
+           uint64_t length);
+
+  uint64_t Size();
+
+ private:
+  struct Page {
+    PageKey key;
+    uint64_t version;
+    uint64_t length;
+    std::unique_ptr<char[]> data;
+    bool referenced;
+  };
+
+  struct alignas(64) Shard {
+    std::mutex mutex;
+    std::unordered_map<PageKey, size_t, PageKeyHash> index;  // key -> slot
+    std::vector<Page> slots;
+    std::vector<size_t> free_slots;  // the slots of dropped pages
+    size_t hand{0};
+  };
+
+  Shard* GetShard(const PageKey& key);
+
+  // Return a free slot of shard, evict one page if it's full
+  size_t Evict(Shard* shard);
+
+ private:
+  PageCacheOption option_;
+  size_t shard_capacity_;  // max pages of each shard
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+  bvar::Adder<uint64_t> num_hits_;
+  bvar::Adder<uint64_t> num_misses_;
+  bvar::Adder<uint64_t> num_evicts_;
+  bvar::Adder<int64_t> num_pages_;
+};
+
+}  // namespace datastream
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_DATASTREAM_PAGE_CACHE_H_
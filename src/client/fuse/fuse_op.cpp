@@ -25,15 +25,21 @@
 #include <string>
 
 #include "client/common/status.h"
+#include "client/fuse/read_buffer_pool.h"
 #include "client/vfs/vfs_meta.h"
 #include "client/vfs_wrapper/vfs_wrapper.h"
 #include "utils/configuration.h"
 
 static dingofs::client::vfs::VFSWrapper* g_vfs = nullptr;
 
+// the reply data is written to /dev/fuse by splice
+static bool g_splice_write = false;
+
 using dingofs::client::Status;
+using dingofs::client::fuse::ReadBuffer;
 using dingofs::client::vfs::Attr;
 using dingofs::client::vfs::FsStat;
+using dingofs::client::vfs::SpliceBuffer;
 
 namespace {
 
@@ -132,12 +138,27 @@ void ReplyCreate(fuse_req_t req, struct fuse_file_info* fi, const Attr& attr) {
   fuse_reply_create(req, &e, fi);
 }
 
+// NOTE: the single memory buffer is written to /dev/fuse with the reply
+// header by writev(), so it's not copied, and it's safe to reuse the buffer
+// once this returns (the pages are never gifted to the pipe).
 static void ReplyData(fuse_req_t req, char* buffer, size_t size) {
   struct fuse_bufvec bufvec = FUSE_BUFVEC_INIT(size);
   bufvec.buf[0].mem = buffer;
   fuse_reply_data(req, &bufvec, FUSE_BUF_SPLICE_MOVE);
 }
 
+// NOTE: the range of file is spliced to /dev/fuse through a pipe within
+// fuse_reply_data(), the data is never copied into user space, so the
+// file must be kept open until this returns.
+static void ReplySplice(fuse_req_t req, const SpliceBuffer& buffer) {
+  struct fuse_bufvec bufvec = FUSE_BUFVEC_INIT(buffer.size);
+  bufvec.buf[0].flags =
+      static_cast<fuse_buf_flags>(FUSE_BUF_IS_FD | FUSE_BUF_FD_SEEK);
+  bufvec.buf[0].fd = buffer.fd;
+  bufvec.buf[0].pos = buffer.offset;
+  fuse_reply_data(req, &bufvec, FUSE_BUF_SPLICE_MOVE);
+}
+
 static void ReplyWrite(fuse_req_t req, size_t size) {
   fuse_reply_write(req, size);
 }
@@ -227,6 +248,7 @@ void FuseOpInit(void* userdata, struct fuse_conn_info* conn) {
   if (g_vfs->EnableSplice()) {
     VLOG(1) << "Enable splice";
     EnableSplice(conn);
+    g_splice_write = (conn->want & FUSE_CAP_SPLICE_WRITE) != 0;
   }
 
   g_vfs->Init();
@@ -396,15 +418,28 @@ void FuseOpRead(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
                 struct fuse_file_info* fi) {
   VLOG(1) << "FuseOpRead inodeId=" << ino << ", size: " << size
           << ", offset: " << off << ", fi->fh: " << fi->fh;
-  std::unique_ptr<char[]> buffer(new char[size]);
-  memset(buffer.get(), 0, size);
+  if (g_splice_write) {
+    SpliceBuffer splice;
+    Status s = g_vfs->ReadSplice(ino, size, off, fi->fh, &splice);
+    if (s.ok()) {
+      ReplySplice(req, splice);
+      splice.release();
+      return;
+    } else if (!s.IsNotSupport()) {
+      ReplyError(req, s);
+      return;
+    }
+  }
+
+  // the buffer is not zeroed, only [0, rsize) is filled and replied
+  ReadBuffer buffer(size);
 
   uint64_t rsize = 0;
-  Status s = g_vfs->Read(ino, buffer.get(), size, off, fi->fh, &rsize);
+  Status s = g_vfs->Read(ino, buffer.Data(), size, off, fi->fh, &rsize);
   if (!s.ok()) {
     ReplyError(req, s);
   } else {
-    ReplyData(req, buffer.get(), rsize);
+    ReplyData(req, buffer.Data(), rsize);
   }
 }
 
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/fuse/read_buffer_pool.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "client/common/dynamic_config.h"
+
+namespace dingofs {
+namespace client {
+namespace fuse {
+
+USING_FLAG(fuse_read_buffer_pool_max_mb);
+
+// The buffers cached by current thread, which are returned to the
+// shared free lists when the thread exits. They are counted in the
+// cached bytes of pool as well.
+struct ThreadCache {
+  ~ThreadCache() {
+    auto& pool = ReadBufferPool::GetInstance();
+    for (size_t i = 0; i < ReadBufferPool::kNumClasses; i++) {
+      for (char* buffer : free_lists[i]) {
+        pool.Push(i, buffer);
+      }
+    }
+  }
+
+  static size_t Capacity(size_t size_class) {
+    return std::max<size_t>(1, ReadBufferPool::kThreadCacheBytes /
+                                   ReadBufferPool::ClassSize(size_class));
+  }
+
+  std::array<std::vector<char*>, ReadBufferPool::kNumClasses> free_lists;
+};
+
+static thread_local ThreadCache thread_cache;
+
+// NOTE: the pool is never destroyed, because the thread caches
+// may be released after static objects at exit.
+ReadBufferPool& ReadBufferPool::GetInstance() {
+  static auto* pool = new ReadBufferPool();
+  return *pool;
+}
+
+ReadBufferPool::ReadBufferPool()
+    : cached_bytes_(0),
+      num_thread_cache_hits_("dingofs_fuse_read_buffer_pool",
+                             "thread_cache_hits"),
+      num_shared_hits_("dingofs_fuse_read_buffer_pool", "shared_hits"),
+      num_misses_("dingofs_fuse_read_buffer_pool", "misses"),
+      in_use_bytes_("dingofs_fuse_read_buffer_pool", "in_use_bytes"),
+      shared_cached_bytes_("dingofs_fuse_read_buffer_pool",
+                           "shared_cached_bytes") {}
+
+size_t ReadBufferPool::SizeClass(size_t size) {
+  size_t size_class = 0;
+  for (size_t class_size = kMinClassSize; class_size < size;
+       class_size <<= 1) {
+    size_class++;
+  }
+  return std::min(size_class, kNumClasses);
+}
+
+size_t ReadBufferPool::ClassSize(size_t size_class) {
+  return kMinClassSize << size_class;
+}
+
+char* ReadBufferPool::NewBuffer(size_t size) {
+  size = (size + kAlignment - 1) / kAlignment * kAlignment;
+  void* buffer = std::aligned_alloc(kAlignment, size);
+  if (buffer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return static_cast<char*>(buffer);
+}
+
+void ReadBufferPool::DeleteBuffer(char* buffer) { std::free(buffer); }
+
+char* ReadBufferPool::Allocate(size_t size) {
+  in_use_bytes_ << static_cast<int64_t>(size);
+  size_t size_class = SizeClass(size);
+  if (size_class == kNumClasses) {  // not pooled
+    num_misses_ << 1;
+    return NewBuffer(size);
+  }
+
+  auto& free_list = thread_cache.free_lists[size_class];
+  if (!free_list.empty()) {
+    char* buffer = free_list.back();
+    free_list.pop_back();
+    Unreserve(ClassSize(size_class));
+    num_thread_cache_hits_ << 1;
+    return buffer;
+  }
+
+  char* buffer = Pop(size_class);
+  if (buffer != nullptr) {
+    num_shared_hits_ << 1;
+    return buffer;
+  }
+
+  num_misses_ << 1;
+  return NewBuffer(ClassSize(size_class));
+}
+
+void ReadBufferPool::Deallocate(char* buffer, size_t size) {
+  in_use_bytes_ << -static_cast<int64_t>(size);
+  size_t size_class = SizeClass(size);
+  if (size_class == kNumClasses || !Reserve(ClassSize(size_class))) {
+    DeleteBuffer(buffer);
+    return;
+  }
+
+  auto& free_list = thread_cache.free_lists[size_class];
+  if (free_list.size() < ThreadCache::Capacity(size_class)) {
+    free_list.push_back(buffer);
+    return;
+  }
+  Push(size_class, buffer);
+}
+
+bool ReadBufferPool::Reserve(size_t bytes) {
+  uint64_t limit = FLAGS_fuse_read_buffer_pool_max_mb * 1024 * 1024;
+  uint64_t cached = cached_bytes_.load(std::memory_order_relaxed);
+  do {
+    if (cached + bytes > limit) {
+      return false;
+    }
+  } while (!cached_bytes_.compare_exchange_weak(cached, cached + bytes,
+                                                std::memory_order_relaxed));
+  return true;
+}
+
+void ReadBufferPool::Unreserve(size_t bytes) {
+  cached_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+char* ReadBufferPool::Pop(size_t size_class) {
+  char* buffer;
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto& free_list = free_lists_[size_class];
+    if (free_list.empty()) {
+      return nullptr;
+    }
+    buffer = free_list.back();
+    free_list.pop_back();
+  }
+
+  Unreserve(ClassSize(size_class));
+  shared_cached_bytes_ << -static_cast<int64_t>(ClassSize(size_class));
+  return buffer;
+}
+
+void ReadBufferPool::Push(size_t size_class, char* buffer) {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    free_lists_[size_class].push_back(buffer);
+  }
+  shared_cached_bytes_ << static_cast<int64_t>(ClassSize(size_class));
+}
+
+uint64_t ReadBufferPool::CachedBytes() {
+  return cached_bytes_.load(std::memory_order_relaxed);
+}
+
+ReadBuffer::ReadBuffer(size_t size)
+    : data_(ReadBufferPool::GetInstance().Allocate(size)), size_(size) {}
+
+ReadBuffer::~ReadBuffer() {
+  ReadBufferPool::GetInstance().Deallocate(data_, size_);
+}
+
+}  // namespace fuse
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_FUSE_READ_BUFFER_POOL_H_
+#define DINGOFS_SRC_CLIENT_FUSE_READ_BUFFER_POOL_H_
+
+#include <bvar/bvar.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace dingofs {
+namespace client {
+namespace fuse {
+
+// The pool of fuse read buffers, which saves the allocation (and zeroing)
+// of a new buffer for every read request.
+//
+// Buffers are grouped into power-of-two size classes from 4KiB to 1MiB,
+// the larger ones are not pooled. Every thread keeps a few buffers of
+// each class to reuse without lock, the surplus goes to the shared free
+// lists. The idle buffers, both in thread caches and shared free lists,
+// hold at most |FLAGS_fuse_read_buffer_pool_max_mb|.
+//
+// NOTE: the buffer is NOT zeroed, the reader must fill every byte
+// it returns (holes are zeroed by the read path).
+class ReadBufferPool {
+ public:
+  static constexpr size_t kMinClassSize = 4 * 1024;
+  static constexpr size_t kMaxClassSize = 1024 * 1024;
+  static constexpr size_t kNumClasses = 9;  // 4KiB, 8KiB, ..., 1MiB
+  static constexpr size_t kThreadCacheBytes = 4 * 1024 * 1024;
+  static constexpr size_t kAlignment = 4096;
+
+ public:
+  static ReadBufferPool& GetInstance();
+
+  char* Allocate(size_t size);
+
+  // The |size| must be the same as the one passed to Allocate()
+  void Deallocate(char* buffer, size_t size);
+
+  uint64_t CachedBytes();
+
+  // Return the size class of |size|, or kNumClasses if it's not pooled
+  static size_t SizeClass(size_t size);
+
+  static size_t ClassSize(size_t size_class);
+
+ private:
+  friend struct ThreadCache;
+
+  ReadBufferPool();
+
+  static char* NewBuffer(size_t size);
+
+  static void DeleteBuffer(char* buffer);
+
+  // Account the idle buffer against the limit, returns false if exceeded
+  bool Reserve(size_t bytes);
+
+  void Unreserve(size_t bytes);
+
+  // shared free lists, the buffer pushed must be reserved
+  char* Pop(size_t size_class);
+
+  void Push(size_t size_class, char* buffer);
+
+ private:
+  std::mutex mutex_;  // protect free_lists_
+  std::array<std::vector<char*>, kNumClasses> free_lists_;
+  std::atomic<uint64_t> cached_bytes_;  // idle bytes, include thread caches
+
+  bvar::Adder<uint64_t> num_thread_cache_hits_;
+  bvar::Adder<uint64_t> num_shared_hits_;
+  bvar::Adder<uint64_t> num_misses_;
+  bvar::Adder<int64_t> in_use_bytes_;
+  bvar::Adder<int64_t> shared_cached_bytes_;
+};
+
+// The buffer which goes back to pool on destruction
+class ReadBuffer {
+ public:
+  explicit ReadBuffer(size_t size);
+
+  ~ReadBuffer();
+
+  ReadBuffer(const ReadBuffer&) = delete;
+  ReadBuffer& operator=(const ReadBuffer&) = delete;
+
+  char* Data() { return data_; }
+
+  size_t Size() const { return size_; }
+
+ private:
+  char* data_;
+  size_t size_;
+};
+
+}  // namespace fuse
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_FUSE_READ_BUFFER_POOL_H_
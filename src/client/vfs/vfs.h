@@ -84,6 +84,12 @@ class VFS {
   virtual Status Read(Ino ino, char* buf, uint64_t size, uint64_t offset,
                       uint64_t fh, uint64_t* out_rsize) = 0;
 
+  // Read without copying: the |buffer| refers to the file which holds the
+  // whole range on local disk, it returns NotSupport if there is no such
+  // file, then the caller should fall back to Read().
+  virtual Status ReadSplice(Ino ino, uint64_t size, uint64_t offset,
+                            uint64_t fh, SpliceBuffer* buffer) = 0;
+
   virtual Status Write(Ino ino, const char* buf, uint64_t size, uint64_t offset,
                        uint64_t fh, uint64_t* out_wsize) = 0;
 
@@ -18,6 +18,7 @@
 #define DINGOFS_CLIENT_VFS_CONTEXT_H_
 
 #include <cstdint>
+#include <functional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -118,6 +119,15 @@ static std::string FsStat2Str(const FsStat& fs_stat) {
   return oss.str();
 }
 
+// The data of read which is held by a file on local disk, it's replied by
+// splicing [offset, offset + size) of the file instead of copying it.
+struct SpliceBuffer {
+  int fd{-1};
+  uint64_t offset{0};  // offset in file
+  uint64_t size{0};
+  std::function<void()> release;  // called once the data is replied
+};
+
 // map pb chunkinfo
 struct Slice {
   uint64_t id;          // slice id map to old pb chunkid
@@ -65,6 +65,8 @@ class RenameOperator {
   void GetOldInode(uint64_t* old_inode_id, int64_t* old_inode_size,
                    pb::metaserver::FsFileType* old_inode_type);
 
+  uint64_t GetSrcInodeId() const { return srcDentry_.inodeid(); }
+
   // related to quota and stat
   void UpdateSrcDirUsage(std::shared_ptr<filesystem::FileSystem>& fs);
   void RollbackUpdateSrcDirUsage(std::shared_ptr<filesystem::FileSystem>& fs);
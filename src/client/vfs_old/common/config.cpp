@@ -96,6 +96,28 @@ void InitS3Option(Configuration* conf, S3Option* s3Opt) {
                             &s3Opt->s3ClientAdaptorOpt.prefetchBlocks);
   conf->GetValueFatalIfFail("s3.prefetchExecQueueNum",
                             &s3Opt->s3ClientAdaptorOpt.prefetchExecQueueNum);
+  conf->GetValueFatalIfFail("s3.readaheadMaxBlocks",
+                            &s3Opt->s3ClientAdaptorOpt.readaheadMaxBlocks);
+  conf->GetValueFatalIfFail("s3.readaheadMaxMemoryByte",
+                            &s3Opt->s3ClientAdaptorOpt.readaheadMaxMemoryByte);
+  conf->GetValueFatalIfFail(
+      "s3.readaheadMaxBandwidthByte",
+      &s3Opt->s3ClientAdaptorOpt.readaheadMaxBandwidthByte);
+  conf->GetValueFatalIfFail("s3.readaheadIdleTimeoutMs",
+                            &s3Opt->s3ClientAdaptorOpt.readaheadIdleTimeoutMs);
+  conf->GetValueFatalIfFail("s3.readMergeGapByte",
+                            &s3Opt->s3ClientAdaptorOpt.readMergeGapByte);
+  conf->GetValueFatalIfFail("s3.readSplitByte",
+                            &s3Opt->s3ClientAdaptorOpt.readSplitByte);
+  conf->GetValueFatalIfFail("s3.readMaxInflightRanges",
+                            &s3Opt->s3ClientAdaptorOpt.readMaxInflightRanges);
+  conf->GetValueFatalIfFail("s3.writeMergeGapByte",
+                            &s3Opt->s3ClientAdaptorOpt.writeMergeGapByte);
+  LOG_IF(WARNING, !conf->GetBoolValue(
+                      "s3.writeAlignBlock",
+                      &s3Opt->s3ClientAdaptorOpt.writeAlignBlock))
+      << "Not found `s3.writeAlignBlock` in conf, use default value `"
+      << std::boolalpha << s3Opt->s3ClientAdaptorOpt.writeAlignBlock << '`';
   conf->GetValueFatalIfFail("data_stream.background_flush.interval_ms",
                             &s3Opt->s3ClientAdaptorOpt.intervalMs);
   conf->GetValueFatalIfFail("data_stream.slice.stay_in_memory_max_second",
@@ -161,6 +183,8 @@ void InitRefreshDataOpt(Configuration* conf, RefreshDataOption* opt) {
 
 void InitKVClientManagerOpt(Configuration* conf, KVClientManagerOpt* config) {
   conf->GetValueFatalIfFail("fuseClient.supportKVcache", &FLAGS_supportKVcache);
+  conf->GetValueFatalIfFail("fuseClient.memcacheBinaryProtocol",
+                            &FLAGS_memcacheBinaryProtocol);
   conf->GetValueFatalIfFail("fuseClient.setThreadPool",
                             &config->setThreadPooln);
   conf->GetValueFatalIfFail("fuseClient.getThreadPool",
@@ -191,6 +215,11 @@ void InitFileSystemOption(Configuration* c, FileSystemOption* option) {
                            &o->negativeTimeoutSec);
     c->GetValueFatalIfFail("fs.lookupCache.minUses", &o->minUses);
   }
+  {  // entry cache option
+    auto o = &option->entryCacheOption;
+    c->GetValueFatalIfFail("fs.entryCache.leaseSec", &o->leaseSec);
+    c->GetValueFatalIfFail("fs.entryCache.capacityMB", &o->capacityMB);
+  }
   {  // dir cache option
     auto o = &option->dirCacheOption;
     c->GetValueFatalIfFail("fs.dirCache.lruSize", &o->lruSize);
@@ -237,11 +266,35 @@ void InitDataStreamOption(Configuration* c, DataStreamOption* option) {
     c->GetValueFatalIfFail("data_stream.slice.flush_queue_size",
                            &o->flush_queue_size);
   }
+  {  // writeback option
+    auto* o = &option->writeback_option;
+    c->GetValueFatalIfFail("data_stream.writeback.max_inflight_mb",
+                           &o->max_inflight_bytes);
+    c->GetValueFatalIfFail("data_stream.writeback.max_inode_inflight_mb",
+                           &o->max_inode_inflight_bytes);
+    o->max_inflight_bytes = o->max_inflight_bytes * kMiB;
+    o->max_inode_inflight_bytes = o->max_inode_inflight_bytes * kMiB;
+  }
+  {  // read cache option
+    auto* o = &option->read_cache_option;
+    c->GetValueFatalIfFail("data_stream.read_cache.capacity_mb",
+                           &o->capacity);
+    c->GetValueFatalIfFail("data_stream.read_cache.page_size", &o->page_size);
+    c->GetValueFatalIfFail("data_stream.read_cache.num_shards",
+                           &o->num_shards);
+    o->capacity = o->capacity * kMiB;
+    if (o->capacity > 0 && o->page_size == 0) {
+      CHECK(false) << "Read cache page size must greater than 0.";
+    }
+  }
   {  // page option
     auto* o = &option->page_option;
     c->GetValueFatalIfFail("data_stream.page.size", &o->page_size);
     c->GetValueFatalIfFail("data_stream.page.total_size_mb", &o->total_size);
     c->GetValueFatalIfFail("data_stream.page.use_pool", &o->use_pool);
+    c->GetValueFatalIfFail("data_stream.page.num_shards", &o->num_shards);
+    c->GetValueFatalIfFail("data_stream.page.use_hugepage", &o->use_hugepage);
+    c->GetValueFatalIfFail("data_stream.page.numa_aware", &o->numa_aware);
 
     if (o->page_size == 0) {
       CHECK(false) << "Page size must greater than 0.";
@@ -298,6 +351,12 @@ void InitBlockCacheOption(Configuration* c, BlockCacheOption* option) {
                            &option->upload_stage_workers);
     c->GetValueFatalIfFail("block_cache.upload_stage_queue_size",
                            &option->upload_stage_queue_size);
+    c->GetValueFatalIfFail("block_cache.cache_fill_workers",
+                           &option->cache_fill_workers);
+    c->GetValueFatalIfFail("block_cache.cache_fill_queue_size",
+                           &option->cache_fill_queue_size);
+    c->GetValueFatalIfFail("block_cache.cache_fill_bandwidth_mb",
+                           &FLAGS_block_cache_fill_bandwidth_mb);
     c->GetValueFatalIfFail("block_cache.cache_store", &option->cache_store);
     if (option->cache_store != "none" && option->cache_store != "disk") {
       CHECK(false) << "Only support disk or none cache store.";
@@ -308,6 +367,10 @@ void InitBlockCacheOption(Configuration* c, BlockCacheOption* option) {
     DiskCacheOption o;
     c->GetValueFatalIfFail("disk_cache.cache_dir", &o.cache_dir);
     c->GetValueFatalIfFail("disk_cache.cache_size_mb", &o.cache_size);
+    c->GetValueFatalIfFail("disk_cache.segment_size_mb", &o.segment_size);
+    o.segment_size = o.segment_size * kMiB;
+    c->GetValueFatalIfFail("disk_cache.io_uring_depth", &o.io_uring_depth);
+    c->GetValueFatalIfFail("disk_cache.cache_policy", &o.cache_policy);
     c->GetValueFatalIfFail("disk_cache.free_space_ratio",
                            &FLAGS_disk_cache_free_space_ratio);
     c->GetValueFatalIfFail("disk_cache.cache_expire_second",
@@ -317,11 +380,34 @@ void InitBlockCacheOption(Configuration* c, BlockCacheOption* option) {
         &FLAGS_disk_cache_cleanup_expire_interval_millsecond);
     c->GetValueFatalIfFail("disk_cache.drop_page_cache",
                            &FLAGS_drop_page_cache);
+    c->GetValueFatalIfFail("disk_cache.load_threads",
+                           &FLAGS_disk_cache_load_threads);
+    c->GetValueFatalIfFail("disk_cache.persist_index",
+                           &FLAGS_disk_cache_persist_index);
     if (option->cache_store == "disk") {
       SplitDiskCacheOption(o, &option->disk_cache_options);
     }
   }
 
+  {  // memory cache option
+    uint64_t cache_size_mb;
+    c->GetValueFatalIfFail("mem_cache.cache_size_mb", &cache_size_mb);
+    option->mem_cache_option.cache_size = cache_size_mb * kMiB;
+  }
+
+  {  // cache group option
+    auto* o = &option->cache_group_option;
+    std::string peers;
+    c->GetValueFatalIfFail("cache_group.enable", &o->enable);
+    c->GetValueFatalIfFail("cache_group.listen_address", &o->listen_address);
+    c->GetValueFatalIfFail("cache_group.peers", &peers);
+    c->GetValueFatalIfFail("cache_group.rpc_timeout_ms", &o->rpc_timeout_ms);
+    o->peers = StrSplit(peers, ",");
+    if (o->enable && option->cache_store == "none") {
+      CHECK(false) << "Cache group requires a cache store.";
+    }
+  }
+
   {  // disk state option
     c->GetValueFatalIfFail("disk_state.tick_duration_second",
                            &FLAGS_disk_state_tick_duration_second);
@@ -372,6 +458,10 @@ void InitFuseClientOption(Configuration* conf, FuseClientOption* clientOption) {
                             &clientOption->downloadMaxRetryTimes);
   conf->GetValueFatalIfFail("fuseClient.warmupThreadsNum",
                             &clientOption->warmupThreadsNum);
+  conf->GetValueFatalIfFail("fuseClient.warmupMaxInflightMB",
+                            &clientOption->warmupMaxInflightMB);
+  conf->GetValueFatalIfFail("fuseClient.warmupBandwidthMB",
+                            &clientOption->warmupBandwidthMB);
   LOG_IF(WARNING, conf->GetBoolValue("fuseClient.enableSplice",
                                      &clientOption->enableFuseSplice))
       << "Not found `fuseClient.enableSplice` in conf, use default value `"
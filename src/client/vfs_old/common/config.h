@@ -65,6 +65,15 @@ struct S3ClientAdaptorOption {
   uint64_t pageSize;
   uint32_t prefetchBlocks;
   uint32_t prefetchExecQueueNum;
+  uint32_t readaheadMaxBlocks = 32;
+  uint64_t readaheadMaxMemoryByte = 0;
+  uint64_t readaheadMaxBandwidthByte = 0;
+  uint32_t readaheadIdleTimeoutMs = 10000;
+  uint64_t readMergeGapByte = 0;
+  uint64_t readSplitByte = 0;
+  uint32_t readMaxInflightRanges = 16;
+  uint64_t writeMergeGapByte = 0;
+  bool writeAlignBlock = false;
   uint32_t intervalMs;
   uint32_t flushIntervalSec;
   uint64_t writeCacheMaxByte;
@@ -127,6 +136,11 @@ struct LookupCacheOption {
   uint32_t minUses;
 };
 
+struct EntryCacheOption {
+  uint32_t leaseSec;  // 0 means disable
+  uint64_t capacityMB;
+};
+
 struct DirCacheOption {
   uint64_t lruSize;
   uint32_t timeoutSec;
@@ -158,6 +172,7 @@ struct FileSystemOption {
   uint32_t blockSize = 0x10000u;
   KernelCacheOption kernelCacheOption;
   LookupCacheOption lookupCacheOption;
+  EntryCacheOption entryCacheOption;
   DirCacheOption dirCacheOption;
   OpenFilesOption openFilesOption;
   AttrWatcherOption attrWatcherOption;
@@ -190,6 +205,8 @@ struct FuseClientOption {
   bool enableFuseSplice = false;
   uint32_t downloadMaxRetryTimes;
   uint32_t warmupThreadsNum = 10;
+  uint64_t warmupMaxInflightMB = 256;  // window of warmup s3 gets
+  uint64_t warmupBandwidthMB = 0;      // 0 means unlimited
 };
 
 void InitFuseClientOption(utils::Configuration* conf,
@@ -67,6 +67,9 @@ DEFINE_bool(enableCto, true, "acheieve cto consistency");
 DEFINE_bool(useFakeS3, false,
             "Use fake s3 to inject more metadata for testing metaserver");
 DEFINE_bool(supportKVcache, false, "use kvcache to speed up sharing");
+DEFINE_bool(memcacheBinaryProtocol, true,
+            "use the binary protocol of memcached, which pipelines the gets "
+            "of a batch, for the connections created afterwards");
 
 /**
  * use curl -L fuseclient:port/flags/fuseClientAvgWriteBytes?setvalue=true
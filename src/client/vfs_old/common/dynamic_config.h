@@ -55,6 +55,7 @@ DECLARE_bool(useFakeS3);
 // ----- related fuse client -----
 DECLARE_bool(enableCto);
 DECLARE_bool(supportKVcache);
+DECLARE_bool(memcacheBinaryProtocol);
 
 DECLARE_uint64(fuseClientAvgWriteIops);
 DECLARE_uint64(fuseClientBurstWriteIops);
@@ -30,26 +30,22 @@ namespace client {
 namespace filesystem {
 
 using common::AttrWatcherOption;
-using utils::ReadLockGuard;
-using utils::RWLock;
-using utils::WriteLockGuard;
 
 using pb::metaserver::InodeAttr;
 
 AttrWatcher::AttrWatcher(AttrWatcherOption option,
                          std::shared_ptr<OpenFiles> openFiles,
                          std::shared_ptr<DirCache> dirCache)
-    : modifiedAt_(std::make_shared<LRUType>(option.lruSize)),
+    : modifiedAt_(std::make_shared<LRUType>(option.lruSize,
+                                                "filesystem_attrwatcher")),
       openFiles_(openFiles),
       dirCache_(dirCache) {}
 
 void AttrWatcher::RemeberMtime(const InodeAttr& attr) {
-  WriteLockGuard lk(rwlock_);
   modifiedAt_->Put(attr.inodeid(), AttrMtime(attr));
 }
 
 bool AttrWatcher::GetMtime(Ino ino, base::time::TimeSpec* time) {
-  ReadLockGuard lk(rwlock_);
   return modifiedAt_->Get(ino, time);
 }
 
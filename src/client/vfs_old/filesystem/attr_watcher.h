@@ -37,7 +37,7 @@ namespace filesystem {
 
 class AttrWatcher {
  public:
-  using LRUType = utils::LRUCache<Ino, base::time::TimeSpec>;
+  using LRUType = utils::ShardedLRUCache<Ino, base::time::TimeSpec>;
 
   AttrWatcher(common::AttrWatcherOption option,
               std::shared_ptr<OpenFiles> openFiles,
@@ -54,7 +54,6 @@ class AttrWatcher {
  private:
   friend class AttrWatcherGuard;
 
-  utils::RWLock rwlock_;
   std::shared_ptr<LRUType> modifiedAt_;
   std::shared_ptr<OpenFiles> openFiles_;
   std::shared_ptr<DirCache> dirCache_;
@@ -118,9 +118,13 @@ TimeSpec DirEntryList::GetMtime() {
   return mtime_;
 }
 
-DirCache::DirCache(DirCacheOption option)
-    : rwlock_(), nentries_(0), option_(option) {
-  lru_ = std::make_shared<LRUType>(0);  // control size by ourself
+DirCache::DirCache(DirCacheOption option) : option_(option) {
+  // the capacity is the number of entries, each directory charges its size
+  lru_ = std::make_shared<LRUType>(
+      option.lruSize, "filesystem_dircache", kNumShards,
+      [this](const Ino& parent, const std::shared_ptr<DirEntryList>& entries) {
+        Delete(parent, entries, true);
+      });
   mq_ = std::make_shared<MessageQueueType>("dircache", 10000);
   mq_->Subscribe(
       [&](const std::shared_ptr<DirEntryList>& entries) { entries->Clear(); });
@@ -132,62 +136,44 @@ DirCache::DirCache(DirCacheOption option)
 void DirCache::Start() { mq_->Start(); }
 
 void DirCache::Stop() {
-  WriteLockGuard lk(rwlock_);
-  Evit(option_.lruSize);
+  lru_->Clear();
   mq_->Stop();
 }
 
 void DirCache::Delete(Ino parent, std::shared_ptr<DirEntryList> entries,
                       bool evit) {
   size_t ndelete = entries->Size();
-  nentries_ -= ndelete;
   metric_->AddEntries(-static_cast<int64_t>(ndelete));
   mq_->Publish(entries);  // clear entries in background
-  lru_->Remove(parent);
 
   VLOG(1) << "Delete directory cache (evit=" << evit << "): "
           << "parent = " << parent << ", mtime = " << entries->GetMtime()
-          << ", delete size = " << ndelete << ", nentries = " << nentries_;
-}
-
-void DirCache::Evit(size_t size) {
-  Ino parent;
-  std::shared_ptr<DirEntryList> entries;
-  while (nentries_ + size >= option_.lruSize) {
-    bool yes = lru_->GetLast(&parent, &entries);
-    if (!yes) {
-      break;
-    }
-    Delete(parent, entries, true);
-  }
+          << ", delete size = " << ndelete;
 }
 
 void DirCache::Put(Ino parent, std::shared_ptr<DirEntryList> entries) {
-  WriteLockGuard lk(rwlock_);
   if (entries->Size() == 0) {  // TODO(Wine93): cache it!
     return;
   }
 
-  Evit(entries->Size());  // it guarantee put entries success
-  lru_->Put(parent, entries);
+  // the metric is added before put, the replaced or evicted entries
+  // are subtracted by Delete() inside put
   int64_t ninsert = entries->Size();
-  nentries_ += ninsert;
   metric_->AddEntries(static_cast<int64_t>(ninsert));
+  lru_->Put(parent, entries, ninsert);  // it guarantee put entries success
 
   VLOG(1) << "Insert directory cache: parent = " << parent
           << ", mtime = " << entries->GetMtime()
-          << ", insert size = " << ninsert << ", nentries = " << nentries_;
+          << ", insert size = " << ninsert;
 }
 
 bool DirCache::Get(Ino parent, std::shared_ptr<DirEntryList>* entries) {
-  ReadLockGuard lk(rwlock_);
   return lru_->Get(parent, entries);
 }
 
 void DirCache::Drop(Ino parent) {
-  WriteLockGuard lk(rwlock_);
   std::shared_ptr<DirEntryList> entries;
-  bool yes = lru_->Get(parent, &entries);
+  bool yes = lru_->Remove(parent, &entries);
   if (yes) {
     Delete(parent, entries, false);
   }
@@ -73,10 +73,14 @@ class DirEntryList {
 
 class DirCache {
  public:
-  using LRUType = utils::LRUCache<Ino, std::shared_ptr<DirEntryList>>;
+  using LRUType = utils::ShardedLRUCache<Ino, std::shared_ptr<DirEntryList>>;
   using MessageType = std::shared_ptr<DirEntryList>;
   using MessageQueueType = base::queue::MessageQueue<MessageType>;
 
+  // each directory charges all of its entries, a few big shards keep one
+  // large directory from flushing out everything else in its shard
+  static constexpr size_t kNumShards = 4;
+
   explicit DirCache(common::DirCacheOption option);
 
   void Start();
@@ -89,13 +93,11 @@ class DirCache {
 
   void Drop(Ino parent);
 
+  std::shared_ptr<DirCacheMetric> GetMetric() { return metric_; }
+
  private:
   void Delete(Ino parent, std::shared_ptr<DirEntryList> entries, bool evit);
 
-  void Evit(size_t size);
-
-  utils::RWLock rwlock_;
-  size_t nentries_;
   common::DirCacheOption option_;
   std::shared_ptr<LRUType> lru_;
   std::shared_ptr<MessageQueueType> mq_;
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/vfs_old/filesystem/entry_cache.h"
+
+#include <glog/logging.h>
+
+#include "client/vfs_old/filesystem/utils.h"
+
+namespace dingofs {
+namespace client {
+namespace filesystem {
+
+using base::time::TimeSpec;
+using common::EntryCacheOption;
+using pb::metaserver::InodeAttr;
+
+// approximate memory of one cached item except the name and attribute,
+// including the lru list node and the hash slot.
+static constexpr uint64_t kItemOverhead = 128;
+
+EntryCache::EntryCache(EntryCacheOption option)
+    : enable_(option.leaseSec > 0 && option.capacityMB > 0),
+      option_(option),
+      clock_(0),
+      versions_(new std::atomic<uint64_t>[kVersionSlots]),
+      metric_(std::make_shared<EntryCacheMetric>()) {
+  for (size_t i = 0; i < kVersionSlots; i++) {
+    versions_[i].store(0, std::memory_order_relaxed);
+  }
+
+  // the memory is split evenly between entries and attributes
+  uint64_t capacity = option.capacityMB * 1024 * 1024 / 2;
+  entries_ = std::make_unique<EntryLRUType>(capacity,
+                                            "filesystem_entrycache_dentry");
+  attrs_ = std::make_unique<AttrLRUType>(capacity,
+                                         "filesystem_entrycache_attr");
+  if (enable_) {
+    LOG(INFO) << "Using entry cache, lease = " << option.leaseSec
+              << ", capacity = " << option.capacityMB << "MB";
+  }
+}
+
+bool EntryCache::Expired(const TimeSpec& expireTime) {
+  return expireTime < Now();
+}
+
+size_t EntryCache::EntrySlot(Ino parent, const std::string& name) {
+  return DentryKeyHash()(DentryKeyView{parent, name}) % kVersionSlots;
+}
+
+size_t EntryCache::AttrSlot(Ino ino) { return ino % kVersionSlots; }
+
+void EntryCache::Invalidate(size_t slot) {
+  uint64_t version = clock_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  auto& stamp = versions_[slot];
+  uint64_t old = stamp.load(std::memory_order_acquire);
+  while (old < version &&
+         !stamp.compare_exchange_weak(old, version,
+                                      std::memory_order_acq_rel)) {
+  }
+}
+
+bool EntryCache::Valid(size_t slot, uint64_t epoch) const {
+  return versions_[slot].load(std::memory_order_acquire) <= epoch;
+}
+
+bool EntryCache::GetEntry(Ino parent, const std::string& name,
+                          InodeAttr* attr) {
+  if (!enable_) {
+    return false;
+  }
+
+  EntryValue value;
+  auto key = DentryKeyView{parent, name};
+  bool yes = entries_->Get(key, &value);
+  if (yes && Expired(value.expireTime)) {
+    entries_->Remove(key);
+    yes = false;
+  }
+
+  std::shared_ptr<const AttrValue> attr_value;
+  if (yes) {
+    yes = attrs_->Get(value.ino, &attr_value) &&
+          !Expired(attr_value->expireTime);
+  }
+
+  metric_->OnLookup(yes);
+  if (yes) {
+    *attr = attr_value->attr;
+  }
+  return yes;
+}
+
+bool EntryCache::GetAttr(Ino ino, InodeAttr* attr) {
+  if (!enable_) {
+    return false;
+  }
+
+  std::shared_ptr<const AttrValue> value;
+  bool yes = attrs_->Get(ino, &value);
+  if (yes && Expired(value->expireTime)) {
+    attrs_->Remove(ino);
+    yes = false;
+  }
+
+  metric_->OnGetAttr(yes);
+  if (yes) {
+    *attr = value->attr;
+  }
+  return yes;
+}
+
+void EntryCache::PutEntry(Ino parent, const std::string& name,
+                          const InodeAttr& attr, uint64_t epoch) {
+  size_t slot = EntrySlot(parent, name);
+  if (!enable_ || !Valid(slot, epoch)) {
+    return;
+  }
+
+  auto expireTime = Now() + TimeSpec(option_.leaseSec, 0);
+  entries_->Put(DentryKey{parent, name},
+                EntryValue{attr.inodeid(), expireTime},
+                kItemOverhead + name.size());
+  PutAttr(attr, epoch);
+
+  // invalidated while putting, the invalidation may miss what we put
+  if (!Valid(slot, epoch)) {
+    entries_->Remove(DentryKeyView{parent, name});
+  }
+}
+
+void EntryCache::PutAttr(const InodeAttr& attr, uint64_t epoch) {
+  size_t slot = AttrSlot(attr.inodeid());
+  if (!enable_ || !Valid(slot, epoch)) {
+    return;
+  }
+
+  auto value = std::make_shared<AttrValue>();
+  value->attr = attr;
+  value->expireTime = Now() + TimeSpec(option_.leaseSec, 0);
+  attrs_->Put(attr.inodeid(), value, kItemOverhead + attr.SpaceUsedLong());
+
+  if (!Valid(slot, epoch)) {
+    attrs_->Remove(attr.inodeid());
+  }
+}
+
+void EntryCache::DeleteEntry(Ino parent, const std::string& name) {
+  if (enable_) {
+    Invalidate(EntrySlot(parent, name));
+    entries_->Remove(DentryKeyView{parent, name});
+  }
+}
+
+void EntryCache::DeleteAttr(Ino ino) {
+  if (enable_) {
+    Invalidate(AttrSlot(ino));
+    attrs_->Remove(ino);
+  }
+}
+
+}  // namespace filesystem
+}  // namespace client
+}  // namespace dingofs
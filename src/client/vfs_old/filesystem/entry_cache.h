@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_FILESYSTEM_ENTRY_CACHE_H_
+#define DINGOFS_SRC_CLIENT_FILESYSTEM_ENTRY_CACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "base/time/time.h"
+#include "client/vfs_old/common/config.h"
+#include "client/vfs_old/filesystem/meta.h"
+#include "client/vfs_old/filesystem/metric.h"
+#include "utils/lru_cache.h"
+
+namespace dingofs {
+namespace client {
+namespace filesystem {
+
+// Positive cache for lookup and getattr results: the entry (parent, name)
+// -> ino and the attribute ino -> attr are trusted until the lease expired.
+//
+// Local mutations must invalidate the changed entries and attributes. Every
+// invalidation ticks a clock and stamps the version slot its key hashes to.
+// A result fetched from metaserver is only cached if its slot was not stamped
+// since the fetch began (see Epoch), so a slow lookup can't bring back the
+// entry removed meanwhile, while unrelated invalidations don't stop caching.
+class EntryCache {
+ public:
+  struct EntryValue {
+    Ino ino;
+    base::time::TimeSpec expireTime;
+  };
+
+  struct AttrValue {
+    pb::metaserver::InodeAttr attr;
+    base::time::TimeSpec expireTime;
+  };
+
+  using EntryLRUType = utils::ShardedLRUCache<DentryKey, EntryValue,
+                                              DentryKeyHash, DentryKeyEqual>;
+  using AttrLRUType =
+      utils::ShardedLRUCache<Ino, std::shared_ptr<const AttrValue>>;
+
+  static constexpr size_t kVersionSlots = 4096;
+
+  explicit EntryCache(common::EntryCacheOption option);
+
+  bool GetEntry(Ino parent, const std::string& name,
+                pb::metaserver::InodeAttr* attr);
+
+  bool GetAttr(Ino ino, pb::metaserver::InodeAttr* attr);
+
+  // Must be taken before fetching the result which will be put
+  uint64_t Epoch() const { return clock_.load(std::memory_order_acquire); }
+
+  void PutEntry(Ino parent, const std::string& name,
+                const pb::metaserver::InodeAttr& attr, uint64_t epoch);
+
+  void PutAttr(const pb::metaserver::InodeAttr& attr, uint64_t epoch);
+
+  void DeleteEntry(Ino parent, const std::string& name);
+
+  void DeleteAttr(Ino ino);
+
+ private:
+  bool Expired(const base::time::TimeSpec& expireTime);
+
+  static size_t EntrySlot(Ino parent, const std::string& name);
+
+  static size_t AttrSlot(Ino ino);
+
+  void Invalidate(size_t slot);
+
+  // no invalidation hit the slot since the epoch taken
+  bool Valid(size_t slot, uint64_t epoch) const;
+
+  bool enable_;
+  common::EntryCacheOption option_;
+  std::atomic<uint64_t> clock_;
+  std::unique_ptr<std::atomic<uint64_t>[]> versions_;
+  std::unique_ptr<EntryLRUType> entries_;
+  std::unique_ptr<AttrLRUType> attrs_;
+  std::shared_ptr<EntryCacheMetric> metric_;
+};
+
+}  // namespace filesystem
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_FILESYSTEM_ENTRY_CACHE_H_
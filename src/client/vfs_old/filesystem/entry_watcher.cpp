@@ -34,15 +34,11 @@ namespace filesystem {
 
 using base::filepath::HasSuffix;
 using base::string::StrSplit;
-using utils::LRUCache;
-using utils::ReadLockGuard;
-using utils::RWLock;
-using utils::WriteLockGuard;
 
 using pb::metaserver::InodeAttr;
 
 EntryWatcher::EntryWatcher(const std::string& nocto_suffix) {
-  nocto_ = std::make_unique<LRUType>(65536);
+  nocto_ = std::make_unique<LRUType>(65536, "filesystem_entrywatcher");
 
   if (nocto_suffix.empty()) {
     return;
@@ -64,7 +60,6 @@ void EntryWatcher::Remeber(const InodeAttr& attr, const std::string& filename) {
 
   for (const auto& suffix : suffixs_) {
     if (HasSuffix(filename, suffix)) {
-      WriteLockGuard lk(rwlock_);
       nocto_->Put(attr.inodeid(), true);
       return;
     }
@@ -72,12 +67,10 @@ void EntryWatcher::Remeber(const InodeAttr& attr, const std::string& filename) {
 }
 
 void EntryWatcher::Forget(Ino ino) {
-  WriteLockGuard lk(rwlock_);
   nocto_->Remove(ino);
 }
 
 bool EntryWatcher::ShouldWriteback(Ino ino) {
-  ReadLockGuard lk(rwlock_);
   bool ignore;
   return nocto_->Get(ino, &ignore);
 }
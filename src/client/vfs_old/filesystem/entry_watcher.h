@@ -36,7 +36,7 @@ namespace filesystem {
 // remeber regular file's ino which will use nocto flush plolicy
 class EntryWatcher {
  public:
-  using LRUType = utils::LRUCache<Ino, bool>;
+  using LRUType = utils::ShardedLRUCache<Ino, bool>;
 
   EntryWatcher(const std::string& nocto_suffix);
 
@@ -48,7 +48,6 @@ class EntryWatcher {
   bool ShouldWriteback(Ino ino);
 
  private:
-  utils::RWLock rwlock_;
   std::unique_ptr<LRUType> nocto_;
   std::vector<std::string> suffixs_;
 };
@@ -52,6 +52,7 @@ FileSystem::FileSystem(uint32_t fs_id, std::string fs_name,
     : fs_id_(fs_id), fs_name_(fs_name), option_(option), member(member) {
   deferSync_ = std::make_shared<DeferSync>(option.deferSyncOption);
   negative_ = std::make_shared<LookupCache>(option.lookupCacheOption);
+  positive_ = std::make_shared<EntryCache>(option.entryCacheOption);
   dirCache_ = std::make_shared<DirCache>(option.dirCacheOption);
   openFiles_ = std::make_shared<OpenFiles>(option_.openFilesOption, deferSync_);
   attrWatcher_ = std::make_shared<AttrWatcher>(option_.attrWatcherOption,
@@ -121,14 +122,21 @@ DINGOFS_ERROR FileSystem::Lookup(Request req, Ino parent,
     return DINGOFS_ERROR::NAMETOOLONG;
   }
 
-  bool yes = negative_->Get(parent, name);
+  bool yes = positive_->GetEntry(parent, name, &entry_out->attr);
+  if (yes) {
+    return DINGOFS_ERROR::OK;
+  }
+
+  yes = negative_->Get(parent, name);
   if (yes) {
     return DINGOFS_ERROR::NOTEXIST;
   }
 
+  uint64_t epoch = positive_->Epoch();
   auto rc = rpc_->Lookup(parent, name, entry_out);
   if (rc == DINGOFS_ERROR::OK) {
     negative_->Delete(parent, name);
+    positive_->PutEntry(parent, name, entry_out->attr, epoch);
   } else if (rc == DINGOFS_ERROR::NOTEXIST) {
     negative_->Put(parent, name);
   }
@@ -137,19 +145,29 @@ DINGOFS_ERROR FileSystem::Lookup(Request req, Ino parent,
 
 DINGOFS_ERROR FileSystem::GetAttr(Request req, Ino ino, AttrOut* attr_out) {
   InodeAttr attr;
+  bool yes = positive_->GetAttr(ino, &attr);
+  if (yes) {
+    *attr_out = AttrOut(attr);
+    return DINGOFS_ERROR::OK;
+  }
+
+  uint64_t epoch = positive_->Epoch();
   auto rc = rpc_->GetAttr(ino, &attr);
   if (rc == DINGOFS_ERROR::OK) {
     *attr_out = AttrOut(attr);
+    positive_->PutAttr(attr, epoch);
   }
   return rc;
 }
 
 DINGOFS_ERROR FileSystem::OpenDir(Ino ino, uint64_t* fh) {
   InodeAttr attr;
+  uint64_t epoch = positive_->Epoch();
   DINGOFS_ERROR rc = rpc_->GetAttr(ino, &attr);
   if (rc != DINGOFS_ERROR::OK) {
     return rc;
   }
+  positive_->PutAttr(attr, epoch);  // refresh the cached one
 
   // revalidate directory cache
   std::shared_ptr<DirEntryList> entries;
@@ -213,6 +231,8 @@ DINGOFS_ERROR FileSystem::Open(Ino ino) {
     LOG(WARNING) << "open(" << ino << "): stale file handler"
                  << ", cache(" << mtime << ") vs remote(" << InodeMtime(inode)
                  << ")";
+    // the kernel will lookup again, which must not hit the stale attribute
+    positive_->DeleteAttr(ino);
     return DINGOFS_ERROR::STALE;
   }
 
@@ -221,10 +241,22 @@ DINGOFS_ERROR FileSystem::Open(Ino ino) {
 }
 
 DINGOFS_ERROR FileSystem::Release(Ino ino) {
-  openFiles_->Close(ino);
+  bool written;
+  openFiles_->Close(ino, &written);
+  if (written) {  // the written length and mtime are no longer patched
+    positive_->DeleteAttr(ino);
+  }
   return DINGOFS_ERROR::OK;
 }
 
+void FileSystem::InvalidateEntry(Ino parent, const std::string& name) {
+  negative_->Delete(parent, name);
+  positive_->DeleteEntry(parent, name);
+  positive_->DeleteAttr(parent);  // mtime, ctime and nlink of parent
+}
+
+void FileSystem::InvalidateAttr(Ino ino) { positive_->DeleteAttr(ino); }
+
 void FileSystem::UpdateFsQuotaUsage(int64_t add_space, int64_t add_inode) {
   fs_stat_manager_->UpdateFsQuotaUsage(add_space, add_inode);
 }
@@ -274,6 +306,7 @@ void FileSystem::BeforeReplyOpen(pb::metaserver::InodeAttr& attr) {
 }
 
 void FileSystem::BeforeReplyWrite(pb::metaserver::InodeAttr& attr) {
+  openFiles_->MarkWritten(attr.inodeid());
   AttrWatcherGuard watcher(attrWatcher_, &attr, ReplyType::ONLY_LENGTH, true);
 }
 
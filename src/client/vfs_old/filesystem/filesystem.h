@@ -36,6 +36,7 @@
 #include "client/vfs_old/filesystem/dir_cache.h"
 #include "client/vfs_old/filesystem/dir_parent_watcher.h"
 #include "client/vfs_old/filesystem/dir_quota_manager.h"
+#include "client/vfs_old/filesystem/entry_cache.h"
 #include "client/vfs_old/filesystem/entry_watcher.h"
 #include "client/vfs_old/filesystem/error.h"
 #include "client/vfs_old/filesystem/fs_push_metric_manager.h"
@@ -98,6 +99,13 @@ class FileSystem {
 
   DINGOFS_ERROR Release(Ino ino);
 
+  // invalidate the cached entry (and attribute of its parent) which is
+  // changed by local mutation
+  void InvalidateEntry(Ino parent, const std::string& name);
+
+  // invalidate the cached attribute which is changed by local mutation
+  void InvalidateAttr(Ino ino);
+
   // utility: file handler
   std::shared_ptr<FileHandler> NewHandler();
 
@@ -150,6 +158,7 @@ class FileSystem {
   ExternalMember member;
   std::shared_ptr<DeferSync> deferSync_;
   std::shared_ptr<LookupCache> negative_;
+  std::shared_ptr<EntryCache> positive_;
   std::shared_ptr<DirCache> dirCache_;
   std::shared_ptr<OpenFiles> openFiles_;
   std::shared_ptr<AttrWatcher> attrWatcher_;
@@ -34,10 +34,6 @@ namespace client {
 namespace filesystem {
 
 using common::LookupCacheOption;
-using utils::LRUCache;
-using utils::ReadLockGuard;
-using utils::RWLock;
-using utils::WriteLockGuard;
 
 #define RETURN_FALSE_IF_DISABLED() \
   do {                             \
@@ -47,8 +43,8 @@ using utils::WriteLockGuard;
   } while (0)
 
 LookupCache::LookupCache(LookupCacheOption option)
-    : enable_(option.negativeTimeoutSec > 0), rwlock_(), option_(option) {
-  lru_ = std::make_shared<LRUType>(option.lruSize);
+    : enable_(option.negativeTimeoutSec > 0), option_(option) {
+  lru_ = std::make_shared<LRUType>(option.lruSize, "filesystem_lookupcache");
   if (enable_) {
     LOG(INFO) << "Using lookup negative lru cache"
               << ", timeout = " << option.negativeTimeoutSec
@@ -56,16 +52,10 @@ LookupCache::LookupCache(LookupCacheOption option)
   }
 }
 
-std::string LookupCache::CacheKey(Ino parent, const std::string& name) {
-  return absl::StrFormat("%d:%s", parent, name);
-}
-
 bool LookupCache::Get(Ino parent, const std::string& name) {
   RETURN_FALSE_IF_DISABLED();
-  ReadLockGuard lk(rwlock_);
   CacheEntry entry;
-  auto key = CacheKey(parent, name);
-  bool yes = lru_->Get(key, &entry);
+  bool yes = lru_->Get(DentryKeyView{parent, name}, &entry);
   if (!yes) {
     VLOG(1) << absl::StrFormat("Lookup cache not found: key(%d,%s)", parent,
                                name);
@@ -80,27 +70,17 @@ bool LookupCache::Get(Ino parent, const std::string& name) {
 
 bool LookupCache::Put(Ino parent, const std::string& name) {
   RETURN_FALSE_IF_DISABLED();
-  WriteLockGuard lk(rwlock_);
-  CacheEntry entry;
-  auto key = CacheKey(parent, name);
-  bool yes = lru_->Get(key, &entry);
-  if (yes) {
-    entry.uses++;
-  } else {
-    entry.uses = 0;
-  }
-
-  entry.expireTime =
-      Now() + base::time::TimeSpec(option_.negativeTimeoutSec, 0);
-  lru_->Put(key, entry);
+  auto expireTime = Now() + base::time::TimeSpec(option_.negativeTimeoutSec, 0);
+  lru_->Update(DentryKey{parent, name}, [&](CacheEntry* entry, bool found) {
+    entry->uses = found ? entry->uses + 1 : 0;
+    entry->expireTime = expireTime;
+  });
   return true;
 }
 
 bool LookupCache::Delete(Ino parent, const std::string& name) {
   RETURN_FALSE_IF_DISABLED();
-  WriteLockGuard lk(rwlock_);
-  auto key = CacheKey(parent, name);
-  lru_->Remove(key);
+  lru_->Remove(DentryKeyView{parent, name});
   return true;
 }
 
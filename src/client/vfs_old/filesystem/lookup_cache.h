@@ -34,8 +34,8 @@ namespace dingofs {
 namespace client {
 namespace filesystem {
 
-// memory cache for lookup result, now we only support cache negative result,
-// and other positive entry will be cached in kernel.
+// memory cache for negative lookup result, the positive entry is cached
+// in kernel and EntryCache.
 class LookupCache {
  public:
   struct CacheEntry {
@@ -43,7 +43,8 @@ class LookupCache {
     base::time::TimeSpec expireTime;
   };
 
-  using LRUType = utils::LRUCache<std::string, CacheEntry>;
+  using LRUType = utils::ShardedLRUCache<DentryKey, CacheEntry, DentryKeyHash,
+                                         DentryKeyEqual>;
 
   explicit LookupCache(common::LookupCacheOption option);
 
@@ -54,10 +55,7 @@ class LookupCache {
   bool Delete(Ino parent, const std::string& name);
 
  private:
-  std::string CacheKey(Ino parent, const std::string& name);
-
   bool enable_;
-  utils::RWLock rwlock_;
   common::LookupCacheOption option_;
   std::shared_ptr<LRUType> lru_;
 };
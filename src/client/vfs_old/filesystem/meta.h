@@ -26,7 +26,10 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 
+#include "absl/hash/hash.h"
 #include "dingofs/metaserver.pb.h"
 #include "base/time/time.h"
 #include "client/vfs_old/dir_buffer.h"
@@ -72,6 +75,38 @@ struct DirEntry {
   pb::metaserver::InodeAttr attr;
 };
 
+// The key of directory entry in caches, it can be looked up by
+// DentryKeyView without building the name string.
+struct DentryKey {
+  Ino parent;
+  std::string name;
+};
+
+struct DentryKeyView {
+  Ino parent;
+  std::string_view name;
+};
+
+struct DentryKeyHash {
+  using is_transparent = void;
+
+  template <typename Key>
+  size_t operator()(const Key& key) const {
+    return absl::Hash<std::pair<Ino, std::string_view>>()(
+        std::make_pair(key.parent, std::string_view(key.name)));
+  }
+};
+
+struct DentryKeyEqual {
+  using is_transparent = void;
+
+  template <typename Lhs, typename Rhs>
+  bool operator()(const Lhs& lhs, const Rhs& rhs) const {
+    return lhs.parent == rhs.parent &&
+           std::string_view(lhs.name) == std::string_view(rhs.name);
+  }
+};
+
 struct FileOut {
   FileOut() = default;
 
@@ -37,6 +37,8 @@ class DirCacheMetric {
 
   void AddEntries(int64_t n) { metric_.nentries << n; }
 
+  int64_t GetEntries() const { return metric_.nentries.get_value(); }
+
  private:
   struct Metric {
     Metric() : nentries("filesystem_dircache", "nentries") {}
@@ -46,6 +48,43 @@ class DirCacheMetric {
   Metric metric_;
 };
 
+class EntryCacheMetric {
+ public:
+  EntryCacheMetric() = default;
+
+  void OnLookup(bool hit) {
+    if (hit) {
+      metric_.lookupHit << 1;
+    } else {
+      metric_.lookupMiss << 1;
+    }
+  }
+
+  void OnGetAttr(bool hit) {
+    if (hit) {
+      metric_.getattrHit << 1;
+    } else {
+      metric_.getattrMiss << 1;
+    }
+  }
+
+ private:
+  struct Metric {
+    Metric()
+        : lookupHit("filesystem_entrycache", "lookup_hit"),
+          lookupMiss("filesystem_entrycache", "lookup_miss"),
+          getattrHit("filesystem_entrycache", "getattr_hit"),
+          getattrMiss("filesystem_entrycache", "getattr_miss") {}
+
+    bvar::Adder<uint64_t> lookupHit;
+    bvar::Adder<uint64_t> lookupMiss;
+    bvar::Adder<uint64_t> getattrHit;
+    bvar::Adder<uint64_t> getattrMiss;
+  };
+
+  Metric metric_;
+};
+
 class OpenfilesMetric {
  public:
   OpenfilesMetric() = default;
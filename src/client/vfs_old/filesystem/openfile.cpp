@@ -79,8 +79,11 @@ bool OpenFiles::IsOpened(Ino ino, std::shared_ptr<InodeWrapper>* inode) {
 }
 
 // file should already flushed before close
-void OpenFiles::Close(Ino ino) {
+void OpenFiles::Close(Ino ino, bool* written) {
   WriteLockGuard lk(rwlock_);
+  if (written != nullptr) {
+    *written = false;
+  }
 
   auto iter = files_.find(ino);
   if (iter == files_.end()) {
@@ -96,6 +99,9 @@ void OpenFiles::Close(Ino ino) {
             << ", refs = " << iter->second->refs
             << ", mtime = " << InodeMtime(iter->second->inode);
 
+    if (written != nullptr) {
+      *written = iter->second->written.load(std::memory_order_relaxed);
+    }
     files_.erase(iter);
     metric_->AddOpenfiles(-1);
   }
@@ -128,6 +134,14 @@ bool OpenFiles::GetFileAttr(Ino ino, pb::metaserver::InodeAttr* attr) {
   return true;
 }
 
+void OpenFiles::MarkWritten(Ino ino) {
+  ReadLockGuard lk(rwlock_);
+  auto iter = files_.find(ino);
+  if (iter != files_.end()) {
+    iter->second->written.store(true, std::memory_order_relaxed);
+  }
+}
+
 }  // namespace filesystem
 }  // namespace client
 }  // namespace dingofs
@@ -23,6 +23,7 @@
 #ifndef DINGOFS_SRC_CLIENT_FILESYSTEM_OPENFILE_H_
 #define DINGOFS_SRC_CLIENT_FILESYSTEM_OPENFILE_H_
 
+#include <atomic>
 #include <memory>
 #include <unordered_map>
 
@@ -37,10 +38,11 @@ namespace filesystem {
 
 struct OpenFile {
   explicit OpenFile(std::shared_ptr<InodeWrapper> inode)
-      : inode(inode), refs(0) {}
+      : inode(inode), refs(0), written(false) {}
 
   std::shared_ptr<InodeWrapper> inode;
   uint64_t refs;
+  std::atomic<bool> written;
 };
 
 class OpenFiles {
@@ -54,12 +56,15 @@ class OpenFiles {
 
   bool IsOpened(Ino ino, std::shared_ptr<InodeWrapper>* inode);
 
-  void Close(Ino ino);
+  // |written| is set if it's the last close and the file was written
+  void Close(Ino ino, bool* written = nullptr);
 
   void CloseAll();
 
   bool GetFileAttr(Ino ino, pb::metaserver::InodeAttr* attr);
 
+  void MarkWritten(Ino ino);
+
  private:
   utils::RWLock rwlock_;
   common::OpenFilesOption option_;
@@ -260,6 +260,7 @@ DINGOFS_ERROR InodeWrapper::RefreshS3ChunkInfo() {
   }
   auto before = s3ChunkInfoSize_;
   inode_.mutable_s3chunkinfomap()->swap(s3ChunkInfoMap);
+  sliceIndexes_.clear();
   UpdateS3ChunkInfoMetric(CalS3ChunkInfoSize() - before);
   ClearS3ChunkInfoAdd();
   UpdateMaxS3ChunkInfoSize();
@@ -267,6 +268,24 @@ DINGOFS_ERROR InodeWrapper::RefreshS3ChunkInfo() {
   return DINGOFS_ERROR::OK;
 }
 
+std::shared_ptr<SliceIndex> InodeWrapper::GetSliceIndexLocked(
+    uint64_t chunkIndex) {
+  auto iter = sliceIndexes_.find(chunkIndex);
+  if (iter != sliceIndexes_.end()) {
+    return iter->second;
+  }
+
+  const auto& s3ChunkInfoMap = inode_.s3chunkinfomap();
+  auto it = s3ChunkInfoMap.find(chunkIndex);
+  if (it == s3ChunkInfoMap.end()) {
+    return nullptr;
+  }
+
+  auto index = std::make_shared<SliceIndex>(it->second);
+  sliceIndexes_.emplace(chunkIndex, index);
+  return index;
+}
+
 DINGOFS_ERROR InodeWrapper::Link(uint64_t parent) {
   dingofs::utils::UniqueLock lg(mtx_);
   REFRESH_NLINK;
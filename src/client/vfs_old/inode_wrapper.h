@@ -30,11 +30,13 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "dingofs/metaserver.pb.h"
 #include "client/vfs_old/common/common.h"
 #include "client/vfs_old/filesystem/error.h"
+#include "client/vfs_old/slice_index.h"
 #include "stub/metric/metric.h"
 #include "stub/rpcclient/metaserver_client.h"
 #include "utils/concurrent/concurrent.h"
@@ -255,13 +257,26 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
     s3ChunkInfoAddSize_++;
     s3ChunkInfoSize_++;
     UpdateS3ChunkInfoMetric(2);
+
+    auto iter = sliceIndexes_.find(chunkIndex);
+    if (iter != sliceIndexes_.end()) {
+      iter->second->Add(info);
+    }
   }
 
+  // NOTE: the caller may modify the chunk info map, so the slice indexes
+  // built from it are invalidated.
   google::protobuf::Map<uint64_t, pb::metaserver::S3ChunkInfoList>*
   GetChunkInfoMap() {
+    sliceIndexes_.clear();
     return inode_.mutable_s3chunkinfomap();
   }
 
+  // Get the resolved slice index of chunk, which is built on first access
+  // and updated when slices are appended, return nullptr if the chunk
+  // has no slices.
+  std::shared_ptr<SliceIndex> GetSliceIndexLocked(uint64_t chunkIndex);
+
   void MarkInodeError() {
     // TODO(xuchaojie) : when inode is marked error, prevent futher write.
     status_ = InodeStatus::kError;
@@ -367,6 +382,9 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
 
   mutable utils::Mutex syncingVolumeExtentsMtx_;
 
+  // chunk index -> resolved slices, protected by |mtx_|
+  std::unordered_map<uint64_t, std::shared_ptr<SliceIndex>> sliceIndexes_;
+
   // timestamp when put in cache
   uint64_t time_;
 };
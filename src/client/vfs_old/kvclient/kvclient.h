@@ -23,11 +23,24 @@
 #define DINGOFS_SRC_CLIENT_KVCLIENT_KVCLIENT_H_
 
 #include <string>
+#include <vector>
 
 namespace dingofs {
 
 namespace client {
 
+/**
+ * Single get of a batch, the value[offset, offset + length) is copied
+ * into the buffer, |res| is true if it's found.
+ */
+struct KVGetRequest {
+  std::string key;
+  char* value;
+  uint64_t offset;
+  uint64_t length;
+  bool res{false};
+};
+
 /**
  * Single client to kv interface.
  */
@@ -51,6 +64,17 @@ class KVClient {
 
   virtual bool Get(const std::string& key, char* value, uint64_t offset,
                    uint64_t length, std::string* errorlog) = 0;
+
+  /**
+   * @brief: get a batch of keys, the client which supports pipelining
+   *         should override it to save the round-trips.
+   */
+  virtual void MGet(std::vector<KVGetRequest>* requests) {
+    std::string errorlog;
+    for (auto& req : *requests) {
+      req.res = Get(req.key, req.value, req.offset, req.length, &errorlog);
+    }
+  }
 };
 
 }  // namespace client
@@ -74,5 +74,18 @@ void KVClientManager::Get(std::shared_ptr<GetKVCacheTask> task) {
   });
 }
 
+void KVClientManager::MGet(std::shared_ptr<MGetKVCacheTask> task) {
+  threadPool_.Enqueue([task, this]() {
+    LatencyGuard guard(&kvClientMetric_.kvClientGet.latency);
+
+    client_->MGet(&task->requests);
+    for (const auto& req : task->requests) {
+      ONRETURN(Get, req.res);
+    }
+
+    task->done(task);
+  });
+}
+
 }  // namespace client
 }  // namespace dingofs
@@ -28,6 +28,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "client/vfs_old/common/config.h"
 #include "client/vfs_old/kvclient/kvclient.h"
@@ -40,11 +41,14 @@ namespace client {
 class KVClientManager;
 class SetKVCacheTask;
 class GetKVCacheTask;
+class MGetKVCacheTask;
 
 using SetKVCacheDone =
     std::function<void(const std::shared_ptr<SetKVCacheTask>&)>;
 using GetKVCacheDone =
     std::function<void(const std::shared_ptr<GetKVCacheTask>&)>;
+using MGetKVCacheDone =
+    std::function<void(const std::shared_ptr<MGetKVCacheTask>&)>;
 
 struct SetKVCacheTask {
   std::string key;
@@ -71,6 +75,14 @@ struct GetKVCacheTask {
   }
 };
 
+struct MGetKVCacheTask {
+  std::vector<KVGetRequest> requests;
+  MGetKVCacheDone done;
+  MGetKVCacheTask() {
+    done = [](const std::shared_ptr<MGetKVCacheTask>&) {};
+  }
+};
+
 class KVClientManager {
  public:
   KVClientManager() = default;
@@ -88,6 +100,9 @@ class KVClientManager {
 
   void Get(std::shared_ptr<GetKVCacheTask> task);
 
+  // Get all keys of task in one batch
+  void MGet(std::shared_ptr<MGetKVCacheTask> task);
+
   stub::metric::KVClientMetric* GetClientMetricForTesting() {
     return &kvClientMetric_;
   }
@@ -22,10 +22,243 @@
 
 #include "client/vfs_old/kvclient/memcache_client.h"
 
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <unordered_map>
+
+#include "client/vfs_old/common/dynamic_config.h"
+
 namespace dingofs {
 namespace client {
 
-thread_local memcached_st* tcli = nullptr;
+USING_FLAG(memcacheBinaryProtocol);
+
+MemCachedClient::MemCachedClient(uint32_t pool_size)
+    : server_(nullptr),
+      client_(memcached_create(nullptr)),
+      pool_size_(std::max(pool_size, 1U)),
+      num_conns_(0) {
+  SetBehaviors(client_);
+}
+
+MemCachedClient::MemCachedClient(memcached_st* cli, uint32_t pool_size)
+    : server_(nullptr),
+      client_(cli),
+      pool_size_(std::max(pool_size, 1U)),
+      num_conns_(0) {
+  SetBehaviors(client_);
+}
+
+bool MemCachedClient::Init(
+    const pb::mds::topology::MemcacheClusterInfo& kvcachecluster) {
+  if (client_ != nullptr) {
+    memcached_free(client_);
+  }
+  client_ = memcached(nullptr, 0);
+  SetBehaviors(client_);
+
+  for (int i = 0; i < kvcachecluster.servers_size(); i++) {
+    if (!AddServer(kvcachecluster.servers(i).ip(),
+                   kvcachecluster.servers(i).port())) {
+      return false;
+    }
+  }
+  memcached_behavior_set(client_, MEMCACHED_BEHAVIOR_DISTRIBUTION,
+                         MEMCACHED_DISTRIBUTION_CONSISTENT);
+  memcached_behavior_set(client_, MEMCACHED_BEHAVIOR_RETRY_TIMEOUT, 5);
+
+  return PushServer();
+}
+
+void MemCachedClient::UnInit() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  for (auto& conn : conns_) {
+    memcached_result_free(&conn->result);
+    memcached_free(conn->mc);
+  }
+  conns_.clear();
+  idle_conns_.clear();
+  num_conns_ = 0;
+
+  if (client_) {
+    memcached_free(client_);
+    client_ = nullptr;
+  }
+}
+
+void MemCachedClient::SetBehaviors(memcached_st* mc) {
+  // the binary protocol pipelines the gets of mget
+  memcached_behavior_set(mc, MEMCACHED_BEHAVIOR_BINARY_PROTOCOL,
+                         FLAGS_memcacheBinaryProtocol ? 1 : 0);
+  memcached_behavior_set(mc, MEMCACHED_BEHAVIOR_TCP_NODELAY, 1);
+  memcached_behavior_set(mc, MEMCACHED_BEHAVIOR_TCP_KEEPALIVE, 1);
+}
+
+MemCachedClient::Connection* MemCachedClient::Acquire() {
+  {
+    std::unique_lock<std::mutex> lk(mutex_);
+    while (idle_conns_.empty() && num_conns_ >= pool_size_) {
+      cond_.wait(lk);
+    }
+
+    if (!idle_conns_.empty()) {
+      auto* conn = idle_conns_.back();
+      idle_conns_.pop_back();
+      return conn;
+    }
+    num_conns_++;  // the slot is taken, the connection is created unlocked
+  }
+
+  // the connection is used by one thread at a time, it connects to
+  // servers on first use
+  auto conn = std::make_unique<Connection>();
+  conn->mc = memcached_clone(nullptr, client_);
+  if (conn->mc == nullptr) {
+    LOG(ERROR) << "Clone memcached connection failed";
+    {
+      std::lock_guard<std::mutex> lk(mutex_);
+      num_conns_--;
+    }
+    cond_.notify_one();
+    return nullptr;
+  }
+  memcached_result_create(conn->mc, &conn->result);
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  conns_.emplace_back(std::move(conn));
+  return conns_.back().get();
+}
+
+void MemCachedClient::Release(Connection* conn, bool broken) {
+  if (broken) {  // it reconnects on next use
+    memcached_quit(conn->mc);
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    idle_conns_.push_back(conn);
+  }
+  cond_.notify_one();
+}
+
+bool MemCachedClient::Set(const std::string& key, const char* value,
+                          const uint64_t value_len, std::string* errorlog) {
+  auto* conn = Acquire();
+  if (conn == nullptr) {
+    *errorlog = ResError(MEMCACHED_MEMORY_ALLOCATION_FAILURE);
+    return false;
+  }
+  auto res = memcached_set(conn->mc, key.c_str(), key.length(), value,
+                           value_len, 0, 0);
+  Release(conn, res != MEMCACHED_SUCCESS);
+  if (MEMCACHED_SUCCESS == res) {
+    VLOG(9) << "Set key = " << key << " OK";
+    return true;
+  }
+
+  *errorlog = ResError(res);
+  LOG(ERROR) << "Set key = " << key << " error = " << *errorlog;
+  return false;
+}
+
+bool MemCachedClient::Get(const std::string& key, char* value,
+                          uint64_t offset, uint64_t length,
+                          std::string* errorlog) {
+  std::vector<KVGetRequest> requests{
+      KVGetRequest{key, value, offset, length, false}};
+  MGet(&requests);
+  if (!requests[0].res) {
+    *errorlog = ResError(MEMCACHED_NOTFOUND);
+  }
+  return requests[0].res;
+}
+
+void MemCachedClient::MGet(std::vector<KVGetRequest>* requests) {
+  // the same key may be requested for different ranges
+  std::unordered_map<std::string_view, std::vector<KVGetRequest*>> waiters;
+  std::vector<const char*> keys;
+  std::vector<size_t> key_lengths;
+  for (auto& req : *requests) {
+    req.res = false;
+    auto& reqs = waiters[req.key];
+    if (reqs.empty()) {
+      keys.push_back(req.key.data());
+      key_lengths.push_back(req.key.size());
+    }
+    reqs.push_back(&req);
+  }
+  if (keys.empty()) {
+    return;
+  }
+
+  auto* conn = Acquire();
+  if (conn == nullptr) {
+    return;
+  }
+  auto rc = memcached_mget(conn->mc, keys.data(), key_lengths.data(),
+                           keys.size());
+  if (rc != MEMCACHED_SUCCESS) {
+    LOG(ERROR) << "Mget " << keys.size()
+               << " keys error = " << ResError(rc);
+    Release(conn, true);
+    return;
+  }
+
+  memcached_result_st* result;
+  while ((result = memcached_fetch_result(conn->mc, &conn->result, &rc)) !=
+         nullptr) {
+    std::string_view key(memcached_result_key_value(result),
+                         memcached_result_key_length(result));
+    auto iter = waiters.find(key);
+    if (iter == waiters.end()) {
+      continue;
+    }
+
+    const char* data = memcached_result_value(result);
+    size_t data_length = memcached_result_length(result);
+    for (auto* req : iter->second) {
+      if (req->offset + req->length <= data_length) {
+        std::memcpy(req->value, data + req->offset, req->length);
+        req->res = true;
+      } else {
+        LOG(ERROR) << "Get key = " << req->key
+                   << " error, get_value_len = " << data_length
+                   << ", expect_value_len = " << req->offset + req->length;
+      }
+    }
+  }
+
+  bool broken = (rc != MEMCACHED_END && rc != MEMCACHED_SUCCESS &&
+                 rc != MEMCACHED_NOTFOUND);
+  if (broken) {
+    LOG(ERROR) << "Mget " << keys.size()
+               << " keys error = " << ResError(rc);
+  }
+  Release(conn, broken);
+}
+
+bool MemCachedClient::AddServer(const std::string& hostname,
+                                const uint32_t port) {
+  memcached_return_t res;
+  server_ =
+      memcached_server_list_append(server_, hostname.c_str(), port, &res);
+  if (MEMCACHED_SUCCESS == res) {
+    return true;
+  }
+  LOG(ERROR) << "client add " << hostname << " " << port << " error";
+  return false;
+}
+
+bool MemCachedClient::PushServer() {
+  memcached_return_t res = memcached_server_push(client_, server_);
+  if (MEMCACHED_SUCCESS == res) {
+    return true;
+  }
+  memcached_server_list_free(server_);
+  server_ = nullptr;
+  return false;
+}
 
 }  // namespace client
 }  // namespace dingofs
@@ -27,7 +27,11 @@
 #include <libmemcached-1.0/memcached.h>
 #include <libmemcached-1.0/types/return.h>
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "dingofs/topology.pb.h"
 #include "client/vfs_old/kvclient/kvclient.h"
@@ -36,12 +40,6 @@ namespace dingofs {
 
 namespace client {
 
-/**
- * only the threadpool will operate the kvclient,
- * for threadsafe and fast, we can make every thread has a client.
- */
-extern thread_local memcached_st* tcli;
-
 /**
  * MemCachedClient is a client to memcached cluster. You'd better
  * don't use it directly.
@@ -71,86 +69,35 @@ extern thread_local memcached_st* tcli;
  * if (!ue) {...}
  * then ...
  * manager.Unint();
+ *
+ * The connections are cloned from the master client on demand and kept
+ * in a pool (at most |pool_size| of them), a connection is only reset
+ * when an operation on it fails. The binary protocol is used unless
+ * FLAGS_memcacheBinaryProtocol is off, so the gets of MGet() are
+ * pipelined in one round-trip.
  */
 
 class MemCachedClient : public KVClient {
  public:
-  MemCachedClient() : server_(nullptr) { client_ = memcached_create(nullptr); }
-  explicit MemCachedClient(memcached_st* cli) : client_(cli) {}
-  ~MemCachedClient() { UnInit(); }
+  static constexpr uint32_t kDefaultPoolSize = 32;
 
-  bool Init(const pb::mds::topology::MemcacheClusterInfo& kvcachecluster) {
-    client_ = memcached(nullptr, 0);
+  explicit MemCachedClient(uint32_t pool_size = kDefaultPoolSize);
+  MemCachedClient(memcached_st* cli, uint32_t pool_size = kDefaultPoolSize);
+  ~MemCachedClient() { UnInit(); }
 
-    for (int i = 0; i < kvcachecluster.servers_size(); i++) {
-      if (!AddServer(kvcachecluster.servers(i).ip(),
-                     kvcachecluster.servers(i).port())) {
-        return false;
-      }
-    }
-    memcached_behavior_set(client_, MEMCACHED_BEHAVIOR_DISTRIBUTION,
-                           MEMCACHED_DISTRIBUTION_CONSISTENT);
-    memcached_behavior_set(client_, MEMCACHED_BEHAVIOR_RETRY_TIMEOUT, 5);
+  bool Init(const pb::mds::topology::MemcacheClusterInfo& kvcachecluster);
 
-    return PushServer();
-  }
-
-  void UnInit() override {
-    if (client_) {
-      memcached_free(client_);
-      client_ = nullptr;
-    }
-  }
+  void UnInit() override;
 
   bool Set(const std::string& key, const char* value, const uint64_t value_len,
-           std::string* errorlog) override {
-    if (nullptr == tcli) {
-      tcli = memcached_clone(nullptr, client_);
-    }
-    auto res =
-        memcached_set(tcli, key.c_str(), key.length(), value, value_len, 0, 0);
-    if (MEMCACHED_SUCCESS == res) {
-      VLOG(9) << "Set key = " << key << " OK";
-      return true;
-    }
-    *errorlog = ResError(res);
-    memcached_free(tcli);
-    tcli = nullptr;
-    LOG(ERROR) << "Set key = " << key << " error = " << *errorlog;
-    return false;
-  }
+           std::string* errorlog) override;
 
+  // The value is copied into |value| from the reused result buffer of
+  // connection, there is no allocation for each get.
   bool Get(const std::string& key, char* value, uint64_t offset,
-           uint64_t length, std::string* errorlog) override {
-    if (nullptr == tcli) {
-      // multi thread use a memcached_st* client is unsafe.
-      // should clone it or use memcached_st_pool.
-      tcli = memcached_clone(nullptr, client_);
-    }
-    uint32_t flags = 0;
-    size_t value_length = 0;
-    memcached_return_t ue;
-    char* res = memcached_get(tcli, key.c_str(), key.length(), &value_length,
-                              &flags, &ue);
-    if (MEMCACHED_SUCCESS == ue && res != nullptr && value &&
-        value_length >= length) {
-      VLOG(9) << "Get key = " << key << " OK";
-      memcpy(value, res + offset, length);
-      free(res);
-      return true;
-    }
-
-    *errorlog = ResError(ue);
-    if (ue != MEMCACHED_NOTFOUND) {
-      LOG(ERROR) << "Get key = " << key << " error = " << *errorlog
-                 << ", get_value_len = " << value_length
-                 << ", expect_value_len = " << length;
-      memcached_free(tcli);
-      tcli = nullptr;
-    }
-
-    return false;
-  }
+           uint64_t length, std::string* errorlog) override;
+
+  void MGet(std::vector<KVGetRequest>* requests) override;
 
   // transform the res to a error string
   const std::string ResError(const memcached_return_t res) {
@@ -161,29 +108,12 @@ class MemCachedClient : public KVClient {
    * @brief: add a remote memcache server to client,
    * this means just add, you must use push after all server add.
    */
-  bool AddServer(const std::string& hostname, const uint32_t port) {
-    memcached_return_t res;
-    server_ =
-        memcached_server_list_append(server_, hostname.c_str(), port, &res);
-    if (MEMCACHED_SUCCESS == res) {
-      return true;
-    }
-    LOG(ERROR) << "client add " << hostname << " " << port << " error";
-    return false;
-  }
+  bool AddServer(const std::string& hostname, const uint32_t port);
 
   /**
    * @brief: push the server list to the client
    */
-  bool PushServer() {
-    memcached_return_t res = memcached_server_push(client_, server_);
-    if (MEMCACHED_SUCCESS == res) {
-      return true;
-    }
-    memcached_server_list_free(server_);
-    server_ = nullptr;
-    return false;
-  }
+  bool PushServer();
 
   /**
    * @return: return this client number of remote servers
@@ -192,10 +122,32 @@ class MemCachedClient : public KVClient {
     return static_cast<int>(memcached_server_count(client_));
   }
 
+ private:
+  struct Connection {
+    memcached_st* mc;
+    memcached_result_st result;  // reused by the gets
+  };
+
+  void SetBehaviors(memcached_st* mc);
+
+  // Borrow a connection, it blocks if all connections are in use, and
+  // returns nullptr if it fails to create one
+  Connection* Acquire();
+
+  // Return the connection, it's reset if |broken|
+  void Release(Connection* conn, bool broken);
+
  private:
   using KVClient::Init;
   memcached_server_st* server_;
   memcached_st* client_;
+
+  uint32_t pool_size_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  uint32_t num_conns_;  // including the ones being created
+  std::vector<std::unique_ptr<Connection>> conns_;
+  std::vector<Connection*> idle_conns_;
 };
 
 }  //  namespace client
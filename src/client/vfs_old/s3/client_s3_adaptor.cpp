@@ -25,6 +25,8 @@
 #include <brpc/channel.h>
 #include <brpc/controller.h>
 
+#include <algorithm>
+
 #include "client/blockcache/block_cache.h"
 #include "client/blockcache/error.h"
 #include "client/datastream/data_stream.h"
@@ -80,6 +82,19 @@ S3ClientAdaptorImpl::Init(const S3ClientAdaptorOption& option,
   filesystem_ = filesystem;
   block_cache_ = block_cache;
   kvClientManager_ = std::move(kvClientManager);
+  flight_ = std::make_shared<blockcache::SingleFlight>();
+  readaheadOption_.blockSize = blockSize_;
+  readaheadOption_.minBlocks = std::max(prefetchBlocks_, 1U);
+  readaheadOption_.maxBlocks =
+      std::max(option.readaheadMaxBlocks, readaheadOption_.minBlocks);
+  readaheadBudget_ = std::make_shared<ReadaheadBudget>(
+      option.readaheadMaxMemoryByte, option.readaheadMaxBandwidthByte,
+      option.readaheadIdleTimeoutMs);
+  readPlannerOption_.mergeGapBytes = option.readMergeGapByte;
+  readPlannerOption_.splitBytes = option.readSplitByte;
+  readMaxInflightRanges_ = std::max(option.readMaxInflightRanges, 1U);
+  writeMergeGapByte_ = option.writeMergeGapByte;
+  writeAlignBlock_ = option.writeAlignBlock;
 
   // init block cache
   {
@@ -90,16 +105,14 @@ S3ClientAdaptorImpl::Init(const S3ClientAdaptorOption& option,
     }
   }
 
-  if (HasDiskCache()) {
-    // init rpc send exec-queue
-    downloadTaskQueues_.resize(prefetchExecQueueNum_);
-    for (auto& q : downloadTaskQueues_) {
-      int rc = bthread::execution_queue_start(
-          &q, nullptr, &S3ClientAdaptorImpl::ExecAsyncDownloadTask, this);
-      if (rc != 0) {
-        LOG(ERROR) << "Init AsyncRpcQueues failed";
-        return DINGOFS_ERROR::INTERNAL;
-      }
+  // init rpc send exec-queue, readahead works without cache store too
+  downloadTaskQueues_.resize(std::max(prefetchExecQueueNum_, 1U));
+  for (auto& q : downloadTaskQueues_) {
+    int rc = bthread::execution_queue_start(
+        &q, nullptr, &S3ClientAdaptorImpl::ExecAsyncDownloadTask, this);
+    if (rc != 0) {
+      LOG(ERROR) << "Init AsyncRpcQueues failed";
+      return DINGOFS_ERROR::INTERNAL;
     }
   }
   if (startBackGround) {
@@ -111,6 +124,15 @@ S3ClientAdaptorImpl::Init(const S3ClientAdaptorOption& option,
             << ", chunk size: " << chunkSize_
             << ", prefetchBlocks: " << prefetchBlocks_
             << ", prefetchExecQueueNum: " << prefetchExecQueueNum_
+            << ", readaheadMaxBlocks: " << readaheadOption_.maxBlocks
+            << ", readaheadMaxMemoryByte: " << option.readaheadMaxMemoryByte
+            << ", readaheadMaxBandwidthByte: "
+            << option.readaheadMaxBandwidthByte
+            << ", readMergeGapByte: " << option.readMergeGapByte
+            << ", readSplitByte: " << option.readSplitByte
+            << ", readMaxInflightRanges: " << readMaxInflightRanges_
+            << ", writeMergeGapByte: " << writeMergeGapByte_
+            << ", writeAlignBlock: " << writeAlignBlock_
             << ", intervalMs: " << option.intervalMs
             << ", flushIntervalSec: " << option.flushIntervalSec
             << ", writeCacheMaxByte: " << option.writeCacheMaxByte
@@ -132,9 +154,7 @@ int S3ClientAdaptorImpl::Write(uint64_t inodeId, uint64_t offset,
     fsCacheManager_->DataCacheByteInc(length);
 
     // Write stall for memory near full
-    while (DataStream::GetInstance().MemoryNearFull()) {
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
-    }
+    DataStream::GetInstance().WaitMemoryNotFull();
   }
 
   FileCacheManagerPtr file_cache_manager =
@@ -163,6 +183,17 @@ int S3ClientAdaptorImpl::Read(uint64_t inode_id, uint64_t offset,
   return ret;
 }
 
+int S3ClientAdaptorImpl::ReadSplice(uint64_t inode_id, uint64_t offset,
+                                    uint64_t length,
+                                    vfs::SpliceBuffer* buffer) {
+  FileCacheManagerPtr file_cache_manager =
+      fsCacheManager_->FindOrCreateFileCacheManager(fsId_, inode_id);
+  if (!file_cache_manager->ReadSplice(offset, length, buffer)) {
+    return -1;
+  }
+  return 0;
+}
+
 DINGOFS_ERROR S3ClientAdaptorImpl::Truncate(InodeWrapper* inodeWrapper,
                                             uint64_t size) {
   const auto* inode = inodeWrapper->GetInodeLocked();
@@ -242,6 +273,14 @@ void S3ClientAdaptorImpl::ReleaseCache(uint64_t inodeId) {
   fsCacheManager_->ReleaseFileCacheManager(inodeId);
 }
 
+void S3ClientAdaptorImpl::ReleaseReadahead(uint64_t inodeId) {
+  FileCacheManagerPtr fileCacheManager =
+      fsCacheManager_->FindFileCacheManager(inodeId);
+  if (fileCacheManager) {
+    fileCacheManager->ReleaseReadahead();
+  }
+}
+
 DINGOFS_ERROR S3ClientAdaptorImpl::Flush(uint64_t inode_id) {
   FileCacheManagerPtr file_cache_manager =
       fsCacheManager_->FindFileCacheManager(inode_id);
@@ -249,7 +288,15 @@ DINGOFS_ERROR S3ClientAdaptorImpl::Flush(uint64_t inode_id) {
     return DINGOFS_ERROR::OK;
   }
   VLOG(6) << "Flush data of inodeId=" << inode_id;
-  return file_cache_manager->Flush(true, false);
+
+  // fsync or close is waiting, its flush goes before background flush
+  DataStream::GetInstance().BeginUrgentFlush(inode_id);
+  DINGOFS_ERROR rc = file_cache_manager->Flush(true, false);
+  if (rc == DINGOFS_ERROR::OK) {
+    file_cache_manager->WaitFlush();
+  }
+  DataStream::GetInstance().EndUrgentFlush(inode_id);
+  return rc;
 }
 
 DINGOFS_ERROR S3ClientAdaptorImpl::FsSync() {
@@ -274,13 +321,14 @@ void S3ClientAdaptorImpl::BackGroundFlush() {
     if (DataStream::GetInstance().MemoryNearFull()) {
       VLOG(3) << "BackGroundFlush radically, write cache num is: "
               << fsCacheManager_->GetDataCacheNum();
-      fsCacheManager_->FsSync(true);
+      // wait for the writeback, which releases the memory
+      fsCacheManager_->FsSync(true, true);
 
     } else {
       waitInterval_.WaitForNextExcution();
       VLOG(6) << "BackGroundFlush, write cache num is:"
               << fsCacheManager_->GetDataCacheNum();
-      fsCacheManager_->FsSync(false);
+      fsCacheManager_->FsSync(false, false);
       VLOG(6) << "background fssync end";
     }
   }
@@ -294,11 +342,9 @@ int S3ClientAdaptorImpl::Stop() {
   if (bgFlushThread_.joinable()) {
     bgFlushThread_.join();
   }
-  if (HasDiskCache()) {
-    for (auto& q : downloadTaskQueues_) {
-      bthread::execution_queue_stop(q);
-      bthread::execution_queue_join(q);
-    }
+  for (auto& q : downloadTaskQueues_) {
+    bthread::execution_queue_stop(q);
+    bthread::execution_queue_join(q);
   }
   block_cache_->Shutdown();
   return 0;
@@ -330,7 +376,12 @@ DINGOFS_ERROR S3ClientAdaptorImpl::FlushAllCache(uint64_t inodeId) {
 
   // force flush data in memory to s3
   VLOG(6) << "FlushAllCache, flush memory data of inodeId=" << inodeId;
+  DataStream::GetInstance().BeginUrgentFlush(inodeId);
   DINGOFS_ERROR ret = fileCacheManager->Flush(true, false);
+  if (ret == DINGOFS_ERROR::OK) {
+    fileCacheManager->WaitFlush();
+  }
+  DataStream::GetInstance().EndUrgentFlush(inodeId);
   if (ret != DINGOFS_ERROR::OK) {
     return ret;
   }
@@ -355,7 +406,7 @@ DINGOFS_ERROR S3ClientAdaptorImpl::FlushAllCache(uint64_t inodeId) {
 void S3ClientAdaptorImpl::Enqueue(
     std::shared_ptr<FlushChunkCacheContext> context) {
   auto task = [this, context]() { this->FlushChunkClosure(context); };
-  DataStream::GetInstance().EnterFlushChunkQueue(task);
+  DataStream::GetInstance().EnterFlushChunkQueue(context->inode, task);
 }
 
 int S3ClientAdaptorImpl::FlushChunkClosure(
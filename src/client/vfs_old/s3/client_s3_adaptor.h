@@ -24,17 +24,21 @@
 
 #include <bthread/execution_queue.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "client/blockcache/block_cache.h"
 #include "client/blockcache/s3_client.h"
+#include "client/blockcache/single_flight.h"
 #include "client/vfs_old/common/config.h"
 #include "client/vfs_old/filesystem/error.h"
 #include "client/vfs_old/filesystem/filesystem.h"
 #include "client/vfs_old/inode_cache_manager.h"
 #include "client/vfs_old/s3/client_s3_cache_manager.h"
+#include "client/vfs_old/s3/read_planner.h"
+#include "client/vfs_old/s3/readahead.h"
 #include "stub/rpcclient/mds_client.h"
 #include "utils/wait_interval.h"
 
@@ -71,8 +75,14 @@ class S3ClientAdaptor {
                     const char* buf) = 0;
   virtual int Read(uint64_t inodeId, uint64_t offset, uint64_t length,
                    char* buf) = 0;
+  // Resolve the range into the block file cached on local disk, return 0
+  // if the whole range is held by it.
+  virtual int ReadSplice(uint64_t inodeId, uint64_t offset, uint64_t length,
+                         vfs::SpliceBuffer* buffer) = 0;
   virtual DINGOFS_ERROR Truncate(InodeWrapper* inodeWrapper, uint64_t size) = 0;
   virtual void ReleaseCache(uint64_t inodeId) = 0;
+  // Drop the readahead data of the file, e.g. it's closed.
+  virtual void ReleaseReadahead(uint64_t inodeId) = 0;
   virtual DINGOFS_ERROR Flush(uint64_t inodeId) = 0;
   virtual DINGOFS_ERROR FlushAllCache(uint64_t inodeId) = 0;
   virtual DINGOFS_ERROR FsSync() = 0;
@@ -86,6 +96,8 @@ class S3ClientAdaptor {
   virtual uint32_t GetObjectPrefix() = 0;
   virtual std::shared_ptr<blockcache::BlockCache> GetBlockCache() = 0;
   virtual bool HasDiskCache() = 0;
+  // The reads of files which are waiting on s3 now
+  virtual uint32_t GetForegroundReads() = 0;
 };
 
 using FlushChunkCacheCallBack =
@@ -128,8 +140,12 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
   int Read(uint64_t inode_id, uint64_t offset, uint64_t length,
            char* buf) override;
 
+  int ReadSplice(uint64_t inode_id, uint64_t offset, uint64_t length,
+                 vfs::SpliceBuffer* buffer) override;
+
   DINGOFS_ERROR Truncate(InodeWrapper* inodeWrapper, uint64_t size) override;
   void ReleaseCache(uint64_t inodeId) override;
+  void ReleaseReadahead(uint64_t inodeId) override;
   DINGOFS_ERROR Flush(uint64_t inode_id) override;
   DINGOFS_ERROR FlushAllCache(uint64_t inodeId) override;
   DINGOFS_ERROR FsSync() override;
@@ -152,6 +168,11 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     return block_cache_->GetStoreType() == blockcache::StoreType::DISK;
   }
 
+  // Whether the block cache can hold the prefetched blocks (disk or memory).
+  bool HasCacheStore() {
+    return block_cache_->GetStoreType() != blockcache::StoreType::NONE;
+  }
+
   std::shared_ptr<InodeCacheManager> GetInodeCacheManager() {
     return inodeManager_;
   }
@@ -164,6 +185,44 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     return block_cache_;
   }
 
+  // Coalesce the concurrent reads of the same block from s3
+  std::shared_ptr<blockcache::SingleFlight> GetSingleFlight() {
+    return flight_;
+  }
+
+  const ReadaheadOption& GetReadaheadOption() const {
+    return readaheadOption_;
+  }
+
+  // The readahead budget shared by all files
+  std::shared_ptr<ReadaheadBudget> GetReadaheadBudget() {
+    return readaheadBudget_;
+  }
+
+  const ReadPlannerOption& GetReadPlannerOption() const {
+    return readPlannerOption_;
+  }
+
+  uint32_t GetReadMaxInflightRanges() const { return readMaxInflightRanges_; }
+
+  // The background fetches (e.g. warmup) back off while the reads of
+  // files are waiting on s3
+  void BeginForegroundRead() {
+    foregroundReads_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void EndForegroundRead() {
+    foregroundReads_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  uint32_t GetForegroundReads() override {
+    return foregroundReads_.load(std::memory_order_relaxed);
+  }
+
+  uint64_t GetWriteMergeGapByte() const { return writeMergeGapByte_; }
+
+  bool IsWriteAlignBlock() const { return writeAlignBlock_; }
+
   pb::mds::FSStatusCode AllocS3ChunkId(uint32_t fsId, uint32_t idNum,
                                        uint64_t* chunkId) override;
 
@@ -242,6 +301,14 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
   int FlushChunkClosure(std::shared_ptr<FlushChunkCacheContext> context);
 
   std::shared_ptr<KVClientManager> kvClientManager_ = nullptr;
+  std::shared_ptr<blockcache::SingleFlight> flight_;
+  ReadaheadOption readaheadOption_;
+  std::shared_ptr<ReadaheadBudget> readaheadBudget_;
+  ReadPlannerOption readPlannerOption_;
+  uint32_t readMaxInflightRanges_ = 16;
+  std::atomic<uint32_t> foregroundReads_{0};
+  uint64_t writeMergeGapByte_ = 0;
+  bool writeAlignBlock_ = false;
 };
 
 }  // namespace client
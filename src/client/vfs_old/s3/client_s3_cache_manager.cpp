@@ -26,6 +26,11 @@
 #include <malloc.h>
 #include <sys/types.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <random>
+#include <thread>
 #include <utility>
 
 #include "absl/cleanup/cleanup.h"
@@ -56,9 +61,12 @@ using blockcache::Block;
 using blockcache::BlockContext;
 using blockcache::BlockFrom;
 using blockcache::BlockKey;
+using blockcache::BlockReader;
+using blockcache::FlightCall;
 using blockcache::StrErr;
 
 using datastream::DataStream;
+using datastream::PageKey;
 using filesystem::Ino;
 using stub::metric::MetricGuard;
 using stub::metric::S3Metric;
@@ -212,7 +220,7 @@ bool FsCacheManager::Delete(std::list<DataCachePtr>::iterator iter) {
   return true;
 }
 
-DINGOFS_ERROR FsCacheManager::FsSync(bool force) {
+DINGOFS_ERROR FsCacheManager::FsSync(bool force, bool wait) {
   std::unordered_map<uint64_t, FileCacheManagerPtr> pending;
   {
     WriteLockGuard writeLockGuard(rwLock_);
@@ -262,6 +270,9 @@ DINGOFS_ERROR FsCacheManager::FsSync(bool force) {
     auto file = item.second;
     DataStream::GetInstance().EnterFlushFileQueue([&, ino, file, post_flush]() {
       auto code = file->Flush(force);
+      if (code == DINGOFS_ERROR::OK && wait) {
+        file->WaitFlush();
+      }
       post_flush(ino, file, code);
       if (code != DINGOFS_ERROR::OK && code != DINGOFS_ERROR::NOTEXIST) {
         rc = code;
@@ -273,6 +284,23 @@ DINGOFS_ERROR FsCacheManager::FsSync(bool force) {
   return rc;
 }
 
+FileCacheManager::FileCacheManager(
+    uint32_t fsid, uint64_t inode, S3ClientAdaptorImpl* s3ClientAdaptor,
+    std::shared_ptr<KVClientManager> kvClientManager,
+    std::shared_ptr<utils::TaskThreadPool<>> threadPool)
+    : fsId_(fsid),
+      inode_(inode),
+      s3ClientAdaptor_(s3ClientAdaptor),
+      kvClientManager_(std::move(kvClientManager)),
+      readTaskPool_(threadPool) {
+  if (s3ClientAdaptor != nullptr &&
+      s3ClientAdaptor->GetReadaheadBudget() != nullptr) {
+    readahead_ = std::make_shared<Readahead>(
+        s3ClientAdaptor->GetReadaheadOption(),
+        s3ClientAdaptor->GetReadaheadBudget());
+  }
+}
+
 int FileCacheManager::Write(uint64_t offset, uint64_t length,
                             const char* dataBuf) {
   uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
@@ -402,32 +430,37 @@ int FileCacheManager::GenerateKVRequest(
     const std::shared_ptr<InodeWrapper>& inode_wrapper,
     const std::vector<ReadRequest>& read_request, char* data_buf,
     std::vector<S3ReadRequest>* kv_request) {
-  ::dingofs::utils::UniqueLock lg_guard = inode_wrapper->GetUniqueLock();
-
-  const Inode* inode = inode_wrapper->GetInodeLocked();
-  const auto* s3chunkinfo = inode_wrapper->GetChunkInfoMap();
+  uint64_t fs_id, inode_id;
+  std::vector<std::shared_ptr<SliceIndex>> slice_indexes;
+  slice_indexes.reserve(read_request.size());
+  {
+    // only hold the inode lock to fetch the slice indexes,
+    // the requests are resolved against them out of the lock.
+    ::dingofs::utils::UniqueLock lg_guard = inode_wrapper->GetUniqueLock();
+    const Inode* inode = inode_wrapper->GetInodeLocked();
+    fs_id = inode->fsid();
+    inode_id = inode->inodeid();
+    for (const auto& req : read_request) {
+      slice_indexes.emplace_back(inode_wrapper->GetSliceIndexLocked(req.index));
+    }
+  }
 
-  for_each(
-      read_request.begin(), read_request.end(), [&](const ReadRequest& req) {
-        VLOG(6) << "inodeId=" << inode->inodeid()
-                << " requset: " << req.DebugString();
+  for (size_t i = 0; i < read_request.size(); i++) {
+    const auto& req = read_request[i];
+    VLOG(6) << "inodeId=" << inode_id << " requset: " << req.DebugString();
 
-        auto info_iter = s3chunkinfo->find(req.index);
-        if (info_iter == s3chunkinfo->end()) {
-          VLOG(6) << "inodeId=" << inode->inodeid()
-                  << " s3chunkinfo do not find index = " << req.index;
-          memset(data_buf + req.bufOffset, 0, req.len);
-          return;
-        } else {
-          std::vector<S3ReadRequest> tmp_kv_requests;
-          GenerateS3Request(req, info_iter->second, data_buf, &tmp_kv_requests,
-                            inode->fsid(), inode->inodeid());
-          kv_request->insert(kv_request->end(), tmp_kv_requests.begin(),
-                             tmp_kv_requests.end());
-        }
-      });
+    const auto& slice_index = slice_indexes[i];
+    if (nullptr == slice_index) {
+      VLOG(6) << "inodeId=" << inode_id
+              << " s3chunkinfo do not find index = " << req.index;
+      memset(data_buf + req.bufOffset, 0, req.len);
+      continue;
+    }
+    GenerateS3Request(req, *slice_index, data_buf, kv_request, fs_id,
+                      inode_id);
+  }
 
-  VLOG(9) << "inodeId=" << inode->inodeid() << " process "
+  VLOG(9) << "inodeId=" << inode_id << " process "
           << S3ReadRequestVecDebugString(*kv_request) << " ok";
 
   return 0;
@@ -490,18 +523,194 @@ int FileCacheManager::Read(uint64_t inode_id, uint64_t offset, uint64_t length,
     return -1;
   }
 
+  // readahead is issued before the read, so it overlaps with current read
+  PrefetchForRead(inode_wrapper, offset, length);
+
+  std::vector<PageFill> page_fills;
+  ReadFromPageCache(inode_wrapper, &mem_cache_miss_request, data_buf,
+                    &page_fills);
+  if (mem_cache_miss_request.empty()) {
+    return actual_read_len;
+  }
+
+  int rc = ReadFromKV(inode_wrapper, mem_cache_miss_request, data_buf);
+  if (rc != 0) {
+    return rc;
+  }
+  FillPageCache(page_fills, data_buf);
+  return actual_read_len;
+}
+
+bool FileCacheManager::ReadSplice(uint64_t offset, uint64_t length,
+                                  vfs::SpliceBuffer* buffer) {
+  uint64_t chunk_index = 0;
+  uint64_t chunk_pos = 0;
+  uint64_t block_index = 0;
+  uint64_t block_pos = 0;
+  GetBlockLoc(offset, &chunk_index, &chunk_pos, &block_index, &block_pos);
+
+  const uint64_t block_size = s3ClientAdaptor_->GetBlockSize();
+  const uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
+  if (length == 0 || block_pos + length > block_size) {  // cross blocks
+    return false;
+  }
+
+  // the dirty data is newer than the block cached on disk
+  if (FindOrCreateChunkCacheManager(chunk_index)->HasDirtyData()) {
+    return false;
+  }
+
+  std::shared_ptr<InodeWrapper> inode_wrapper;
+  auto inode_manager = s3ClientAdaptor_->GetInodeCacheManager();
+  if (DINGOFS_ERROR::OK != inode_manager->GetInode(inode_, inode_wrapper)) {
+    return false;
+  }
+
+  std::shared_ptr<SliceIndex> slice_index;
+  {
+    ::dingofs::utils::UniqueLock lg_guard = inode_wrapper->GetUniqueLock();
+    slice_index = inode_wrapper->GetSliceIndexLocked(chunk_index);
+  }
+  if (slice_index == nullptr) {
+    return false;
+  }
+
+  // the whole range must be served by the same slice
+  auto ranges = slice_index->Resolve(offset, length);
+  if (ranges.size() != 1 || ranges[0].hole || ranges[0].slice.zero) {
+    return false;
+  }
+
+  const auto& slice = ranges[0].slice;
+  uint64_t object_offset = 0;
+  if (offset / block_size == slice.offset / block_size) {
+    object_offset = slice.offset % chunk_size % block_size;
+  }
+  BlockKey key(fsId_, inode_, slice.chunkId, block_index, slice.compaction);
+
+  auto block_cache = s3ClientAdaptor_->GetBlockCache();
+  if (!block_cache->IsCached(key)) {
+    return false;
+  }
+
+  std::shared_ptr<BlockReader> reader;
+  auto rc = block_cache->Load(key, reader);
+  if (rc != BCACHE_ERROR::OK) {
+    return false;
+  }
+
+  int fd;
+  off_t fd_offset;
+  if (!reader->Fd(block_pos - object_offset, length, &fd, &fd_offset)) {
+    reader->Close();
+    return false;
+  }
+
+  PrefetchForRead(inode_wrapper, offset, length);
+
+  buffer->fd = fd;
+  buffer->offset = fd_offset;
+  buffer->size = length;
+  buffer->release = [reader]() { reader->Close(); };
+  return true;
+}
+
+void FileCacheManager::ReadFromPageCache(
+    const std::shared_ptr<InodeWrapper>& inode_wrapper,
+    std::vector<ReadRequest>* requests, char* data_buf,
+    std::vector<PageFill>* fills) {
+  auto* page_cache = DataStream::GetInstance().GetPageCache();
+  if (page_cache == nullptr) {
+    return;
+  }
+
+  const uint64_t page_size = page_cache->PageSize();
+  const uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
+  const uint64_t file_len = inode_wrapper->GetLength();
+  std::vector<ReadRequest> misses;
+  auto add_miss = [&](uint64_t index, uint64_t chunk_pos, uint64_t len,
+                      uint64_t buf_offset) {
+    if (!misses.empty()) {
+      auto& last = misses.back();
+      if (last.index == index && last.chunkPos + last.len == chunk_pos &&
+          last.bufOffset + last.len == buf_offset) {
+        last.len += len;  // adjacent ranges
+        return;
+      }
+    }
+    misses.push_back(ReadRequest{index, chunk_pos, len, buf_offset});
+  };
+
+  for (const auto& req : *requests) {
+    // the dirty data is newer than s3, the chunk bypasses the cache
+    std::shared_ptr<SliceIndex> slice_index;
+    {
+      ::dingofs::utils::UniqueLock lg_guard = inode_wrapper->GetUniqueLock();
+      slice_index = inode_wrapper->GetSliceIndexLocked(req.index);
+    }
+    if (slice_index == nullptr ||
+        FindOrCreateChunkCacheManager(req.index)->HasDirtyData()) {
+      misses.push_back(req);
+      continue;
+    }
+
+    // the version is taken before reading, the page read later is
+    // never newer than it
+    uint64_t version = slice_index->Version();
+    uint64_t chunk_offset = req.index * chunk_size;
+    uint64_t end = req.chunkPos + req.len;
+    for (uint64_t page = req.chunkPos / page_size; page * page_size < end;
+         page++) {
+      uint64_t page_pos = page * page_size;
+      uint64_t page_end = std::min(page_pos + page_size, chunk_size);
+      if (chunk_offset + page_end > file_len) {
+        page_end = std::max(file_len, chunk_offset + page_pos) - chunk_offset;
+      }
+      uint64_t begin = std::max(page_pos, req.chunkPos);
+      uint64_t stop = std::min(page_pos + page_size, end);
+      uint64_t buf_offset = req.bufOffset + (begin - req.chunkPos);
+      PageKey key{inode_, req.index, page};
+      if (stop <= page_end &&
+          page_cache->Get(key, version, begin - page_pos, stop - begin,
+                          data_buf + buf_offset)) {
+        continue;
+      }
+
+      // only the wanted range is read into the caller's buffer, and the
+      // page is put into the cache from there if it's wholly read
+      add_miss(req.index, begin, stop - begin, buf_offset);
+      if (begin == page_pos && stop == page_end) {
+        fills->push_back(
+            PageFill{key, version, buf_offset, page_end - page_pos});
+      }
+    }
+  }
+
+  *requests = std::move(misses);
+}
+
+void FileCacheManager::FillPageCache(const std::vector<PageFill>& fills,
+                                     const char* data_buf) {
+  auto* page_cache = DataStream::GetInstance().GetPageCache();
+  for (const auto& fill : fills) {
+    page_cache->Put(fill.key, fill.version, data_buf + fill.bufOffset,
+                    fill.length);
+  }
+}
+
+int FileCacheManager::ReadFromKV(
+    const std::shared_ptr<InodeWrapper>& inode_wrapper,
+    const std::vector<ReadRequest>& requests, char* data_buf) {
   uint32_t retry = 0;
   do {
     // generate kv request
     std::vector<S3ReadRequest> kv_requests;
-    GenerateKVRequest(inode_wrapper, mem_cache_miss_request, data_buf,
-                      &kv_requests);
+    GenerateKVRequest(inode_wrapper, requests, data_buf, &kv_requests);
 
     // read from kv cluster (localcache -> remote kv cluster -> s3)
     // localcache/remote kv cluster fail will not return error code.
     // Failure to read from s3 will eventually return failure.
-    ReadStatus ret =
-        ReadKVRequest(kv_requests, data_buf, inode_wrapper->GetLength());
+    ReadStatus ret = ReadKVRequest(kv_requests, data_buf);
     if (ret == ReadStatus::OK) {
       break;
     }
@@ -512,14 +721,24 @@ int FileCacheManager::Read(uint64_t inode_id, uint64_t offset, uint64_t length,
         return -1;
       }
     } else {
-      LOG(WARNING) << "read inodeId=" << inode_id
+      LOG(WARNING) << "read inodeId=" << inode_
                    << " from s3 failed, ret = " << static_cast<int>(ret);
       // TODO: maybe we should return -1 here
       return static_cast<int>(ret);
     }
   } while (true);
 
-  return actual_read_len;
+  return 0;
+}
+
+bool FileCacheManager::ReadKVRequestFromReadahead(const std::string& name,
+                                                  char* databuf,
+                                                  uint64_t offset,
+                                                  uint64_t length) {
+  if (readahead_ == nullptr) {
+    return false;
+  }
+  return readahead_->Read(name, offset, length, databuf);
 }
 
 bool FileCacheManager::ReadKVRequestFromLocalCache(const BlockKey& key,
@@ -541,75 +760,199 @@ bool FileCacheManager::ReadKVRequestFromLocalCache(const BlockKey& key,
   return true;
 }
 
-bool FileCacheManager::ReadKVRequestFromRemoteCache(const std::string& name,
-                                                    char* databuf,
-                                                    uint64_t offset,
-                                                    uint64_t length) {
-  if (!kvClientManager_) {
-    return false;
+bool FileCacheManager::ReadKVRequestFromCacheGroup(const BlockKey& key,
+                                                   char* buffer,
+                                                   uint64_t offset,
+                                                   uint64_t len) {
+  auto block_cache = s3ClientAdaptor_->GetBlockCache();
+  return block_cache->RangePeer(key, offset, len, buffer) == BCACHE_ERROR::OK;
+}
+
+void FileCacheManager::ReadKVRequestFromRemoteCache(
+    std::vector<BlockRead>* reads) {
+  if (!kvClientManager_ || reads->empty()) {
+    return;
+  }
+
+  auto task = std::make_shared<MGetKVCacheTask>();
+  for (const auto& read : *reads) {
+    task->requests.emplace_back(KVGetRequest{read.key.Filename(), read.buffer,
+                                             read.offset, read.length});
   }
 
-  auto task = std::make_shared<GetKVCacheTask>(name, databuf, offset, length);
   CountDownEvent event(1);
-  task->done = [&](const std::shared_ptr<GetKVCacheTask>& task) {
+  task->done = [&](const std::shared_ptr<MGetKVCacheTask>& task) {
     (void)task;
     event.Signal();
-    return;
   };
-  kvClientManager_->Get(task);
+  kvClientManager_->MGet(task);
   event.Wait();
 
-  return task->res;
-}
+  std::vector<BlockRead> misses;
+  for (size_t i = 0; i < reads->size(); i++) {
+    if (task->requests[i].res) {
+      VLOG(9) << "inodeId=" << inode_ << " read " << task->requests[i].key
+              << " from remote cache ok";
+    } else {
+      misses.emplace_back((*reads)[i]);
+    }
+  }
+  *reads = std::move(misses);
+}
+
+bool FileCacheManager::ReadKVRequestFromInflight(const std::string& name,
+                                                 char* databuf,
+                                                 uint64_t offset,
+                                                 uint64_t length) {
+  // the concurrent reads which covered by inflight read (or prefetch)
+  // of the same block will wait for it instead of reading from s3 again
+  return s3ClientAdaptor_->GetSingleFlight()->Join(name, offset, length,
+                                                   databuf);
+}
+
+BCACHE_ERROR FileCacheManager::ReadKVRequestFromS3(
+    std::vector<RangeRead> reads) {
+  ReadPlanner planner(s3ClientAdaptor_->GetReadPlannerOption());
+  auto fetches = planner.Plan(std::move(reads));
+
+  auto s3_client = s3ClientAdaptor_->GetS3Client();
+  auto flight = s3ClientAdaptor_->GetSingleFlight();
+  const uint32_t max_inflight =
+      std::max(s3ClientAdaptor_->GetReadMaxInflightRanges(), 1U);
+
+  std::mutex mutex;  // protect the states below
+  std::condition_variable cond;
+  uint32_t inflight = 0;
+  std::vector<uint32_t> pending(fetches.size());
+  std::vector<BCACHE_ERROR> rcs(fetches.size(), BCACHE_ERROR::OK);
+  std::vector<std::shared_ptr<FlightCall>> calls(fetches.size());
+
+  // the fetch is shared with the concurrent reads via single flight,
+  // it reads into the caller's buffer directly if it serves one read only
+  for (size_t i = 0; i < fetches.size(); i++) {
+    const auto& fetch = fetches[i];
+    char* buffer = nullptr;
+    if (fetch.reads.size() == 1 && fetch.reads[0].offset == fetch.offset &&
+        fetch.reads[0].length == fetch.length) {
+      buffer = fetch.reads[0].buffer;
+    }
+    calls[i] = flight->Begin(fetch.key, fetch.offset, fetch.length, buffer);
+    pending[i] = fetch.parts.size();
+  }
 
-bool FileCacheManager::ReadKVRequestFromS3(const std::string& name,
-                                           char* databuf, uint64_t offset,
-                                           uint64_t length, BCACHE_ERROR* rc) {
-  {
-    *rc = s3ClientAdaptor_->GetS3Client()->Range(name, offset, length, databuf);
-    if (*rc != BCACHE_ERROR::OK) {
-      LOG(ERROR) << "Object " << name << " read from s3 failed"
-                 << ", rc=" << rc << ", " << StrErr(*rc);
-      return false;
+  // End() waits for the joined reads to copy from the borrowed buffer,
+  // so it's invoked out of the lock.
+  auto done = [&](size_t i, BCACHE_ERROR rc) {
+    bool last;
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      if (rc != BCACHE_ERROR::OK) {
+        rcs[i] = rc;
+      }
+      last = (--pending[i] == 0);
+    }
+    if (last) {
+      const auto& fetch = fetches[i];
+      flight->End(fetch.key, calls[i], rcs[i], fetch.length);
+    }
+
+    std::lock_guard<std::mutex> lk(mutex);
+    inflight--;
+    cond.notify_all();
+  };
+
+  // at most |max_inflight| requests are inflight, the pool thread isn't
+  // blocked by them
+  for (size_t i = 0; i < fetches.size(); i++) {
+    const auto& fetch = fetches[i];
+    VLOG(9) << "inodeId=" << inode_ << " read " << fetch.key
+            << " from s3, offset=" << fetch.offset
+            << ", length=" << fetch.length
+            << ", ranges=" << fetch.reads.size()
+            << ", parts=" << fetch.parts.size();
+    for (const auto& part : fetch.parts) {
+      {
+        std::unique_lock<std::mutex> lk(mutex);
+        cond.wait(lk, [&]() { return inflight < max_inflight; });
+        inflight++;
+      }
+      char* buffer = calls[i]->Buffer() + (part.offset - fetch.offset);
+      s3_client->AsyncRange(fetch.key, part.offset, part.length, buffer,
+                            [&done, i](BCACHE_ERROR rc) { done(i, rc); });
     }
   }
 
-  return true;
+  {
+    std::unique_lock<std::mutex> lk(mutex);
+    cond.wait(lk, [&]() { return inflight == 0; });
+  }
+
+  for (size_t i = 0; i < fetches.size(); i++) {
+    const auto& fetch = fetches[i];
+    if (rcs[i] != BCACHE_ERROR::OK) {
+      LOG(ERROR) << "Object " << fetch.key << " read from s3 failed"
+                 << ", rc=" << rcs[i] << ", " << StrErr(rcs[i]);
+      return rcs[i];
+    }
+
+    for (const auto& read : fetch.reads) {
+      char* data = calls[i]->Buffer() + (read.offset - fetch.offset);
+      if (data != read.buffer) {
+        std::memcpy(read.buffer, data, read.length);
+      }
+    }
+  }
+  return BCACHE_ERROR::OK;
 }
 
 FileCacheManager::ReadStatus FileCacheManager::ReadKVRequest(
-    const std::vector<S3ReadRequest>& kv_requests, char* data_buf,
-    uint64_t file_len) {
+    const std::vector<S3ReadRequest>& kv_requests, char* data_buf) {
   absl::BlockingCounter counter(kv_requests.size());
-  std::once_flag cancel_flag;
-  std::atomic<bool> is_canceled{false};
-  std::atomic<BCACHE_ERROR> ret_code{BCACHE_ERROR::OK};
+  std::mutex mutex;
+  std::vector<BlockRead> misses;
 
   for (const auto& req : kv_requests) {
     readTaskPool_->Enqueue([&]() {
       auto defer = absl::MakeCleanup([&]() { counter.DecrementCount(); });
-      if (is_canceled) {
-        LOG(WARNING) << "kv request is canceled " << req.DebugString();
-        return;
-      }
-      ProcessKVRequest(req, data_buf, file_len, cancel_flag, is_canceled,
-                       ret_code);
+      ProcessKVRequest(req, data_buf, &misses, &mutex);
     });
   }
 
   counter.Wait();
 
-  VLOG(3) << "read  inodeId=" << inode_
-          << " kv request end, ret_code : " << ret_code.load()
-          << ", is_canceled: " << is_canceled.load();
-  return toReadStatus(ret_code.load());
+  // read from remotecache -> inflight -> s3
+  ReadKVRequestFromRemoteCache(&misses);
+
+  std::vector<RangeRead> s3_reads;
+  for (const auto& miss : misses) {
+    std::string store_key = miss.key.StoreKey();
+    if (ReadKVRequestFromInflight(store_key, miss.buffer, miss.offset,
+                                  miss.length)) {
+      VLOG(9) << "inodeId=" << inode_ << " read " << store_key
+              << " from inflight read ok";
+      continue;
+    }
+
+    // read from s3 later, merged with the other ranges
+    s3_reads.emplace_back(
+        RangeRead{store_key, miss.offset, miss.length, miss.buffer});
+  }
+
+  BCACHE_ERROR rc = BCACHE_ERROR::OK;
+  if (!s3_reads.empty()) {
+    s3ClientAdaptor_->BeginForegroundRead();
+    rc = ReadKVRequestFromS3(std::move(s3_reads));
+    s3ClientAdaptor_->EndForegroundRead();
+  }
+
+  VLOG(3) << "read  inodeId=" << inode_ << " kv request end, rc : " << rc;
+  return toReadStatus(rc);
 }
 
 void FileCacheManager::ProcessKVRequest(const S3ReadRequest& req,
-                                        char* data_buf, uint64_t file_len,
-                                        std::once_flag& cancel_flag,
-                                        std::atomic<bool>& is_canceled,
-                                        std::atomic<BCACHE_ERROR>& ret_code) {
+                                        char* data_buf,
+                                        std::vector<BlockRead>* misses,
+                                        std::mutex* mutex) {
   VLOG(3) << "read inodeId=" << inode_ << " from kv request "
           << req.DebugString();
   uint64_t chunk_index = 0;
@@ -618,12 +961,7 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest& req,
   uint64_t block_pos = 0;
   GetBlockLoc(req.offset, &chunk_index, &chunk_pos, &block_index, &block_pos);
 
-  const uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
   const uint64_t block_size = s3ClientAdaptor_->GetBlockSize();
-  // prefetch
-  if (s3ClientAdaptor_->HasDiskCache()) {
-    PrefetchForBlock(req, file_len, block_size, chunk_size, block_index);
-  }
 
   // read request
   // |--------------------------------|----------------------------------|
@@ -645,42 +983,34 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest& req,
                  req.compaction);
     char* current_buf = data_buf + req.readOffset + read_buf_offset;
 
-    // read from localcache -> remotecache -> s3
+    // read from readahead -> localcache -> cache group, the rest later
     do {
-      std::string name = key.Filename();
       std::string store_key = key.StoreKey();
-      if (ReadKVRequestFromLocalCache(
-              key, current_buf, block_pos - object_offset, current_read_len)) {
+      if (ReadKVRequestFromReadahead(store_key, current_buf,
+                                     block_pos - object_offset,
+                                     current_read_len)) {
         VLOG(9) << "inodeId=" << inode_ << " read " << store_key
-                << " from local cache ok";
+                << " from readahead ok";
         break;
       }
 
-      if (ReadKVRequestFromRemoteCache(
-              name, current_buf, block_pos - object_offset, current_read_len)) {
-        VLOG(9) << "inodeId=" << inode_ << " read " << name
-                << " from remote cache ok";
+      if (ReadKVRequestFromLocalCache(
+              key, current_buf, block_pos - object_offset, current_read_len)) {
+        VLOG(9) << "inodeId=" << inode_ << " read " << store_key
+                << " from local cache ok";
         break;
       }
 
-      BCACHE_ERROR rc = BCACHE_ERROR::OK;
-      if (ReadKVRequestFromS3(store_key, current_buf, block_pos - object_offset,
-                              current_read_len, &rc)) {
+      if (ReadKVRequestFromCacheGroup(
+              key, current_buf, block_pos - object_offset, current_read_len)) {
         VLOG(9) << "inodeId=" << inode_ << " read " << store_key
-                << " from s3 ok";
+                << " from cache group ok";
         break;
       }
 
-      LOG(ERROR) << "inodeId=" << inode_ << " read " << name << " fail"
-                 << ", rc:" << rc;
-
-      // make sure variable is set only once
-      std::call_once(cancel_flag, [&]() {
-        is_canceled.store(true);
-        ret_code.store(rc);
-      });
-
-      return;
+      std::lock_guard<std::mutex> lk(*mutex);
+      misses->emplace_back(BlockRead{key, block_pos - object_offset,
+                                     current_read_len, current_buf});
     } while (false);
 
     // update param
@@ -694,59 +1024,101 @@ void FileCacheManager::ProcessKVRequest(const S3ReadRequest& req,
   }
 }
 
-void FileCacheManager::PrefetchForBlock(const S3ReadRequest& req,
-                                        uint64_t fileLen, uint64_t blockSize,
-                                        uint64_t chunkSize,
-                                        uint64_t startBlockIndex) {
-  uint32_t prefetchBlocks = s3ClientAdaptor_->GetPrefetchBlocks();
-  uint32_t objectPrefix = s3ClientAdaptor_->GetObjectPrefix();
-  std::vector<std::pair<BlockKey, uint64_t>> prefetchObjs;
+void FileCacheManager::PrefetchForRead(
+    const std::shared_ptr<InodeWrapper>& inode_wrapper, uint64_t offset,
+    uint64_t length) {
+  if (readahead_ == nullptr) {
+    return;
+  }
 
-  uint64_t blockIndex = startBlockIndex;
-  for (uint32_t i = 0; i < prefetchBlocks; i++) {
-    BlockKey key(req.fsId, req.inodeId, req.chunkId, blockIndex,
-                 req.compaction);
-    uint64_t maxReadLen = (blockIndex + 1) * blockSize;
-    uint64_t needReadLen =
-        maxReadLen > fileLen ? fileLen - blockIndex * blockSize : blockSize;
+  uint64_t file_len = inode_wrapper->GetLength();
+  auto ranges = readahead_->OnRead(offset, length, file_len);
+  if (ranges.empty()) {
+    return;
+  }
 
-    prefetchObjs.push_back(std::make_pair(key, needReadLen));
+  // resolve the readahead ranges into blocks by the slices cover them
+  const uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
+  const uint64_t block_size = s3ClientAdaptor_->GetBlockSize();
+  std::vector<PrefetchBlock> prefetch_objs;
+  for (const auto& range : ranges) {
+    uint64_t pos = range.offset;
+    uint64_t end = range.offset + range.len;
+    while (pos < end) {
+      uint64_t chunk_index = pos / chunk_size;
+      uint64_t n = std::min(end, (chunk_index + 1) * chunk_size) - pos;
+      std::shared_ptr<SliceIndex> slice_index;
+      {
+        ::dingofs::utils::UniqueLock lg_guard = inode_wrapper->GetUniqueLock();
+        slice_index = inode_wrapper->GetSliceIndexLocked(chunk_index);
+      }
 
-    blockIndex++;
-    if (maxReadLen > fileLen || blockIndex >= chunkSize / blockSize) {
-      break;
+      if (slice_index != nullptr) {
+        for (const auto& piece : slice_index->Resolve(pos, n)) {
+          if (piece.hole || piece.slice.zero) {
+            continue;
+          }
+
+          uint64_t piece_end = piece.offset + piece.len;
+          for (uint64_t block = piece.offset / block_size;
+               block * block_size < piece_end; block++) {
+            BlockKey key(fsId_, inode_, piece.slice.chunkId,
+                         block * block_size % chunk_size / block_size,
+                         piece.slice.compaction);
+            if (!prefetch_objs.empty() &&
+                prefetch_objs.back().key.StoreKey() == key.StoreKey()) {
+              continue;
+            }
+
+            uint64_t block_end = std::min((block + 1) * block_size, file_len);
+            prefetch_objs.push_back(
+                PrefetchBlock{key, block_end - block * block_size, block_end});
+          }
+        }
+      }
+      pos += n;
     }
   }
 
-  PrefetchS3Objs(prefetchObjs);
+  PrefetchS3Objs(prefetch_objs);
 }
 
 class AsyncPrefetchCallback {
  public:
-  AsyncPrefetchCallback(BlockKey key, uint64_t inode,
-                        S3ClientAdaptorImpl* s3Client, int64_t startTime)
-      : key(key), inode_(inode), s3Client_(s3Client), startTime_(startTime) {}
+  AsyncPrefetchCallback(BlockKey key, S3ClientAdaptorImpl* s3Client,
+                        int64_t startTime, std::shared_ptr<FlightCall> call,
+                        std::shared_ptr<Readahead> readahead)
+      : key(key),
+        s3Client_(s3Client),
+        startTime_(startTime),
+        call_(call),
+        readahead_(readahead) {}
 
   void operator()(const aws::S3Adapter*,
                   const std::shared_ptr<GetObjectAsyncContext>& context) {
     VLOG(9) << "prefetch end: " << context->key << ", len " << context->len
             << "actual len: " << context->actualLen;
-    std::unique_ptr<char[]> guard(context->buf);
+    // wake up the reads which wait for this prefetch
+    auto flight_guard = absl::MakeCleanup([&]() {
+      s3Client_->GetSingleFlight()->End(
+          context->key, call_,
+          context->retCode == 0 ? BCACHE_ERROR::OK : BCACHE_ERROR::IO_ERROR,
+          context->actualLen);
+    });
     // prefetch s3 data metrics
     MetricGuard metric_guard(&context->retCode,
                              &S3Metric::GetInstance().read_s3,
                              context->actualLen, startTime_);
-    auto file_cache =
-        s3Client_->GetFsCacheManager()->FindFileCacheManager(inode_);
 
-    if (!file_cache) {
-      VLOG(3) << "prefetch inodeId=" << inode_
-              << " end, but file cache is released, key: " << context->key;
+    if (context->retCode != 0) {
+      LOG(WARNING) << "prefetch failed, key: " << context->key;
+      readahead_->Abort(context->key);
       return;
     }
 
-    if (context->retCode != 0) {
-      LOG(WARNING) << "prefetch failed, key: " << context->key;
+    // without cache store, the data is held in memory until it's passed
+    if (!s3Client_->HasCacheStore()) {
+      readahead_->Complete(context->key, call_, context->actualLen);
       return;
     }
 
@@ -757,55 +1129,56 @@ class AsyncPrefetchCallback {
       LOG_EVERY_SECOND(INFO)
           << "Cache block( " << key.Filename() << ") failed: " << StrErr(rc);
     }
-
-    {
-      dingofs::utils::LockGuard lg(file_cache->downloadMtx_);
-      file_cache->downloadingObj_.erase(context->key);
-    }
+    readahead_->Complete(context->key, nullptr, context->actualLen);
   }
 
  private:
   BlockKey key;
-  const uint64_t inode_;
   S3ClientAdaptorImpl* s3Client_;
   int64_t startTime_;
+  std::shared_ptr<FlightCall> call_;  // own the prefetch buffer
+  std::shared_ptr<Readahead> readahead_;
 };
 
 void FileCacheManager::PrefetchS3Objs(
-    const std::vector<std::pair<BlockKey, uint64_t>>& prefetchObjs) {
+    const std::vector<PrefetchBlock>& prefetchObjs) {
+  bool has_cache_store = s3ClientAdaptor_->HasCacheStore();
   for (const auto& obj : prefetchObjs) {
-    BlockKey key = obj.first;
+    BlockKey key = obj.key;
     std::string name = key.StoreKey();
-    uint64_t read_len = obj.second;
-    dingofs::utils::LockGuard lg(downloadMtx_);
-    if (downloadingObj_.find(name) != downloadingObj_.end()) {
+    uint64_t read_len = obj.len;
+    if (has_cache_store && s3ClientAdaptor_->GetBlockCache()->IsCached(key)) {
       VLOG(9) << "inodeId=" << key.ino
-              << " obj is already in downloading: " << name
-              << ", size: " << downloadingObj_.size();
+              << " downloading is exist in cache: " << name;
       continue;
     }
-    if (s3ClientAdaptor_->GetBlockCache()->IsCached(key)) {
-      VLOG(9) << "inodeId=" << key.ino
-              << " downloading is exist in cache: " << name
-              << ", size: " << downloadingObj_.size();
+
+    // it's already in downloading or the readahead budget is exhausted
+    if (!readahead_->Issue(name, obj.fileEnd, read_len)) {
+      VLOG(9) << "inodeId=" << key.ino << " skip download: " << name;
       continue;
     }
 
-    VLOG(9) << "inodeId=" << key.ino << " download start: " << name
-            << ", size: " << downloadingObj_.size();
-    downloadingObj_.emplace(name);
-
-    auto inodeid = inode_;
+    VLOG(9) << "inodeId=" << key.ino << " download start: " << name;
+    auto readahead = readahead_;
     auto* s3_client_adaptor = s3ClientAdaptor_;
-    auto task = [key, name, inodeid, s3_client_adaptor, read_len]() {
-      char* data_cache_s3 = new char[read_len];
+    auto task = [key, name, s3_client_adaptor, read_len, readahead]() {
+      // the reader has jumped away before the prefetch starts
+      if (!readahead->Wanted(name)) {
+        VLOG(9) << "inodeId=" << key.ino << " prefetch canceled: " << name;
+        readahead->Abort(name);
+        return;
+      }
+
+      auto call =
+          s3_client_adaptor->GetSingleFlight()->Begin(name, 0, read_len);
       auto context = std::make_shared<GetObjectAsyncContext>();
       context->key = name;
-      context->buf = data_cache_s3;
+      context->buf = call->Buffer();
       context->offset = 0;
       context->len = read_len;
-      context->cb = AsyncPrefetchCallback{key, inodeid, s3_client_adaptor,
-                                          butil::cpuwide_time_ms()};
+      context->cb = AsyncPrefetchCallback{
+          key, s3_client_adaptor, butil::cpuwide_time_ms(), call, readahead};
       VLOG(9) << "inodeId=" << key.ino << "prefetch start: " << context->key
               << ", len: " << context->len;
       s3_client_adaptor->GetS3Client()->AsyncGet(context);
@@ -814,247 +1187,54 @@ void FileCacheManager::PrefetchS3Objs(
   }
 }
 
-void FileCacheManager::HandleReadRequest(
-    const ReadRequest& request, const S3ChunkInfo& s3ChunkInfo,
-    std::vector<ReadRequest>* addReadRequests,
-    std::vector<uint64_t>* deletingReq, std::vector<S3ReadRequest>* requests,
-    char* dataBuf, uint64_t fsId, uint64_t inodeId) {
-  uint64_t block_size = s3ClientAdaptor_->GetBlockSize();
-  uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
-
-  uint64_t s3_chunk_info_offset = s3ChunkInfo.offset();
-  uint64_t s3_chunk_info_len = s3ChunkInfo.len();
-
-  VLOG(9) << "inodeId=" << inodeId
-          << " HandleReadRequest request index:" << request.index
-          << ", chunkPos:" << request.chunkPos << ", len:" << request.len
-          << ", bufOffset:" << request.bufOffset;
-
-  VLOG(9) << "inodeId=" << inodeId
-          << " HandleReadRequest s3info chunkid:" << s3ChunkInfo.chunkid()
-          << ", offset:" << s3_chunk_info_offset
-          << ", len:" << s3_chunk_info_len
-          << ", compaction:" << s3ChunkInfo.compaction()
-          << ", zero:" << s3ChunkInfo.zero();
-
-  S3ReadRequest s3_request;
-  uint64_t file_offset = request.index * chunk_size + request.chunkPos;
-  uint64_t length = request.len;
-  uint64_t buf_offset = request.bufOffset;
-
-  uint64_t read_offset = 0;
-  /*
-           -----             read block
-                  ------     S3ChunkInfo
-  */
-  if (file_offset + length <= s3_chunk_info_offset) {
-    return;
-    /*
-         -----              ------------   read block           -
-            ------             -----       S3ChunkInfo
-    */
-  } else if ((s3_chunk_info_offset > file_offset) &&
-             (s3_chunk_info_offset < file_offset + length)) {
-    ReadRequest split_request;
-    split_request.index = request.index;
-    split_request.chunkPos = request.chunkPos;
-    split_request.len = s3_chunk_info_offset - file_offset;
-    split_request.bufOffset = buf_offset;
-    addReadRequests->emplace_back(split_request);
-    deletingReq->emplace_back(request.chunkPos);
-    read_offset += split_request.len;
-    /*
-         -----                 read block           -
-            ------             S3ChunkInfo
-    */
-    if (file_offset + length <= s3_chunk_info_offset + s3_chunk_info_len) {
-      if (s3ChunkInfo.zero()) {
-        memset(static_cast<char*>(dataBuf) + buf_offset + read_offset, 0,
-               file_offset + length - s3_chunk_info_offset);
-      } else {
-        s3_request.chunkId = s3ChunkInfo.chunkid();
-        s3_request.offset = s3_chunk_info_offset;
-        s3_request.len = file_offset + length - s3_chunk_info_offset;
-        s3_request.objectOffset =
-            s3_chunk_info_offset % chunk_size % block_size;
-        s3_request.readOffset = buf_offset + read_offset;
-        s3_request.compaction = s3ChunkInfo.compaction();
-        s3_request.fsId = fsId;
-        s3_request.inodeId = inodeId;
-        requests->push_back(s3_request);
-      }
-      /*
-                           ------------   read block           -
-                              -----       S3ChunkInfo
-      */
-    } else {
-      if (s3ChunkInfo.zero()) {
-        memset(static_cast<char*>(dataBuf) + buf_offset + read_offset, 0,
-               s3_chunk_info_len);
-      } else {
-        s3_request.chunkId = s3ChunkInfo.chunkid();
-        s3_request.offset = s3_chunk_info_offset;
-        s3_request.len = s3_chunk_info_len;
-        s3_request.objectOffset =
-            s3_chunk_info_offset % chunk_size % block_size;
-        s3_request.readOffset = buf_offset + read_offset;
-        s3_request.compaction = s3ChunkInfo.compaction();
-        s3_request.fsId = fsId;
-        s3_request.inodeId = inodeId;
-        requests->push_back(s3_request);
-      }
-
-      ReadRequest split_request;
-
-      read_offset += s3_chunk_info_len;
-      split_request.index = request.index;
-      split_request.chunkPos = request.chunkPos + read_offset;
-      split_request.len =
-          file_offset + length - (s3_chunk_info_offset + s3_chunk_info_len);
-      split_request.bufOffset = buf_offset + read_offset;
-      addReadRequests->emplace_back(split_request);
-    }
-    /*
-          ----                      ---------   read block
-        ----------                --------      S3ChunkInfo
-    */
-  } else if ((s3_chunk_info_offset <= file_offset) &&
-             (s3_chunk_info_offset + s3_chunk_info_len > file_offset)) {
-    deletingReq->emplace_back(request.chunkPos);
-    /*
-          ----                    read block
-        ----------                S3ChunkInfo
-    */
-    if (file_offset + length <= s3_chunk_info_offset + s3_chunk_info_len) {
-      if (s3ChunkInfo.zero()) {
-        memset(static_cast<char*>(dataBuf) + buf_offset + read_offset, 0,
-               length);
-      } else {
-        s3_request.chunkId = s3ChunkInfo.chunkid();
-        s3_request.offset = file_offset;
-        s3_request.len = length;
-        if (file_offset / block_size == s3_chunk_info_offset / block_size) {
-          s3_request.objectOffset =
-              s3_chunk_info_offset % chunk_size % block_size;
-        } else {
-          s3_request.objectOffset = 0;
-        }
-        s3_request.readOffset = buf_offset + read_offset;
-        s3_request.compaction = s3ChunkInfo.compaction();
-        s3_request.fsId = fsId;
-        s3_request.inodeId = inodeId;
-        requests->push_back(s3_request);
-      }
-      /*
-                                ---------   read block
-                              --------      S3ChunkInfo
-      */
-    } else {
-      if (s3ChunkInfo.zero()) {
-        memset(static_cast<char*>(dataBuf) + buf_offset + read_offset, 0,
-               s3_chunk_info_offset + s3_chunk_info_len - file_offset);
-      } else {
-        s3_request.chunkId = s3ChunkInfo.chunkid();
-        s3_request.offset = file_offset;
-        s3_request.len = s3_chunk_info_offset + s3_chunk_info_len - file_offset;
-        if (file_offset / block_size == s3_chunk_info_offset / block_size) {
-          s3_request.objectOffset =
-              s3_chunk_info_offset % chunk_size % block_size;
-        } else {
-          s3_request.objectOffset = 0;
-        }
-        s3_request.readOffset = buf_offset + read_offset;
-        s3_request.compaction = s3ChunkInfo.compaction();
-        s3_request.fsId = fsId;
-        s3_request.inodeId = inodeId;
-        requests->push_back(s3_request);
-      }
-      read_offset += s3_chunk_info_offset + s3_chunk_info_len - file_offset;
-      ReadRequest split_request;
-      split_request.index = request.index;
-      split_request.chunkPos = request.chunkPos + s3_chunk_info_offset +
-                               s3_chunk_info_len - file_offset;
-      split_request.len =
-          file_offset + length - (s3_chunk_info_offset + s3_chunk_info_len);
-      split_request.bufOffset = buf_offset + read_offset;
-      addReadRequests->emplace_back(split_request);
-    }
-    /*
-                -----  read block
-        ----           S3ChunkInfo
-    do nothing
-    */
-  } else {
-  }
-}
-
-void FileCacheManager::GenerateS3Request(ReadRequest request,
-                                         const S3ChunkInfoList& s3ChunkInfoList,
+void FileCacheManager::GenerateS3Request(const ReadRequest& request,
+                                         const SliceIndex& sliceIndex,
                                          char* dataBuf,
                                          std::vector<S3ReadRequest>* requests,
                                          uint64_t fsId, uint64_t inodeId) {
-  // first is chunkPos, user read request is split into multiple,
-  // and emplace in the readRequests;
-  std::map<uint64_t, ReadRequest> read_requests;
+  uint64_t block_size = s3ClientAdaptor_->GetBlockSize();
+  uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
+  uint64_t file_offset = request.index * chunk_size + request.chunkPos;
 
   VLOG(9) << "inodeId=" << inodeId
           << " GenerateS3Request start request chunkIndex:" << request.index
           << ", chunkPos:" << request.chunkPos << ", len:" << request.len
           << ", bufOffset:" << request.bufOffset;
-  read_requests.emplace(request.chunkPos, request);
-  for (int i = s3ChunkInfoList.s3chunks_size() - 1; i >= 0; i--) {
-    const S3ChunkInfo& s3_chunk_info = s3ChunkInfoList.s3chunks(i);
-    // readRequests is split by current s3ChunkInfo, emplace_back to the
-    // addReadRequests
-    std::vector<ReadRequest> add_read_requests;
-    // if readRequest is split to one or two, old readRequest should be
-    // delete,
-    std::vector<uint64_t> deleting_req;
-    for (auto& read_request : read_requests) {
-      HandleReadRequest(read_request.second, s3_chunk_info, &add_read_requests,
-                        &deleting_req, requests, dataBuf, fsId, inodeId);
-    }
-
-    for (unsigned long& iter : deleting_req) {
-      read_requests.erase(iter);
-    }
-
-    for (auto& add_read_request : add_read_requests) {
-      auto ret =
-          read_requests.emplace(add_read_request.chunkPos, add_read_request);
-      if (!ret.second) {
-        LOG(ERROR) << "read request emplace failed. chunkPos:"
-                   << add_read_request.chunkPos
-                   << ", len:" << add_read_request.len
-                   << ", index:" << add_read_request.index
-                   << ",bufOffset:" << add_read_request.bufOffset;
-      }
-    }
 
-    if (read_requests.empty()) {
-      VLOG(6) << "inodeId=" << inodeId << " readRequests has hit s3ChunkInfos.";
-      break;
+  // every byte of request is served by the newest slice covers it,
+  // or it's a hole which read as zero.
+  for (const auto& range : sliceIndex.Resolve(file_offset, request.len)) {
+    uint64_t read_offset = request.bufOffset + (range.offset - file_offset);
+    if (range.hole || range.slice.zero) {
+      VLOG(9) << "empty buf offset:" << range.offset << ", len:" << range.len
+              << ", bufOffset:" << read_offset;
+      memset(dataBuf + read_offset, 0, range.len);
+      continue;
     }
-  }
 
-  for (auto& read_request : read_requests) {
-    VLOG(9) << "empty buf index:" << read_request.second.index
-            << ", chunkPos:" << read_request.second.chunkPos
-            << ", len:" << read_request.second.len
-            << ", bufOffset:" << read_request.second.bufOffset;
-    memset(dataBuf + read_request.second.bufOffset, 0, read_request.second.len);
-  }
+    const auto& slice = range.slice;
+    S3ReadRequest s3_request;
+    s3_request.chunkId = slice.chunkId;
+    s3_request.offset = range.offset;
+    s3_request.len = range.len;
+    if (range.offset / block_size == slice.offset / block_size) {
+      s3_request.objectOffset = slice.offset % chunk_size % block_size;
+    } else {
+      s3_request.objectOffset = 0;
+    }
+    s3_request.readOffset = read_offset;
+    s3_request.compaction = slice.compaction;
+    s3_request.fsId = fsId;
+    s3_request.inodeId = inodeId;
+    requests->push_back(s3_request);
 
-  auto s3_request_iter = requests->begin();
-  for (; s3_request_iter != requests->end(); s3_request_iter++) {
-    VLOG(9) << "s3Request chunkid:" << s3_request_iter->chunkId
-            << ", offset:" << s3_request_iter->offset
-            << ", len:" << s3_request_iter->len
-            << ", objectOffset:" << s3_request_iter->objectOffset
-            << ", readOffset:" << s3_request_iter->readOffset
-            << ", fsid:" << s3_request_iter->fsId
-            << ", inodeId=" << s3_request_iter->inodeId
-            << ", compaction:" << s3_request_iter->compaction;
+    VLOG(9) << "s3Request chunkid:" << s3_request.chunkId
+            << ", offset:" << s3_request.offset << ", len:" << s3_request.len
+            << ", objectOffset:" << s3_request.objectOffset
+            << ", readOffset:" << s3_request.readOffset
+            << ", fsid:" << s3_request.fsId
+            << ", inodeId=" << s3_request.inodeId
+            << ", compaction:" << s3_request.compaction;
   }
 }
 
@@ -1070,6 +1250,12 @@ void FileCacheManager::ReleaseCache() {
   g_s3MultiManagerMetric->chunkManagerNum << -1 * chunNum;
 }
 
+void FileCacheManager::ReleaseReadahead() {
+  if (readahead_ != nullptr) {
+    readahead_->Release();
+  }
+}
+
 void FileCacheManager::TruncateCache(uint64_t offset, uint64_t fileSize) {
   uint64_t chunkSize = s3ClientAdaptor_->GetChunkSize();
   uint64_t chunkIndex = offset / chunkSize;
@@ -1170,6 +1356,19 @@ DINGOFS_ERROR FileCacheManager::Flush(bool force, bool toS3) {
   return ret;
 }
 
+void FileCacheManager::WaitFlush() {
+  std::map<uint64_t, ChunkCacheManagerPtr> tmp;
+  {
+    ReadLockGuard read_lock_guard(rwLock_);
+    tmp = chunkCacheMap_;
+  }
+
+  for (auto& item : tmp) {
+    item.second->WaitFlush();
+  }
+  VLOG(6) << "Finish wait file cache flush, inodeId=" << inode_;
+}
+
 void ChunkCacheManager::ReadChunk(uint64_t index, uint64_t chunkPos,
                                   uint64_t readLen, char* dataBuf,
                                   uint64_t dataBufOffset,
@@ -1186,14 +1385,16 @@ void ChunkCacheManager::ReadChunk(uint64_t index, uint64_t chunkPos,
   // read by flushing data cache
   flushingDataCacheMtx_.lock();
   if (!IsFlushDataEmpty()) {
-    // read by flushing data cache
-    for (auto request : cache_miss_write_requests) {
+    // read by flushing data cache, the newer one first
+    cache_miss_flush_data_request = std::move(cache_miss_write_requests);
+    for (auto iter = flushingDataCaches_.rbegin();
+         iter != flushingDataCaches_.rend(); iter++) {
       std::vector<ReadRequest> tmp_requests;
-      ReadByFlushData(request.chunkPos, request.len, dataBuf, request.bufOffset,
-                      &tmp_requests);
-      cache_miss_flush_data_request.insert(cache_miss_flush_data_request.end(),
-                                           tmp_requests.begin(),
-                                           tmp_requests.end());
+      for (auto request : cache_miss_flush_data_request) {
+        ReadByFlushData(*iter, request.chunkPos, request.len, dataBuf,
+                        request.bufOffset, &tmp_requests);
+      }
+      cache_miss_flush_data_request.swap(tmp_requests);
     }
     flushingDataCacheMtx_.unlock();
 
@@ -1418,16 +1619,22 @@ void ChunkCacheManager::ReadByReadCache(uint64_t chunkPos, uint64_t readLen,
   return;
 }
 
-void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
+void ChunkCacheManager::ReadByFlushData(const FlushingDataCache& flushing,
+                                        uint64_t chunkPos, uint64_t readLen,
                                         char* dataBuf, uint64_t dataBufOffset,
                                         std::vector<ReadRequest>* requests) {
-  uint64_t dcChunkPos = flushingDataCache_->GetChunkPos();
-  uint64_t dcLen = flushingDataCache_->GetLen();
+  const DataCachePtr& flushingDataCache = flushing.dataCache;
+  uint64_t dcChunkPos = flushingDataCache->GetChunkPos();
+  uint64_t dcLen = flushingDataCache->GetLen();
+  if (flushing.validEnd < dcChunkPos + dcLen) {  // truncated
+    dcLen = flushing.validEnd > dcChunkPos ? flushing.validEnd - dcChunkPos : 0;
+  }
+
   ReadRequest request;
   VLOG(9) << "Try to ReadByFlushData chunkPos: " << chunkPos
           << ", readLen: " << readLen << ", dcChunkPos: " << dcChunkPos
           << ", dcLen: " << dcLen;
-  if (chunkPos + readLen <= dcChunkPos) {
+  if (chunkPos + readLen <= dcChunkPos || dcLen == 0) {
     request.index = index_;
     request.len = readLen;
     request.chunkPos = chunkPos;
@@ -1447,7 +1654,7 @@ void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
             ------           DataCache
     */
     if (chunkPos + readLen <= dcChunkPos + dcLen) {
-      flushingDataCache_->CopyDataCacheToBuf(
+      flushingDataCache->CopyDataCacheToBuf(
           0, chunkPos + readLen - dcChunkPos,
           dataBuf + request.len + dataBufOffset);
       readLen = 0;
@@ -1457,7 +1664,7 @@ void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
               ------           DataCache
       */
     } else {
-      flushingDataCache_->CopyDataCacheToBuf(
+      flushingDataCache->CopyDataCacheToBuf(
           0, dcLen, dataBuf + request.len + dataBufOffset);
       readLen = chunkPos + readLen - (dcChunkPos + dcLen);
       dataBufOffset = dcChunkPos + dcLen - chunkPos + dataBufOffset;
@@ -1469,8 +1676,8 @@ void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
            ---------           DataCache
     */
     if (chunkPos + readLen <= dcChunkPos + dcLen) {
-      flushingDataCache_->CopyDataCacheToBuf(chunkPos - dcChunkPos, readLen,
-                                             dataBuf + dataBufOffset);
+      flushingDataCache->CopyDataCacheToBuf(chunkPos - dcChunkPos, readLen,
+                                            dataBuf + dataBufOffset);
       readLen = 0;
       return;
       /*
@@ -1478,9 +1685,9 @@ void ChunkCacheManager::ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
              ---------                DataCache
       */
     } else {
-      flushingDataCache_->CopyDataCacheToBuf(chunkPos - dcChunkPos,
-                                             dcChunkPos + dcLen - chunkPos,
-                                             dataBuf + dataBufOffset);
+      flushingDataCache->CopyDataCacheToBuf(chunkPos - dcChunkPos,
+                                            dcChunkPos + dcLen - chunkPos,
+                                            dataBuf + dataBufOffset);
       readLen = chunkPos + readLen - dcChunkPos - dcLen;
       dataBufOffset = dcChunkPos + dcLen - chunkPos + dataBufOffset;
       chunkPos = dcChunkPos + dcLen;
@@ -1648,6 +1855,12 @@ void ChunkCacheManager::TruncateCache(uint64_t chunkPos) {
 
   TruncateWriteCache(chunkPos);
   TruncateReadCache(chunkPos);
+
+  // the flushing data beyond |chunkPos| is neither read nor committed
+  dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
+  for (auto& flushing : flushingDataCaches_) {
+    flushing.validEnd = std::min(flushing.validEnd, chunkPos);
+  }
 }
 
 void ChunkCacheManager::TruncateWriteCache(uint64_t chunkPos) {
@@ -1700,62 +1913,54 @@ void ChunkCacheManager::ReleaseWriteDataCache(const DataCachePtr& dataCache) {
 
 DINGOFS_ERROR ChunkCacheManager::Flush(uint64_t inodeId, bool force,
                                        bool toS3) {
-  std::map<uint64_t, DataCachePtr> tmp;
   dingofs::utils::LockGuard lg(flushMtx_);
+  CoalesceWriteCache(inodeId);
+
   DINGOFS_ERROR ret = DINGOFS_ERROR::OK;
-  // DataCachePtr dataCache;
   while (1) {
-    bool isFlush = false;
+    DataCachePtr dataCache;
     {
       WriteLockGuard writeLockGuard(rwLockChunk_);
 
       auto iter = dataWCacheMap_.begin();
       while (iter != dataWCacheMap_.end()) {
         if (iter->second->CanFlush(force)) {
+          dataCache = std::move(iter->second);
           {
             dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
-            flushingDataCache_ = std::move(iter->second);
+            flushingDataCaches_.push_back(FlushingDataCache{
+                dataCache, UINT64_MAX, false, nullptr,
+                std::make_shared<CountDownEvent>(1)});
           }
           dataWCacheMap_.erase(iter);
-          isFlush = true;
           break;
         } else {
           iter++;
         }
       }
     }
-    if (isFlush) {
-      VLOG(9) << "Flush datacache chunkPos:"
-              << flushingDataCache_->GetChunkPos()
-              << ", len:" << flushingDataCache_->GetLen()
-              << ", inodeId=" << inodeId << ", chunkIndex:" << index_;
-      assert(flushingDataCache_->IsDirty());
+    if (dataCache != nullptr) {
+      VLOG(9) << "Flush datacache chunkPos:" << dataCache->GetChunkPos()
+              << ", len:" << dataCache->GetLen() << ", inodeId=" << inodeId
+              << ", chunkIndex:" << index_;
+      assert(dataCache->IsDirty());
       do {
-        ret = flushingDataCache_->Flush(inodeId, toS3);
+        ret = dataCache->Flush(inodeId, toS3);
         if (ret == DINGOFS_ERROR::NOTEXIST) {
           LOG(WARNING) << "dataCache flush failed. ret:" << ret
-                       << ", index:" << index_ << ", data chunkpos:"
-                       << flushingDataCache_->GetChunkPos();
-          ReleaseWriteDataCache(flushingDataCache_);
+                       << ", index:" << index_
+                       << ", data chunkpos:" << dataCache->GetChunkPos();
+          CommitFlush(dataCache.get(), nullptr);
           break;
         } else if (ret == DINGOFS_ERROR::INTERNAL) {
           LOG(WARNING) << "dataCache flush failed. ret:" << ret
-                       << ", index:" << index_ << ", data chunkpos:"
-                       << flushingDataCache_->GetChunkPos()
+                       << ", index:" << index_
+                       << ", data chunkpos:" << dataCache->GetChunkPos()
                        << ", should retry.";
           ::sleep(3);
           continue;
         }
-        VLOG(9) << "ReleaseWriteDataCache chunkPos:"
-                << flushingDataCache_->GetChunkPos()
-                << ", len:" << flushingDataCache_->GetLen()
-                << ", inodeId=" << inodeId << ", chunkIndex:" << index_;
-        ReleaseWriteDataCache(flushingDataCache_);
       } while (ret != DINGOFS_ERROR::OK);
-      {
-        dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
-        flushingDataCache_ = nullptr;
-      }
     } else {
       VLOG(9) << "can not find flush datacache, inodeId=" << inodeId
               << ", chunkIndex:" << index_;
@@ -1765,6 +1970,312 @@ DINGOFS_ERROR ChunkCacheManager::Flush(uint64_t inodeId, bool force,
   return DINGOFS_ERROR::OK;
 }
 
+// the pages which [pos, pos + len) lies in
+static uint64_t PagesOf(uint64_t pos, uint64_t len, uint64_t page_size) {
+  if (len == 0) {
+    return 0;
+  }
+  return (pos + len - 1) / page_size - pos / page_size + 1;
+}
+
+void ChunkCacheManager::CoalesceWriteCache(uint64_t inodeId) {
+  const uint64_t merge_gap = s3ClientAdaptor_->GetWriteMergeGapByte();
+  const bool align_block = s3ClientAdaptor_->IsWriteAlignBlock();
+  if (merge_gap == 0 && !align_block) {
+    return;
+  }
+
+  // The pages are freed only by flush, which takes the locks held below,
+  // so it never waits for pages: it's skipped if the memory is near full,
+  // and the pages it may take are reserved without waiting beforehand.
+  auto& data_stream = DataStream::GetInstance();
+  if (data_stream.MemoryNearFull()) {
+    return;
+  }
+
+  const uint64_t block_size = s3ClientAdaptor_->GetBlockSize();
+  const uint64_t page_size = s3ClientAdaptor_->GetPageSize();
+  uint64_t max_pages = 0;
+  {
+    ReadLockGuard read_lock_guard(rwLockChunk_);
+    if (dataWCacheMap_.empty()) {
+      return;
+    }
+
+    uint64_t prev_end = UINT64_MAX;
+    for (const auto& item : dataWCacheMap_) {
+      uint64_t pos = item.second->GetChunkPos();
+      if (prev_end <= pos && pos - prev_end <= merge_gap) {
+        max_pages += PagesOf(prev_end, pos - prev_end, page_size);
+      }
+      if (align_block) {  // head and tail, each one is within a block
+        max_pages += 2 * (block_size / page_size);
+      }
+      prev_end = pos + item.second->GetLen();
+    }
+  }
+
+  std::vector<char*> pages;
+  auto free_pages = absl::MakeCleanup([&]() {
+    for (char* page : pages) {
+      data_stream.FreePage(page);
+    }
+  });
+  while (pages.size() < max_pages && !data_stream.MemoryNearFull()) {
+    char* page = data_stream.TryNewPage();
+    if (page == nullptr) {
+      break;
+    }
+    pages.push_back(page);
+  }
+
+  // NOTE: the inode lock is never taken with the chunk lock held
+  std::shared_ptr<InodeWrapper> inode_wrapper;
+  auto ret = s3ClientAdaptor_->GetInodeCacheManager()->GetInode(
+      inodeId, inode_wrapper);
+  if (ret != DINGOFS_ERROR::OK) {
+    return;
+  }
+
+  // No slice is committed while coalescing, otherwise the range committed
+  // after the slice index taken (and no longer flushing) looks like a hole.
+  // Lock order: commitMtx_ -> inode, the same as CommitFlush().
+  dingofs::utils::LockGuard commit_guard(commitMtx_);
+  std::shared_ptr<SliceIndex> slice_index;
+  {
+    ::dingofs::utils::UniqueLock lg_guard = inode_wrapper->GetUniqueLock();
+    slice_index = inode_wrapper->GetSliceIndexLocked(index_);
+  }
+
+  const uint64_t chunk_size = s3ClientAdaptor_->GetChunkSize();
+  const uint64_t file_len = inode_wrapper->GetLength();
+  const uint64_t chunk_offset = index_ * chunk_size;
+  if (file_len <= chunk_offset) {
+    return;
+  }
+  const uint64_t chunk_end = std::min(file_len - chunk_offset, chunk_size);
+  auto fs_cache_manager = s3ClientAdaptor_->GetFsCacheManager();
+  std::vector<char> buffer;
+
+  WriteLockGuard write_lock_guard(rwLockChunk_);
+  WriteLockGuard write_cache_lock_guard(rwLockWrite_);
+
+  // 1. merge the data caches whose gap is a hole or in page cache
+  for (auto iter = dataWCacheMap_.begin(); iter != dataWCacheMap_.end();) {
+    auto next = std::next(iter);
+    if (next == dataWCacheMap_.end()) {
+      break;
+    }
+
+    DataCachePtr data_cache = iter->second;
+    DataCachePtr merge_data_cache = next->second;
+    uint64_t end = data_cache->GetChunkPos() + data_cache->GetLen();
+    uint64_t gap = merge_data_cache->GetChunkPos() - end;
+    if (gap > merge_gap || PagesOf(end, gap, page_size) > pages.size()) {
+      iter = next;
+      continue;
+    }
+
+    buffer.resize(gap);
+    if (!ReadCleanData(inodeId, slice_index, end, gap, true, buffer.data())) {
+      iter = next;
+      continue;
+    }
+
+    VLOG(9) << "Merge data cache chunkPos:" << data_cache->GetChunkPos()
+            << ", len:" << data_cache->GetLen()
+            << " with chunkPos:" << merge_data_cache->GetChunkPos()
+            << ", len:" << merge_data_cache->GetLen() << ", gap:" << gap
+            << ", inodeId=" << inodeId << ", chunkIndex:" << index_;
+    uint64_t old_size = data_cache->GetActualLen();
+    data_cache->AppendData(gap, buffer.data(), &pages);
+    data_cache->MergeDataCacheToDataCache(merge_data_cache, 0,
+                                          merge_data_cache->GetLen());
+    fs_cache_manager->DataCacheByteInc(data_cache->GetActualLen() - old_size);
+    fs_cache_manager->DataCacheNumFetchSub(1);
+    fs_cache_manager->DataCacheByteDec(merge_data_cache->GetActualLen());
+    dataWCacheMap_.erase(next);
+  }
+
+  if (!align_block) {
+    return;
+  }
+
+  // 2. pad the data caches to block boundaries (or end of file) with the
+  // clean data in page cache, but the holes are never padded, and the
+  // padding is no more than the dirty data, so a small write isn't
+  // amplified into a whole block
+  std::vector<DataCachePtr> data_caches;
+  uint64_t pad_budget = 0;
+  for (const auto& item : dataWCacheMap_) {
+    data_caches.push_back(item.second);
+    pad_budget += item.second->GetLen();
+  }
+  for (size_t i = 0; i < data_caches.size(); i++) {
+    const auto& data_cache = data_caches[i];
+    uint64_t prev_end = 0;
+    if (i > 0) {
+      prev_end = data_caches[i - 1]->GetChunkPos() +
+                 data_caches[i - 1]->GetLen();
+    }
+    uint64_t next_pos =
+        i + 1 < data_caches.size() ? data_caches[i + 1]->GetChunkPos()
+                                   : chunk_size;
+
+    uint64_t pos = data_cache->GetChunkPos();
+    uint64_t head = pos - pos % block_size;
+    buffer.resize(pos - head);
+    if (head < pos && head >= prev_end && pos - head <= pad_budget &&
+        PagesOf(head, pos - head, page_size) <= pages.size() &&
+        ReadCleanData(inodeId, slice_index, head, pos - head, false,
+                      buffer.data())) {
+      pad_budget -= pos - head;
+      uint64_t old_size = data_cache->GetActualLen();
+      data_cache->PrependData(pos - head, buffer.data(), &pages);
+      UpdateWriteCacheMap(pos, data_cache.get());
+      fs_cache_manager->DataCacheByteInc(data_cache->GetActualLen() -
+                                         old_size);
+    }
+
+    uint64_t end = data_cache->GetChunkPos() + data_cache->GetLen();
+    uint64_t tail = std::min((end + block_size - 1) / block_size * block_size,
+                             chunk_end);
+    if (tail <= end || tail > next_pos || tail - end > pad_budget ||
+        PagesOf(end, tail - end, page_size) > pages.size()) {
+      continue;
+    }
+    buffer.resize(tail - end);
+    if (ReadCleanData(inodeId, slice_index, end, tail - end, false,
+                      buffer.data())) {
+      pad_budget -= tail - end;
+      uint64_t old_size = data_cache->GetActualLen();
+      data_cache->AppendData(tail - end, buffer.data(), &pages);
+      fs_cache_manager->DataCacheByteInc(data_cache->GetActualLen() -
+                                         old_size);
+    }
+  }
+}
+
+// protect by commitMtx_
+bool ChunkCacheManager::ReadCleanData(
+    uint64_t inodeId, const std::shared_ptr<SliceIndex>& sliceIndex,
+    uint64_t chunkPos, uint64_t len, bool fillHole, char* buffer) {
+  if (len == 0) {
+    return true;
+  }
+
+  // the flushing data is newer than the committed one
+  {
+    dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
+    for (const auto& flushing : flushingDataCaches_) {
+      uint64_t pos = flushing.dataCache->GetChunkPos();
+      uint64_t end = std::min(pos + flushing.dataCache->GetLen(),
+                              flushing.validEnd);
+      if (chunkPos < end && pos < chunkPos + len) {
+        return false;
+      }
+    }
+  }
+
+  if (sliceIndex == nullptr) {  // nothing committed
+    if (!fillHole) {
+      return false;
+    }
+    memset(buffer, 0, len);
+    return true;
+  }
+
+  // the version is taken before reading, the pages of older version miss
+  auto* page_cache = DataStream::GetInstance().GetPageCache();
+  uint64_t version = sliceIndex->Version();
+  uint64_t chunk_offset = index_ * s3ClientAdaptor_->GetChunkSize();
+  uint64_t file_offset = chunk_offset + chunkPos;
+  for (const auto& range : sliceIndex->Resolve(file_offset, len)) {
+    char* dst = buffer + (range.offset - file_offset);
+    if (range.hole || range.slice.zero) {
+      if (!fillHole) {
+        return false;
+      }
+      memset(dst, 0, range.len);
+      continue;
+    } else if (page_cache == nullptr) {
+      return false;
+    }
+
+    const uint64_t page_size = page_cache->PageSize();
+    uint64_t begin = range.offset - chunk_offset;
+    uint64_t end = begin + range.len;
+    for (uint64_t pos = begin; pos < end;) {
+      uint64_t page = pos / page_size;
+      uint64_t stop = std::min((page + 1) * page_size, end);
+      if (!page_cache->Get(PageKey{inodeId, index_, page}, version,
+                           pos - page * page_size, stop - pos,
+                           dst + (pos - begin))) {
+        return false;
+      }
+      pos = stop;
+    }
+  }
+  return true;
+}
+
+void ChunkCacheManager::CommitFlush(DataCache* dataCache, CommitFunc commit) {
+  dingofs::utils::LockGuard lg(commitMtx_);
+  {
+    dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
+    for (auto& flushing : flushingDataCaches_) {
+      if (flushing.dataCache.get() == dataCache) {
+        flushing.flushed = true;
+        flushing.commit = std::move(commit);
+        break;
+      }
+    }
+  }
+
+  // commit in the order of flush, so the newer slice always
+  // overwrites the older one
+  while (true) {
+    FlushingDataCache flushing;
+    {
+      dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
+      if (flushingDataCaches_.empty() || !flushingDataCaches_.front().flushed) {
+        break;
+      }
+      flushing = flushingDataCaches_.front();
+    }
+
+    // NOTE: the data cache is still readable until the slice is committed
+    if (flushing.commit != nullptr) {
+      flushing.commit(flushing.validEnd);
+    }
+
+    {
+      dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
+      flushingDataCaches_.pop_front();
+    }
+    VLOG(9) << "ReleaseWriteDataCache chunkPos:"
+            << flushing.dataCache->GetChunkPos()
+            << ", len:" << flushing.dataCache->GetLen()
+            << ", chunkIndex:" << index_;
+    ReleaseWriteDataCache(flushing.dataCache);
+    flushing.done->Signal();
+  }
+}
+
+void ChunkCacheManager::WaitFlush() {
+  std::vector<std::shared_ptr<CountDownEvent>> events;
+  {
+    dingofs::utils::LockGuard lg(flushingDataCacheMtx_);
+    for (const auto& flushing : flushingDataCaches_) {
+      events.emplace_back(flushing.done);
+    }
+  }
+
+  for (auto& event : events) {
+    event->Wait();
+  }
+}
+
 void ChunkCacheManager::UpdateWriteCacheMap(uint64_t oldChunkPos,
                                             DataCache* pDataCache) {
   auto iter = dataWCacheMap_.find(oldChunkPos);
@@ -1855,8 +2366,18 @@ DataCache::DataCache(S3ClientAdaptorImpl* s3ClientAdaptor,
   kvClientManager_ = std::move(kvClientManager);
 }
 
+char* DataCache::NewPage(std::vector<char*>* pages) {
+  if (pages != nullptr && !pages->empty()) {
+    char* page = pages->back();
+    pages->pop_back();
+    return page;
+  }
+  return DataStream::GetInstance().NewPage();
+}
+
 void DataCache::CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
-                                   const char* data) {
+                                   const char* data,
+                                   std::vector<char*>* pages) {
   uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
   uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
   uint64_t pos = chunkPos_ + dataCachePos;
@@ -1894,7 +2415,7 @@ void DataCache::CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
         pageData = pdMap[pageIndex];
       } else {
         pageData = new PageData();
-        pageData->data = DataStream::GetInstance().NewPage();
+        pageData->data = NewPage(pages);
         pageData->index = pageIndex;
         pdMap.emplace(pageIndex, pageData);
         addLen += pageSize;
@@ -1916,7 +2437,8 @@ void DataCache::CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
           << ", actualLen:" << actualLen_;
 }
 
-void DataCache::AddDataBefore(uint64_t len, const char* data) {
+void DataCache::AddDataBefore(uint64_t len, const char* data,
+                              std::vector<char*>* pages) {
   uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
   uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
   uint64_t tmpLen = len;
@@ -1953,7 +2475,7 @@ void DataCache::AddDataBefore(uint64_t len, const char* data) {
         pageData = pdMap[pageIndex];
       } else {
         pageData = new PageData();
-        pageData->data = DataStream::GetInstance().NewPage();
+        pageData->data = NewPage(pages);
         pageData->index = pageIndex;
         pdMap.emplace(pageIndex, pageData);
       }
@@ -2283,35 +2805,36 @@ DINGOFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
           << ", chunkIndex=" << chunkCacheManager_->GetIndex()
           << ", inodeId=" << inodeId;
 
+  std::shared_ptr<InodeWrapper> inodeWrapper;
+  DINGOFS_ERROR ret =
+      s3ClientAdaptor_->GetInodeCacheManager()->GetInode(inodeId, inodeWrapper);
+  if (ret != DINGOFS_ERROR::OK) {
+    LOG(WARNING) << "get inode fail, ret:" << ret;
+    status_.store(DataCacheStatus::Dirty, std::memory_order_release);
+    return ret;
+  }
+
+  // the flushing bytes are bounded, it blocks the flusher if exceeded
+  uint64_t length = len_;
+  DataStream::GetInstance().AcquireWriteback(inodeId, length);
+
   // generate flush task
   std::vector<FlushBlock> s3Tasks;
   std::vector<std::shared_ptr<SetKVCacheTask>> kvCacheTasks;
   char* data = reinterpret_cast<char*>(memalign(IO_ALIGNED_BLOCK_SIZE, len_));
   if (!data) {
     LOG(ERROR) << "new data failed.";
+    DataStream::GetInstance().ReleaseWriteback(inodeId, length);
     return DINGOFS_ERROR::INTERNAL;
   }
   CopyDataCacheToBuf(0, len_, data);
   uint64_t writeOffset = 0;
   uint64_t chunkId = 0;
-  DINGOFS_ERROR ret = PrepareFlushTasks(inodeId, data, &s3Tasks, &kvCacheTasks,
-                                        &chunkId, &writeOffset);
+  ret = PrepareFlushTasks(inodeId, data, &s3Tasks, &kvCacheTasks, &chunkId,
+                          &writeOffset);
   if (DINGOFS_ERROR::OK != ret) {
     free(data);
-    return ret;
-  }
-
-  // exec flush task
-  FlushTaskExecute(toS3, s3Tasks, kvCacheTasks);
-  free(data);
-
-  // inode ship to flush
-  std::shared_ptr<InodeWrapper> inodeWrapper;
-  ret =
-      s3ClientAdaptor_->GetInodeCacheManager()->GetInode(inodeId, inodeWrapper);
-  if (ret != DINGOFS_ERROR::OK) {
-    LOG(WARNING) << "get inode fail, ret:" << ret;
-    status_.store(DataCacheStatus::Dirty, std::memory_order_release);
+    DataStream::GetInstance().ReleaseWriteback(inodeId, length);
     return ret;
   }
 
@@ -2320,9 +2843,31 @@ DINGOFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
   uint64_t chunkSize = s3ClientAdaptor_->GetChunkSize();
   int64_t offset = chunkIndex * chunkSize + chunkPos_;
   PrepareS3ChunkInfo(chunkId, offset, writeOffset, &info);
-  inodeWrapper->AppendS3ChunkInfo(chunkIndex, info);
-  s3ClientAdaptor_->GetInodeCacheManager()->ShipToFlush(inodeWrapper);
 
+  // inode ship to flush once all blocks are put
+  auto inodeCacheManager = s3ClientAdaptor_->GetInodeCacheManager();
+  uint64_t chunkPos = chunkPos_;
+  auto commit = [inodeCacheManager, inodeWrapper, chunkIndex, chunkPos,
+                 info](uint64_t validEnd) mutable {
+    if (validEnd <= chunkPos) {  // truncated
+      return;
+    } else if (chunkPos + info.len() > validEnd) {
+      info.set_len(validEnd - chunkPos);
+    }
+    inodeWrapper->AppendS3ChunkInfo(chunkIndex, info);
+    inodeCacheManager->ShipToFlush(inodeWrapper);
+  };
+
+  // exec flush task
+  auto self = shared_from_this();
+  FlushTaskExecute(toS3, s3Tasks, kvCacheTasks,
+                   [self, inodeId, data, length, commit]() {
+                     free(data);
+                     DataStream::GetInstance().ReleaseWriteback(inodeId,
+                                                                length);
+                     self->chunkCacheManager_->CommitFlush(self.get(),
+                                                           commit);
+                   });
   return DINGOFS_ERROR::OK;
 }
 
@@ -2375,67 +2920,76 @@ DINGOFS_ERROR DataCache::PrepareFlushTasks(
   return DINGOFS_ERROR::OK;
 }
 
+// Exponential backoff with jitter, in [base/2, base]
+static uint64_t FlushRetryBackoffMs(uint32_t retry) {
+  static constexpr uint64_t kMinBackoffMs = 10;
+  static constexpr uint64_t kMaxBackoffMs = 10 * 1000;
+  static thread_local std::mt19937_64 rng(std::random_device{}());
+
+  uint64_t backoff = kMinBackoffMs << std::min<uint32_t>(retry, 10);
+  backoff = std::min(backoff, kMaxBackoffMs);
+  return backoff / 2 + rng() % (backoff / 2 + 1);
+}
+
 void DataCache::FlushTaskExecute(
     bool to_s3, const std::vector<FlushBlock>& s3Tasks,
-    const std::vector<std::shared_ptr<SetKVCacheTask>>& kvCacheTasks) {
-  // callback
-  std::atomic<uint64_t> s3PendingTaskCal(s3Tasks.size());
-  std::atomic<uint64_t> kvPendingTaskCal(kvCacheTasks.size());
-  CountDownEvent s3TaskEvent(s3PendingTaskCal);
-  CountDownEvent kvTaskEvent(kvPendingTaskCal);
-
-  // success callback
-  PutObjectAsyncCallBack callback =
-      [&](const std::shared_ptr<PutObjectAsyncContext>& context) {
-        // move metrics collection to block_cache.cpp
-
-        // Don't move the if sentence to the front
-        // it will cause core dumped because s3Metric_
-        // will be destructed before being accessed
-        s3TaskEvent.Signal();
-      };
-
-  SetKVCacheDone kvdone = [&](const std::shared_ptr<SetKVCacheTask>& task) {
-    kvTaskEvent.Signal();
+    const std::vector<std::shared_ptr<SetKVCacheTask>>& kvCacheTasks,
+    std::function<void()> done) {
+  (void)to_s3;
+  uint64_t kvPendingTaskCal = kvClientManager_ ? kvCacheTasks.size() : 0;
+  auto pending = std::make_shared<std::atomic<uint64_t>>(s3Tasks.size() +
+                                                         kvPendingTaskCal);
+  if (pending->load() == 0) {
+    done();
     return;
+  }
+
+  auto signal = [pending, done]() {
+    if (pending->fetch_sub(1) == 1) {
+      done();
+    }
   };
 
   // s3task execute
   auto fs = s3ClientAdaptor_->GetFileSystem();
   auto entry_watcher = fs->BorrowMember().entry_watcher;
   auto block_cache = s3ClientAdaptor_->GetBlockCache();
-  if (s3PendingTaskCal.load()) {
-    for (const auto& fblock : s3Tasks) {
-      auto context = fblock.context;
-      BlockKey key = fblock.key;
-      Block block(context->buffer, context->bufferSize);
-      auto from = entry_watcher->ShouldWriteback(key.ino)
-                      ? BlockFrom::NOCTO_FLUSH
-                      : BlockFrom::CTO_FLUSH;
-      BlockContext ctx(from);
-      DataStream::GetInstance().EnterFlushSliceQueue(
-          [&, key, block, ctx, callback]() {
-            for (;;) {
-              auto rc = block_cache->Put(key, block, ctx);
-              if (rc == BCACHE_ERROR::OK) {
-                callback(context);
-                break;
-              }
+  for (const auto& fblock : s3Tasks) {
+    auto context = fblock.context;
+    BlockKey key = fblock.key;
+    Block block(context->buffer, context->bufferSize);
+    auto from = entry_watcher->ShouldWriteback(key.ino)
+                    ? BlockFrom::NOCTO_FLUSH
+                    : BlockFrom::CTO_FLUSH;
+    BlockContext ctx(from);
+    DataStream::GetInstance().EnterFlushSliceQueue(
+        key.ino, block.size, [block_cache, key, block, ctx, signal]() {
+          for (uint32_t retry = 0;; retry++) {
+            auto rc = block_cache->Put(key, block, ctx);
+            if (rc == BCACHE_ERROR::OK) {
+              break;
             }
-          });
-    }
+
+            uint64_t backoff_ms = FlushRetryBackoffMs(retry);
+            LOG(WARNING) << "Put block (" << key.Filename()
+                         << ") failed: " << StrErr(rc) << ", retry after "
+                         << backoff_ms << "ms.";
+            std::this_thread::sleep_for(std::chrono::milliseconds(backoff_ms));
+          }
+          signal();
+        });
   }
+
   // kvtask execute
-  if (kvClientManager_ && kvPendingTaskCal.load()) {
-    std::for_each(kvCacheTasks.begin(), kvCacheTasks.end(),
-                  [&](const std::shared_ptr<SetKVCacheTask>& task) {
-                    task->done = kvdone;
-                    kvClientManager_->Set(task);
-                  });
-    kvTaskEvent.Wait();
+  if (kvPendingTaskCal > 0) {
+    SetKVCacheDone kvdone = [signal](const std::shared_ptr<SetKVCacheTask>&) {
+      signal();
+    };
+    for (const auto& task : kvCacheTasks) {
+      task->done = kvdone;
+      kvClientManager_->Set(task);
+    }
   }
-
-  s3TaskEvent.Wait();
 }
 
 void DataCache::PrepareS3ChunkInfo(uint64_t chunkId, uint64_t offset,
@@ -24,9 +24,11 @@
 
 #include <algorithm>
 #include <cstring>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -36,10 +38,14 @@
 #include "dingofs/metaserver.pb.h"
 #include "client/blockcache/cache_store.h"
 #include "client/datastream/data_stream.h"
+#include "client/vfs/vfs_meta.h"
 #include "client/vfs_old/filesystem/error.h"
 #include "client/vfs_old/inode_wrapper.h"
 #include "client/vfs_old/kvclient/kvclient_manager.h"
+#include "client/vfs_old/s3/read_planner.h"
+#include "client/vfs_old/s3/readahead.h"
 #include "utils/concurrent/concurrent.h"
+#include "utils/concurrent/count_down_event.h"
 
 namespace dingofs {
 namespace client {
@@ -168,6 +174,9 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
 
   uint64_t GetActualLen() { return actualLen_; }
 
+  // Submit the puts of all blocks and return without waiting for them,
+  // the slice is committed to inode by chunk cache manager once they
+  // are all done.
   virtual DINGOFS_ERROR Flush(uint64_t inodeId, bool toS3 = false);
   void Release();
   bool IsDirty() {
@@ -188,13 +197,26 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
   void CopyDataCacheToBuf(uint64_t offset, uint64_t len, char* data);
   void MergeDataCacheToDataCache(DataCachePtr mergeDataCache,
                                  uint64_t dataOffset, uint64_t len);
+  // Extend the data cache at tail or head by |data|, the caller must
+  // make sure that no other dirty data overlaps it, and the new pages
+  // are taken from |pages| which are reserved by the caller
+  void AppendData(uint64_t len, const char* data, std::vector<char*>* pages) {
+    CopyBufToDataCache(len_, len, data, pages);
+  }
+  void PrependData(uint64_t len, const char* data, std::vector<char*>* pages) {
+    AddDataBefore(len, data, pages);
+  }
 
  private:
   void PrepareS3ChunkInfo(uint64_t chunkId, uint64_t offset, uint64_t len,
                           pb::metaserver::S3ChunkInfo* info);
   void CopyBufToDataCache(uint64_t dataCachePos, uint64_t len,
-                          const char* data);
-  void AddDataBefore(uint64_t len, const char* data);
+                          const char* data,
+                          std::vector<char*>* pages = nullptr);
+  void AddDataBefore(uint64_t len, const char* data,
+                     std::vector<char*>* pages = nullptr);
+  // Take a reserved page if any, otherwise allocate one
+  static char* NewPage(std::vector<char*>* pages);
 
   DINGOFS_ERROR PrepareFlushTasks(
       uint64_t inodeId, char* data, std::vector<FlushBlock>* s3Tasks,
@@ -203,7 +225,8 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
 
   void FlushTaskExecute(
       bool to_s3, const std::vector<FlushBlock>& s3Tasks,
-      const std::vector<std::shared_ptr<SetKVCacheTask>>& kvCacheTasks);
+      const std::vector<std::shared_ptr<SetKVCacheTask>>& kvCacheTasks,
+      std::function<void()> done);
 
   S3ClientAdaptorImpl* s3ClientAdaptor_;
   ChunkCacheManagerPtr chunkCacheManager_;
@@ -236,12 +259,24 @@ class S3ReadResponse {
 
 class ChunkCacheManager
     : public std::enable_shared_from_this<ChunkCacheManager> {
+ public:
+  using CommitFunc = std::function<void(uint64_t validEnd)>;
+
+  // The data cache which is being written back, it's still readable
+  // until its slice is committed to inode.
+  struct FlushingDataCache {
+    DataCachePtr dataCache;
+    uint64_t validEnd;  // chunk pos, the data beyond it is truncated
+    bool flushed;       // all blocks are put
+    CommitFunc commit;  // nullptr means there is nothing to commit
+    std::shared_ptr<utils::CountDownEvent> done;
+  };
+
  public:
   ChunkCacheManager(uint64_t index, S3ClientAdaptorImpl* s3ClientAdaptor,
                     std::shared_ptr<KVClientManager> kvClientManager)
       : index_(index),
         s3ClientAdaptor_(s3ClientAdaptor),
-        flushingDataCache_(nullptr),
         kvClientManager_(std::move(kvClientManager)) {}
   virtual ~ChunkCacheManager() = default;
   void ReadChunk(uint64_t index, uint64_t chunkPos, uint64_t readLen,
@@ -260,14 +295,32 @@ class ChunkCacheManager
   virtual void ReadByReadCache(uint64_t chunkPos, uint64_t readLen,
                                char* dataBuf, uint64_t dataBufOffset,
                                std::vector<ReadRequest>* requests);
-  virtual void ReadByFlushData(uint64_t chunkPos, uint64_t readLen,
+  virtual void ReadByFlushData(const FlushingDataCache& flushing,
+                               uint64_t chunkPos, uint64_t readLen,
                                char* dataBuf, uint64_t dataBufOffset,
                                std::vector<ReadRequest>* requests);
   virtual DINGOFS_ERROR Flush(uint64_t inodeId, bool force, bool toS3 = false);
+  // Merge the dirty data caches whose gap can be filled from memory, and
+  // pad them to block boundaries, so they're flushed as fewer slices of
+  // larger objects
+  void CoalesceWriteCache(uint64_t inodeId);
+  // Called when all blocks of the flushing data cache are put, the slices
+  // are committed in the order of flush.
+  void CommitFlush(DataCache* dataCache, CommitFunc commit);
+  // Wait for the data caches flushed so far to be committed
+  void WaitFlush();
   uint64_t GetIndex() { return index_; }
   bool IsEmpty() {
     utils::ReadLockGuard writeCacheLock(rwLockChunk_);
-    return (dataWCacheMap_.empty() && dataRCacheMap_.empty());
+    utils::LockGuard lg(flushingDataCacheMtx_);
+    return (dataWCacheMap_.empty() && dataRCacheMap_.empty() &&
+            flushingDataCaches_.empty());
+  }
+  // Whether the chunk has data which isn't committed to s3 yet
+  bool HasDirtyData() {
+    utils::ReadLockGuard writeCacheLock(rwLockChunk_);
+    utils::LockGuard lg(flushingDataCacheMtx_);
+    return !dataWCacheMap_.empty() || !flushingDataCaches_.empty();
   }
   virtual void ReleaseReadDataCache(uint64_t key);
   virtual void ReleaseCache();
@@ -280,6 +333,10 @@ class ChunkCacheManager
       utils::WriteLockGuard writeLockGuard(rwLockWrite_);
       dataWCacheMap_.clear();
     }
+    {
+      utils::LockGuard lg(flushingDataCacheMtx_);
+      flushingDataCaches_.clear();
+    }
     utils::WriteLockGuard writeLockGuard(rwLockRead_);
     dataRCacheMap_.clear();
   }
@@ -291,7 +348,13 @@ class ChunkCacheManager
   void ReleaseWriteDataCache(const DataCachePtr& dataCache);
   void TruncateWriteCache(uint64_t chunkPos);
   void TruncateReadCache(uint64_t chunkPos);
-  bool IsFlushDataEmpty() { return flushingDataCache_ == nullptr; }
+  bool IsFlushDataEmpty() { return flushingDataCaches_.empty(); }
+  // Read the committed data of [chunkPos, chunkPos + len) which is in
+  // page cache, or a hole if |fillHole|, it fails if any part isn't.
+  bool ReadCleanData(uint64_t inodeId,
+                     const std::shared_ptr<SliceIndex>& sliceIndex,
+                     uint64_t chunkPos, uint64_t len, bool fillHole,
+                     char* buffer);
 
   uint64_t index_;
   std::map<uint64_t, DataCachePtr> dataWCacheMap_;  // first is pos in chunk
@@ -301,8 +364,9 @@ class ChunkCacheManager
   utils::RWLock rwLockRead_;  //  for read cache
   S3ClientAdaptorImpl* s3ClientAdaptor_;
   dingofs::utils::Mutex flushMtx_;
-  DataCachePtr flushingDataCache_;
+  std::list<FlushingDataCache> flushingDataCaches_;  // in the order of flush
   dingofs::utils::Mutex flushingDataCacheMtx_;
+  dingofs::utils::Mutex commitMtx_;
 
   std::shared_ptr<KVClientManager> kvClientManager_;
 };
@@ -312,12 +376,7 @@ class FileCacheManager {
   FileCacheManager(uint32_t fsid, uint64_t inode,
                    S3ClientAdaptorImpl* s3ClientAdaptor,
                    std::shared_ptr<KVClientManager> kvClientManager,
-                   std::shared_ptr<utils::TaskThreadPool<>> threadPool)
-      : fsId_(fsid),
-        inode_(inode),
-        s3ClientAdaptor_(s3ClientAdaptor),
-        kvClientManager_(std::move(kvClientManager)),
-        readTaskPool_(threadPool) {}
+                   std::shared_ptr<utils::TaskThreadPool<>> threadPool);
   FileCacheManager() = default;
   ~FileCacheManager() = default;
 
@@ -325,15 +384,26 @@ class FileCacheManager {
 
   void ReleaseCache();
 
+  // Release the readahead blocks held by this file
+  void ReleaseReadahead();
+
   virtual void TruncateCache(uint64_t offset, uint64_t fileSize);
 
   virtual DINGOFS_ERROR Flush(bool force, bool toS3 = false);
 
+  // Wait for the flushed data of this file to be committed
+  void WaitFlush();
+
   virtual int Write(uint64_t offset, uint64_t length, const char* dataBuf);
 
   virtual int Read(uint64_t inode_id, uint64_t offset, uint64_t length,
                    char* data_buf);
 
+  // Splice the range from the block file cached on local disk, it's only
+  // possible when the range is held by one block of the newest slice and
+  // there is no dirty data in memory.
+  bool ReadSplice(uint64_t offset, uint64_t length, vfs::SpliceBuffer* buffer);
+
   bool IsEmpty() { return chunkCacheMap_.empty(); }
 
   uint64_t GetInodeId() const { return inode_; }
@@ -350,21 +420,18 @@ class FileCacheManager {
  private:
   void WriteChunk(uint64_t index, uint64_t chunkPos, uint64_t writeLen,
                   const char* dataBuf);
-  void GenerateS3Request(ReadRequest request,
-                         const pb::metaserver::S3ChunkInfoList& s3ChunkInfoList,
-                         char* dataBuf, std::vector<S3ReadRequest>* requests,
-                         uint64_t fsId, uint64_t inodeId);
-
-  void PrefetchS3Objs(
-      const std::vector<std::pair<blockcache::BlockKey, uint64_t>>&
-          prefetchObjs);
-
-  void HandleReadRequest(const ReadRequest& request,
-                         const pb::metaserver::S3ChunkInfo& s3ChunkInfo,
-                         std::vector<ReadRequest>* addReadRequests,
-                         std::vector<uint64_t>* deletingReq,
-                         std::vector<S3ReadRequest>* requests, char* dataBuf,
-                         uint64_t fsId, uint64_t inodeId);
+  void GenerateS3Request(const ReadRequest& request,
+                         const SliceIndex& sliceIndex, char* dataBuf,
+                         std::vector<S3ReadRequest>* requests, uint64_t fsId,
+                         uint64_t inodeId);
+
+  struct PrefetchBlock {
+    blockcache::BlockKey key;
+    uint64_t len;
+    uint64_t fileEnd;  // file offset where the block ends
+  };
+
+  void PrefetchS3Objs(const std::vector<PrefetchBlock>& prefetchObjs);
 
   int HandleReadRequest(const std::vector<S3ReadRequest>& requests,
                         std::vector<S3ReadResponse>* responses,
@@ -405,40 +472,81 @@ class FileCacheManager {
     return st;
   }
 
-  // read kv request, need
+  // the missed page which is wholly covered by the read
+  struct PageFill {
+    datastream::PageKey key;
+    uint64_t version;
+    uint64_t bufOffset;
+    uint64_t length;
+  };
+
+  // serve the requests of clean chunks from the page cache, the missed
+  // ranges are left in |requests| to read into |data_buf| as they are,
+  // and the missed pages which are wholly read are returned by |fills|
+  void ReadFromPageCache(const std::shared_ptr<InodeWrapper>& inode_wrapper,
+                         std::vector<ReadRequest>* requests, char* data_buf,
+                         std::vector<PageFill>* fills);
+
+  // put the pages which are read into |data_buf| into the page cache
+  void FillPageCache(const std::vector<PageFill>& fills, const char* data_buf);
+
+  // read the requests from kv(localdisk/remote cache/s3), it retries
+  // if the object doesn't exist yet
+  int ReadFromKV(const std::shared_ptr<InodeWrapper>& inode_wrapper,
+                 const std::vector<ReadRequest>& requests, char* data_buf);
+
+  // A block range which missed the memory and local caches
+  struct BlockRead {
+    blockcache::BlockKey key;
+    uint64_t offset;  // offset in block
+    uint64_t length;
+    char* buffer;
+  };
+
+  // read kv request from local caches in parallel, then look up the missed
+  // blocks in remote cache in one batch, and read the rest from s3 together
   ReadStatus ReadKVRequest(const std::vector<S3ReadRequest>& kv_requests,
-                           char* data_buf, uint64_t file_len);
+                           char* data_buf);
 
-  // thread function for ReadKVRequest
+  // thread function for ReadKVRequest, the ranges which missed the memory
+  // and local caches are appended to |misses|
   void ProcessKVRequest(const S3ReadRequest& req, char* data_buf,
-                        uint64_t file_len, std::once_flag& cancel_flag,
-                        std::atomic<bool>& is_canceled,
-                        std::atomic<blockcache::BCACHE_ERROR>& ret_code);
+                        std::vector<BlockRead>* misses, std::mutex* mutex);
+
+  // read kv request from readahead data held in memory
+  bool ReadKVRequestFromReadahead(const std::string& name, char* databuf,
+                                  uint64_t offset, uint64_t length);
 
   // read kv request from local disk cache
   bool ReadKVRequestFromLocalCache(const blockcache::BlockKey& key,
                                    char* buffer, uint64_t offset,
                                    uint64_t length);
 
-  // read kv request from remote cache like memcached
-  bool ReadKVRequestFromRemoteCache(const std::string& name, char* databuf,
-                                    uint64_t offset, uint64_t length);
+  // read kv request from the owner of block in cache group
+  bool ReadKVRequestFromCacheGroup(const blockcache::BlockKey& key,
+                                   char* buffer, uint64_t offset,
+                                   uint64_t length);
 
-  // read kv request from s3
-  bool ReadKVRequestFromS3(const std::string& name, char* databuf,
-                           uint64_t offset, uint64_t length,
-                           blockcache::BCACHE_ERROR* rc);
+  // read the blocks from remote cache like memcached by one batched get,
+  // the blocks which are found are removed from |reads|
+  void ReadKVRequestFromRemoteCache(std::vector<BlockRead>* reads);
+
+  // read kv request from the inflight read (or prefetch) which covers it
+  bool ReadKVRequestFromInflight(const std::string& name, char* databuf,
+                                 uint64_t offset, uint64_t length);
+
+  // read the ranges from s3, the adjacent ranges of the same object are
+  // merged and the requests are issued asynchronously
+  blockcache::BCACHE_ERROR ReadKVRequestFromS3(std::vector<RangeRead> reads);
 
   // read retry policy when read from s3 occur not exist error
   int HandleReadS3NotExist(uint32_t retry,
                            const std::shared_ptr<InodeWrapper>& inode_wrapper);
 
-  // prefetch for block
-  void PrefetchForBlock(const S3ReadRequest& req, uint64_t fileLen,
-                        uint64_t blockSize, uint64_t chunkSize,
-                        uint64_t startBlockIndex);
-
-  friend class AsyncPrefetchCallback;
+  // feed the read to readahead, and prefetch the blocks of
+  // readahead window from s3
+  void PrefetchForRead(const std::shared_ptr<InodeWrapper>& inode_wrapper,
+                       uint64_t offset, uint64_t length);
 
   uint64_t fsId_;
   uint64_t inode_;
@@ -446,8 +554,7 @@ class FileCacheManager {
   utils::RWLock rwLock_;
   dingofs::utils::Mutex mtx_;
   S3ClientAdaptorImpl* s3ClientAdaptor_;
-  dingofs::utils::Mutex downloadMtx_;
-  std::set<std::string> downloadingObj_;
+  std::shared_ptr<Readahead> readahead_;
 
   std::shared_ptr<KVClientManager> kvClientManager_;
   std::shared_ptr<utils::TaskThreadPool<>> readTaskPool_;
@@ -480,7 +587,8 @@ class FsCacheManager {
   bool Delete(std::list<DataCachePtr>::iterator iter);
   void Get(std::list<DataCachePtr>::iterator iter);
 
-  DINGOFS_ERROR FsSync(bool force);
+  // Flush the data of all files, and wait for it to be committed if |wait|
+  DINGOFS_ERROR FsSync(bool force, bool wait = true);
   uint64_t GetDataCacheNum() {
     return wDataCacheNum_.load(std::memory_order_relaxed);
   }
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/vfs_old/s3/read_planner.h"
+
+#include <algorithm>
+
+namespace dingofs {
+namespace client {
+
+ReadPlanner::ReadPlanner(const ReadPlannerOption& option) : option_(option) {}
+
+std::vector<RangeFetch> ReadPlanner::Plan(std::vector<RangeRead> reads) const {
+  std::sort(reads.begin(), reads.end(),
+            [](const RangeRead& a, const RangeRead& b) {
+              return a.key != b.key ? a.key < b.key : a.offset < b.offset;
+            });
+
+  std::vector<RangeFetch> fetches;
+  for (auto& read : reads) {
+    if (read.length == 0) {
+      continue;
+    }
+
+    if (!fetches.empty()) {
+      auto& fetch = fetches.back();
+      uint64_t fetch_end = fetch.offset + fetch.length;
+      if (fetch.key == read.key &&
+          read.offset <= fetch_end + option_.mergeGapBytes) {
+        fetch.length = std::max(fetch_end, read.offset + read.length) -
+                       fetch.offset;
+        fetch.reads.emplace_back(std::move(read));
+        continue;
+      }
+    }
+
+    RangeFetch fetch;
+    fetch.key = read.key;
+    fetch.offset = read.offset;
+    fetch.length = read.length;
+    fetch.reads.emplace_back(std::move(read));
+    fetches.emplace_back(std::move(fetch));
+  }
+
+  for (auto& fetch : fetches) {
+    Split(&fetch);
+  }
+  return fetches;
+}
+
+void ReadPlanner::Split(RangeFetch* fetch) const {
+  uint64_t split = option_.splitBytes;
+  if (split == 0 || fetch->length <= split) {
+    fetch->parts.push_back(RangeFetch::Part{fetch->offset, fetch->length});
+    return;
+  }
+
+  // the parts are almost the same size, avoid a tiny tail
+  uint64_t count = (fetch->length + split - 1) / split;
+  uint64_t size = (fetch->length + count - 1) / count;
+  for (uint64_t pos = 0; pos < fetch->length; pos += size) {
+    fetch->parts.push_back(RangeFetch::Part{
+        fetch->offset + pos, std::min(size, fetch->length - pos)});
+  }
+}
+
+}  // namespace client
+}  // namespace dingofs
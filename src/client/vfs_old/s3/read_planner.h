@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_OLD_S3_READ_PLANNER_H_
+#define DINGOFS_SRC_CLIENT_VFS_OLD_S3_READ_PLANNER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dingofs {
+namespace client {
+
+struct ReadPlannerOption {
+  uint64_t mergeGapBytes = 0;  // merge the ranges whose gap is within it
+  uint64_t splitBytes = 0;     // split the larger fetch, 0 means never
+};
+
+// A range of object which missed all caches and must be read from s3
+struct RangeRead {
+  std::string key;  // object key
+  uint64_t offset;  // offset in object
+  uint64_t length;
+  char* buffer;  // where the data goes
+};
+
+// A range request to s3, which serves one or more range reads
+struct RangeFetch {
+  struct Part {
+    uint64_t offset;  // offset in object
+    uint64_t length;
+  };
+
+  std::string key;
+  uint64_t offset;
+  uint64_t length;
+  std::vector<RangeRead> reads;
+  std::vector<Part> parts;  // issued in parallel
+};
+
+// Plan the s3 requests for the range reads of one file read:
+// the adjacent (or overlapping) ranges of the same object are merged into
+// one request, and the large request is split into parts which are
+// fetched in parallel.
+class ReadPlanner {
+ public:
+  explicit ReadPlanner(const ReadPlannerOption& option);
+
+  std::vector<RangeFetch> Plan(std::vector<RangeRead> reads) const;
+
+ private:
+  void Split(RangeFetch* fetch) const;
+
+ private:
+  ReadPlannerOption option_;
+};
+
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_OLD_S3_READ_PLANNER_H_
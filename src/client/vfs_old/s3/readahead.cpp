@@ -0,0 +1,424 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/vfs_old/s3/readahead.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace dingofs {
+namespace client {
+
+using blockcache::FlightCall;
+
+static uint64_t NowMs() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+ReadaheadBudget::ReadaheadBudget(uint64_t maxMemoryBytes,
+                                 uint64_t maxBandwidthBytes,
+                                 uint64_t idleTimeoutMs)
+    : idleTimeoutMs_(idleTimeoutMs),
+      lastSweepMs_(0),
+      maxMemoryBytes_(maxMemoryBytes),
+      maxBandwidthBytes_(maxBandwidthBytes),
+      usedBytes_(0),
+      windowStartMs_(NowMs()),
+      windowBytes_(0),
+      memoryBytes_("dingofs_readahead", "memory_bytes"),
+      issuedBytes_("dingofs_readahead", "issued_bytes"),
+      hitBlocks_("dingofs_readahead", "hit_blocks"),
+      wasteBlocks_("dingofs_readahead", "waste_blocks"),
+      cancelBlocks_("dingofs_readahead", "cancel_blocks"),
+      throttledBlocks_("dingofs_readahead", "throttled_blocks") {}
+
+bool ReadaheadBudget::Acquire(uint64_t bytes) {
+  if (TryAcquire(bytes)) {
+    return true;
+  } else if (ReleaseIdle() > 0 && TryAcquire(bytes)) {
+    return true;
+  }
+  throttledBlocks_ << 1;
+  return false;
+}
+
+bool ReadaheadBudget::TryAcquire(uint64_t bytes) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  uint64_t now = NowMs();
+  if (now - windowStartMs_ >= 1000) {
+    windowStartMs_ = now;
+    windowBytes_ = 0;
+  }
+
+  if ((maxMemoryBytes_ > 0 && usedBytes_ + bytes > maxMemoryBytes_) ||
+      (maxBandwidthBytes_ > 0 && windowBytes_ + bytes > maxBandwidthBytes_)) {
+    return false;
+  }
+
+  usedBytes_ += bytes;
+  windowBytes_ += bytes;
+  memoryBytes_ << bytes;
+  issuedBytes_ << bytes;
+  return true;
+}
+
+void ReadaheadBudget::Release(uint64_t bytes) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  bytes = std::min(bytes, usedBytes_);
+  usedBytes_ -= bytes;
+  memoryBytes_ << -static_cast<int64_t>(bytes);
+}
+
+uint64_t ReadaheadBudget::UsedBytes() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return usedBytes_;
+}
+
+uint64_t ReadaheadBudget::ReleaseIdle() {
+  std::lock_guard<std::mutex> lk(registryMutex_);
+  uint64_t now = NowMs();
+  if (now - lastSweepMs_ < 1000) {  // sweep at most once per second
+    return 0;
+  }
+  lastSweepMs_ = now;
+
+  uint64_t released = 0;
+  for (auto* readahead : readaheads_) {
+    released += readahead->ReleaseIdle(now, idleTimeoutMs_);
+  }
+  return released;
+}
+
+void ReadaheadBudget::Register(Readahead* readahead) {
+  std::lock_guard<std::mutex> lk(registryMutex_);
+  readaheads_.insert(readahead);
+}
+
+void ReadaheadBudget::Unregister(Readahead* readahead) {
+  std::lock_guard<std::mutex> lk(registryMutex_);
+  readaheads_.erase(readahead);
+}
+
+Readahead::Readahead(const ReadaheadOption& option,
+                     std::shared_ptr<ReadaheadBudget> budget)
+    : option_(option),
+      budget_(std::move(budget)),
+      prevOffset_(0),
+      prevLen_(0),
+      stride_(0),
+      window_(option.blockSize * option.minBlocks),
+      raEnd_(0),
+      wasted_(false),
+      eof_(false),
+      lastAccessMs_(NowMs()) {
+  budget_->Register(this);
+}
+
+Readahead::~Readahead() {
+  budget_->Unregister(this);
+  for (const auto& item : blocks_) {
+    budget_->Release(item.second.length);
+  }
+}
+
+std::vector<Readahead::Range> Readahead::OnRead(uint64_t offset,
+                                                uint64_t length,
+                                                uint64_t fileLen) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  std::vector<Range> ranges;
+  lastAccessMs_ = NowMs();
+  if (length == 0 || (offset == prevOffset_ && length == prevLen_)) {
+    return ranges;  // re-read the same range, keep the stream as it is
+  }
+
+  uint64_t end = offset + length;
+  eof_ = end >= fileLen;
+  switch (Detect(offset, length)) {
+    case Pattern::kSequential: {
+      EvictLocked(offset);
+      raEnd_ = std::max(raEnd_, end);
+      if (raEnd_ - end >= window_ / 2) {  // the lookahead is enough
+        break;
+      }
+
+      uint64_t start = raEnd_;
+      uint64_t stop = std::min(start + window_, fileLen);
+      if (stop > start) {
+        ranges.push_back(Range{start, stop - start});
+        raEnd_ = stop;
+        Grow();
+      }
+      break;
+    }
+
+    case Pattern::kStrided: {
+      EvictLocked(offset);
+      uint64_t count = std::max<uint64_t>(1, window_ / length);
+      count = std::min<uint64_t>(count, option_.maxBlocks);
+      for (uint64_t i = 1; i <= count; i++) {
+        uint64_t start = offset + i * stride_;
+        if (start >= fileLen) {
+          break;
+        } else if (start + length <= raEnd_) {  // already issued
+          continue;
+        }
+        uint64_t len = std::min(length, fileLen - start);
+        ranges.push_back(Range{start, len});
+        raEnd_ = start + len;
+      }
+      if (!ranges.empty()) {
+        Grow();
+      }
+      break;
+    }
+
+    default:  // random
+      ResetLocked();
+      stride_ = prevLen_ == 0 ? 0
+                              : static_cast<int64_t>(offset) -
+                                    static_cast<int64_t>(prevOffset_);
+      window_ = option_.blockSize * option_.minBlocks;
+      raEnd_ = 0;
+      wasted_ = false;
+  }
+
+  prevOffset_ = offset;
+  prevLen_ = length;
+  return ranges;
+}
+
+Readahead::Pattern Readahead::Detect(uint64_t offset, uint64_t length) const {
+  if (prevLen_ == 0) {  // the first read
+    return Pattern::kRandom;
+  } else if (offset >= prevOffset_ && offset <= prevOffset_ + prevLen_) {
+    return Pattern::kSequential;
+  } else if (stride_ > static_cast<int64_t>(prevLen_) &&
+             offset == prevOffset_ + stride_ && length == prevLen_) {
+    return Pattern::kStrided;
+  }
+  return Pattern::kRandom;
+}
+
+void Readahead::Grow() {
+  if (!wasted_) {
+    window_ = std::min(window_ * 2, option_.blockSize * option_.maxBlocks);
+  }
+  wasted_ = false;
+}
+
+void Readahead::Shrink() {
+  window_ = std::max(window_ / 2, option_.blockSize * option_.minBlocks);
+  wasted_ = true;
+}
+
+bool Readahead::Issue(const std::string& name, uint64_t fileEnd,
+                      uint64_t length) {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    auto iter = blocks_.find(name);
+    if (iter != blocks_.end()) {
+      auto& block = iter->second;
+      if (block.dropped) {  // it's still inflight, wanted again
+        block.dropped = false;
+        block.fileEnd = fileEnd;
+      }
+      return false;
+    }
+  }
+
+  // acquire without holding the lock, it may release the idle blocks
+  // of other files, including this one
+  if (!budget_->Acquire(length)) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto ret = blocks_.emplace(
+      name, Block{fileEnd, length, true, false, false, nullptr, 0});
+  if (!ret.second) {  // issued by others meanwhile
+    budget_->Release(length);
+    return false;
+  }
+  return true;
+}
+
+bool Readahead::Wanted(const std::string& name) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto iter = blocks_.find(name);
+  return iter != blocks_.end() && !iter->second.dropped;
+}
+
+void Readahead::Complete(const std::string& name,
+                         std::shared_ptr<FlightCall> call, size_t nread) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto iter = blocks_.find(name);
+  if (iter == blocks_.end()) {
+    return;
+  } else if (iter->second.dropped) {
+    EraseLocked(iter);
+    return;
+  }
+
+  auto& block = iter->second;
+  block.inflight = false;
+  block.call = std::move(call);
+  block.nread = nread;
+  if (block.used && PassedAtEofLocked(block)) {  // no one will read it
+    EraseLocked(iter);
+  } else if (block.call == nullptr) {  // the data is held by cache store
+    budget_->Release(block.length);
+    block.length = 0;
+  }
+}
+
+void Readahead::Abort(const std::string& name) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto iter = blocks_.find(name);
+  if (iter != blocks_.end()) {
+    EraseLocked(iter);
+  }
+}
+
+bool Readahead::Read(const std::string& name, uint64_t offset,
+                     uint64_t length, char* buffer) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto iter = blocks_.find(name);
+  if (iter == blocks_.end() || iter->second.dropped) {
+    return false;
+  }
+
+  auto& block = iter->second;
+  if (!block.used) {
+    block.used = true;
+    budget_->hitBlocks_ << 1;
+  }
+
+  if (block.inflight) {
+    return false;
+  }
+
+  bool ok = false;
+  if (block.call != nullptr && offset + length <= block.nread) {
+    std::memcpy(buffer, block.call->Buffer() + offset, length);
+    ok = true;
+  }
+
+  // it's not evicted by the following reads for there is none
+  if (PassedAtEofLocked(block)) {
+    EraseLocked(iter);
+  }
+  return ok;
+}
+
+uint64_t Readahead::WindowBytes() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return window_;
+}
+
+void Readahead::Release() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  ResetLocked();
+  prevOffset_ = 0;
+  prevLen_ = 0;
+  stride_ = 0;
+  window_ = option_.blockSize * option_.minBlocks;
+  raEnd_ = 0;
+  wasted_ = false;
+  eof_ = false;
+}
+
+uint64_t Readahead::ReleaseIdle(uint64_t nowMs, uint64_t idleMs) {
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (blocks_.empty() || nowMs < lastAccessMs_ + idleMs) {
+    return 0;
+  }
+
+  uint64_t released = 0;
+  for (auto iter = blocks_.begin(); iter != blocks_.end();) {
+    const auto& block = iter->second;
+    if (block.dropped) {
+      iter++;
+      continue;
+    }
+
+    if (!block.used) {
+      budget_->wasteBlocks_ << 1;
+    }
+    if (!block.inflight) {
+      released += block.length;
+    }
+    iter = DropLocked(iter);
+  }
+  return released;
+}
+
+void Readahead::EvictLocked(uint64_t offset) {
+  for (auto iter = blocks_.begin(); iter != blocks_.end();) {
+    const auto& block = iter->second;
+    if (block.dropped || block.fileEnd > offset) {
+      iter++;
+      continue;
+    }
+
+    if (!block.used) {
+      budget_->wasteBlocks_ << 1;
+      Shrink();
+    }
+    iter = DropLocked(iter);
+  }
+}
+
+void Readahead::ResetLocked() {
+  for (auto iter = blocks_.begin(); iter != blocks_.end();) {
+    if (iter->second.dropped) {
+      iter++;
+      continue;
+    }
+
+    if (iter->second.inflight) {
+      budget_->cancelBlocks_ << 1;
+    }
+    iter = DropLocked(iter);
+  }
+}
+
+bool Readahead::PassedAtEofLocked(const Block& block) const {
+  return eof_ && block.fileEnd <= prevOffset_ + prevLen_;
+}
+
+Readahead::BlockMap::iterator Readahead::DropLocked(BlockMap::iterator iter) {
+  if (iter->second.inflight) {
+    iter->second.dropped = true;
+    return ++iter;
+  }
+  return EraseLocked(iter);
+}
+
+Readahead::BlockMap::iterator Readahead::EraseLocked(BlockMap::iterator iter) {
+  budget_->Release(iter->second.length);
+  return blocks_.erase(iter);
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_OLD_S3_READAHEAD_H_
+#define DINGOFS_SRC_CLIENT_VFS_OLD_S3_READAHEAD_H_
+
+#include <bvar/bvar.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "client/blockcache/single_flight.h"
+
+namespace dingofs {
+namespace client {
+
+struct ReadaheadOption {
+  uint64_t blockSize = 4 * 1024 * 1024;
+  uint32_t minBlocks = 1;  // initial window
+  uint32_t maxBlocks = 32;
+};
+
+class Readahead;
+
+// The global budget shared by all files: the bytes of readahead data
+// which are inflight or held in memory, and the bytes issued per second.
+// Readahead is speculative, so it's skipped rather than waiting when
+// the budget is exhausted, but the blocks of files which are not read
+// for |idleTimeoutMs| are released first to make room.
+class ReadaheadBudget {
+ public:
+  // 0 means no limit
+  ReadaheadBudget(uint64_t maxMemoryBytes, uint64_t maxBandwidthBytes,
+                  uint64_t idleTimeoutMs = 10 * 1000);
+
+  bool Acquire(uint64_t bytes);
+
+  void Release(uint64_t bytes);
+
+  uint64_t UsedBytes();
+
+  // Release the blocks of idle files, return the bytes released.
+  uint64_t ReleaseIdle();
+
+ private:
+  friend class Readahead;
+
+  bool TryAcquire(uint64_t bytes);
+
+  void Register(Readahead* readahead);
+
+  void Unregister(Readahead* readahead);
+
+  // lock order: registryMutex_ -> Readahead::mutex_ -> mutex_
+  std::mutex registryMutex_;
+  std::unordered_set<Readahead*> readaheads_;
+  uint64_t idleTimeoutMs_;
+  uint64_t lastSweepMs_;
+
+  std::mutex mutex_;
+  uint64_t maxMemoryBytes_;
+  uint64_t maxBandwidthBytes_;
+  uint64_t usedBytes_;
+  uint64_t windowStartMs_;  // start of current bandwidth window (1 second)
+  uint64_t windowBytes_;
+
+  bvar::Adder<int64_t> memoryBytes_;
+  bvar::Adder<uint64_t> issuedBytes_;
+  bvar::Adder<uint64_t> hitBlocks_;
+  bvar::Adder<uint64_t> wasteBlocks_;
+  bvar::Adder<uint64_t> cancelBlocks_;
+  bvar::Adder<uint64_t> throttledBlocks_;
+};
+
+// The readahead state machine of one file, it's something like kernel's
+// ondemand readahead:
+//
+//   * the stream is sequential if the read starts inside or right after
+//     the previous read, or strided if it repeats the previous distance;
+//   * the window starts from |minBlocks| and doubles every time it's
+//     issued, until |maxBlocks|, the next window is issued once the
+//     reader consumed half of the lookahead (async readahead);
+//   * readahead blocks which are passed without being read are wasted,
+//     which halves the window;
+//   * a random read breaks the stream, the readahead blocks which
+//     are not fetched yet are cancelled;
+//   * the blocks are released once the reader passed them at the end of
+//     file, the file is closed, or it's idle for a while.
+class Readahead {
+ public:
+  struct Range {
+    uint64_t offset;
+    uint64_t len;
+  };
+
+ public:
+  Readahead(const ReadaheadOption& option,
+            std::shared_ptr<ReadaheadBudget> budget);
+
+  ~Readahead();
+
+  // Feed a read of [offset, offset + length), return the file ranges
+  // to readahead, which is empty if the stream is not confirmed yet.
+  std::vector<Range> OnRead(uint64_t offset, uint64_t length,
+                            uint64_t fileLen);
+
+  // Track the block which will be fetched, return false if it's already
+  // tracked or the budget is exhausted.
+  bool Issue(const std::string& name, uint64_t fileEnd, uint64_t length);
+
+  // Whether the issued block is still wanted by the stream
+  bool Wanted(const std::string& name);
+
+  // The block is fetched, |call| is kept to serve reads from memory,
+  // or it's nullptr if the block has been put into cache store.
+  void Complete(const std::string& name,
+                std::shared_ptr<blockcache::FlightCall> call, size_t nread);
+
+  // The block is failed or cancelled
+  void Abort(const std::string& name);
+
+  // Copy from the readahead data held in memory, and mark the block is used.
+  bool Read(const std::string& name, uint64_t offset, uint64_t length,
+            char* buffer);
+
+  uint64_t WindowBytes();
+
+  // Drop all blocks, e.g. the file is closed.
+  void Release();
+
+  // Drop all blocks if it's not read since |nowMs - idleMs|,
+  // return the bytes released.
+  uint64_t ReleaseIdle(uint64_t nowMs, uint64_t idleMs);
+
+ private:
+  enum class Pattern : uint8_t {
+    kRandom = 0,
+    kSequential = 1,
+    kStrided = 2,
+  };
+
+  struct Block {
+    uint64_t fileEnd;
+    uint64_t length;  // budget acquired
+    bool inflight;
+    bool used;
+    bool dropped;  // dropped while inflight, erased once it's done
+    std::shared_ptr<blockcache::FlightCall> call;
+    size_t nread;
+  };
+
+  using BlockMap = std::unordered_map<std::string, Block>;
+
+  Pattern Detect(uint64_t offset, uint64_t length) const;
+
+  void Grow();
+
+  void Shrink();
+
+  // Drop the blocks which end before |offset|, the unused ones are wasted.
+  void EvictLocked(uint64_t offset);
+
+  // Drop all blocks for the stream is broken.
+  void ResetLocked();
+
+  // Whether the reader has read through the block at the end of file
+  bool PassedAtEofLocked(const Block& block) const;
+
+  BlockMap::iterator DropLocked(BlockMap::iterator iter);
+
+  BlockMap::iterator EraseLocked(BlockMap::iterator iter);
+
+ private:
+  std::mutex mutex_;
+  const ReadaheadOption option_;
+  std::shared_ptr<ReadaheadBudget> budget_;
+  uint64_t prevOffset_;
+  uint64_t prevLen_;
+  int64_t stride_;
+  uint64_t window_;  // bytes
+  uint64_t raEnd_;   // readahead is issued up to (exclusive)
+  bool wasted_;      // any block is wasted since last window
+  bool eof_;         // the previous read reached the end of file
+  uint64_t lastAccessMs_;
+  BlockMap blocks_;  // name -> block
+};
+
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_OLD_S3_READAHEAD_H_
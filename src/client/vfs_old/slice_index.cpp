@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/vfs_old/slice_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace dingofs {
+namespace client {
+
+using pb::metaserver::S3ChunkInfo;
+using pb::metaserver::S3ChunkInfoList;
+
+SliceIndex::SliceIndex(const S3ChunkInfoList& slices) {
+  for (const auto& info : slices.s3chunks()) {
+    AddLocked(info);
+  }
+}
+
+void SliceIndex::Add(const S3ChunkInfo& info) {
+  utils::WriteLockGuard lk(rwlock_);
+  AddLocked(info);
+}
+
+//      |-------|       |-------|        intervals
+//          |---------------|            new slice
+//      |---|---------------|---|        after
+void SliceIndex::AddLocked(const S3ChunkInfo& info) {
+  uint64_t begin = info.offset();
+  uint64_t end = info.offset() + info.len();
+  if (begin >= end) {
+    return;
+  }
+
+  // cut the interval which spans the begin
+  auto iter = intervals_.lower_bound(begin);
+  if (iter != intervals_.begin()) {
+    auto prev = std::prev(iter);
+    if (prev->second.end > begin) {
+      Interval tail = prev->second;
+      prev->second.end = begin;
+      if (tail.end > end) {  // new slice is inside the interval
+        intervals_.emplace(end, tail);
+      }
+    }
+  }
+
+  // remove the intervals covered by the new slice, and cut the last one
+  while (iter != intervals_.end() && iter->first < end) {
+    if (iter->second.end > end) {
+      Interval tail = iter->second;
+      intervals_.erase(iter);
+      intervals_.emplace(end, tail);
+      break;
+    }
+    iter = intervals_.erase(iter);
+  }
+
+  SliceInfo slice{info.chunkid(), info.compaction(), info.offset(),
+                  info.zero()};
+  intervals_[begin] = Interval{end, slice};
+
+  for (uint64_t value : {info.chunkid(), info.compaction(), begin, end,
+                         static_cast<uint64_t>(info.zero())}) {
+    version_ = Mix(version_ ^ value);
+  }
+}
+
+std::vector<SliceRange> SliceIndex::Resolve(uint64_t offset,
+                                            uint64_t length) const {
+  std::vector<SliceRange> ranges;
+  uint64_t pos = offset;
+  uint64_t end = offset + length;
+
+  utils::ReadLockGuard lk(rwlock_);
+  auto iter = intervals_.upper_bound(offset);
+  if (iter != intervals_.begin() && std::prev(iter)->second.end > offset) {
+    iter = std::prev(iter);
+  }
+
+  for (; iter != intervals_.end() && iter->first < end; iter++) {
+    uint64_t begin = std::max(iter->first, pos);
+    if (begin > pos) {
+      ranges.push_back(SliceRange{pos, begin - pos, true, SliceInfo{}});
+    }
+    uint64_t stop = std::min(iter->second.end, end);
+    ranges.push_back(SliceRange{begin, stop - begin, false, iter->second.slice});
+    pos = stop;
+  }
+
+  if (pos < end) {
+    ranges.push_back(SliceRange{pos, end - pos, true, SliceInfo{}});
+  }
+  return ranges;
+}
+
+size_t SliceIndex::Size() const {
+  utils::ReadLockGuard lk(rwlock_);
+  return intervals_.size();
+}
+
+uint64_t SliceIndex::Version() const {
+  utils::ReadLockGuard lk(rwlock_);
+  return version_;
+}
+
+// the finalizer of splitmix64
+uint64_t SliceIndex::Mix(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_VFS_OLD_SLICE_INDEX_H_
+#define DINGOFS_SRC_CLIENT_VFS_OLD_SLICE_INDEX_H_
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "dingofs/metaserver.pb.h"
+#include "utils/concurrent/concurrent.h"
+
+namespace dingofs {
+namespace client {
+
+struct SliceInfo {
+  uint64_t chunkId;
+  uint64_t compaction;
+  uint64_t offset;  // file offset where the slice begins
+  bool zero;
+};
+
+// A piece of the resolved range, which is served by |slice|,
+// or it's a hole if |hole| is true.
+struct SliceRange {
+  uint64_t offset;  // file offset
+  uint64_t len;
+  bool hole;
+  SliceInfo slice;
+};
+
+// The resolved slice map of one chunk: it maps every byte of chunk to the
+// newest slice which covers it, so a read only looks up the intervals it
+// overlaps, instead of splitting the request against all slices.
+//
+// The slices are non-overlapping intervals keyed by begin offset, a new
+// slice is laid on top of the existing ones by cutting the intervals
+// it covers.
+class SliceIndex {
+ public:
+  SliceIndex() = default;
+
+  explicit SliceIndex(const pb::metaserver::S3ChunkInfoList& slices);
+
+  // The slice must be newer than all slices already added
+  void Add(const pb::metaserver::S3ChunkInfo& info);
+
+  // Resolve [offset, offset + length) into pieces ordered by offset
+  std::vector<SliceRange> Resolve(uint64_t offset, uint64_t length) const;
+
+  size_t Size() const;
+
+  // The version of the chunk data, it changes whenever a slice is added,
+  // so the data cached by version is never stale.
+  uint64_t Version() const;
+
+ private:
+  struct Interval {
+    uint64_t end;
+    SliceInfo slice;
+  };
+
+  void AddLocked(const pb::metaserver::S3ChunkInfo& info);
+
+  static uint64_t Mix(uint64_t x);
+
+  mutable utils::RWLock rwlock_;  // protect intervals_
+  std::map<uint64_t, Interval> intervals_;  // begin -> interval
+  uint64_t version_{0};
+};
+
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_VFS_OLD_SLICE_INDEX_H_
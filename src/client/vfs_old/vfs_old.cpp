@@ -372,6 +372,8 @@ Status VFSOld::Start(const VFSConfig& vfs_conf) {
       uuid = fs_info_->uuid();
     }
     RewriteCacheDir(&block_cache_option, uuid);
+    block_cache_option.cache_group_option.block_size =
+        fuse_client_option_.s3Opt.s3ClientAdaptorOpt.blockSize;
     auto block_cache =
         std::make_shared<blockcache::BlockCacheImpl>(block_cache_option);
 
@@ -584,6 +586,7 @@ Status VFSOld::SetAttr(Ino ino, int set, const Attr& in_attr, Attr* out_attr) {
   pb::metaserver::InodeAttr attr;
 
   auto defer = ::absl::MakeCleanup([&]() {
+    fs_->InvalidateAttr(ino);
     if (ret == DINGOFS_ERROR::OK) {
       fs_->BeforeReplyAttr(attr);
     }
@@ -749,6 +752,10 @@ Status VFSOld::AllocNode(Ino parent, const std::string& name, uint32_t uid,
           << ", uid: " << uid << ", gid: " << gid
           << ", type: " << pb::metaserver::FsFileType_Name(type)
           << ", mode: " << mode << ", dev: " << dev;
+  // it may be created partly even if failed
+  auto invalidate =
+      ::absl::MakeCleanup([&]() { fs_->InvalidateEntry(parent, name); });
+
   {
     // precheck
     if (name.length() > fuse_client_option_.fileSystemOption.maxNameLength) {
@@ -932,6 +939,9 @@ Status VFSOld::Unlink(Ino parent, const std::string& name) {
     return Status::NoPermitted("Can not unlink internal node");
   }
 
+  auto invalidate =
+      ::absl::MakeCleanup([&]() { fs_->InvalidateEntry(parent, name); });
+
   pb::metaserver::Dentry dentry;
   DINGOFS_ERROR ret = dentry_cache_manager_->GetDentry(parent, name, &dentry);
   if (ret != DINGOFS_ERROR::OK) {
@@ -941,6 +951,8 @@ Status VFSOld::Unlink(Ino parent, const std::string& name) {
   }
 
   Ino inode_id = dentry.inodeid();
+  auto invalidate_attr =
+      ::absl::MakeCleanup([&]() { fs_->InvalidateAttr(inode_id); });
   // NOTE: recycle logic is removed
 
   {
@@ -1124,6 +1136,11 @@ Status VFSOld::Rename(Ino old_parent, const std::string& old_name,
       new_name, dentry_cache_manager_, inode_cache_manager_, metaserver_client_,
       mds_client_, fuse_client_option_.enableMultiMountPointRename);
 
+  auto invalidate = ::absl::MakeCleanup([&]() {
+    fs_->InvalidateEntry(old_parent, old_name);
+    fs_->InvalidateEntry(new_parent, new_name);
+  });
+
   dingofs::utils::LockGuard lg(rename_mutex_);
   DINGOFS_ERROR rc = DINGOFS_ERROR::OK;
   VLOG(3) << "Rename [start]: " << rename_operator.DebugString();
@@ -1154,6 +1171,19 @@ Status VFSOld::Rename(Ino old_parent, const std::string& old_name,
   rename_operator.UpdateInodeCtime();
   rename_operator.UpdateCache();
 
+  {
+    // ctime and parents of source and nlink of overwritten one are changed
+    uint64_t old_inode_id;
+    int64_t old_inode_size;
+    pb::metaserver::FsFileType old_inode_type;
+    rename_operator.GetOldInode(&old_inode_id, &old_inode_size,
+                                &old_inode_type);
+    fs_->InvalidateAttr(rename_operator.GetSrcInodeId());
+    if (old_inode_id != 0) {
+      fs_->InvalidateAttr(old_inode_id);
+    }
+  }
+
   rename_operator.FinishUpdateUsage(fs_);
 
   // careful about the rc
@@ -1181,6 +1211,11 @@ Status VFSOld::Link(Ino ino, Ino new_parent, const std::string& new_name,
     }
   }
 
+  auto invalidate = ::absl::MakeCleanup([&]() {
+    fs_->InvalidateEntry(new_parent, new_name);
+    fs_->InvalidateAttr(ino);
+  });
+
   std::shared_ptr<InodeWrapper> inode_wrapper;
   DINGOFS_ERROR ret = inode_cache_manager_->GetInode(ino, inode_wrapper);
   if (ret != DINGOFS_ERROR::OK) {
@@ -1452,6 +1487,42 @@ Status VFSOld::Read(Ino ino, char* buf, uint64_t size, uint64_t offset,
   return Status::OK();
 }
 
+Status VFSOld::ReadSplice(Ino ino, uint64_t size, uint64_t offset, uint64_t fh,
+                          SpliceBuffer* buffer) {
+  VLOG(1) << "ReadSplice inodeId=" << ino << ", size: " << size
+          << ", offset: " << offset << ", fh: " << fh;
+  if (ino == STATSINODEID || size == 0) {
+    return Status::NotSupport("not spliceable");
+  }
+
+  std::shared_ptr<InodeWrapper> inode_wrapper;
+  DINGOFS_ERROR ret = inode_cache_manager_->GetInode(ino, inode_wrapper);
+  if (ret != DINGOFS_ERROR::OK) {
+    return Status::NotSupport("not spliceable");  // let Read() report it
+  }
+
+  // the short read at the end of file is served by Read()
+  if (offset + size > inode_wrapper->GetLength() ||
+      s3_adapter_->ReadSplice(ino, offset, size, buffer) != 0) {
+    return Status::NotSupport("not spliceable");
+  }
+
+  ReadThrottleAdd(size);
+
+  uint64_t r_size = size;
+  FsMetricGuard guard(&stub::metric::FSMetric::GetInstance().user_read,
+                      &r_size);
+
+  utils::UniqueLock lg_guard = inode_wrapper->GetUniqueLock();
+  inode_wrapper->UpdateTimestampLocked(kAccessTime);
+  inode_cache_manager_->ShipToFlush(inode_wrapper);
+
+  VLOG(1) << "Success read splice for inodeId=" << ino
+          << ", fd = " << buffer->fd << ", offset = " << buffer->offset
+          << ", size = " << buffer->size;
+  return Status::OK();
+}
+
 void VFSOld::WriteThrottleAdd(uint64_t size) { throttle_.Add(false, size); }
 
 Status VFSOld::Write(Ino ino, const char* buf, uint64_t size, uint64_t offset,
@@ -1583,6 +1654,7 @@ Status VFSOld::Release(Ino ino, uint64_t fh) {
     return filesystem::DingofsErrorToStatus(rc);
   }
 
+  s3_adapter_->ReleaseReadahead(ino);
   return Status::OK();
 }
 
@@ -1734,6 +1806,8 @@ Status VFSOld::SetXAttr(Ino ino, const std::string& name,
       return filesystem::DingofsErrorToStatus(ret);
     }
 
+    auto invalidate =
+        ::absl::MakeCleanup([&]() { fs_->InvalidateAttr(ino); });
     dingofs::utils::UniqueLock lg_guard = inode_wrapper->GetUniqueLock();
     inode_wrapper->SetXattrLocked(name, value);
 
@@ -1938,6 +2012,9 @@ Status VFSOld::Rmdir(Ino parent, const std::string& name) {
     return Status::NoPermitted("not permit rmdir internal dir");
   }
 
+  auto invalidate =
+      ::absl::MakeCleanup([&]() { fs_->InvalidateEntry(parent, name); });
+
   pb::metaserver::Dentry dentry;
   DINGOFS_ERROR ret = dentry_cache_manager_->GetDentry(parent, name, &dentry);
   if (ret != DINGOFS_ERROR::OK) {
@@ -1948,6 +2025,8 @@ Status VFSOld::Rmdir(Ino parent, const std::string& name) {
   }
 
   uint64_t inode_id = dentry.inodeid();
+  auto invalidate_attr =
+      ::absl::MakeCleanup([&]() { fs_->InvalidateAttr(inode_id); });
 
   {
     // check dir empty
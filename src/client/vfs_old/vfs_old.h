@@ -88,6 +88,9 @@ class VFSOld : public VFS {
   Status Read(Ino ino, char* buf, uint64_t size, uint64_t offset, uint64_t fh,
               uint64_t* out_rsize) override;
 
+  Status ReadSplice(Ino ino, uint64_t size, uint64_t offset, uint64_t fh,
+                    SpliceBuffer* buffer) override;
+
   Status Write(Ino ino, const char* buf, uint64_t size, uint64_t offset,
                uint64_t fh, uint64_t* out_wsize) override;
 
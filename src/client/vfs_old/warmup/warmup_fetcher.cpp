@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/vfs_old/warmup/warmup_fetcher.h"
+
+#include <butil/time.h>
+
+#include <chrono>
+#include <utility>
+
+namespace dingofs {
+namespace client {
+namespace warmup {
+
+// the waiters recheck the foreground reads and bandwidth budget by it
+static constexpr auto kRecheckInterval = std::chrono::milliseconds(10);
+
+WarmupFetcher::WarmupFetcher(WarmupFetcherOption option, BusyFunc busy)
+    : option_(option), busy_(std::move(busy)) {}
+
+bool WarmupFetcher::Acquire(const std::string& key, uint64_t bytes) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (inflight_keys_.count(key) != 0) {
+    return false;
+  }
+
+  while (!stopped_) {
+    bool busy = busy_ != nullptr && busy_();
+    if (Admit(bytes, busy)) {
+      inflight_bytes_ += bytes;
+      inflight_keys_.emplace(key);
+      return true;
+    }
+    cond_.wait_for(lk, kRecheckInterval);
+  }
+  return false;
+}
+
+void WarmupFetcher::Release(const std::string& key, uint64_t bytes) {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    inflight_bytes_ -= bytes;
+    inflight_keys_.erase(key);
+  }
+  cond_.notify_all();
+}
+
+void WarmupFetcher::Stop() {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    stopped_ = true;
+  }
+  cond_.notify_all();
+}
+
+uint64_t WarmupFetcher::InflightBytes() {
+  std::lock_guard<std::mutex> lk(mutex_);
+  return inflight_bytes_;
+}
+
+// The first get is always admitted when nothing is inflight (or nothing is
+// spent in current second), so a block larger than the limits never hangs.
+bool WarmupFetcher::Admit(uint64_t bytes, bool busy) {
+  if (inflight_bytes_ > 0) {
+    if (busy) {
+      return false;
+    } else if (option_.max_inflight_bytes > 0 &&
+               inflight_bytes_ + bytes > option_.max_inflight_bytes) {
+      return false;
+    }
+  }
+
+  if (option_.bandwidth > 0) {
+    int64_t now = butil::monotonic_time_s();
+    if (now != window_second_) {
+      window_second_ = now;
+      window_bytes_ = 0;
+    }
+
+    if (window_bytes_ > 0 && window_bytes_ + bytes > option_.bandwidth) {
+      return false;
+    }
+    window_bytes_ += bytes;
+  }
+  return true;
+}
+
+}  // namespace warmup
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#ifndef DINGOFS_SRC_CLIENT_WARMUP_WARMUP_FETCHER_H_
+#define DINGOFS_SRC_CLIENT_WARMUP_WARMUP_FETCHER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace dingofs {
+namespace client {
+namespace warmup {
+
+struct WarmupFetcherOption {
+  uint64_t max_inflight_bytes = 0;  // window of s3 gets, 0 means unlimited
+  uint64_t bandwidth = 0;           // bytes per second, 0 means unlimited
+};
+
+// The admission of warmup s3 gets shared by all warmup tasks:
+//   1) the bytes of inflight gets are bounded by a window, the caller
+//      blocks until the window has room.
+//   2) the bandwidth is capped by a fixed window limiter, the budget is
+//      reset every second.
+//   3) while foreground reads are waiting on s3 (|busy| returns true), only
+//      one warmup get is admitted at a time, so warmup yields to them.
+//   4) the object which is being fetched by another warmup task is
+//      rejected, it's fetched only once.
+class WarmupFetcher {
+ public:
+  using BusyFunc = std::function<bool()>;
+
+  WarmupFetcher(WarmupFetcherOption option, BusyFunc busy);
+
+  // Block until the get of object is admitted, return false if the
+  // object is inflight already or the fetcher is stopped.
+  bool Acquire(const std::string& key, uint64_t bytes);
+
+  // Must be invoked once the admitted get is done (success or not)
+  void Release(const std::string& key, uint64_t bytes);
+
+  // Wake up and reject all waiters
+  void Stop();
+
+  uint64_t InflightBytes();
+
+ private:
+  bool Admit(uint64_t bytes, bool busy);
+
+ private:
+  WarmupFetcherOption option_;
+  BusyFunc busy_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool stopped_{false};
+  uint64_t inflight_bytes_{0};
+  std::unordered_set<std::string> inflight_keys_;
+  int64_t window_second_{0};
+  uint64_t window_bytes_{0};
+};
+
+}  // namespace warmup
+}  // namespace client
+}  // namespace dingofs
+
+#endif  // DINGOFS_SRC_CLIENT_WARMUP_WARMUP_FETCHER_H_
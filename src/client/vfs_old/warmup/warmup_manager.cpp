@@ -33,6 +33,7 @@
 #include <utility>
 
 #include "base/filepath/filepath.h"
+#include "base/math/math.h"
 #include "client/blockcache/cache_store.h"
 #include "client/blockcache/s3_client.h"
 #include "client/vfs_old/common/common.h"
@@ -50,6 +51,7 @@ namespace warmup {
 using aws::GetObjectAsyncCallBack;
 using aws::GetObjectAsyncContext;
 using base::filepath::PathSplit;
+using base::math::kMiB;
 using blockcache::BCACHE_ERROR;
 using blockcache::Block;
 using blockcache::BlockKey;
@@ -112,6 +114,10 @@ void WarmupManagerS3Impl::UnInit() {
     bgFetchThread_.join();
   }
 
+  if (fetcher_ != nullptr) {
+    fetcher_->Stop();  // wake up the tasks waiting for window
+  }
+
   for (auto& task : inode2FetchDentryPool_) {
     task.second->Stop();
   }
@@ -144,6 +150,13 @@ void WarmupManagerS3Impl::UnInit() {
 
 void WarmupManagerS3Impl::Init(const FuseClientOption& option) {
   WarmupManager::Init(option);
+  WarmupFetcherOption fetcher_option;
+  fetcher_option.max_inflight_bytes = option.warmupMaxInflightMB * kMiB;
+  fetcher_option.bandwidth = option.warmupBandwidthMB * kMiB;
+  fetcher_ = std::make_unique<WarmupFetcher>(fetcher_option, [this]() {
+    return s3Adaptor_->GetForegroundReads() > 0;
+  });
+
   bgFetchStop_.store(false, std::memory_order_release);
   bgFetchThread_ = utils::Thread(&WarmupManagerS3Impl::BackGroundFetch, this);
   initbgFetchThread_ = true;
@@ -301,14 +314,7 @@ void WarmupManagerS3Impl::FetchDentry(fuse_ino_t key, fuse_ino_t ino,
   }
 
   if (FsFileType::TYPE_S3 == dentry.type()) {
-    WriteLockGuard lock(warmupInodesDequeMutex_);
-    auto iter_deque = FindWarmupInodesByKeyLocked(key);
-    if (iter_deque == warmupInodesDeque_.end()) {
-      warmupInodesDeque_.emplace_back(key,
-                                      std::set<fuse_ino_t>{dentry.inodeid()});
-    } else {
-      iter_deque->AddFileInode(dentry.inodeid());
-    }
+    AddWarmupInodes(key, std::set<fuse_ino_t>{dentry.inodeid()});
     return;
   } else if (FsFileType::TYPE_DIRECTORY == dentry.type()) {
     auto task = [this, key, dentry]() {
@@ -338,17 +344,13 @@ void WarmupManagerS3Impl::FetchChildDentry(fuse_ino_t key, fuse_ino_t ino) {
     return;
   }
 
+  // the subdirectories are walked by the pool in parallel, and the files
+  // of this directory are added at once
+  std::set<fuse_ino_t> files;
   for (const auto& dentry : dentry_list) {
     VLOG(9) << "FetchChildDentry: key:" << key << " dentry: " << dentry.name();
     if (FsFileType::TYPE_S3 == dentry.type()) {
-      WriteLockGuard lock(warmupInodesDequeMutex_);
-      auto iter_deque = FindWarmupInodesByKeyLocked(key);
-      if (iter_deque == warmupInodesDeque_.end()) {
-        warmupInodesDeque_.emplace_back(key,
-                                        std::set<fuse_ino_t>{dentry.inodeid()});
-      } else {
-        iter_deque->AddFileInode(dentry.inodeid());
-      }
+      files.emplace(dentry.inodeid());
       VLOG(9) << "FetchChildDentry: " << dentry.inodeid();
     } else if (FsFileType::TYPE_DIRECTORY == dentry.type()) {
       auto task = [this, key, dentry]() {
@@ -361,9 +363,44 @@ void WarmupManagerS3Impl::FetchChildDentry(fuse_ino_t key, fuse_ino_t ino) {
       VLOG(9) << "unknown type";
     }
   }
+
+  if (!files.empty()) {
+    AddWarmupInodes(key, std::move(files));
+  }
   VLOG(9) << "FetchChildDentry end: key:" << key << " inode: " << ino;
 }
 
+void WarmupManagerS3Impl::AddWarmupInodes(fuse_ino_t key,
+                                          std::set<fuse_ino_t> files) {
+  std::set<uint64_t> inode_ids(files.begin(), files.end());
+  std::list<pb::metaserver::InodeAttr> attrs;
+  DINGOFS_ERROR ret = inodeManager_->BatchGetInodeAttr(&inode_ids, &attrs);
+  if (ret == DINGOFS_ERROR::OK) {
+    for (const auto& attr : attrs) {
+      if (attr.length() == 0) {  // nothing to fetch
+        files.erase(attr.inodeid());
+      }
+    }
+  } else {  // warmup them anyway, the inode is fetched later
+    LOG(WARNING) << "inodeManager batch get inode attr fail, ret = " << ret
+                 << ", key = " << key << ", files = " << files.size();
+  }
+
+  if (files.empty()) {
+    return;
+  }
+
+  WriteLockGuard lock(warmupInodesDequeMutex_);
+  auto iter_deque = FindWarmupInodesByKeyLocked(key);
+  if (iter_deque == warmupInodesDeque_.end()) {
+    warmupInodesDeque_.emplace_back(key, std::move(files));
+  } else {
+    for (auto file : files) {
+      iter_deque->AddFileInode(file);
+    }
+  }
+}
+
 void WarmupManagerS3Impl::FetchDataEnqueue(fuse_ino_t key, fuse_ino_t ino) {
   VLOG(9) << "FetchDataEnqueue start: key:" << key << " inode: " << ino;
   auto task = [key, ino, this]() {
@@ -519,12 +556,15 @@ void WarmupManagerS3Impl::WarmUpAllObjs(
                           context->len, start);
         if (bgFetchStop_.load(std::memory_order_acquire)) {
           VLOG(9) << "need stop warmup";
+          fetcher_->Release(context->key, context->len);
+          delete[] context->buf;
           cond.Signal();
           return;
         }
         if (context->retCode == 0) {
           VLOG(9) << "Get Object success: " << context->key;
           PutObjectToCache(ino, context);
+          fetcher_->Release(context->key, context->len);
           CollectMetrics(&warmupS3Metric_.warmupS3Cached, context->len, start);
           warmupS3Metric_.warmupS3CacheSize << context->len;
           if (pending_req.fetch_sub(1, std::memory_order_seq_cst) == 1) {
@@ -535,6 +575,7 @@ void WarmupManagerS3Impl::WarmUpAllObjs(
         }
         warmupS3Metric_.warmupS3Cached.eps.count << 1;
         if (++context->retry >= option_.downloadMaxRetryTimes) {
+          fetcher_->Release(context->key, context->len);
           if (pending_req.fetch_sub(1, std::memory_order_seq_cst) == 1) {
             VLOG(6) << "pendingReq is over";
             cond.Signal();
@@ -558,21 +599,26 @@ void WarmupManagerS3Impl::WarmUpAllObjs(
       std::string name = bkey.StoreKey();
       uint64_t read_len = iter.second;
       VLOG(9) << "download start: " << name;
+      bool cached = false;
       {
         ReadLockGuard lock(inode2ProgressMutex_);
         auto iter_progress = FindWarmupProgressByKeyLocked(ino);
-        if (iter_progress->second.GetStorageType() ==
-                dingofs::client::common::WarmupStorageType::
-                    kWarmupStorageTypeDisk &&
-            s3Adaptor_->GetBlockCache()->IsCached(bkey)) {
-          // storage in disk and has cached
-          pending_req.fetch_sub(1);
-          continue;
-        }
+        cached = iter_progress != inode2Progress_.end() &&
+                 iter_progress->second.GetStorageType() ==
+                     dingofs::client::common::WarmupStorageType::
+                         kWarmupStorageTypeDisk &&
+                 s3Adaptor_->GetBlockCache()->IsCached(bkey);
+      }
+
+      // storage in disk and has cached, or it's fetching by another task,
+      // otherwise wait until the window has room
+      if (cached || !fetcher_->Acquire(name, read_len)) {
+        SkipObject(ino);
+        pending_req.fetch_sub(1);
+        continue;
       }
 
       char* cache_s3 = new char[read_len];
-      memset(cache_s3, 0, read_len);
       auto context = std::make_shared<GetObjectAsyncContext>();
       context->key = name;
       context->buf = cache_s3;
@@ -646,10 +692,11 @@ void WarmupManagerS3Impl::ScanCleanFetchS3ObjectsPool() {
 
 void WarmupManagerS3Impl::ScanCleanWarmupProgress() {
   // clean done warmupProgress
-  ReadLockGuard lock(inode2ProgressMutex_);
+  WriteLockGuard lock(inode2ProgressMutex_);
   for (auto iter = inode2Progress_.begin(); iter != inode2Progress_.end();) {
     if (ProgressDone(iter->first)) {
-      VLOG(9) << "warmup key: " << iter->first << " done!";
+      LOG(INFO) << "warmup key: " << iter->first
+                << " done: " << iter->second.ToString();
       iter = inode2Progress_.erase(iter);
     } else {
       ++iter;
@@ -660,7 +707,7 @@ void WarmupManagerS3Impl::ScanCleanWarmupProgress() {
 void WarmupManagerS3Impl::ScanWarmupInodes() {
   // file need warmup
   WriteLockGuard lock(warmupInodesDequeMutex_);
-  if (!warmupInodesDeque_.empty()) {
+  while (!warmupInodesDeque_.empty()) {
     WarmupInodes inodes = warmupInodesDeque_.front();
     for (auto const& iter : inodes.GetReadAheadFiles()) {
       VLOG(9) << "BackGroundFetch: key: " << inodes.GetKey()
@@ -674,7 +721,7 @@ void WarmupManagerS3Impl::ScanWarmupInodes() {
 void WarmupManagerS3Impl::ScanWarmupFilelist() {
   // Use a write lock to ensure that all parsing tasks are added.
   WriteLockGuard lock(warmupFilelistDequeMutex_);
-  if (!warmupFilelistDeque_.empty()) {
+  while (!warmupFilelistDeque_.empty()) {
     WarmupFilelist warmup_filelist = warmupFilelistDeque_.front();
     VLOG(9) << "warmup ino: " << warmup_filelist.GetKey()
             << " len is: " << warmup_filelist.GetFileLen();
@@ -736,6 +783,7 @@ void WarmupManagerS3Impl::PutObjectToCache(
   }
   // update progress
   iter->second.FinishedPlusOne();
+  iter->second.AddFinishedBytes(context->len);
   switch (iter->second.GetStorageType()) {
     case dingofs::client::common::WarmupStorageType::kWarmupStorageTypeDisk: {
       BlockKey key;
@@ -768,6 +816,14 @@ void WarmupManagerS3Impl::PutObjectToCache(
   }
 }
 
+void WarmupManagerS3Impl::SkipObject(fuse_ino_t key) {
+  ReadLockGuard lock(inode2ProgressMutex_);
+  auto iter = FindWarmupProgressByKeyLocked(key);
+  if (iter != inode2Progress_.end()) {
+    iter->second.FinishedPlusOne();
+  }
+}
+
 void WarmupManager::CollectMetrics(stub::metric::InterfaceMetric* interface,
                                    int count, uint64_t start) {
   interface->bps.count << count;
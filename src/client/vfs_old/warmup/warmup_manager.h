@@ -23,6 +23,8 @@
 #ifndef DINGOFS_SRC_CLIENT_WARMUP_WARMUP_MANAGER_H_
 #define DINGOFS_SRC_CLIENT_WARMUP_WARMUP_MANAGER_H_
 
+#include <butil/time.h>
+
 #include <algorithm>
 #include <atomic>
 #include <cstdint>
@@ -44,6 +46,7 @@
 #include "client/vfs/vfs.h"
 #include "client/vfs_old/kvclient/kvclient_manager.h"
 #include "client/vfs_old/s3/client_s3_adaptor.h"
+#include "client/vfs_old/warmup/warmup_fetcher.h"
 #include "common/task_thread_pool.h"
 #include "stub/metric/metric.h"
 #include "stub/rpcclient/metaserver_client.h"
@@ -91,75 +94,91 @@ class WarmupInodes {
   std::set<fuse_ino_t> readAheadFiles_;
 };
 
+// The counters are bumped by the fetch callbacks of many threads, so they
+// are all atomics, and the reader may see a slightly stale snapshot.
 class WarmupProgress {
  public:
   explicit WarmupProgress(
       common::WarmupStorageType type =
           common::WarmupStorageType::kWarmupStorageTypeUnknown)
-      : total_(0), finished_(0), error_(0), storageType_(type) {}
+      : total_(0),
+        finished_(0),
+        error_(0),
+        finishedBytes_(0),
+        startUs_(butil::monotonic_time_us()),
+        storageType_(type) {}
 
   WarmupProgress(const WarmupProgress& wp)
-      : total_(wp.total_),
-        finished_(wp.finished_),
-        error_(wp.error_),
+      : total_(wp.total_.load(std::memory_order_relaxed)),
+        finished_(wp.finished_.load(std::memory_order_relaxed)),
+        error_(wp.error_.load(std::memory_order_relaxed)),
+        finishedBytes_(wp.finishedBytes_.load(std::memory_order_relaxed)),
+        startUs_(wp.startUs_),
         storageType_(wp.storageType_) {}
 
-  void AddTotal(uint64_t add) {
-    std::lock_guard<std::mutex> lock(totalMutex_);
-    total_ += add;
-  }
-
   WarmupProgress& operator=(const WarmupProgress& wp) {
-    total_ = wp.total_;
-    finished_ = wp.finished_;
-    error_ = wp.error_;
+    total_.store(wp.total_.load(std::memory_order_relaxed),
+                 std::memory_order_relaxed);
+    finished_.store(wp.finished_.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+    error_.store(wp.error_.load(std::memory_order_relaxed),
+                 std::memory_order_relaxed);
+    finishedBytes_.store(wp.finishedBytes_.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+    startUs_ = wp.startUs_;
     return *this;
   }
 
-  void FinishedPlusOne() {
-    std::lock_guard<std::mutex> lock(finishedMutex_);
-    ++finished_;
+  void AddTotal(uint64_t add) {
+    total_.fetch_add(add, std::memory_order_relaxed);
   }
 
-  uint64_t GetTotal() {
-    std::lock_guard<std::mutex> lock(totalMutex_);
-    return total_;
+  void FinishedPlusOne() { finished_.fetch_add(1, std::memory_order_relaxed); }
+
+  void AddFinishedBytes(uint64_t bytes) {
+    finishedBytes_.fetch_add(bytes, std::memory_order_relaxed);
   }
 
-  uint64_t GetFinished() {
-    std::lock_guard<std::mutex> lock(finishedMutex_);
-    return finished_;
+  uint64_t GetTotal() const { return total_.load(std::memory_order_relaxed); }
+
+  uint64_t GetFinished() const {
+    return finished_.load(std::memory_order_relaxed);
   }
 
-  void ErrorsPlusOne() {
-    std::lock_guard<std::mutex> lock(errorMutex_);
-    ++error_;
+  void ErrorsPlusOne() { error_.fetch_add(1, std::memory_order_relaxed); }
+
+  uint64_t GetErrors() const { return error_.load(std::memory_order_relaxed); }
+
+  uint64_t GetFinishedBytes() const {
+    return finishedBytes_.load(std::memory_order_relaxed);
   }
 
-  uint64_t GetErrors() {
-    std::lock_guard<std::mutex> lock(errorMutex_);
-    return error_;
+  // Bytes per second since the task is added
+  uint64_t GetThroughput() const {
+    int64_t elapsed_us = butil::monotonic_time_us() - startUs_;
+    if (elapsed_us <= 0) {
+      return 0;
+    }
+    return GetFinishedBytes() * 1000000 / elapsed_us;
   }
 
-  std::string ToString() {
-    std::lock_guard<std::mutex> lockT(totalMutex_);
-    std::lock_guard<std::mutex> lockF(finishedMutex_);
-    std::lock_guard<std::mutex> lockE(errorMutex_);
-    return "total:" + std::to_string(total_) +
-           ",finished:" + std::to_string(finished_) +
-           ",error:" + std::to_string(error_);
+  std::string ToString() const {
+    return "total:" + std::to_string(GetTotal()) +
+           ",finished:" + std::to_string(GetFinished()) +
+           ",error:" + std::to_string(GetErrors()) +
+           ",bytes:" + std::to_string(GetFinishedBytes()) +
+           ",throughput:" + std::to_string(GetThroughput());
   }
 
   common::WarmupStorageType GetStorageType() { return storageType_; }
 
  private:
-  uint64_t total_;
-  std::mutex totalMutex_;
-  uint64_t finished_;
-  std::mutex finishedMutex_;
+  std::atomic<uint64_t> total_;
+  std::atomic<uint64_t> finished_;
+  std::atomic<uint64_t> error_;
+  std::atomic<uint64_t> finishedBytes_;
+  int64_t startUs_;
   common::WarmupStorageType storageType_;
-  uint64_t error_;  // TODO may be better to use atomic types
-  std::mutex errorMutex_;
 };
 
 class WarmupManager {
@@ -319,6 +338,10 @@ class WarmupManagerS3Impl : public WarmupManager {
 
   void FetchChildDentry(fuse_ino_t key, fuse_ino_t ino);
 
+  // Add the files to warmup inodes, the empty files are skipped by
+  // the attributes fetched in batch
+  void AddWarmupInodes(fuse_ino_t key, std::set<fuse_ino_t> files);
+
   /**
    * @brief
    * Please use it with the lock warmupInodesDequeMutex_
@@ -417,6 +440,9 @@ class WarmupManagerS3Impl : public WarmupManager {
       fuse_ino_t ino,
       const std::shared_ptr<aws::GetObjectAsyncContext>& context);
 
+  // The object is skipped as it's cached or fetched by another task
+  void SkipObject(fuse_ino_t key);
+
  protected:
   std::deque<WarmupFilelist> warmupFilelistDeque_;
   mutable utils::RWLock warmupFilelistDequeMutex_;
@@ -441,6 +467,9 @@ class WarmupManagerS3Impl : public WarmupManager {
       inode2FetchS3ObjectsPool_;
   mutable utils::RWLock inode2FetchS3ObjectsPoolMutex_;
 
+  // the window and bandwidth of s3 gets shared by all warmup tasks
+  std::unique_ptr<WarmupFetcher> fetcher_;
+
   dingofs::stub::metric::WarmupManagerS3Metric warmupS3Metric_;
 };
 
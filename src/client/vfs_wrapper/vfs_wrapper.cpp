@@ -402,6 +402,31 @@ Status VFSWrapper::Read(Ino ino, char* buf, uint64_t size, uint64_t offset,
   return s;
 }
 
+Status VFSWrapper::ReadSplice(Ino ino, uint64_t size, uint64_t offset,
+                              uint64_t fh, SpliceBuffer* buffer) {
+  VLOG(1) << "VFSReadSplice inodeId=" << ino << " size: " << size
+          << " offset: " << offset << " fh: " << fh;
+  Status s;
+  AccessLogGuard log([&]() {
+    return absl::StrFormat("read_splice (%d,%d,%d): %s", ino, size, offset,
+                           s.ToString());
+  });
+
+  ClientOpMetricGuard op_metric(
+      {&client_op_metric_->opRead, &client_op_metric_->opAll});
+
+  s = vfs_->ReadSplice(ino, size, offset, fh, buffer);
+  VLOG(1) << "VFSReadSplice end inodeId=" << ino << " size: " << size
+          << " offset: " << offset << " status: " << s.ToString();
+  if (s.IsNotSupport()) {  // the read falls back to Read()
+    log.enable = false;
+    op_metric.CancelOp();
+  } else if (!s.ok()) {
+    op_metric.FailOp();
+  }
+  return s;
+}
+
 Status VFSWrapper::Write(Ino ino, const char* buf, uint64_t size,
                          uint64_t offset, uint64_t fh, uint64_t* out_wsize) {
   VLOG(1) << "VFSWrite inodeId=" << ino << " size: " << size
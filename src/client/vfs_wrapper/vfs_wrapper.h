@@ -85,6 +85,9 @@ class VFSWrapper {
   Status Read(Ino ino, char* buf, uint64_t size, uint64_t offset, uint64_t fh,
               uint64_t* out_rsize);
 
+  Status ReadSplice(Ino ino, uint64_t size, uint64_t offset, uint64_t fh,
+                    SpliceBuffer* buffer);
+
   Status Write(Ino ino, const char* buf, uint64_t size, uint64_t offset,
                uint64_t fh, uint64_t* out_wsize);
 
@@ -149,6 +152,14 @@ struct ClientOpMetricGuard {
 
   void FailOp() { op_ok = false; }
 
+  // The op is not done here, e.g. it falls back to another op
+  void CancelOp() {
+    for (auto& metric : metric_list) {
+      metric->inflightOpNum << -1;
+    }
+    metric_list.clear();
+  }
+
   bool op_ok{true};
   std::list<dingofs::stub::metric::OpMetric*> metric_list;
   uint64_t start;
@@ -27,11 +27,17 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/hash/hash.h"
 #include "utils/concurrent/concurrent.h"
 #include "utils/timeutility.h"
 
@@ -807,6 +813,324 @@ void SglLRUCache<K, KeyTraits>::RemoveElement(
   size_--;
 }
 
+// ShardedLRUCache
+//
+// The keys are spread over shards by hash, each shard is an independent LRU
+// list guarded by its own mutex, so accesses to different keys rarely
+// contend. The capacity is split evenly among shards and the eviction is
+// done per shard, so the order is only approximately LRU for the whole cache.
+//
+// If |Hash| and |KeyEqual| are transparent (define is_transparent), Get and
+// Remove accept any key-like type they accept, e.g. a view of the key which
+// can be built without allocation.
+template <typename K, typename V, typename Hash = absl::Hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+class ShardedLRUCache {
+ public:
+  // Invoked with the shard lock held for every item which is evicted,
+  // replaced by Put or dropped by Clear, must not access the cache.
+  using EvictFunc = std::function<void(const K& key, const V& value)>;
+
+  static constexpr size_t kDefaultShards = 32;
+
+  // Each shard holds at least this many items (or charges)
+  static constexpr uint64_t kMinShardCapacity = 64;
+
+  /*
+   * @param[in] capacity The total charges of cache, 0 indicates unlimited
+   * @param[in] metricPrefix Expose metrics with this prefix if not empty
+   * @param[in] numShards The maximum number of shards
+   * @param[in] onEvict Callback for evicted items
+   */
+  explicit ShardedLRUCache(uint64_t capacity,
+                           const std::string& metricPrefix = "",
+                           size_t numShards = kDefaultShards,
+                           EvictFunc onEvict = nullptr);
+
+  /*
+   * @brief Store key-value which takes |charge| of capacity
+   */
+  void Put(const K& key, const V& value, uint64_t charge = 1);
+
+  /*
+   * @brief Get corresponding value of the key and move it to front
+   *
+   * @return false if not found, true if succeeded
+   */
+  template <typename Key>
+  bool Get(const Key& key, V* value);
+
+  /*
+   * @brief Modify value of the key in place by |f| (with shard lock held),
+   *        a default constructed value is inserted if the key not found.
+   *
+   * @param[in] f void(V* value, bool found)
+   */
+  template <typename Func>
+  void Update(const K& key, Func f);
+
+  /*
+   * @brief Remove key-value from cache, the removed value is stored in
+   *        |value| if it's not nullptr.
+   *
+   * @return false if not found, true if removed
+   */
+  template <typename Key>
+  bool Remove(const Key& key, V* value = nullptr);
+
+  /*
+   * @brief Remove all items, |onEvict| is invoked for each of them
+   */
+  void Clear();
+
+  uint64_t Size();
+
+  uint64_t Charge();
+
+  size_t NumShards() const { return shards_.size(); }
+
+ private:
+  struct Item {
+    K key;
+    V value;
+    uint64_t charge;
+  };
+
+  using ListType = std::list<Item>;
+
+  struct Shard {
+    std::mutex mutex;
+    uint64_t capacity;
+    uint64_t charge{0};
+    ListType ll;
+    absl::flat_hash_map<K, typename ListType::iterator, Hash, KeyEqual> map;
+  };
+
+  struct Metrics {
+    explicit Metrics(const std::string& prefix)
+        : cache(prefix), lockContention(prefix, "lock_contention") {}
+
+    CacheMetrics cache;
+    bvar::Adder<uint64_t> lockContention;
+  };
+
+  template <typename Key>
+  Shard* GetShard(const Key& key);
+
+  std::unique_lock<std::mutex> Lock(Shard* shard);
+
+  void InsertLocked(Shard* shard, const K& key, const V& value,
+                    uint64_t charge);
+
+  void EraseLocked(Shard* shard, typename ListType::iterator iter);
+
+  void EvictLocked(Shard* shard);
+
+  void OnHit(bool hit);
+
+ private:
+  Hash hash_;
+  EvictFunc onEvict_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::unique_ptr<Metrics> metrics_;
+};
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+ShardedLRUCache<K, V, Hash, KeyEqual>::ShardedLRUCache(
+    uint64_t capacity, const std::string& metricPrefix, size_t numShards,
+    EvictFunc onEvict)
+    : onEvict_(std::move(onEvict)) {
+  if (capacity > 0) {  // small cache keeps (almost) exact LRU order
+    numShards = std::min<uint64_t>(
+        numShards, std::max<uint64_t>(1, capacity / kMinShardCapacity));
+  }
+  numShards = std::max<size_t>(numShards, 1);
+
+  for (size_t i = 0; i < numShards; i++) {
+    auto shard = std::make_unique<Shard>();
+    shard->capacity = (capacity + numShards - 1) / numShards;
+    shards_.emplace_back(std::move(shard));
+  }
+
+  if (!metricPrefix.empty()) {
+    metrics_ = std::make_unique<Metrics>(metricPrefix);
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Key>
+typename ShardedLRUCache<K, V, Hash, KeyEqual>::Shard*
+ShardedLRUCache<K, V, Hash, KeyEqual>::GetShard(const Key& key) {
+  // mix the hash, the user provided one may be identity (e.g. std::hash)
+  uint64_t h = static_cast<uint64_t>(hash_(key));
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  return shards_[h % shards_.size()].get();
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+std::unique_lock<std::mutex> ShardedLRUCache<K, V, Hash, KeyEqual>::Lock(
+    Shard* shard) {
+  std::unique_lock<std::mutex> lk(shard->mutex, std::try_to_lock);
+  if (!lk.owns_lock()) {
+    if (metrics_ != nullptr) {
+      metrics_->lockContention << 1;
+    }
+    lk.lock();
+  }
+  return lk;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void ShardedLRUCache<K, V, Hash, KeyEqual>::OnHit(bool hit) {
+  if (metrics_ == nullptr) {
+    return;
+  } else if (hit) {
+    metrics_->cache.OnCacheHit();
+  } else {
+    metrics_->cache.OnCacheMiss();
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void ShardedLRUCache<K, V, Hash, KeyEqual>::InsertLocked(Shard* shard,
+                                                         const K& key,
+                                                         const V& value,
+                                                         uint64_t charge) {
+  shard->ll.push_front(Item{key, value, charge});
+  shard->map[key] = shard->ll.begin();
+  shard->charge += charge;
+  if (metrics_ != nullptr) {
+    metrics_->cache.UpdateAddToCacheCount();
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void ShardedLRUCache<K, V, Hash, KeyEqual>::EraseLocked(
+    Shard* shard, typename ListType::iterator iter) {
+  shard->charge -= iter->charge;
+  shard->map.erase(iter->key);
+  shard->ll.erase(iter);
+  if (metrics_ != nullptr) {
+    metrics_->cache.UpdateRemoveFromCacheCount();
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void ShardedLRUCache<K, V, Hash, KeyEqual>::EvictLocked(Shard* shard) {
+  // the newest item is kept even if it exceeds the capacity of shard
+  while (shard->capacity != 0 && shard->charge > shard->capacity &&
+         shard->ll.size() > 1) {
+    auto iter = std::prev(shard->ll.end());
+    if (onEvict_) {
+      onEvict_(iter->key, iter->value);
+    }
+    EraseLocked(shard, iter);
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void ShardedLRUCache<K, V, Hash, KeyEqual>::Put(const K& key, const V& value,
+                                                uint64_t charge) {
+  auto* shard = GetShard(key);
+  auto lk = Lock(shard);
+  auto iter = shard->map.find(key);
+  if (iter != shard->map.end()) {
+    if (onEvict_) {
+      onEvict_(iter->second->key, iter->second->value);
+    }
+    EraseLocked(shard, iter->second);
+  }
+  InsertLocked(shard, key, value, charge);
+  EvictLocked(shard);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Key>
+bool ShardedLRUCache<K, V, Hash, KeyEqual>::Get(const Key& key, V* value) {
+  auto* shard = GetShard(key);
+  auto lk = Lock(shard);
+  auto iter = shard->map.find(key);
+  if (iter == shard->map.end()) {
+    OnHit(false);
+    return false;
+  }
+
+  shard->ll.splice(shard->ll.begin(), shard->ll, iter->second);
+  *value = iter->second->value;
+  OnHit(true);
+  return true;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Func>
+void ShardedLRUCache<K, V, Hash, KeyEqual>::Update(const K& key, Func f) {
+  auto* shard = GetShard(key);
+  auto lk = Lock(shard);
+  auto iter = shard->map.find(key);
+  if (iter != shard->map.end()) {
+    shard->ll.splice(shard->ll.begin(), shard->ll, iter->second);
+    f(&iter->second->value, true);
+    return;
+  }
+
+  InsertLocked(shard, key, V(), 1);
+  f(&shard->ll.begin()->value, false);
+  EvictLocked(shard);
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+template <typename Key>
+bool ShardedLRUCache<K, V, Hash, KeyEqual>::Remove(const Key& key, V* value) {
+  auto* shard = GetShard(key);
+  auto lk = Lock(shard);
+  auto iter = shard->map.find(key);
+  if (iter == shard->map.end()) {
+    return false;
+  }
+
+  if (value != nullptr) {
+    *value = std::move(iter->second->value);
+  }
+  EraseLocked(shard, iter->second);
+  return true;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+void ShardedLRUCache<K, V, Hash, KeyEqual>::Clear() {
+  for (auto& shard : shards_) {
+    auto lk = Lock(shard.get());
+    while (!shard->ll.empty()) {
+      auto iter = std::prev(shard->ll.end());
+      if (onEvict_) {
+        onEvict_(iter->key, iter->value);
+      }
+      EraseLocked(shard.get(), iter);
+    }
+  }
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+uint64_t ShardedLRUCache<K, V, Hash, KeyEqual>::Size() {
+  uint64_t size = 0;
+  for (auto& shard : shards_) {
+    auto lk = Lock(shard.get());
+    size += shard->ll.size();
+  }
+  return size;
+}
+
+template <typename K, typename V, typename Hash, typename KeyEqual>
+uint64_t ShardedLRUCache<K, V, Hash, KeyEqual>::Charge() {
+  uint64_t charge = 0;
+  for (auto& shard : shards_) {
+    auto lk = Lock(shard.get());
+    charge += shard->charge;
+  }
+  return charge;
+}
+
 }  // namespace utils
 }  // namespace dingofs
 
@@ -46,6 +46,7 @@ namespace blockcache {
 USING_FLAG(block_cache_logging);
 USING_FLAG(disk_cache_expire_second);
 USING_FLAG(disk_cache_free_space_ratio);
+USING_FLAG(disk_cache_persist_index);
 
 using ::dingofs::base::string::GenUuid;
 using ::dingofs::base::string::StrJoin;
@@ -80,6 +81,7 @@ class DiskCacheBuilder {
     FLAGS_block_cache_logging = false;
     FLAGS_disk_cache_free_space_ratio = 0.1;
     FLAGS_disk_cache_expire_second = 0;
+    FLAGS_disk_cache_persist_index = false;
     return DiskCacheOption{
         .index = 0,
         .cache_dir = "." + GenUuid(),
@@ -119,6 +121,8 @@ class BlockCacheBuilder {
         .stage = true,
         .upload_stage_workers = 2,
         .upload_stage_queue_size = 10,
+        .cache_fill_workers = 1,
+        .cache_fill_queue_size = 10,
         .disk_cache_options =
             std::vector<DiskCacheOption>{DiskCacheBuilder::DefaultOption()},
     };
@@ -139,6 +143,7 @@ class BlockCacheBuilder {
     auto block_cache = std::make_shared<BlockCacheImpl>(option_);
     s3_client_ = std::make_shared<MockS3Client>();
     block_cache->s3_ = s3_client_;
+    filler_ = block_cache->filler_;
 
     return block_cache;
   }
@@ -147,6 +152,8 @@ class BlockCacheBuilder {
 
   std::shared_ptr<MockS3Client> GetS3Client() { return s3_client_; }
 
+  std::shared_ptr<BlockCacheFiller> GetFiller() { return filler_; }
+
   std::string GetRootDir() const {
     return option_.disk_cache_options[0].cache_dir;
   }
@@ -154,6 +161,7 @@ class BlockCacheBuilder {
  private:
   BlockCacheOption option_;
   std::shared_ptr<MockS3Client> s3_client_;
+  std::shared_ptr<BlockCacheFiller> filler_;
 };
 
 }  // namespace blockcache
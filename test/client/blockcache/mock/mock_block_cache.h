@@ -37,7 +37,12 @@ using ::dingofs::client::blockcache::BCACHE_ERROR;
 
 class MockBlockCache : public BlockCache {
  public:
-  MockBlockCache() = default;
+  MockBlockCache() {
+    // no cache group by default
+    ON_CALL(*this, RangePeer(::testing::_, ::testing::_, ::testing::_,
+                             ::testing::_))
+        .WillByDefault(::testing::Return(BCACHE_ERROR::NOT_FOUND));
+  }
 
   ~MockBlockCache() override = default;
 
@@ -51,8 +56,14 @@ class MockBlockCache : public BlockCache {
   MOCK_METHOD5(Range, BCACHE_ERROR(const BlockKey& key, off_t offset,
                                    size_t size, char* buffer, bool retrive));
 
+  MOCK_METHOD2(Load, BCACHE_ERROR(const BlockKey& key,
+                                  std::shared_ptr<BlockReader>& reader));
+
   MOCK_METHOD2(Cache, BCACHE_ERROR(const BlockKey& key, const Block& block));
 
+  MOCK_METHOD4(RangePeer, BCACHE_ERROR(const BlockKey& key, off_t offset,
+                                       size_t length, char* buffer));
+
   MOCK_METHOD1(Flush, BCACHE_ERROR(uint64_t ino));
 
   MOCK_METHOD1(IsCached, bool(const BlockKey& key));
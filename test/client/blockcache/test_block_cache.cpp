@@ -71,6 +71,37 @@ TEST_F(BlockCacheTest, Put) {
   ASSERT_TRUE(fs->FileExists(cache_path));
 }
 
+TEST_F(BlockCacheTest, PutWithoutStage) {
+  auto builder = BlockCacheBuilder().SetOption(
+      [](BlockCacheOption* option) { option->stage = false; });
+  auto block_cache = builder.Build();
+  ASSERT_EQ(block_cache->Init(), BCACHE_ERROR::OK);
+  auto defer = MakeCleanup([&]() {
+    block_cache->Shutdown();
+    builder.Cleanup();
+  });
+
+  // CASE 1: block put to s3 directly will be filled into cache
+  auto key = BlockKeyBuilder().Build(100);
+  auto block = BlockBuilder().Build("hello world");
+  auto ctx = BlockContext(BlockFrom::CTO_FLUSH);
+  EXPECT_CALL(*builder.GetS3Client(), Put(_, _, _))
+      .WillOnce(Return(BCACHE_ERROR::OK));
+  ASSERT_EQ(block_cache->Put(key, block, ctx), BCACHE_ERROR::OK);
+
+  builder.GetFiller()->WaitAllFilled();
+  ASSERT_TRUE(block_cache->IsCached(key));
+
+  // CASE 2: block which put failed won't be cached
+  key = BlockKeyBuilder().Build(200);
+  EXPECT_CALL(*builder.GetS3Client(), Put(_, _, _))
+      .WillOnce(Return(BCACHE_ERROR::IO_ERROR));
+  ASSERT_EQ(block_cache->Put(key, block, ctx), BCACHE_ERROR::IO_ERROR);
+
+  builder.GetFiller()->WaitAllFilled();
+  ASSERT_FALSE(block_cache->IsCached(key));
+}
+
 TEST_F(BlockCacheTest, Range) {
   auto builder = BlockCacheBuilder();
   auto block_cache = builder.Build();
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <thread>
+
+#include "base/math/math.h"
+#include "client/blockcache/block_cache_uploader_cmmon.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::dingofs::base::math::kMiB;
+
+class BlockCacheUploaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(BlockCacheUploaderTest, BufferPool) {
+  auto pool = std::make_shared<UploadBufferPool>(kMiB, 2, 2);
+  ASSERT_EQ(pool->NumFree(), 2);
+
+  // CASE 1: allocate from pool
+  auto buffer1 = pool->Allocate(kMiB);
+  auto buffer2 = pool->Allocate(100);
+  ASSERT_EQ(pool->NumFree(), 0);
+
+  // CASE 2: fallback to heap if pool exhausted or block too large
+  auto buffer3 = pool->Allocate(100);
+  auto buffer4 = pool->Allocate(2 * kMiB);
+  ASSERT_TRUE(buffer3 != nullptr);
+  ASSERT_TRUE(buffer4 != nullptr);
+  ASSERT_EQ(pool->NumFree(), 0);
+
+  // CASE 3: buffer is given back when released
+  char* addr = buffer1.get();
+  buffer1.reset();
+  buffer3.reset();
+  ASSERT_EQ(pool->NumFree(), 1);
+  ASSERT_EQ(pool->Allocate(kMiB).get(), addr);
+}
+
+TEST_F(BlockCacheUploaderTest, BufferPoolShrink) {
+  auto pool = std::make_shared<UploadBufferPool>(kMiB, 3, 1);
+  ASSERT_EQ(pool->NumFree(), 3);
+
+  auto buffer1 = pool->Allocate(kMiB);
+  auto buffer2 = pool->Allocate(kMiB);
+  auto buffer3 = pool->Allocate(kMiB);
+  ASSERT_EQ(pool->NumFree(), 0);
+
+  // only one idle buffer is kept, the others are freed
+  buffer1.reset();
+  buffer2.reset();
+  buffer3.reset();
+  ASSERT_EQ(pool->NumFree(), 3);
+
+  // freed buffers can be allocated again
+  buffer1 = pool->Allocate(kMiB);
+  buffer2 = pool->Allocate(kMiB);
+  buffer3 = pool->Allocate(kMiB);
+  ASSERT_EQ(pool->NumFree(), 0);
+}
+
+TEST_F(BlockCacheUploaderTest, LimiterBackoff) {
+  UploadLimiter limiter(1, 8);
+  ASSERT_EQ(limiter.Limit(), 8);
+
+  // CASE 1: stable latency keeps the limit
+  for (int i = 0; i < 8; i++) {
+    ASSERT_TRUE(limiter.Acquire());
+  }
+  ASSERT_EQ(limiter.Inflight(), 8);
+  limiter.OnSample(1000, kMiB, true);
+  limiter.Release();
+  ASSERT_EQ(limiter.Limit(), 8);
+
+  // CASE 2: latency goes up
+  limiter.OnSample(10000, kMiB, true);
+  limiter.Release();
+  ASSERT_EQ(limiter.Limit(), 7);
+
+  // CASE 3: put failed
+  for (int i = 0; i < 100; i++) {
+    limiter.OnSample(1000, kMiB, false);
+  }
+  ASSERT_EQ(limiter.Limit(), 1);
+
+  // CASE 4: increase again
+  for (int i = 0; i < 6; i++) {
+    limiter.Release();
+  }
+  ASSERT_EQ(limiter.Inflight(), 0);
+  for (int i = 0; i < 100; i++) {
+    ASSERT_TRUE(limiter.Acquire());
+    limiter.OnSample(1000, kMiB, true);
+    limiter.Release();
+  }
+  ASSERT_GT(limiter.Limit(), 1);
+}
+
+TEST_F(BlockCacheUploaderTest, LimiterStop) {
+  UploadLimiter limiter(1, 1);
+  ASSERT_TRUE(limiter.Acquire());
+
+  std::thread thread([&]() { ASSERT_FALSE(limiter.Acquire()); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  limiter.Stop();
+  thread.join();
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <string>
+
+#include "client/blockcache/block_checksum.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+class BlockChecksumTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(BlockChecksumTest, EncodeDecode) {
+  constexpr size_t kSize = BlockChecksum::kSubBlockSize;
+  std::string data(kSize * 2 + 100, 'x');
+  auto checksum = BlockChecksum::Compute(data.data(), data.size());
+  ASSERT_FALSE(checksum.Empty());
+  ASSERT_EQ(checksum.Length(), data.size());
+
+  BlockChecksum decoded;
+  ASSERT_TRUE(decoded.Decode(checksum.Encode()));
+  ASSERT_EQ(decoded.Length(), data.size());
+  ASSERT_TRUE(decoded.Verify(0, data.data(), data.size()));
+
+  ASSERT_FALSE(decoded.Decode(""));
+  ASSERT_FALSE(decoded.Decode(checksum.Encode().substr(0, 20)));
+}
+
+TEST_F(BlockChecksumTest, AlignRange) {
+  constexpr size_t kSize = BlockChecksum::kSubBlockSize;
+  std::string data(kSize * 2 + 100, 'x');
+  auto checksum = BlockChecksum::Compute(data.data(), data.size());
+
+  off_t offset;
+  size_t length;
+  checksum.AlignRange(0, kSize, &offset, &length);
+  ASSERT_EQ(offset, 0);
+  ASSERT_EQ(length, kSize);
+
+  checksum.AlignRange(kSize - 1, 2, &offset, &length);
+  ASSERT_EQ(offset, 0);
+  ASSERT_EQ(length, kSize * 2);
+
+  checksum.AlignRange(kSize * 2 + 1, 10, &offset, &length);
+  ASSERT_EQ(offset, kSize * 2);
+  ASSERT_EQ(length, 100);
+}
+
+TEST_F(BlockChecksumTest, Verify) {
+  constexpr size_t kSize = BlockChecksum::kSubBlockSize;
+  std::string data(kSize * 2 + 100, 'x');
+  auto checksum = BlockChecksum::Compute(data.data(), data.size());
+
+  data[kSize + 1] = 'y';  // corrupt the second sub-block
+  ASSERT_TRUE(checksum.Verify(0, data.data(), kSize));
+  ASSERT_FALSE(checksum.Verify(kSize, data.data() + kSize, kSize));
+  ASSERT_TRUE(checksum.Verify(kSize * 2, data.data() + kSize * 2, 100));
+  ASSERT_FALSE(checksum.Verify(1, data.data() + 1, kSize));  // unaligned
+
+  // IOBuf
+  butil::IOBuf buffer;
+  buffer.append(data.data() + kSize * 2, 100);
+  ASSERT_TRUE(checksum.Verify(kSize * 2, buffer));
+  buffer.clear();
+  buffer.append(data.data(), 100);
+  buffer.append(data.data() + 100, kSize - 100);
+  ASSERT_TRUE(checksum.Verify(0, buffer));
+  buffer.clear();
+  buffer.append(data.data() + kSize, kSize);
+  ASSERT_FALSE(checksum.Verify(kSize, buffer));
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
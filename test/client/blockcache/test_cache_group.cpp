@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "client/blockcache/cache_group.h"
+#include "client/blockcache/mem_cache.h"
+#include "client/blockcache/mock/mock_s3_client.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::testing::Invoke;
+
+class CacheGroupTest : public ::testing::Test {
+ protected:
+  static constexpr uint64_t kBlockSize = 4096;
+
+  void SetUp() override {
+    s3_ = std::make_shared<MockS3Client>();
+    EXPECT_CALL(*s3_, AsyncGet(_))
+        .WillRepeatedly(
+            Invoke([this](std::shared_ptr<GetObjectAsyncContext> context) {
+              num_gets_++;
+              std::memset(context->buf, 'x', context->len);
+              context->retCode = 0;
+              context->actualLen = context->len;
+              context->cb(nullptr, context);
+            }));
+  }
+
+  std::unique_ptr<CacheGroup> NewGroup(const std::string& listen_address,
+                                       std::shared_ptr<CacheStore> store) {
+    CacheGroupOption option;
+    option.enable = true;
+    option.listen_address = listen_address;
+    option.peers = {kAddress1, kAddress2};
+    option.block_size = kBlockSize;
+    return std::make_unique<CacheGroup>(option, store, s3_);
+  }
+
+  static std::shared_ptr<CacheStore> NewStore() {
+    auto store =
+        std::make_shared<MemCache>(MemCacheOption{.cache_size = 1 << 20});
+    store->Init(nullptr);
+    return store;
+  }
+
+  static constexpr const char* kAddress1 = "127.0.0.1:29100";
+  static constexpr const char* kAddress2 = "127.0.0.1:29101";
+
+  std::shared_ptr<MockS3Client> s3_;
+  std::atomic<int> num_gets_{0};
+};
+
+TEST_F(CacheGroupTest, RangeFromOwner) {
+  auto store1 = NewStore();
+  auto store2 = NewStore();
+  auto group1 = NewGroup(kAddress1, store1);
+  auto group2 = NewGroup(kAddress2, store2);
+  ASSERT_EQ(group1->Start(), BCACHE_ERROR::OK);
+  ASSERT_EQ(group2->Start(), BCACHE_ERROR::OK);
+
+  // find the blocks owned by ourselves and the other member
+  char buffer[100];
+  bool owned = false;
+  bool peer = false;
+  for (uint64_t index = 0; index < 100 && !(owned && peer); index++) {
+    BlockKey key(1, 1, 1, index, 0);
+    auto rc = group1->Range(key, 10, sizeof(buffer), buffer);
+    if (rc == BCACHE_ERROR::NOT_FOUND) {  // owned by group1
+      owned = true;
+      continue;
+    }
+
+    ASSERT_EQ(rc, BCACHE_ERROR::OK);
+    ASSERT_EQ(std::string(buffer, sizeof(buffer)),
+              std::string(sizeof(buffer), 'x'));
+    ASSERT_TRUE(store2->IsCached(key));  // the owner caches whole block
+    ASSERT_FALSE(store1->IsCached(key));
+
+    // the second read is served by cache of owner
+    int num_gets = num_gets_.load();
+    ASSERT_EQ(group1->Range(key, 0, sizeof(buffer), buffer),
+              BCACHE_ERROR::OK);
+    ASSERT_EQ(num_gets_.load(), num_gets);
+    peer = true;
+  }
+  ASSERT_TRUE(owned);
+  ASSERT_TRUE(peer);
+
+  group1->Stop();
+  group2->Stop();
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
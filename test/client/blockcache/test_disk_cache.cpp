@@ -20,8 +20,13 @@
  * Author: Jingli Chen (Wine93)
  */
 
+#include <fcntl.h>
+#include <sys/xattr.h>
+#include <unistd.h>
+
 #include "absl/cleanup/cleanup.h"
 #include "base/filepath/filepath.h"
+#include "client/blockcache/block_checksum.h"
 #include "client/blockcache/cache_store.h"
 #include "client/blockcache/local_filesystem.h"
 #include "client/blockcache/builder/builder.h"
@@ -167,6 +172,56 @@ TEST_F(DiskCacheTest, IsCached) {
   ASSERT_TRUE(disk_cache->IsCached(key_200));
 }
 
+TEST_F(DiskCacheTest, ChecksumMismatch) {
+  auto builder = DiskCacheBuilder();
+  auto _ = MakeCleanup([&]() { builder.Cleanup(); });
+
+  auto disk_cache = builder.Build();
+  auto rc = disk_cache->Init(
+      [](const BlockKey&, const std::string&, BlockContext) {});
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+  auto defer = MakeCleanup([&]() { disk_cache->Shutdown(); });
+
+  auto key = BlockKeyBuilder().Build(100);
+  std::string data(BlockChecksum::kSubBlockSize * 2, 'x');
+  auto block = BlockBuilder().Build(data);
+  rc = disk_cache->Cache(key, block);
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+
+  auto root_dir = builder.GetRootDir();
+  auto cache_path = PathJoin({root_dir, "cache", key.StoreKey()});
+  if (::getxattr(cache_path.c_str(), BlockChecksum::kXattrName, nullptr, 0) <
+      0) {
+    GTEST_SKIP() << "xattr is not supported";
+  }
+
+  // corrupt the second sub-block
+  int fd = ::open(cache_path.c_str(), O_WRONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(::pwrite(fd, "y", 1, BlockChecksum::kSubBlockSize + 1), 1);
+  ::close(fd);
+
+  // the untouched sub-block is still readable
+  char buffer[4];
+  std::shared_ptr<BlockReader> reader;
+  rc = disk_cache->Load(key, reader);
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+  rc = reader->ReadAt(1, 4, buffer);
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 4), "xxxx");
+
+  // the fd is never handed out for the range beyond the block or corrupted
+  off_t fd_offset;
+  ASSERT_FALSE(reader->Fd(1, data.size(), &fd, &fd_offset));
+  ASSERT_FALSE(reader->Fd(BlockChecksum::kSubBlockSize, 4, &fd, &fd_offset));
+
+  rc = reader->ReadAt(BlockChecksum::kSubBlockSize, 4, buffer);
+  reader->Close();
+  ASSERT_EQ(rc, BCACHE_ERROR::CHECKSUM_MISMATCH);
+  ASSERT_FALSE(disk_cache->IsCached(key));
+  ASSERT_FALSE(NewTempLocalFileSystem()->FileExists(cache_path));
+}
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
@@ -89,6 +89,67 @@ TEST_F(DiskCacheLoaderTest, LoadCache) {
   ASSERT_TRUE(disk_cache->IsCached(key));
 }
 
+TEST_F(DiskCacheLoaderTest, LoadMultiDirs) {
+  auto builder = DiskCacheBuilder();
+  auto disk_cache = builder.Build();
+  auto defer = MakeCleanup([&]() {
+    disk_cache->Shutdown();
+    builder.Cleanup();
+  });
+
+  // blocks are hashed into different subdirectories by chunk id
+  std::vector<BlockKey> keys;
+  auto fs = NewTempLocalFileSystem();
+  auto root_dir = builder.GetRootDir();
+  for (uint64_t id : {1, 1000, 2000, 1000000, 2000000}) {
+    auto key = BlockKeyBuilder().Build(id);
+    auto cache_path = PathJoin({root_dir, "cache", key.StoreKey()});
+    ASSERT_EQ(fs->WriteFile(cache_path, "xyz", 3), BCACHE_ERROR::OK);
+    keys.emplace_back(key);
+  }
+
+  auto rc = disk_cache->Init(
+      [](const BlockKey&, const std::string&, BlockContext) {});
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+  std::this_thread::sleep_for(std::chrono::seconds(3));  // wait for reload
+  for (const auto& key : keys) {
+    ASSERT_TRUE(disk_cache->IsCached(key));
+  }
+}
+
+TEST_F(DiskCacheLoaderTest, LoadIndex) {
+  auto builder = DiskCacheBuilder();
+  auto disk_cache = builder.Build();
+  FLAGS_disk_cache_persist_index = true;
+  auto defer = MakeCleanup([&]() {
+    disk_cache->Shutdown();
+    builder.Cleanup();
+  });
+
+  auto key = BlockKeyBuilder().Build(100);
+  auto fs = NewTempLocalFileSystem();
+  auto root_dir = builder.GetRootDir();
+  auto cache_path = PathJoin({root_dir, "cache", key.StoreKey()});
+  auto index_path = PathJoin({root_dir, ".index"});
+  auto uploader = [](const BlockKey&, const std::string&, BlockContext) {};
+  ASSERT_EQ(fs->WriteFile(cache_path, "xyz", 3), BCACHE_ERROR::OK);
+  ASSERT_EQ(disk_cache->Init(uploader), BCACHE_ERROR::OK);
+  std::this_thread::sleep_for(std::chrono::seconds(3));  // wait for reload
+  ASSERT_TRUE(disk_cache->IsCached(key));
+
+  // index saved at shutdown
+  ASSERT_EQ(disk_cache->Shutdown(), BCACHE_ERROR::OK);
+  ASSERT_TRUE(fs->FileExists(index_path));
+
+  // the block is loaded from index rather than walking directory,
+  // and the index is removed after loaded
+  ASSERT_EQ(fs->RemoveFile(cache_path), BCACHE_ERROR::OK);
+  ASSERT_EQ(disk_cache->Init(uploader), BCACHE_ERROR::OK);
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  ASSERT_TRUE(disk_cache->IsCached(key));
+  ASSERT_FALSE(fs->FileExists(index_path));
+}
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
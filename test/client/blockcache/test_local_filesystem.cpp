@@ -20,7 +20,13 @@
  * Author: Jingli Chen (Wine93)
  */
 
+#include <bthread/countdown_event.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <atomic>
 #include <cstdlib>
+#include <vector>
 
 #include "base/filepath/filepath.h"
 #include "client/blockcache/local_filesystem.h"
@@ -146,6 +152,61 @@ TEST_F(LocalFileSystemTest, FileExists) {
   ASSERT_TRUE(fs->FileExists(path));
 }
 
+TEST_F(LocalFileSystemTest, IoUring) {
+  auto io_uring = std::make_shared<IoUring>(8, 2, 8192);
+  if (!io_uring->Start()) {
+    GTEST_SKIP() << "io_uring is not supported by kernel.";
+  }
+  auto fs = std::make_unique<LocalFileSystem>(nullptr, io_uring);
+
+  std::string path = PathJoin({root_dir_, "f1"});
+  std::string data = std::string(4096, 'a') + "hello world";
+  ASSERT_EQ(fs->WriteFile(path, data.c_str(), data.size()), BCACHE_ERROR::OK);
+
+  auto rc = fs->Do([&](const std::shared_ptr<PosixFileSystem> posix) {
+    int fd;
+    char buffer[11];
+    auto rc = posix->Open(path, O_RDONLY, &fd);
+    EXPECT_EQ(rc, BCACHE_ERROR::OK);
+    EXPECT_EQ(posix->PRead(fd, buffer, 11, 4096), BCACHE_ERROR::OK);
+    EXPECT_EQ(std::string(buffer, 11), "hello world");
+    EXPECT_EQ(posix->PRead(fd, buffer, 11, 4100), BCACHE_ERROR::END_OF_FILE);
+
+    // unaligned read from O_DIRECT file, tmpfs may not support it
+    posix->Close(fd);
+    if (posix->Open(path, O_RDONLY | O_DIRECT, &fd) == BCACHE_ERROR::OK) {
+      EXPECT_EQ(posix->PReadDirect(fd, buffer, 11, 4090), BCACHE_ERROR::OK);
+      EXPECT_EQ(std::string(buffer, 11), "aaaaaahello");
+      posix->Close(fd);
+    }
+    return rc;
+  });
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+
+  // async read more requests than the queue depth
+  int fd = ::open(path.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  std::vector<std::string> buffers(64, std::string(11, 0));
+  std::atomic<int> succ(0);
+  bthread::CountdownEvent done(buffers.size());
+  for (auto& buffer : buffers) {
+    io_uring->AsyncPRead(fd, buffer.data(), 11, 4096, -1, [&](int retcode) {
+      if (retcode == 11) {
+        succ++;
+      }
+      done.signal();
+    });
+  }
+  done.wait();
+  ::close(fd);
+  ASSERT_EQ(succ, static_cast<int>(buffers.size()));
+  for (const auto& buffer : buffers) {
+    ASSERT_EQ(buffer, "hello world");
+  }
+
+  io_uring->Stop();
+}
+
 }  // namespace blockcache
 }  // namespace client
 }  // namespace dingofs
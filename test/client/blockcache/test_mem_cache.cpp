@@ -38,13 +38,12 @@ class MemCacheTest : public ::testing::Test {
 };
 
 TEST_F(MemCacheTest, Basic) {
-  auto store = std::make_unique<MemCache>();
+  auto store = std::make_unique<MemCache>(MemCacheOption{.cache_size = 0});
   BlockKey key;
   Block block(nullptr, 0);
   std::shared_ptr<BlockReader> reader;
 
   ASSERT_EQ(store->Init(nullptr), BCACHE_ERROR::OK);
-  ASSERT_EQ(store->Shutdown(), BCACHE_ERROR::OK);
   ASSERT_EQ(store->Stage(key, block, BlockContext(BlockFrom::CTO_FLUSH)),
             BCACHE_ERROR::NOT_SUPPORTED);
   ASSERT_EQ(store->RemoveStage(key, BlockContext(BlockFrom::CTO_FLUSH)),
@@ -53,6 +52,49 @@ TEST_F(MemCacheTest, Basic) {
   ASSERT_EQ(store->Load(key, reader), BCACHE_ERROR::NOT_SUPPORTED);
   ASSERT_FALSE(store->IsCached(key));
   ASSERT_EQ(store->Id(), "memory_cache");
+  ASSERT_EQ(store->Shutdown(), BCACHE_ERROR::OK);
+}
+
+TEST_F(MemCacheTest, CacheAndLoad) {
+  auto store = std::make_unique<MemCache>(MemCacheOption{.cache_size = 1024});
+  BlockKey key(1, 1, 100, 0, 0);
+  std::string data = "hello world";
+  Block block(data.c_str(), data.size());
+  std::shared_ptr<BlockReader> reader;
+
+  ASSERT_EQ(store->Cache(key, block), BCACHE_ERROR::CACHE_DOWN);
+  ASSERT_EQ(store->Init(nullptr), BCACHE_ERROR::OK);
+  ASSERT_EQ(store->Load(key, reader), BCACHE_ERROR::NOT_FOUND);
+  ASSERT_EQ(store->Cache(key, block), BCACHE_ERROR::OK);
+  ASSERT_TRUE(store->IsCached(key));
+  ASSERT_EQ(store->UsedBytes(), data.size());
+
+  char buffer[5];
+  ASSERT_EQ(store->Load(key, reader), BCACHE_ERROR::OK);
+  ASSERT_EQ(reader->ReadAt(6, 5, buffer), BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 5), "world");
+  ASSERT_EQ(reader->ReadAt(7, 5, buffer), BCACHE_ERROR::INVALID_ARGUMENT);
+  reader->Close();
+
+  ASSERT_EQ(store->Shutdown(), BCACHE_ERROR::OK);
+}
+
+TEST_F(MemCacheTest, CapacityBound) {
+  auto store = std::make_unique<MemCache>(MemCacheOption{.cache_size = 1024});
+  std::string data(512, '0');
+  Block block(data.c_str(), data.size());
+
+  ASSERT_EQ(store->Init(nullptr), BCACHE_ERROR::OK);
+  for (uint64_t id = 1; id <= 100; id++) {
+    ASSERT_EQ(store->Cache(BlockKey(1, 1, id, 0, 0), block), BCACHE_ERROR::OK);
+  }
+  ASSERT_LE(store->UsedBytes(), 1024 + data.size() * 16);
+
+  std::string large(2048, '0');
+  ASSERT_EQ(store->Cache(BlockKey(1, 1, 101, 0, 0),
+                         Block(large.c_str(), large.size())),
+            BCACHE_ERROR::CACHE_FULL);
+  ASSERT_EQ(store->Shutdown(), BCACHE_ERROR::OK);
 }
 
 }  // namespace blockcache
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <unistd.h>
+
+#include <thread>
+#include <vector>
+
+#include "absl/cleanup/cleanup.h"
+#include "client/blockcache/builder/builder.h"
+#include "client/blockcache/cache_store.h"
+#include "client/blockcache/segment_cache.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+using ::absl::MakeCleanup;
+
+class SegmentCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(SegmentCacheTest, CacheAndLoad) {
+  auto builder = DiskCacheBuilder();
+  builder.SetOption([](DiskCacheOption* option) {
+    option->segment_size = 1048576;  // 1MiB
+  });
+  auto disk_cache = builder.Build();
+  auto defer = MakeCleanup([&]() {
+    disk_cache->Shutdown();
+    builder.Cleanup();
+  });
+
+  auto rc = disk_cache->Init(
+      [](const BlockKey&, const std::string&, BlockContext) {});
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+
+  auto key_100 = BlockKeyBuilder().Build(100);
+  auto key_200 = BlockKeyBuilder().Build(200);
+  ASSERT_EQ(disk_cache->Cache(key_100, BlockBuilder().Build("hello")),
+            BCACHE_ERROR::OK);
+  ASSERT_EQ(disk_cache->Stage(key_200, BlockBuilder().Build("world"),
+                              BlockContext(BlockFrom::CTO_FLUSH)),
+            BCACHE_ERROR::OK);
+  ASSERT_TRUE(disk_cache->IsCached(key_100));
+  ASSERT_TRUE(disk_cache->IsCached(key_200));
+
+  char buffer[5];
+  std::shared_ptr<BlockReader> reader;
+  ASSERT_EQ(disk_cache->Load(key_200, reader), BCACHE_ERROR::OK);
+  ASSERT_EQ(reader->ReadAt(0, 5, buffer), BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 5), "world");
+  ASSERT_EQ(reader->ReadAt(1, 5, buffer), BCACHE_ERROR::INVALID_ARGUMENT);
+
+  // splice from segment file
+  int fd;
+  off_t fd_offset;
+  ASSERT_TRUE(reader->Fd(1, 4, &fd, &fd_offset));
+  ASSERT_EQ(pread(fd, buffer, 4, fd_offset), 4);
+  ASSERT_EQ(std::string(buffer, 4), "orld");
+  ASSERT_FALSE(reader->Fd(1, 5, &fd, &fd_offset));
+  reader->Close();
+
+  auto key_300 = BlockKeyBuilder().Build(300);
+  ASSERT_FALSE(disk_cache->IsCached(key_300));
+  ASSERT_EQ(disk_cache->Load(key_300, reader), BCACHE_ERROR::NOT_FOUND);
+}
+
+TEST_F(SegmentCacheTest, Reload) {
+  auto builder = DiskCacheBuilder();
+  builder.SetOption([](DiskCacheOption* option) {
+    option->segment_size = 1048576;  // 1MiB
+  });
+  auto disk_cache = builder.Build();
+  auto defer = MakeCleanup([&]() {
+    disk_cache->Shutdown();
+    builder.Cleanup();
+  });
+
+  auto uploader = [](const BlockKey&, const std::string&, BlockContext) {};
+  ASSERT_EQ(disk_cache->Init(uploader), BCACHE_ERROR::OK);
+
+  auto key = BlockKeyBuilder().Build(100);
+  ASSERT_EQ(disk_cache->Cache(key, BlockBuilder().Build("hello")),
+            BCACHE_ERROR::OK);
+
+  // active segment will be sealed when shutdown
+  ASSERT_EQ(disk_cache->Shutdown(), BCACHE_ERROR::OK);
+  ASSERT_EQ(disk_cache->Init(uploader), BCACHE_ERROR::OK);
+  ASSERT_TRUE(disk_cache->IsCached(key));
+
+  char buffer[5];
+  std::shared_ptr<BlockReader> reader;
+  ASSERT_EQ(disk_cache->Load(key, reader), BCACHE_ERROR::OK);
+  ASSERT_EQ(reader->ReadAt(0, 5, buffer), BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 5), "hello");
+}
+
+TEST_F(SegmentCacheTest, CleanupFull) {
+  auto builder = DiskCacheBuilder();
+  builder.SetOption([](DiskCacheOption* option) {
+    option->cache_size = 30;
+    option->segment_size = 10;  // one segment per block
+  });
+  auto disk_cache = builder.Build();
+  auto defer = MakeCleanup([&]() {
+    disk_cache->Shutdown();
+    builder.Cleanup();
+  });
+
+  auto rc = disk_cache->Init(
+      [](const BlockKey&, const std::string&, BlockContext) {});
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+
+  auto block = BlockBuilder().Build(std::string(10, '0'));
+  auto key_100 = BlockKeyBuilder().Build(100);
+  auto key_200 = BlockKeyBuilder().Build(200);
+  auto key_300 = BlockKeyBuilder().Build(300);
+  ASSERT_EQ(disk_cache->Cache(key_100, block), BCACHE_ERROR::OK);
+  ASSERT_EQ(disk_cache->Cache(key_200, block), BCACHE_ERROR::OK);
+  ASSERT_TRUE(disk_cache->IsCached(key_100));
+  ASSERT_TRUE(disk_cache->IsCached(key_200));
+
+  // the oldest segment will be evicted as a whole
+  ASSERT_EQ(disk_cache->Cache(key_300, block), BCACHE_ERROR::OK);
+  ASSERT_FALSE(disk_cache->IsCached(key_100));
+  ASSERT_TRUE(disk_cache->IsCached(key_200));
+  ASSERT_TRUE(disk_cache->IsCached(key_300));
+}
+
+TEST_F(SegmentCacheTest, DeleteAfterReload) {
+  auto option = DiskCacheBuilder::DefaultOption();
+  auto root_dir = option.cache_dir;
+  system(("mkdir -p " + root_dir).c_str());
+  auto defer = MakeCleanup([&]() { system(("rm -r " + root_dir).c_str()); });
+
+  auto segments = std::make_unique<SegmentCache>(
+      option.cache_size, 10, std::make_shared<DiskCacheLayout>(root_dir),
+      NewTempLocalFileSystem(), std::make_shared<DiskCacheMetric>(option));
+  ASSERT_EQ(segments->Start(), BCACHE_ERROR::OK);
+
+  auto key_100 = BlockKeyBuilder().Build(100);
+  auto key_200 = BlockKeyBuilder().Build(200);
+  auto block = BlockBuilder().Build(std::string(10, '0'));
+  ASSERT_EQ(segments->Put(key_100, block), BCACHE_ERROR::OK);
+  ASSERT_EQ(segments->Put(key_200, block), BCACHE_ERROR::OK);
+
+  // the tombstone is persisted in a later segment
+  segments->Delete(key_100);
+  ASSERT_FALSE(segments->Exists(key_100));
+  segments->Stop();
+
+  ASSERT_EQ(segments->Start(), BCACHE_ERROR::OK);
+  ASSERT_FALSE(segments->Exists(key_100));
+  ASSERT_TRUE(segments->Exists(key_200));
+
+  // put again after deleted
+  ASSERT_EQ(segments->Put(key_100, block), BCACHE_ERROR::OK);
+  segments->Stop();
+  ASSERT_EQ(segments->Start(), BCACHE_ERROR::OK);
+  ASSERT_TRUE(segments->Exists(key_100));
+  segments->Stop();
+}
+
+TEST_F(SegmentCacheTest, ConcurrentPut) {
+  auto option = DiskCacheBuilder::DefaultOption();
+  auto root_dir = option.cache_dir;
+  system(("mkdir -p " + root_dir).c_str());
+  auto defer = MakeCleanup([&]() { system(("rm -r " + root_dir).c_str()); });
+
+  auto segments = std::make_unique<SegmentCache>(
+      option.cache_size, 1024, std::make_shared<DiskCacheLayout>(root_dir),
+      NewTempLocalFileSystem(), std::make_shared<DiskCacheMetric>(option));
+  ASSERT_EQ(segments->Start(), BCACHE_ERROR::OK);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&, i]() {
+      std::string data(100, 'a' + i);
+      for (int j = 0; j < 50; j++) {
+        auto key = BlockKeyBuilder().Build(i * 100 + j);
+        ASSERT_EQ(segments->Put(key, BlockBuilder().Build(data)),
+                  BCACHE_ERROR::OK);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  segments->Stop();
+
+  // every block is readable after reload
+  ASSERT_EQ(segments->Start(), BCACHE_ERROR::OK);
+  char buffer[100];
+  for (int i = 0; i < 8; i++) {
+    for (int j = 0; j < 50; j++) {
+      std::shared_ptr<BlockReader> reader;
+      auto key = BlockKeyBuilder().Build(i * 100 + j);
+      ASSERT_EQ(segments->Get(key, reader), BCACHE_ERROR::OK);
+      ASSERT_EQ(reader->ReadAt(0, 100, buffer), BCACHE_ERROR::OK);
+      ASSERT_EQ(std::string(buffer, 100), std::string(100, 'a' + i));
+      reader->Close();
+    }
+  }
+  segments->Stop();
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
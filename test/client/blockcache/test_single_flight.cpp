@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "client/blockcache/single_flight.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+class SingleFlightTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(SingleFlightTest, Basic) {
+  SingleFlight flight;
+  char buffer[5];
+  auto rc = flight.Do("key", 1, 3, buffer, [](off_t, size_t length,
+                                               char* data) {
+    std::memset(data, 'x', length);
+    return BCACHE_ERROR::OK;
+  });
+  ASSERT_EQ(rc, BCACHE_ERROR::OK);
+  ASSERT_EQ(std::string(buffer, 3), "xxx");
+
+  rc = flight.Do("key", 0, 3, buffer, [](off_t, size_t, char*) {
+    return BCACHE_ERROR::NOT_FOUND;
+  });
+  ASSERT_EQ(rc, BCACHE_ERROR::NOT_FOUND);
+}
+
+TEST_F(SingleFlightTest, Coalesce) {
+  SingleFlight flight;
+  auto call = flight.Begin("key", 0, 100);
+
+  std::atomic<int> fetched(0);
+  std::vector<std::thread> threads;
+  std::vector<std::string> results(10);
+  for (int i = 0; i < 10; i++) {
+    threads.emplace_back([&, i]() {
+      char buffer[10];
+      auto rc = flight.Do("key", i * 10, 10, buffer,
+                          [&](off_t, size_t, char*) {
+                            fetched++;
+                            return BCACHE_ERROR::OK;
+                          });
+      ASSERT_EQ(rc, BCACHE_ERROR::OK);
+      results[i] = std::string(buffer, 10);
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  for (int i = 0; i < 100; i++) {
+    call->Buffer()[i] = '0' + i / 10;
+  }
+  flight.End("key", call, BCACHE_ERROR::OK, 100);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(fetched.load(), 0);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(results[i], std::string(10, '0' + i));
+  }
+}
+
+TEST_F(SingleFlightTest, ShortFetch) {
+  SingleFlight flight;
+  auto call = flight.Begin("key", 0, 100);
+
+  std::atomic<int> fetched(0);
+  std::thread thread([&]() {
+    char buffer[10];
+    auto rc = flight.Do("key", 90, 10, buffer, [&](off_t, size_t, char*) {
+      fetched++;
+      return BCACHE_ERROR::OK;
+    });
+    ASSERT_EQ(rc, BCACHE_ERROR::OK);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  flight.End("key", call, BCACHE_ERROR::OK, 50);  // e.g. the last block
+  thread.join();
+  ASSERT_EQ(fetched.load(), 1);
+}
+
+TEST_F(SingleFlightTest, JoinOrBegin) {
+  SingleFlight flight;
+
+  // CASE 1: the first one is leader, the others wait for it
+  bool leader;
+  auto call = flight.JoinOrBegin("key", 10, 10, 0, 100, &leader);
+  ASSERT_TRUE(leader);
+
+  std::vector<std::thread> threads;
+  std::atomic<int> num_leaders(0);
+  std::vector<std::string> results(10);
+  for (int i = 0; i < 10; i++) {
+    threads.emplace_back([&, i]() {
+      bool leader;
+      auto call = flight.JoinOrBegin("key", i * 10, 10, 0, 100, &leader);
+      if (leader) {
+        num_leaders++;
+        return;
+      }
+      char buffer[10];
+      ASSERT_EQ(flight.Wait(call, i * 10, 10, buffer), BCACHE_ERROR::OK);
+      results[i] = std::string(buffer, 10);
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  for (int i = 0; i < 100; i++) {
+    call->Buffer()[i] = '0' + i / 10;
+  }
+  flight.End("key", call, BCACHE_ERROR::OK, 100);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(num_leaders.load(), 0);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(results[i], std::string(10, '0' + i));
+  }
+
+  // CASE 2: the call is removed after end
+  call = flight.JoinOrBegin("key", 10, 10, 0, 100, &leader);
+  ASSERT_TRUE(leader);
+  flight.End("key", call, BCACHE_ERROR::OK, 100);
+}
+
+TEST_F(SingleFlightTest, BorrowedBuffer) {
+  SingleFlight flight;
+  char buffer[100];
+  auto call = flight.Begin("key", 0, 100, buffer);
+  ASSERT_EQ(call->Buffer(), buffer);
+
+  std::string result;
+  std::thread thread([&]() {
+    char data[10];
+    ASSERT_TRUE(flight.Join("key", 50, 10, data));
+    result = std::string(data, 10);
+  });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  std::memset(buffer, 'x', 100);
+  flight.End("key", call, BCACHE_ERROR::OK, 100);
+
+  // the borrowed buffer can be reused once End() returned
+  std::memset(buffer, 'y', 100);
+  thread.join();
+  ASSERT_EQ(result, std::string(10, 'x'));
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
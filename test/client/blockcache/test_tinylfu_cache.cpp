@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "base/time/time.h"
+#include "client/blockcache/tinylfu_cache.h"
+#include "glog/logging.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace blockcache {
+
+class TinyLFUCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+
+  CacheKey Key(uint64_t id) { return BlockKey(1, 1, id, 1, 0); }
+
+  CacheValue Value(size_t size) { return CacheValue(size, TimeSpec(0, 0)); }
+};
+
+TEST_F(TinyLFUCacheTest, Basic) {
+  auto cache = std::make_unique<TinyLFUCache>(100);
+  ASSERT_EQ(cache->Name(), "tinylfu");
+
+  // CASE 1: admit anything if cache not full
+  ASSERT_TRUE(cache->Admit(Key(1), false));
+  cache->Add(Key(1), Value(100));
+
+  // CASE 2: Get(1): OK
+  CacheValue out;
+  ASSERT_TRUE(cache->Get(Key(1), &out));
+  ASSERT_EQ(out.size, 100);
+  ASSERT_EQ(cache->Size(), 1);
+}
+
+TEST_F(TinyLFUCacheTest, ScanResistance) {
+  auto cache = std::make_unique<TinyLFUCache>(100);
+
+  // CASE 1: hot keys which accessed many times
+  CacheValue out;
+  for (int i = 1; i <= 10; i++) {
+    ASSERT_TRUE(cache->Admit(Key(i), false));
+    cache->Add(Key(i), Value(1));
+    for (int j = 0; j < 5; j++) {
+      ASSERT_TRUE(cache->Get(Key(i), &out));
+    }
+  }
+
+  // CASE 2: one-pass scan can't flush out the hot keys
+  for (int i = 1000; i < 1100; i++) {
+    ASSERT_FALSE(cache->Admit(Key(i), true));
+  }
+  ASSERT_EQ(cache->Size(), 10);
+}
+
+TEST_F(TinyLFUCacheTest, Ghost) {
+  auto cache = std::make_unique<TinyLFUCache>(100);
+
+  // CASE 1: evict key 1
+  cache->Add(Key(1), Value(1));
+  cache->Add(Key(2), Value(1));
+  auto evicted = cache->Evict([&](const CacheValue& value) {
+    return FilterStatus::EVICT_IT;
+  });
+  ASSERT_EQ(evicted.size(), 2);
+  ASSERT_EQ(cache->Size(), 0);
+
+  // CASE 2: key accessed again after evicted will be admitted directly
+  cache->Add(Key(3), Value(1));
+  ASSERT_TRUE(cache->Admit(Key(1), true));
+  cache->Add(Key(1), Value(1));
+
+  // CASE 3: the ghost one is in active list, so the other is evicted first
+  evicted = cache->Evict([&](const CacheValue& value) {
+    return FilterStatus::EVICT_IT;
+  });
+  ASSERT_GE(evicted.size(), 1);
+  ASSERT_EQ(evicted[0].key.Filename(), Key(3).Filename());
+}
+
+TEST(FrequencySketchTest, Aging) {
+  FrequencySketch sketch(1 << 16);
+
+  // CASE 1: counter is capped at 15
+  for (int i = 0; i < 20; i++) {
+    sketch.Increment(0);
+  }
+  ASSERT_EQ(sketch.Frequency(0), 15);
+
+  // CASE 2: all counters are halved after sample size increments
+  for (uint64_t hash = 1; hash <= (1 << 16) * 12; hash++) {
+    sketch.Increment(hash);
+  }
+  ASSERT_LT(sketch.Frequency(0), 10);
+}
+
+}  // namespace blockcache
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "client/datastream/flush_scheduler.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace datastream {
+
+class FlushSchedulerTest : public ::testing::Test {
+ protected:
+  static FlushSchedulerOption Option(uint32_t workers,
+                                     uint64_t max_inode_inflight) {
+    return FlushSchedulerOption{
+        .name = "test_flush",
+        .workers = workers,
+        .queue_size = 100,
+        .max_inode_inflight = max_inode_inflight,
+    };
+  }
+
+  // Occupy the only worker until |gate| is set
+  static void Block(FlushScheduler* scheduler, std::shared_future<void> gate) {
+    auto started = std::make_shared<std::promise<void>>();
+    scheduler->Enqueue(100, 0, [started, gate]() {
+      started->set_value();
+      gate.wait();
+    });
+    started->get_future().wait();
+  }
+
+  void Record(FlushScheduler* scheduler, uint64_t ino) {
+    scheduler->Enqueue(ino, 0, [this, ino]() {
+      std::lock_guard<std::mutex> lk(mutex_);
+      order_.push_back(ino);
+    });
+  }
+
+  std::mutex mutex_;
+  std::vector<uint64_t> order_;
+};
+
+TEST_F(FlushSchedulerTest, RoundRobin) {
+  FlushScheduler scheduler(Option(1, 0));
+  ASSERT_TRUE(scheduler.Start());
+
+  std::promise<void> gate;
+  Block(&scheduler, gate.get_future().share());
+  Record(&scheduler, 1);
+  Record(&scheduler, 1);
+  Record(&scheduler, 1);
+  Record(&scheduler, 2);
+  ASSERT_EQ(scheduler.QueueSize(), 4);
+  gate.set_value();
+  scheduler.Stop();
+
+  ASSERT_EQ(order_, (std::vector<uint64_t>{1, 2, 1, 1}));
+  ASSERT_EQ(scheduler.QueueSize(), 0);
+}
+
+TEST_F(FlushSchedulerTest, Urgent) {
+  FlushScheduler scheduler(Option(1, 0));
+  ASSERT_TRUE(scheduler.Start());
+
+  std::promise<void> gate;
+  Block(&scheduler, gate.get_future().share());
+  Record(&scheduler, 1);
+  Record(&scheduler, 1);
+  Record(&scheduler, 2);
+  Record(&scheduler, 2);
+  scheduler.BeginUrgent(2);
+  gate.set_value();
+  scheduler.Stop();
+  scheduler.EndUrgent(2);
+
+  ASSERT_EQ(order_, (std::vector<uint64_t>{2, 2, 1, 1}));
+}
+
+TEST_F(FlushSchedulerTest, InodeInflightCap) {
+  FlushScheduler scheduler(Option(4, 100));
+  ASSERT_TRUE(scheduler.Start());
+
+  std::atomic<int> running(0);
+  std::atomic<int> max_running(0);
+  for (int i = 0; i < 16; i++) {
+    scheduler.Enqueue(1, 60, [&]() {
+      int n = running.fetch_add(1) + 1;
+      int m = max_running.load();
+      while (n > m && !max_running.compare_exchange_weak(m, n)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      running.fetch_sub(1);
+    });
+  }
+
+  // another inode isn't held up by the capped one
+  std::promise<void> done;
+  scheduler.Enqueue(2, 60, [&done]() { done.set_value(); });
+  ASSERT_EQ(done.get_future().wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  scheduler.Stop();
+
+  ASSERT_LE(max_running.load(), 2);  // 60 + 60 > 100, the third waits
+  ASSERT_EQ(running.load(), 0);
+}
+
+}  // namespace datastream
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <string>
+
+#include "base/math/math.h"
+#include "client/datastream/page_cache.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace datastream {
+
+using ::dingofs::base::math::kKiB;
+
+class PageCacheTest : public ::testing::Test {
+ protected:
+  static PageCacheOption Option(uint64_t num_pages) {
+    PageCacheOption option;
+    option.capacity = num_pages * 4 * kKiB;
+    option.page_size = 4 * kKiB;
+    option.num_shards = 1;
+    return option;
+  }
+};
+
+TEST_F(PageCacheTest, GetPut) {
+  PageCache cache(Option(16));
+  std::string page(4 * kKiB, 'a');
+  page[100] = 'b';
+  char buffer[4 * kKiB];
+
+  PageKey key{1, 0, 0};
+  ASSERT_FALSE(cache.Get(key, 1, 0, 10, buffer));
+  cache.Put(key, 1, page.data(), page.size());
+  ASSERT_TRUE(cache.Get(key, 1, 100, 10, buffer));
+  ASSERT_EQ(std::string(buffer, 10), page.substr(100, 10));
+  ASSERT_EQ(cache.Size(), 4 * kKiB);
+
+  // the chunk has changed
+  ASSERT_FALSE(cache.Get(key, 2, 0, 10, buffer));
+  ASSERT_EQ(cache.Size(), 0);
+
+  // the last page of file
+  cache.Put(key, 2, page.data(), 100);
+  ASSERT_TRUE(cache.Get(key, 2, 0, 100, buffer));
+  ASSERT_FALSE(cache.Get(key, 2, 0, 101, buffer));
+
+  // other files
+  ASSERT_FALSE(cache.Get(PageKey{2, 0, 0}, 2, 0, 10, buffer));
+  ASSERT_FALSE(cache.Get(PageKey{1, 1, 0}, 2, 0, 10, buffer));
+}
+
+TEST_F(PageCacheTest, Clock) {
+  PageCache cache(Option(4));
+  std::string page(4 * kKiB, 'a');
+  char buffer[4 * kKiB];
+
+  for (uint64_t i = 0; i < 4; i++) {
+    cache.Put(PageKey{1, 0, i}, 1, page.data(), page.size());
+  }
+  ASSERT_EQ(cache.Size(), 16 * kKiB);
+
+  // the referenced page survives the eviction
+  ASSERT_TRUE(cache.Get(PageKey{1, 0, 0}, 1, 0, 10, buffer));
+  cache.Put(PageKey{1, 0, 4}, 1, page.data(), page.size());
+  ASSERT_EQ(cache.Size(), 16 * kKiB);
+  ASSERT_TRUE(cache.Get(PageKey{1, 0, 0}, 1, 0, 10, buffer));
+  ASSERT_FALSE(cache.Get(PageKey{1, 0, 1}, 1, 0, 10, buffer));
+  ASSERT_TRUE(cache.Get(PageKey{1, 0, 4}, 1, 0, 10, buffer));
+
+  // the slot of dropped page is reused first
+  ASSERT_FALSE(cache.Get(PageKey{1, 0, 2}, 2, 0, 10, buffer));
+  cache.Put(PageKey{1, 0, 5}, 1, page.data(), page.size());
+  ASSERT_TRUE(cache.Get(PageKey{1, 0, 3}, 1, 0, 10, buffer));
+  ASSERT_TRUE(cache.Get(PageKey{1, 0, 5}, 1, 0, 10, buffer));
+}
+
+}  // namespace datastream
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/math/math.h"
+#include "client/datastream/page_allocator.h"
+#include "gtest/gtest.h"
+
+namespace dingofs {
+namespace client {
+namespace datastream {
+
+using ::dingofs::base::math::kKiB;
+
+class PagePoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(PagePoolTest, Basic) {
+  auto page_pool = std::make_unique<PagePool>(
+      PagePoolOption{.num_shards = 4, .use_hugepage = false});
+  ASSERT_TRUE(page_pool->Init(64 * kKiB, 128));
+  ASSERT_EQ(page_pool->GetFreePages(), 128);
+
+  // allocate all of pages, and each page is distinct
+  std::set<char*> pages;
+  for (auto i = 0; i < 128; i++) {
+    char* page = page_pool->Allocate();
+    ASSERT_TRUE(page != nullptr);
+    memset(page, 0, 64 * kKiB);
+    pages.insert(page);
+  }
+  ASSERT_EQ(pages.size(), 128);
+  ASSERT_EQ(page_pool->GetFreePages(), 0);
+
+  // deallocate it
+  for (char* page : pages) {
+    page_pool->DeAllocate(page);
+  }
+  ASSERT_EQ(page_pool->GetFreePages(), 128);
+
+  // allocate again, the cached pages are reused
+  std::set<char*> reused;
+  for (auto i = 0; i < 128; i++) {
+    reused.insert(page_pool->Allocate());
+  }
+  ASSERT_EQ(reused, pages);
+}
+
+TEST_F(PagePoolTest, WaitPage) {
+  auto page_pool = std::make_unique<PagePool>(
+      PagePoolOption{.num_shards = 2, .use_hugepage = false});
+  ASSERT_TRUE(page_pool->Init(4 * kKiB, 4));
+
+  std::vector<char*> pages;
+  for (auto i = 0; i < 4; i++) {
+    pages.push_back(page_pool->Allocate());
+  }
+
+  // blocked until the page is deallocated by another thread
+  std::atomic<bool> allocated(false);
+  std::thread thread([&]() {
+    page_pool->Allocate();
+    allocated.store(true);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_FALSE(allocated.load());
+
+  page_pool->DeAllocate(pages.back());
+  thread.join();
+  ASSERT_TRUE(allocated.load());
+  ASSERT_EQ(page_pool->GetFreePages(), 0);
+}
+
+TEST_F(PagePoolTest, TryAllocate) {
+  auto page_pool = std::make_unique<PagePool>(
+      PagePoolOption{.num_shards = 2, .use_hugepage = false});
+  ASSERT_TRUE(page_pool->Init(4 * kKiB, 4));
+
+  std::vector<char*> pages;
+  for (auto i = 0; i < 4; i++) {
+    char* page = page_pool->TryAllocate();
+    ASSERT_NE(page, nullptr);
+    pages.push_back(page);
+  }
+
+  // never blocked
+  ASSERT_EQ(page_pool->TryAllocate(), nullptr);
+  ASSERT_EQ(page_pool->GetFreePages(), 0);
+
+  page_pool->DeAllocate(pages.back());
+  ASSERT_EQ(page_pool->TryAllocate(), pages.back());
+  ASSERT_EQ(page_pool->GetFreePages(), 0);
+}
+
+TEST_F(PagePoolTest, Concurrent) {
+  auto page_pool = std::make_unique<PagePool>(
+      PagePoolOption{.num_shards = 4, .use_hugepage = false});
+  ASSERT_TRUE(page_pool->Init(4 * kKiB, 64));
+
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < 8; i++) {
+    threads.emplace_back([&]() {
+      for (auto j = 0; j < 10000; j++) {
+        char* page = page_pool->Allocate();
+        page[0] = 'x';
+        page_pool->DeAllocate(page);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(page_pool->GetFreePages(), 64);
+}
+
+}  // namespace datastream
+}  // namespace client
+}  // namespace dingofs
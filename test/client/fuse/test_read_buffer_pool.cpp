@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "client/common/dynamic_config.h"
+#include "client/fuse/read_buffer_pool.h"
+
+namespace dingofs {
+namespace client {
+namespace fuse {
+
+USING_FLAG(fuse_read_buffer_pool_max_mb);
+
+TEST(ReadBufferPoolTest, SizeClass) {
+  ASSERT_EQ(ReadBufferPool::SizeClass(0), 0);
+  ASSERT_EQ(ReadBufferPool::SizeClass(4096), 0);
+  ASSERT_EQ(ReadBufferPool::SizeClass(4097), 1);
+  ASSERT_EQ(ReadBufferPool::SizeClass(128 * 1024), 5);
+  ASSERT_EQ(ReadBufferPool::SizeClass(1024 * 1024), 8);
+  ASSERT_EQ(ReadBufferPool::SizeClass(1024 * 1024 + 1),
+            ReadBufferPool::kNumClasses);
+  ASSERT_EQ(ReadBufferPool::ClassSize(8), 1024 * 1024);
+}
+
+TEST(ReadBufferPoolTest, Reuse) {
+  auto& pool = ReadBufferPool::GetInstance();
+
+  char* buffer = pool.Allocate(100 * 1024);
+  std::memset(buffer, 'x', 128 * 1024);  // the whole class is usable
+  pool.Deallocate(buffer, 100 * 1024);
+
+  // reused by the same size class, and it's not zeroed
+  char* reused = pool.Allocate(128 * 1024);
+  ASSERT_EQ(reused, buffer);
+  ASSERT_EQ(reused[0], 'x');
+  pool.Deallocate(reused, 128 * 1024);
+
+  // not pooled
+  {
+    ReadBuffer large(4 * 1024 * 1024);
+    ASSERT_EQ(large.Size(), 4 * 1024 * 1024);
+    std::memset(large.Data(), 0, large.Size());
+  }
+}
+
+TEST(ReadBufferPoolTest, ThreadExit) {
+  auto& pool = ReadBufferPool::GetInstance();
+  uint64_t cached = pool.CachedBytes();
+
+  // the thread cache goes back to the shared free lists
+  std::thread thread([]() {
+    std::vector<char*> buffers;
+    for (int i = 0; i < 4; i++) {
+      buffers.push_back(ReadBufferPool::GetInstance().Allocate(1024 * 1024));
+    }
+    for (char* buffer : buffers) {
+      ReadBufferPool::GetInstance().Deallocate(buffer, 1024 * 1024);
+    }
+  });
+  thread.join();
+  ASSERT_EQ(pool.CachedBytes(), cached + 4 * 1024 * 1024);
+
+  // taken from the shared free lists
+  std::thread([&]() {
+    ReadBuffer buffer(1024 * 1024);
+    ASSERT_EQ(pool.CachedBytes(), cached + 3 * 1024 * 1024);
+  }).join();
+}
+
+TEST(ReadBufferPoolTest, MaxCachedBytes) {
+  auto& pool = ReadBufferPool::GetInstance();
+  uint64_t cached = pool.CachedBytes();
+  FLAGS_fuse_read_buffer_pool_max_mb = 1;
+
+  uint64_t limit = std::max<uint64_t>(cached, 1024 * 1024);
+  std::thread thread([&]() {
+    std::vector<char*> buffers;
+    for (int i = 0; i < 16; i++) {
+      buffers.push_back(pool.Allocate(512 * 1024));
+    }
+    for (char* buffer : buffers) {
+      pool.Deallocate(buffer, 512 * 1024);
+    }
+
+    // the thread cache is bounded too
+    ASSERT_LE(pool.CachedBytes(), limit);
+  });
+  thread.join();
+
+  // the surplus is freed instead of cached
+  ASSERT_LE(pool.CachedBytes(), limit);
+  FLAGS_fuse_read_buffer_pool_max_mb = 256;
+}
+
+}  // namespace fuse
+}  // namespace client
+}  // namespace dingofs
@@ -26,6 +26,7 @@
 #include "client/vfs_old/s3/client_s3_cache_manager.h"
 #include "client/vfs_old/s3/client_s3_adaptor.h"
 #include "client/vfs_old/mock_client_s3_cache_manager.h"
+#include "client/vfs_old/mock_inode_cache_manager.h"
 
 namespace dingofs {
 namespace client {
@@ -333,6 +334,115 @@ TEST_F(ChunkCacheManagerTest, test_flush) {
   delete[] buf;
 }
 
+TEST_F(ChunkCacheManagerTest, test_commit_flush_in_order) {
+  uint64_t inodeId = 1;
+  uint64_t len = 1024 * 1024;
+  char* buf = new char[len];
+  auto dataCache1 = std::make_shared<MockDataCache>(
+      s3ClientAdaptor_, chunkCacheManager_, 0, len, buf, nullptr);
+  auto dataCache2 = std::make_shared<MockDataCache>(
+      s3ClientAdaptor_, chunkCacheManager_, len, len, buf, nullptr);
+  for (const auto& dataCache : {dataCache1, dataCache2}) {
+    EXPECT_CALL(*dataCache, Flush(_, _)).WillOnce(Return(DINGOFS_ERROR::OK));
+    EXPECT_CALL(*dataCache, CanFlush(_)).WillOnce(Return(true));
+    chunkCacheManager_->AddWriteDataCacheForTest(dataCache);
+  }
+
+  // flush returns before the data caches are committed
+  ASSERT_EQ(DINGOFS_ERROR::OK, chunkCacheManager_->Flush(inodeId, true, true));
+  ASSERT_FALSE(chunkCacheManager_->IsEmpty());
+
+  // the data caches are still readable while flushing
+  char* readBuf = new char[len];
+  std::vector<ReadRequest> requests;
+  chunkCacheManager_->ReadChunk(0, 0, len, readBuf, 0, &requests);
+  ASSERT_TRUE(requests.empty());
+
+  // committed in the order of flush
+  std::vector<int> committed;
+  chunkCacheManager_->CommitFlush(
+      dataCache2.get(), [&](uint64_t) { committed.push_back(2); });
+  ASSERT_TRUE(committed.empty());
+  chunkCacheManager_->CommitFlush(
+      dataCache1.get(), [&](uint64_t) { committed.push_back(1); });
+  ASSERT_EQ(committed, std::vector<int>({1, 2}));
+  ASSERT_TRUE(chunkCacheManager_->IsEmpty());
+  chunkCacheManager_->WaitFlush();
+
+  delete[] readBuf;
+  delete[] buf;
+}
+
+TEST_F(ChunkCacheManagerTest, test_coalesce_write_cache) {
+  common::S3ClientAdaptorOption option;
+  option.blockSize = 1 * 1024 * 1024;
+  option.chunkSize = 4 * 1024 * 1024;
+  option.baseSleepUs = 500;
+  option.objectPrefix = 0;
+  option.pageSize = 64 * 1024;
+  option.intervalMs = 5000 * 1000;
+  option.flushIntervalSec = 5000;
+  option.readCacheMaxByte = 104857600;
+  option.writeCacheMaxByte = 10485760000;
+  option.readCacheThreads = 5;
+  option.writeMergeGapByte = 256 * 1024;
+  option.writeAlignBlock = true;
+  auto* s3ClientAdaptor = new S3ClientAdaptorImpl();
+  auto fsCacheManager = std::make_shared<FsCacheManager>(
+      s3ClientAdaptor, option.readCacheMaxByte, option.writeCacheMaxByte,
+      option.readCacheThreads, nullptr);
+  auto mockInodeManager = std::make_shared<MockInodeCacheManager>();
+  s3ClientAdaptor->Init(option, nullptr, mockInodeManager, nullptr,
+                        fsCacheManager, nullptr, nullptr, nullptr);
+  auto chunkCacheManager =
+      std::make_shared<ChunkCacheManager>(0, s3ClientAdaptor, nullptr);
+
+  // nothing is committed, the gaps are holes
+  uint64_t fileLen = 1536 * 1024;
+  pb::metaserver::Inode inode;
+  inode.set_inodeid(1);
+  inode.set_length(fileLen);
+  auto inodeWrapper = std::make_shared<InodeWrapper>(inode, nullptr);
+  EXPECT_CALL(*mockInodeManager, GetInode(_, _))
+      .WillRepeatedly(
+          DoAll(SetArgReferee<1>(inodeWrapper), Return(DINGOFS_ERROR::OK)));
+
+  std::vector<char> data(1024, 'a');
+  chunkCacheManager->WriteNewDataCache(s3ClientAdaptor, 0, 1024, data.data());
+  chunkCacheManager->WriteNewDataCache(s3ClientAdaptor, 128 * 1024, 1024,
+                                       data.data());
+  chunkCacheManager->WriteNewDataCache(s3ClientAdaptor, 1028 * 1024, 1024,
+                                       data.data());
+  ASSERT_EQ(3, fsCacheManager->GetDataCacheNum());
+
+  // the first two are merged into [0, 129KiB) over the hole between
+  // them, but the holes are never padded to the block boundary
+  chunkCacheManager->CoalesceWriteCache(1);
+  ASSERT_EQ(2, fsCacheManager->GetDataCacheNum());
+  ASSERT_EQ(256 * 1024, fsCacheManager->GetDataCacheSize());
+
+  uint64_t mergedLen = 129 * 1024;
+  std::vector<char> readBuf(mergedLen, 'x');
+  std::vector<ReadRequest> requests;
+  chunkCacheManager->ReadByWriteCache(0, mergedLen, readBuf.data(), 0,
+                                      &requests);
+  ASSERT_TRUE(requests.empty());
+  std::vector<char> expectBuf(mergedLen, 0);
+  for (uint64_t pos : {0, 128 * 1024}) {
+    memset(expectBuf.data() + pos, 'a', 1024);
+  }
+  ASSERT_EQ(expectBuf, readBuf);
+
+  requests.clear();
+  readBuf.resize(1024 * 1024 - mergedLen);
+  chunkCacheManager->ReadByWriteCache(mergedLen, readBuf.size(),
+                                      readBuf.data(), 0, &requests);
+  ASSERT_EQ(1, requests.size());  // not padded
+
+  chunkCacheManager->ReleaseCacheForTest();
+  delete s3ClientAdaptor;
+}
+
 TEST_F(ChunkCacheManagerTest, test_release_read_dataCache) {
   uint64_t offset = 0;
   uint64_t len = 1024 * 1024;
@@ -133,5 +133,43 @@ TEST_F(MemCachedTest, MultiThreadTask) {
     }
   }
 }
+
+TEST_F(MemCachedTest, MGet) {
+  CountDownEvent setEvent(2);
+  for (const auto& kv : {std::make_pair("k1", "0123456789"),
+                         std::make_pair("k2", "abcdefghij")}) {
+    auto task = std::make_shared<SetKVCacheTask>(kv.first, kv.second, 10);
+    task->done = [&setEvent](const std::shared_ptr<SetKVCacheTask>& task) {
+      setEvent.Signal();
+    };
+    manager_.Set(task);
+  }
+  setEvent.Wait();
+
+  // the same key for different ranges, and a key which doesn't exist
+  char buffer[16];
+  auto task = std::make_shared<MGetKVCacheTask>();
+  task->requests = {
+      KVGetRequest{"k1", buffer, 0, 4},
+      KVGetRequest{"k1", buffer + 4, 6, 4},
+      KVGetRequest{"k2", buffer + 8, 2, 4},
+      KVGetRequest{"k3", buffer + 12, 0, 4},
+      KVGetRequest{"k2", buffer + 12, 8, 4},  // out of range
+  };
+  CountDownEvent getEvent(1);
+  task->done = [&getEvent](const std::shared_ptr<MGetKVCacheTask>& task) {
+    getEvent.Signal();
+  };
+  manager_.MGet(task);
+  getEvent.Wait();
+
+  ASSERT_TRUE(task->requests[0].res);
+  ASSERT_TRUE(task->requests[1].res);
+  ASSERT_TRUE(task->requests[2].res);
+  ASSERT_FALSE(task->requests[3].res);
+  ASSERT_FALSE(task->requests[4].res);
+  ASSERT_EQ(0, memcmp(buffer, "01236789cdef", 12));
+}
+
 }  // namespace client
 }  // namespace dingofs
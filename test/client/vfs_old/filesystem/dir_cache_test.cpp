@@ -22,6 +22,8 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+
 #include "client/vfs_old/filesystem/utils.h"
 #include "client/vfs_old/filesystem/helper/helper.h"
 
@@ -41,6 +43,14 @@ class DirCacheTest : public ::testing::Test {
   void SetUp() override {}
 
   void TearDown() override {}
+
+  static std::shared_ptr<DirEntryList> MkEntries(Ino start, size_t n) {
+    auto entries = std::make_shared<DirEntryList>();
+    for (size_t i = 0; i < n; i++) {
+      entries->Add(MkDirEntry(start + i, "f" + std::to_string(i)));
+    }
+    return entries;
+  }
 };
 
 TEST_F(DirEntryListTest, Size) {
@@ -208,6 +218,68 @@ TEST_F(DirEntryListTest, Mtime) {
   ASSERT_EQ(time, TimeSpec(123, 456));
 }
 
+TEST_F(DirCacheTest, EvictByCharge) {
+  // small capacity keeps a single shard, so the LRU order is exact
+  auto dirCache = DirCacheBuilder()
+                      .SetOption([](DirCacheOption* option) {
+                        option->lruSize = 100;
+                      })
+                      .Build();
+  auto metric = dirCache->GetMetric();
+  dirCache->Start();
+
+  std::shared_ptr<DirEntryList> entries;
+  dirCache->Put(1, MkEntries(100, 40));
+  dirCache->Put(2, MkEntries(200, 40));
+  ASSERT_EQ(metric->GetEntries(), 80);
+
+  // CASE 1: each directory charges its entries, the oldest one is evicted
+  dirCache->Put(3, MkEntries(300, 40));
+  ASSERT_FALSE(dirCache->Get(1, &entries));
+  ASSERT_TRUE(dirCache->Get(2, &entries));
+  ASSERT_TRUE(dirCache->Get(3, &entries));
+  ASSERT_EQ(metric->GetEntries(), 80);
+
+  // CASE 2: a directory larger than capacity evicts all others but itself
+  dirCache->Put(4, MkEntries(400, 150));
+  ASSERT_FALSE(dirCache->Get(2, &entries));
+  ASSERT_FALSE(dirCache->Get(3, &entries));
+  ASSERT_TRUE(dirCache->Get(4, &entries));
+  ASSERT_EQ(entries->Size(), 150);
+  ASSERT_EQ(metric->GetEntries(), 150);
+
+  dirCache->Stop();
+  ASSERT_EQ(metric->GetEntries(), 0);
+}
+
+TEST_F(DirCacheTest, MetricEntries) {
+  auto dirCache = DirCacheBuilder().Build();
+  auto metric = dirCache->GetMetric();
+  dirCache->Start();
+
+  // CASE 1: put
+  dirCache->Put(1, MkEntries(100, 10));
+  dirCache->Put(2, MkEntries(200, 20));
+  ASSERT_EQ(metric->GetEntries(), 30);
+
+  // CASE 2: empty directory is not cached
+  dirCache->Put(3, MkEntries(300, 0));
+  ASSERT_EQ(metric->GetEntries(), 30);
+
+  // CASE 3: replace subtracts the old entries
+  dirCache->Put(1, MkEntries(100, 5));
+  ASSERT_EQ(metric->GetEntries(), 25);
+
+  // CASE 4: drop
+  dirCache->Drop(2);
+  ASSERT_EQ(metric->GetEntries(), 5);
+  dirCache->Drop(2);
+  ASSERT_EQ(metric->GetEntries(), 5);
+
+  dirCache->Stop();
+  ASSERT_EQ(metric->GetEntries(), 0);
+}
+
 }  // namespace filesystem
 }  // namespace client
 }  // namespace dingofs
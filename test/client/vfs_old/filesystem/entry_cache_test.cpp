@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include "client/vfs_old/filesystem/entry_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "client/vfs_old/common/config.h"
+#include "client/vfs_old/filesystem/helper/helper.h"
+
+namespace dingofs {
+namespace client {
+namespace filesystem {
+
+using dingofs::client::common::EntryCacheOption;
+
+class EntryCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(EntryCacheTest, Basic) {
+  auto option = EntryCacheOption{leaseSec : 10, capacityMB : 1};
+  auto cache = std::make_shared<EntryCache>(option);
+
+  InodeAttr attr;
+  ASSERT_FALSE(cache->GetEntry(1, "f1", &attr));
+  ASSERT_FALSE(cache->GetAttr(100, &attr));
+
+  cache->PutEntry(1, "f1", MkAttr(100, AttrOption().length(4096)),
+                  cache->Epoch());
+  ASSERT_TRUE(cache->GetEntry(1, "f1", &attr));
+  ASSERT_EQ(attr.inodeid(), 100);
+  ASSERT_EQ(attr.length(), 4096);
+  ASSERT_TRUE(cache->GetAttr(100, &attr));
+  ASSERT_EQ(attr.length(), 4096);
+}
+
+TEST_F(EntryCacheTest, Enable) {
+  auto option = EntryCacheOption{leaseSec : 0, capacityMB : 1};
+  auto cache = std::make_shared<EntryCache>(option);
+
+  InodeAttr attr;
+  cache->PutEntry(1, "f1", MkAttr(100), cache->Epoch());
+  ASSERT_FALSE(cache->GetEntry(1, "f1", &attr));
+  ASSERT_FALSE(cache->GetAttr(100, &attr));
+}
+
+TEST_F(EntryCacheTest, Lease) {
+  auto option = EntryCacheOption{leaseSec : 1, capacityMB : 1};
+  auto cache = std::make_shared<EntryCache>(option);
+
+  InodeAttr attr;
+  cache->PutEntry(1, "f1", MkAttr(100), cache->Epoch());
+  ASSERT_TRUE(cache->GetEntry(1, "f1", &attr));
+
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  ASSERT_FALSE(cache->GetEntry(1, "f1", &attr));
+  ASSERT_FALSE(cache->GetAttr(100, &attr));
+}
+
+TEST_F(EntryCacheTest, Invalidate) {
+  auto option = EntryCacheOption{leaseSec : 10, capacityMB : 1};
+  auto cache = std::make_shared<EntryCache>(option);
+
+  // CASE 1: delete entry
+  InodeAttr attr;
+  cache->PutEntry(1, "f1", MkAttr(100), cache->Epoch());
+  cache->DeleteEntry(1, "f1");
+  ASSERT_FALSE(cache->GetEntry(1, "f1", &attr));
+  ASSERT_TRUE(cache->GetAttr(100, &attr));
+
+  // CASE 2: delete attribute, the entry is useless without it
+  cache->PutEntry(1, "f1", MkAttr(100), cache->Epoch());
+  cache->DeleteAttr(100);
+  ASSERT_FALSE(cache->GetEntry(1, "f1", &attr));
+  ASSERT_FALSE(cache->GetAttr(100, &attr));
+
+  // CASE 3: the result fetched before invalidation is not cached
+  uint64_t epoch = cache->Epoch();
+  cache->DeleteEntry(1, "f1");
+  cache->PutEntry(1, "f1", MkAttr(100), epoch);
+  ASSERT_FALSE(cache->GetEntry(1, "f1", &attr));
+
+  // CASE 4: invalidation of others doesn't stop caching
+  epoch = cache->Epoch();
+  cache->DeleteAttr(200);
+  cache->PutAttr(MkAttr(100, AttrOption().length(4096)), epoch);
+  ASSERT_TRUE(cache->GetAttr(100, &attr));
+  ASSERT_EQ(attr.length(), 4096);
+
+  // CASE 5: the attribute fetched before its invalidation is not cached
+  epoch = cache->Epoch();
+  cache->DeleteAttr(100);
+  cache->PutAttr(MkAttr(100), epoch);
+  ASSERT_FALSE(cache->GetAttr(100, &attr));
+}
+
+TEST_F(EntryCacheTest, Capacity) {
+  auto option = EntryCacheOption{leaseSec : 10, capacityMB : 1};
+  auto cache = std::make_shared<EntryCache>(option);
+
+  // the names are far more than the capacity
+  std::string prefix(4096, 'x');
+  for (int i = 0; i < 1000; i++) {
+    cache->PutEntry(1, prefix + std::to_string(i), MkAttr(100 + i),
+                    cache->Epoch());
+  }
+
+  InodeAttr attr;
+  ASSERT_FALSE(cache->GetEntry(1, prefix + "0", &attr));
+  ASSERT_TRUE(cache->GetEntry(1, prefix + "999", &attr));
+}
+
+}  // namespace filesystem
+}  // namespace client
+}  // namespace dingofs
@@ -83,6 +83,35 @@ TEST_F(FileSystemTest, Lookup_NegativeCache) {
   ASSERT_EQ(rc, DINGOFS_ERROR::NOTEXIST);
 }
 
+TEST_F(FileSystemTest, Lookup_PositiveCache) {
+  auto builder = FileSystemBuilder();
+  auto fs = builder
+                .SetOption([](FileSystemOption* option) {
+                  option->entryCacheOption.leaseSec = 3600;
+                  option->entryCacheOption.capacityMB = 64;
+                })
+                .Build();
+
+  EXPECT_CALL_RETURN_GetDentry(*builder.GetDentryManager(), DINGOFS_ERROR::OK);
+  EXPECT_CALL_RETURN_GetInodeAttr(*builder.GetInodeManager(),
+                                  DINGOFS_ERROR::OK);
+
+  // CASE 1: the second lookup hit the cache
+  EntryOut entryOut;
+  auto rc = fs->Lookup(Request(), 1, "f1", &entryOut);
+  ASSERT_EQ(rc, DINGOFS_ERROR::OK);
+
+  rc = fs->Lookup(Request(), 1, "f1", &entryOut);
+  ASSERT_EQ(rc, DINGOFS_ERROR::OK);
+
+  // CASE 2: invalidated by local mutation
+  fs->InvalidateEntry(1, "f1");
+  EXPECT_CALL_RETURN_GetDentry(*builder.GetDentryManager(),
+                               DINGOFS_ERROR::NOTEXIST);
+  rc = fs->Lookup(Request(), 1, "f1", &entryOut);
+  ASSERT_EQ(rc, DINGOFS_ERROR::NOTEXIST);
+}
+
 TEST_F(FileSystemTest, GetAttr_Basic) {
   auto builder = FileSystemBuilder();
   auto fs = builder.Build();
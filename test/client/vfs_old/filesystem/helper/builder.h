@@ -42,6 +42,7 @@ namespace filesystem {
 using dingofs::client::common::AttrWatcherOption;
 using dingofs::client::common::DeferSyncOption;
 using dingofs::client::common::DirCacheOption;
+using dingofs::client::common::EntryCacheOption;
 using dingofs::client::common::FileSystemOption;
 using dingofs::client::common::KernelCacheOption;
 using dingofs::client::common::LookupCacheOption;
@@ -206,6 +207,10 @@ class FileSystemBuilder {
       lruSize : 100000,
       negativeTimeoutSec : 0,
     };
+    auto entryCacheOption = EntryCacheOption{
+      leaseSec : 0,
+      capacityMB : 64,
+    };
     auto attrWatcherOption = AttrWatcherOption{
       lruSize : 5000000,
     };
@@ -216,6 +221,7 @@ class FileSystemBuilder {
     option.blockSize = 0x10000u;
     option.kernelCacheOption = kernelCacheOption;
     option.lookupCacheOption = lookupCacheOption;
+    option.entryCacheOption = entryCacheOption;
     option.dirCacheOption = DirCacheBuilder::DefaultOption();
     option.openFilesOption = OpenFilesBuilder::DefaultOption();
     option.attrWatcherOption = attrWatcherOption;
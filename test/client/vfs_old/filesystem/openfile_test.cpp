@@ -98,6 +98,34 @@ TEST_F(OpenFileTest, References) {
   ASSERT_FALSE(yes);
 }
 
+TEST_F(OpenFileTest, Written) {
+  auto builder = OpenFilesBuilder();
+  auto openfiles = builder.Build();
+
+  Ino ino(100);
+  auto inode = MkInode(ino);
+  bool written = true;
+
+  // CASE 1: not written
+  openfiles->Open(ino, inode);
+  openfiles->Close(ino, &written);
+  ASSERT_FALSE(written);
+
+  // CASE 2: written, reported by the last close only
+  openfiles->Open(ino, inode);
+  openfiles->Open(ino, inode);
+  openfiles->MarkWritten(ino);
+  openfiles->Close(ino, &written);
+  ASSERT_FALSE(written);
+  openfiles->Close(ino, &written);
+  ASSERT_TRUE(written);
+
+  // CASE 3: reopen resets it
+  openfiles->Open(ino, inode);
+  openfiles->Close(ino, &written);
+  ASSERT_FALSE(written);
+}
+
 TEST_F(OpenFileTest, CloseAll) {
   auto builder = OpenFilesBuilder();
   auto openfiles = builder.Build();
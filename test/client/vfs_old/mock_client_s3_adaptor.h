@@ -64,7 +64,10 @@ class MockS3ClientAdaptor : public S3ClientAdaptor {
 
   MOCK_METHOD4(Read, int(uint64_t inodeId, uint64_t offset, uint64_t length,
                          char* buf));
+  MOCK_METHOD4(ReadSplice, int(uint64_t inodeId, uint64_t offset,
+                               uint64_t length, vfs::SpliceBuffer* buffer));
   MOCK_METHOD1(ReleaseCache, void(uint64_t inodeId));
+  MOCK_METHOD1(ReleaseReadahead, void(uint64_t inodeId));
   MOCK_METHOD1(Flush, DINGOFS_ERROR(uint64_t inodeId));
   MOCK_METHOD1(FlushAllCache, DINGOFS_ERROR(uint64_t inodeId));
   MOCK_METHOD0(FsSync, DINGOFS_ERROR());
@@ -82,6 +85,7 @@ class MockS3ClientAdaptor : public S3ClientAdaptor {
   MOCK_METHOD0(GetChunkSize, uint64_t());
   MOCK_METHOD0(GetObjectPrefix, uint32_t());
   MOCK_METHOD0(HasDiskCache, bool());
+  MOCK_METHOD0(GetForegroundReads, uint32_t());
 };
 
 }  // namespace client
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "client/vfs_old/s3/read_planner.h"
+
+namespace dingofs {
+namespace client {
+
+TEST(ReadPlannerTest, Merge) {
+  ReadPlannerOption option;
+  option.mergeGapBytes = 100;
+  ReadPlanner planner(option);
+
+  char buffer[4096];
+  std::vector<RangeRead> reads{
+      RangeRead{"b", 0, 100, buffer},
+      RangeRead{"a", 1000, 100, buffer + 100},
+      RangeRead{"a", 0, 100, buffer + 200},
+      RangeRead{"a", 100, 100, buffer + 300},  // adjacent
+      RangeRead{"a", 150, 100, buffer + 400},  // overlapping
+      RangeRead{"a", 300, 100, buffer + 500},  // within the gap
+      RangeRead{"b", 0, 0, buffer + 600},      // empty
+  };
+
+  auto fetches = planner.Plan(reads);
+  ASSERT_EQ(fetches.size(), 3);
+
+  ASSERT_EQ(fetches[0].key, "a");
+  ASSERT_EQ(fetches[0].offset, 0);
+  ASSERT_EQ(fetches[0].length, 400);
+  ASSERT_EQ(fetches[0].reads.size(), 4);
+  ASSERT_EQ(fetches[0].reads[0].buffer, buffer + 200);
+
+  ASSERT_EQ(fetches[1].key, "a");
+  ASSERT_EQ(fetches[1].offset, 1000);
+  ASSERT_EQ(fetches[1].length, 100);
+
+  ASSERT_EQ(fetches[2].key, "b");
+  ASSERT_EQ(fetches[2].reads.size(), 1);
+
+  for (const auto& fetch : fetches) {
+    ASSERT_EQ(fetch.parts.size(), 1);
+    ASSERT_EQ(fetch.parts[0].offset, fetch.offset);
+    ASSERT_EQ(fetch.parts[0].length, fetch.length);
+  }
+}
+
+TEST(ReadPlannerTest, Split) {
+  ReadPlannerOption option;
+  option.splitBytes = 1024;
+  ReadPlanner planner(option);
+
+  char buffer[4096];
+  auto fetches = planner.Plan({RangeRead{"a", 100, 2049, buffer}});
+  ASSERT_EQ(fetches.size(), 1);
+
+  // 3 parts of almost the same size
+  const auto& parts = fetches[0].parts;
+  ASSERT_EQ(parts.size(), 3);
+  uint64_t offset = 100;
+  for (const auto& part : parts) {
+    ASSERT_EQ(part.offset, offset);
+    ASSERT_LE(part.length, 1024);
+    ASSERT_GE(part.length, 683);
+    offset += part.length;
+  }
+  ASSERT_EQ(offset, 100 + 2049);
+
+  // not split
+  fetches = planner.Plan({RangeRead{"a", 0, 1024, buffer}});
+  ASSERT_EQ(fetches[0].parts.size(), 1);
+}
+
+}  // namespace client
+}  // namespace dingofs
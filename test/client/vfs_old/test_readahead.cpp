@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "client/vfs_old/s3/readahead.h"
+
+namespace dingofs {
+namespace client {
+
+using blockcache::FlightCall;
+
+static constexpr uint64_t kBlockSize = 1024;
+static constexpr uint64_t kFileLen = 1024 * 1024;
+
+class ReadaheadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    option_.blockSize = kBlockSize;
+    option_.minBlocks = 1;
+    option_.maxBlocks = 8;
+  }
+
+  ReadaheadOption option_;
+};
+
+TEST_F(ReadaheadTest, Sequential) {
+  auto budget = std::make_shared<ReadaheadBudget>(0, 0);
+  Readahead readahead(option_, budget);
+
+  // the first read doesn't confirm the stream
+  ASSERT_TRUE(readahead.OnRead(0, 100, kFileLen).empty());
+
+  auto ranges = readahead.OnRead(100, 100, kFileLen);
+  ASSERT_EQ(ranges.size(), 1);
+  ASSERT_EQ(ranges[0].offset, 200);
+  ASSERT_EQ(ranges[0].len, kBlockSize);
+  ASSERT_EQ(readahead.WindowBytes(), 2 * kBlockSize);
+
+  // the window doubles until max blocks
+  uint64_t offset = 200;
+  uint64_t ra_end = 200 + kBlockSize;
+  for (int i = 0; i < 100; i++) {
+    for (const auto& range : readahead.OnRead(offset, 100, kFileLen)) {
+      ASSERT_EQ(range.offset, ra_end);
+      ra_end += range.len;
+    }
+    offset += 100;
+  }
+  ASSERT_EQ(readahead.WindowBytes(), 8 * kBlockSize);
+  ASSERT_GT(ra_end, offset);
+
+  // random read breaks the stream
+  ASSERT_TRUE(readahead.OnRead(500 * 1024, 100, kFileLen).empty());
+  ASSERT_EQ(readahead.WindowBytes(), kBlockSize);
+
+  // never beyond the end of file
+  ranges = readahead.OnRead(500 * 1024 + 100, 100, 500 * 1024 + 300);
+  ASSERT_EQ(ranges.size(), 1);
+  ASSERT_EQ(ranges[0].offset, 500 * 1024 + 200);
+  ASSERT_EQ(ranges[0].len, 100);
+}
+
+TEST_F(ReadaheadTest, Strided) {
+  auto budget = std::make_shared<ReadaheadBudget>(0, 0);
+  Readahead readahead(option_, budget);
+
+  ASSERT_TRUE(readahead.OnRead(0, 100, kFileLen).empty());
+  ASSERT_TRUE(readahead.OnRead(1000, 100, kFileLen).empty());
+
+  auto ranges = readahead.OnRead(2000, 100, kFileLen);
+  ASSERT_EQ(ranges.size(), 8);  // max blocks
+  for (size_t i = 0; i < ranges.size(); i++) {
+    ASSERT_EQ(ranges[i].offset, 3000 + i * 1000);
+    ASSERT_EQ(ranges[i].len, 100);
+  }
+
+  // only the strides which are not issued yet
+  ranges = readahead.OnRead(3000, 100, kFileLen);
+  ASSERT_FALSE(ranges.empty());
+  ASSERT_EQ(ranges[0].offset, 11000);
+}
+
+TEST_F(ReadaheadTest, Budget) {
+  auto budget = std::make_shared<ReadaheadBudget>(2 * kBlockSize, 0);
+  {
+    Readahead readahead(option_, budget);
+    ASSERT_TRUE(readahead.Issue("a", kBlockSize, kBlockSize));
+    ASSERT_FALSE(readahead.Issue("a", kBlockSize, kBlockSize));
+    ASSERT_TRUE(readahead.Issue("b", 2 * kBlockSize, kBlockSize));
+    ASSERT_FALSE(readahead.Issue("c", 3 * kBlockSize, kBlockSize));
+    ASSERT_EQ(budget->UsedBytes(), 2 * kBlockSize);
+
+    // put into cache store
+    readahead.Complete("a", nullptr, kBlockSize);
+    ASSERT_EQ(budget->UsedBytes(), kBlockSize);
+
+    // failed
+    readahead.Abort("b");
+    ASSERT_EQ(budget->UsedBytes(), 0);
+
+    // held in memory
+    ASSERT_TRUE(readahead.Issue("c", 3 * kBlockSize, kBlockSize));
+    auto call = std::make_shared<FlightCall>(0, kBlockSize);
+    std::memset(call->Buffer(), 'x', kBlockSize);
+    readahead.Complete("c", call, kBlockSize);
+    ASSERT_EQ(budget->UsedBytes(), kBlockSize);
+  }
+  ASSERT_EQ(budget->UsedBytes(), 0);
+
+  auto throttle = std::make_shared<ReadaheadBudget>(0, kBlockSize);
+  Readahead readahead(option_, throttle);
+  ASSERT_TRUE(readahead.Issue("a", kBlockSize, kBlockSize));
+  readahead.Complete("a", nullptr, kBlockSize);
+  ASSERT_FALSE(readahead.Issue("b", 2 * kBlockSize, kBlockSize));
+}
+
+TEST_F(ReadaheadTest, ReadAndEvict) {
+  auto budget = std::make_shared<ReadaheadBudget>(0, 0);
+  Readahead readahead(option_, budget);
+
+  ASSERT_TRUE(readahead.OnRead(0, 100, kFileLen).empty());
+  ASSERT_EQ(readahead.OnRead(100, 100, kFileLen).size(), 1);
+  ASSERT_EQ(readahead.WindowBytes(), 2 * kBlockSize);
+
+  ASSERT_TRUE(readahead.Issue("a", 2 * kBlockSize, kBlockSize));
+  ASSERT_TRUE(readahead.Issue("b", 3 * kBlockSize, kBlockSize));
+  auto call = std::make_shared<FlightCall>(0, kBlockSize);
+  std::memset(call->Buffer(), 'x', kBlockSize);
+  readahead.Complete("a", call, 100);
+
+  char buffer[100];
+  ASSERT_FALSE(readahead.Read("a", 50, 100, buffer));  // beyond the data
+  ASSERT_TRUE(readahead.Read("a", 0, 100, buffer));
+  ASSERT_EQ(std::string(buffer, 100), std::string(100, 'x'));
+  ASSERT_FALSE(readahead.Read("b", 0, 100, buffer));  // inflight
+
+  // dropped once the reader passed them
+  readahead.Complete("b", nullptr, kBlockSize);
+  readahead.OnRead(200, 1000, kFileLen);
+  readahead.OnRead(1200, 2000, kFileLen);
+  readahead.OnRead(3200, 100, kFileLen);
+  ASSERT_FALSE(readahead.Wanted("a"));
+  ASSERT_EQ(budget->UsedBytes(), 0);
+}
+
+TEST_F(ReadaheadTest, Cancel) {
+  auto budget = std::make_shared<ReadaheadBudget>(0, 0);
+  Readahead readahead(option_, budget);
+
+  ASSERT_TRUE(readahead.OnRead(0, 100, kFileLen).empty());
+  ASSERT_EQ(readahead.OnRead(100, 100, kFileLen).size(), 1);
+  ASSERT_TRUE(readahead.Issue("a", 2 * kBlockSize, kBlockSize));
+  ASSERT_TRUE(readahead.Wanted("a"));
+
+  // random read cancels the inflight readahead
+  ASSERT_TRUE(readahead.OnRead(100 * 1024, 100, kFileLen).empty());
+  ASSERT_FALSE(readahead.Wanted("a"));
+  ASSERT_EQ(budget->UsedBytes(), kBlockSize);
+
+  readahead.Complete("a", nullptr, kBlockSize);
+  ASSERT_EQ(budget->UsedBytes(), 0);
+  ASSERT_TRUE(readahead.Issue("a", 2 * kBlockSize, kBlockSize));
+}
+
+TEST_F(ReadaheadTest, ReleaseAtEof) {
+  auto budget = std::make_shared<ReadaheadBudget>(0, 0);
+  Readahead readahead(option_, budget);
+  uint64_t file_len = 3 * kBlockSize;
+
+  ASSERT_TRUE(readahead.OnRead(0, 100, file_len).empty());
+  ASSERT_EQ(readahead.OnRead(100, 100, file_len).size(), 1);
+  ASSERT_TRUE(readahead.Issue("a", 2 * kBlockSize, kBlockSize));
+  ASSERT_TRUE(readahead.Issue("b", 3 * kBlockSize, kBlockSize));
+  auto call = std::make_shared<FlightCall>(0, kBlockSize);
+  std::memset(call->Buffer(), 'x', kBlockSize);
+  readahead.Complete("a", call, kBlockSize);
+  ASSERT_EQ(budget->UsedBytes(), 2 * kBlockSize);
+
+  // the last read reaches the end of file
+  char buffer[kBlockSize];
+  readahead.OnRead(200, file_len - 200, file_len);
+  ASSERT_TRUE(readahead.Read("a", 0, kBlockSize, buffer));
+  ASSERT_FALSE(readahead.Wanted("a"));
+  ASSERT_EQ(budget->UsedBytes(), kBlockSize);
+
+  // used while inflight, released once it's done
+  ASSERT_FALSE(readahead.Read("b", 0, kBlockSize, buffer));
+  readahead.Complete("b", call, kBlockSize);
+  ASSERT_FALSE(readahead.Wanted("b"));
+  ASSERT_EQ(budget->UsedBytes(), 0);
+}
+
+TEST_F(ReadaheadTest, ReleaseOnClose) {
+  auto budget = std::make_shared<ReadaheadBudget>(0, 0);
+  Readahead readahead(option_, budget);
+
+  ASSERT_TRUE(readahead.OnRead(0, 100, kFileLen).empty());
+  ASSERT_EQ(readahead.OnRead(100, 100, kFileLen).size(), 1);
+  ASSERT_TRUE(readahead.Issue("a", 2 * kBlockSize, kBlockSize));
+  ASSERT_TRUE(readahead.Issue("b", 3 * kBlockSize, kBlockSize));
+  auto call = std::make_shared<FlightCall>(0, kBlockSize);
+  readahead.Complete("a", call, kBlockSize);
+
+  readahead.Release();
+  ASSERT_FALSE(readahead.Wanted("a"));
+  ASSERT_FALSE(readahead.Wanted("b"));
+  ASSERT_EQ(budget->UsedBytes(), kBlockSize);  // b is inflight
+  readahead.Complete("b", call, kBlockSize);
+  ASSERT_EQ(budget->UsedBytes(), 0);
+
+  // the stream starts over
+  ASSERT_EQ(readahead.WindowBytes(), kBlockSize);
+  ASSERT_TRUE(readahead.OnRead(200, 100, kFileLen).empty());
+}
+
+TEST_F(ReadaheadTest, ReleaseIdle) {
+  auto budget = std::make_shared<ReadaheadBudget>(2 * kBlockSize, 0, 10);
+  Readahead idle(option_, budget);
+  Readahead active(option_, budget);
+
+  auto call = std::make_shared<FlightCall>(0, kBlockSize);
+  idle.OnRead(0, 100, kFileLen);
+  ASSERT_TRUE(idle.Issue("a", kBlockSize, kBlockSize));
+  ASSERT_TRUE(idle.Issue("b", 2 * kBlockSize, kBlockSize));
+  idle.Complete("a", call, kBlockSize);
+  idle.Complete("b", call, kBlockSize);
+  ASSERT_EQ(idle.ReleaseIdle(0, 10), 0);  // not idle yet
+
+  // the held blocks of the idle file make room for others
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  active.OnRead(0, 100, kFileLen);
+  ASSERT_TRUE(active.Issue("c", kBlockSize, kBlockSize));
+  ASSERT_FALSE(idle.Wanted("a"));
+  ASSERT_FALSE(idle.Wanted("b"));
+  ASSERT_TRUE(active.Wanted("c"));
+  ASSERT_EQ(budget->UsedBytes(), kBlockSize);
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "client/vfs_old/slice_index.h"
+#include "dingofs/metaserver.pb.h"
+
+namespace dingofs {
+namespace client {
+
+using pb::metaserver::S3ChunkInfo;
+using pb::metaserver::S3ChunkInfoList;
+
+static S3ChunkInfo MakeSlice(uint64_t chunk_id, uint64_t offset,
+                             uint64_t len) {
+  S3ChunkInfo info;
+  info.set_chunkid(chunk_id);
+  info.set_compaction(0);
+  info.set_offset(offset);
+  info.set_len(len);
+  info.set_size(len);
+  info.set_zero(false);
+  return info;
+}
+
+TEST(SliceIndexTest, Resolve) {
+  S3ChunkInfoList slices;
+  *slices.add_s3chunks() = MakeSlice(1, 0, 100);
+  *slices.add_s3chunks() = MakeSlice(2, 20, 10);
+  SliceIndex index(slices);
+  index.Add(MakeSlice(3, 90, 20));
+  ASSERT_EQ(index.Size(), 4);
+
+  //  0     20  30      90   110  120
+  //  |--1--|-2-|---1---|--3--|
+  auto ranges = index.Resolve(10, 110);
+  ASSERT_EQ(ranges.size(), 5);
+  std::vector<uint64_t> chunk_ids{1, 2, 1, 3};
+  std::vector<uint64_t> offsets{10, 20, 30, 90, 110};
+  for (size_t i = 0; i < ranges.size(); i++) {
+    ASSERT_EQ(ranges[i].offset, offsets[i]);
+    if (i < chunk_ids.size()) {
+      ASSERT_FALSE(ranges[i].hole);
+      ASSERT_EQ(ranges[i].slice.chunkId, chunk_ids[i]);
+    }
+  }
+  ASSERT_TRUE(ranges[4].hole);
+  ASSERT_EQ(ranges[4].len, 10);
+  ASSERT_EQ(ranges[2].slice.offset, 0);  // the begin of slice, not piece
+}
+
+TEST(SliceIndexTest, Version) {
+  S3ChunkInfoList slices;
+  *slices.add_s3chunks() = MakeSlice(1, 0, 100);
+  SliceIndex index(slices);
+  ASSERT_EQ(index.Version(), SliceIndex(slices).Version());
+
+  uint64_t version = index.Version();
+  index.Add(MakeSlice(2, 0, 100));
+  ASSERT_NE(index.Version(), version);
+
+  // truncated
+  slices.mutable_s3chunks(0)->set_len(50);
+  ASSERT_NE(SliceIndex(slices).Version(), version);
+}
+
+// Compare with the byte-by-byte result of applying slices in order
+TEST(SliceIndexTest, Random) {
+  constexpr uint64_t kLength = 1024;
+  std::vector<uint64_t> expected(kLength, 0);  // 0 means hole
+  SliceIndex index;
+
+  ::srand(1234);
+  for (uint64_t chunk_id = 1; chunk_id <= 1000; chunk_id++) {
+    uint64_t offset = ::rand() % kLength;
+    uint64_t len = 1 + ::rand() % (kLength - offset);
+    index.Add(MakeSlice(chunk_id, offset, len));
+    for (uint64_t i = offset; i < offset + len; i++) {
+      expected[i] = chunk_id;
+    }
+
+    uint64_t read_offset = ::rand() % kLength;
+    uint64_t read_len = 1 + ::rand() % (kLength - read_offset);
+    uint64_t pos = read_offset;
+    for (const auto& range : index.Resolve(read_offset, read_len)) {
+      ASSERT_EQ(range.offset, pos);
+      for (uint64_t i = range.offset; i < range.offset + range.len; i++) {
+        ASSERT_EQ(expected[i], range.hole ? 0 : range.slice.chunkId);
+      }
+      pos += range.len;
+    }
+    ASSERT_EQ(pos, read_offset + read_len);
+  }
+}
+
+}  // namespace client
+}  // namespace dingofs
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 dingodb.com, Inc. All Rights Reserved
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Project: DingoFS
+ * Created Date: 2026-10-16
+ */
+
+#include <butil/time.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+
+#include "client/vfs_old/warmup/warmup_fetcher.h"
+
+namespace dingofs {
+namespace client {
+namespace warmup {
+
+class WarmupFetcherTest : public ::testing::Test {
+ protected:
+  static bool Admitted(std::future<bool>* future) {
+    return future->wait_for(std::chrono::milliseconds(100)) ==
+           std::future_status::ready;
+  }
+};
+
+TEST_F(WarmupFetcherTest, Window) {
+  WarmupFetcher fetcher(WarmupFetcherOption{.max_inflight_bytes = 100},
+                        nullptr);
+  ASSERT_TRUE(fetcher.Acquire("a", 60));
+  ASSERT_FALSE(fetcher.Acquire("a", 60));  // inflight already
+
+  auto future = std::async(std::launch::async,
+                           [&]() { return fetcher.Acquire("b", 60); });
+  ASSERT_FALSE(Admitted(&future));  // 60 + 60 > 100
+  fetcher.Release("a", 60);
+  ASSERT_TRUE(Admitted(&future));
+  ASSERT_TRUE(future.get());
+  ASSERT_EQ(fetcher.InflightBytes(), 60);
+
+  // the first one is admitted even if it's larger than window
+  fetcher.Release("b", 60);
+  ASSERT_TRUE(fetcher.Acquire("c", 200));
+  fetcher.Release("c", 200);
+}
+
+TEST_F(WarmupFetcherTest, Busy) {
+  std::atomic<bool> busy(true);
+  WarmupFetcher fetcher(WarmupFetcherOption{.max_inflight_bytes = 100},
+                        [&busy]() { return busy.load(); });
+  ASSERT_TRUE(fetcher.Acquire("a", 10));
+
+  // only one is inflight while foreground reads are waiting
+  auto future = std::async(std::launch::async,
+                           [&]() { return fetcher.Acquire("b", 10); });
+  ASSERT_FALSE(Admitted(&future));
+  busy.store(false);
+  ASSERT_TRUE(Admitted(&future));
+  ASSERT_TRUE(future.get());
+}
+
+TEST_F(WarmupFetcherTest, Bandwidth) {
+  WarmupFetcher fetcher(WarmupFetcherOption{.bandwidth = 100}, nullptr);
+  int64_t second = butil::monotonic_time_s();
+  ASSERT_TRUE(fetcher.Acquire("a", 60));
+  fetcher.Release("a", 60);
+
+  // the budget of current second is used up, wait for the next one
+  ASSERT_TRUE(fetcher.Acquire("b", 60));
+  ASSERT_GT(butil::monotonic_time_s(), second);
+  fetcher.Release("b", 60);
+}
+
+TEST_F(WarmupFetcherTest, Stop) {
+  WarmupFetcher fetcher(WarmupFetcherOption{.max_inflight_bytes = 100},
+                        nullptr);
+  ASSERT_TRUE(fetcher.Acquire("a", 100));
+
+  auto future = std::async(std::launch::async,
+                           [&]() { return fetcher.Acquire("b", 1); });
+  ASSERT_FALSE(Admitted(&future));
+  fetcher.Stop();
+  ASSERT_TRUE(Admitted(&future));
+  ASSERT_FALSE(future.get());
+}
+
+}  // namespace warmup
+}  // namespace client
+}  // namespace dingofs
@@ -26,6 +26,11 @@
 #include <gtest/gtest.h>
 
 #include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "utils/timeutility.h"
 
@@ -350,5 +355,139 @@ TEST(TimedCaCheTest, test_timeout) {
   ASSERT_EQ(0, cache->Size());
 }
 
+TEST(ShardedCacheTest, test_base) {
+  ShardedLRUCache<uint64_t, std::string> cache(0, "ShardedLruCache", 4);
+  ASSERT_EQ(4, cache.NumShards());
+
+  std::string res;
+  ASSERT_FALSE(cache.Get(1, &res));
+  for (uint64_t i = 0; i < 100; i++) {
+    cache.Put(i, std::to_string(i));
+  }
+  ASSERT_EQ(100, cache.Size());
+  ASSERT_TRUE(cache.Get(1, &res));
+  ASSERT_EQ("1", res);
+
+  cache.Update(1, [](std::string* value, bool found) {
+    ASSERT_TRUE(found);
+    value->append("1");
+  });
+  cache.Update(100, [](std::string* value, bool found) {
+    ASSERT_FALSE(found);
+    *value = "100";
+  });
+  ASSERT_TRUE(cache.Get(1, &res));
+  ASSERT_EQ("11", res);
+  ASSERT_TRUE(cache.Get(100, &res));
+  ASSERT_EQ("100", res);
+
+  ASSERT_TRUE(cache.Remove(1, &res));
+  ASSERT_EQ("11", res);
+  ASSERT_FALSE(cache.Remove(1));
+  ASSERT_EQ(100, cache.Size());
+}
+
+TEST(ShardedCacheTest, test_evict_by_charge) {
+  std::vector<uint64_t> evicted;
+  ShardedLRUCache<uint64_t, int> cache(
+      10, "", 1, [&](const uint64_t& key, const int&) {
+        evicted.push_back(key);
+      });
+
+  cache.Put(1, 1, 4);
+  cache.Put(2, 2, 4);
+  int res;
+  ASSERT_TRUE(cache.Get(1, &res));  // 2 is the oldest one now
+  cache.Put(3, 3, 4);
+  ASSERT_EQ(std::vector<uint64_t>{2}, evicted);
+  ASSERT_EQ(8, cache.Charge());
+
+  // the newest one is kept even if it exceeds the capacity
+  cache.Put(4, 4, 20);
+  ASSERT_EQ(3, evicted.size());
+  ASSERT_TRUE(cache.Get(4, &res));
+
+  // replaced and cleared items are also passed to callback
+  cache.Put(4, 5);
+  cache.Clear();
+  ASSERT_EQ((std::vector<uint64_t>{2, 1, 3, 4, 4}), evicted);
+  ASSERT_EQ(0, cache.Size());
+  ASSERT_EQ(0, cache.Charge());
+}
+
+TEST(ShardedCacheTest, test_small_capacity) {
+  // each shard holds at least kMinShardCapacity items
+  ShardedLRUCache<uint64_t, int> cache(1);
+  ASSERT_EQ(1, cache.NumShards());
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  int res;
+  ASSERT_FALSE(cache.Get(1, &res));
+  ASSERT_TRUE(cache.Get(2, &res));
+}
+
+struct PairKey {
+  uint64_t id;
+  std::string name;
+};
+
+struct PairKeyView {
+  uint64_t id;
+  std::string_view name;
+};
+
+struct PairKeyHash {
+  using is_transparent = void;
+
+  template <typename Key>
+  size_t operator()(const Key& key) const {
+    return absl::Hash<std::pair<uint64_t, std::string_view>>()(
+        std::make_pair(key.id, std::string_view(key.name)));
+  }
+};
+
+struct PairKeyEqual {
+  using is_transparent = void;
+
+  template <typename Lhs, typename Rhs>
+  bool operator()(const Lhs& lhs, const Rhs& rhs) const {
+    return lhs.id == rhs.id &&
+           std::string_view(lhs.name) == std::string_view(rhs.name);
+  }
+};
+
+TEST(ShardedCacheTest, test_heterogeneous_lookup) {
+  ShardedLRUCache<PairKey, int, PairKeyHash, PairKeyEqual> cache(0);
+  cache.Put(PairKey{1, "f1"}, 1);
+
+  int res;
+  ASSERT_TRUE(cache.Get(PairKeyView{1, "f1"}, &res));
+  ASSERT_EQ(1, res);
+  ASSERT_FALSE(cache.Get(PairKeyView{2, "f1"}, &res));
+  ASSERT_FALSE(cache.Get(PairKeyView{1, "f2"}, &res));
+  ASSERT_TRUE(cache.Remove(PairKeyView{1, "f1"}));
+  ASSERT_FALSE(cache.Get(PairKey{1, "f1"}, &res));
+}
+
+TEST(ShardedCacheTest, test_concurrent) {
+  ShardedLRUCache<uint64_t, uint64_t> cache(0, "ShardedLruCacheConcurrent");
+  std::vector<std::thread> threads;
+  for (uint64_t t = 0; t < 8; t++) {
+    threads.emplace_back([&cache, t]() {
+      for (uint64_t i = 0; i < 1000; i++) {
+        uint64_t key = t * 1000 + i;
+        uint64_t value;
+        cache.Put(key, key);
+        ASSERT_TRUE(cache.Get(key, &value));
+        ASSERT_EQ(key, value);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(8000, cache.Size());
+}
+
 }  // namespace utils
 }  // namespace dingofs